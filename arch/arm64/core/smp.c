@@ -166,12 +166,12 @@ void z_arm64_secondary_start(void)
 
 #ifdef CONFIG_SMP
 
-static void broadcast_ipi(unsigned int ipi)
+static void send_ipi(unsigned int ipi, uint32_t cpu_bitmap)
 {
 	uint64_t mpidr = MPIDR_TO_CORE(GET_MPIDR());
 
 	/*
-	 * Send SGI to all cores except itself
+	 * Send SGI to all selected cores except itself
 	 */
 	unsigned int num_cpus = arch_num_cpus();
 
@@ -179,7 +179,8 @@ static void broadcast_ipi(unsigned int ipi)
 		uint64_t target_mpidr = cpu_map[i];
 		uint8_t aff0;
 
-		if (mpidr == target_mpidr || mpidr == INV_MPID) {
+		if (mpidr == target_mpidr || mpidr == INV_MPID ||
+		    (cpu_bitmap & BIT(i)) == 0U) {
 			continue;
 		}
 
@@ -188,6 +189,11 @@ static void broadcast_ipi(unsigned int ipi)
 	}
 }
 
+static inline void broadcast_ipi(unsigned int ipi)
+{
+	send_ipi(ipi, BIT_MASK(arch_num_cpus()));
+}
+
 void sched_ipi_handler(const void *unused)
 {
 	ARG_UNUSED(unused);
@@ -201,6 +207,11 @@ void arch_sched_ipi(void)
 	broadcast_ipi(SGI_SCHED_IPI);
 }
 
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
+{
+	send_ipi(SGI_SCHED_IPI, cpu_bitmap);
+}
+
 #ifdef CONFIG_USERSPACE
 void mem_cfg_ipi_handler(const void *unused)
 {
@@ -204,6 +204,10 @@ if(CONFIG_INPUT)
   zephyr_iterable_section(NAME input_listener KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
 endif()
 
+if(CONFIG_CBPRINTF_PACKAGE_PRECOMPILED)
+  zephyr_iterable_section(NAME cbprintf_package_layout KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
+endif()
+
 if(CONFIG_USBD_MSC_CLASS)
   zephyr_iterable_section(NAME usbd_msc_lun KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
 endif()
@@ -82,6 +82,100 @@ int loopback_get_num_dropped_packets(void)
 
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+struct loopback_delayed_pkt {
+	struct net_pkt *pkt;
+	int64_t due;
+};
+
+/* Leave some packets to the receiving side, so that cloning does not
+ * wait for the delayed ones.
+ */
+static struct loopback_delayed_pkt loopback_delayed[CONFIG_NET_PKT_RX_COUNT / 2];
+static size_t loopback_delayed_head;
+static size_t loopback_delayed_count;
+static uint32_t loopback_packet_delay_ms;
+static struct k_spinlock loopback_delay_lock;
+
+static void loopback_delay_handler(struct k_work *work);
+
+static K_WORK_DELAYABLE_DEFINE(loopback_delay_work, loopback_delay_handler);
+
+int loopback_set_packet_delay(uint32_t delay_ms)
+{
+	loopback_packet_delay_ms = delay_ms;
+	return 0;
+}
+
+/* Deliver the packets whose delay has passed, in the order they were sent */
+static void loopback_delay_handler(struct k_work *work)
+{
+	struct loopback_delayed_pkt *delayed;
+	k_spinlock_key_t key;
+	struct net_pkt *pkt;
+	int64_t now;
+
+	ARG_UNUSED(work);
+
+	while (true) {
+		key = k_spin_lock(&loopback_delay_lock);
+
+		if (loopback_delayed_count == 0) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			break;
+		}
+
+		delayed = &loopback_delayed[loopback_delayed_head];
+		now = k_uptime_get();
+		if (delayed->due > now) {
+			k_spin_unlock(&loopback_delay_lock, key);
+			k_work_schedule(&loopback_delay_work,
+					K_MSEC(delayed->due - now));
+			break;
+		}
+
+		pkt = delayed->pkt;
+		loopback_delayed_head = (loopback_delayed_head + 1) %
+					ARRAY_SIZE(loopback_delayed);
+		loopback_delayed_count--;
+
+		k_spin_unlock(&loopback_delay_lock, key);
+
+		if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+			LOG_ERR("Data receive failed.");
+			net_pkt_unref(pkt);
+		}
+	}
+}
+
+static int loopback_delay_pkt(struct net_pkt *pkt)
+{
+	struct loopback_delayed_pkt *delayed;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&loopback_delay_lock);
+
+	if (loopback_delayed_count == ARRAY_SIZE(loopback_delayed)) {
+		k_spin_unlock(&loopback_delay_lock, key);
+		return -ENOBUFS;
+	}
+
+	delayed = &loopback_delayed[(loopback_delayed_head +
+				     loopback_delayed_count) %
+				    ARRAY_SIZE(loopback_delayed)];
+	delayed->pkt = pkt;
+	delayed->due = k_uptime_get() + loopback_packet_delay_ms;
+	loopback_delayed_count++;
+
+	k_spin_unlock(&loopback_delay_lock, key);
+
+	/* Does nothing if an earlier packet already scheduled the work */
+	k_work_schedule(&loopback_delay_work, K_MSEC(loopback_packet_delay_ms));
+
+	return 0;
+}
+#endif
+
 static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 {
 	struct net_pkt *cloned;
@@ -138,6 +232,18 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 		goto out;
 	}
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+	if (loopback_packet_delay_ms > 0) {
+		/* Like a link with a full queue, drop what does not fit */
+		if (loopback_delay_pkt(cloned) < 0) {
+			net_pkt_unref(cloned);
+		}
+
+		res = 0;
+		goto out;
+	}
+#endif
+
 	res = net_recv_data(net_pkt_iface(cloned), cloned);
 	if (res < 0) {
 		LOG_ERR("Data receive failed.");
@@ -112,6 +112,72 @@ struct json_obj_descr {
 	};
 };
 
+/** @cond INTERNAL_HIDDEN */
+
+#ifdef CONFIG_JSON_STREAM_MAX_DEPTH
+#define Z_JSON_STREAM_MAX_DEPTH CONFIG_JSON_STREAM_MAX_DEPTH
+#else
+#define Z_JSON_STREAM_MAX_DEPTH 8
+#endif
+
+/* Longest integer the streaming parser decodes, sign included */
+#define Z_JSON_STREAM_NUM_LEN 16
+
+/* One object or array being decoded by the streaming parser */
+struct json_stream_frame {
+	/* Object fields or array element, NULL when skipping the value */
+	const struct json_obj_descr *descr;
+	/* Number of fields, or maximum number of elements */
+	size_t len;
+	/* Struct holding the fields, or first array element */
+	void *val;
+	/* Element counter in the parent struct, if any */
+	size_t *count;
+	/* Bitmap of decoded fields, or number of decoded elements */
+	int64_t decoded;
+	ptrdiff_t elem_size;
+	/* Index in descr of the field being decoded, -1 if unknown */
+	int8_t field;
+	uint8_t state;
+};
+
+/** @endcond */
+
+/**
+ * @brief State of the streaming JSON parser
+ *
+ * Set up with json_stream_obj_parse_init() or
+ * json_stream_arr_parse_init(); the members are private.
+ */
+struct json_stream_parser {
+	struct json_stream_frame stack[Z_JSON_STREAM_MAX_DEPTH];
+	/* Value being decoded, NULL when skipping it */
+	const struct json_obj_descr *descr;
+	void *field;
+	/* Remaining characters of true or false */
+	const char *literal;
+	/* Storage for decoded strings */
+	char *buf;
+	size_t buf_size;
+	size_t buf_used;
+	/* Offset in buf of the value being decoded */
+	size_t tok_start;
+	/* Nesting of a JSON_TOK_OBJ_ARRAY value being copied */
+	size_t raw_depth;
+	/* Fields whose name matches the key read so far */
+	uint64_t key_match;
+	int64_t result;
+	uint8_t depth;
+	uint8_t lex;
+	uint8_t sink;
+	uint8_t type;
+	/* Length of the key or number read so far */
+	uint8_t count;
+	/* Hex digits left in a \u escape */
+	uint8_t hex;
+	char num[Z_JSON_STREAM_NUM_LEN];
+};
+
 /**
  * @brief Function pointer type to append bytes to a buffer while
  * encoding JSON data.
@@ -652,6 +718,96 @@ int json_arr_separate_object_parse_init(struct json_obj *json, char *payload, si
 int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_descr *descr,
 				   size_t descr_len, void *val);
 
+/**
+ * @brief Initialize streaming parsing of an object
+ *
+ * Prepares @a parser to decode a JSON-encoded object that is provided
+ * in chunks with json_stream_parse_feed(), for example straight from
+ * network buffer fragments or socket reads, so that the whole payload
+ * never has to be held in memory.  Values are decoded according to
+ * @a descr into the struct pointed to by @a val, like json_obj_parse()
+ * does, with the same liberties taken.
+ *
+ * As the chunks do not outlive the call they are fed in, decoded
+ * strings, JSON_TOK_OPAQUE and JSON_TOK_FLOAT tokens and
+ * JSON_TOK_OBJ_ARRAY data are copied to @a buf, and the decoded values
+ * point into it.  Strings are NUL-terminated.  Fields not in the
+ * descriptor are skipped, including nested objects and arrays.
+ *
+ * @param parser Parser state
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array. Must be
+ * less than 63.
+ * @param val Pointer to the struct to hold the decoded values
+ * @param buf Storage for the decoded strings, may be NULL if there are
+ * none
+ * @param buf_size Size of @a buf, in bytes
+ */
+void json_stream_obj_parse_init(struct json_stream_parser *parser,
+				const struct json_obj_descr *descr, size_t descr_len,
+				void *val, char *buf, size_t buf_size);
+
+/**
+ * @brief Initialize streaming parsing of an array
+ *
+ * Like json_stream_obj_parse_init(), for a JSON-encoded array decoded
+ * like json_arr_parse() does.
+ *
+ * @param parser Parser state
+ * @param descr Pointer to the array descriptor
+ * @param val Pointer to the struct to hold the decoded values
+ * @param buf Storage for the decoded strings, may be NULL if there are
+ * none
+ * @param buf_size Size of @a buf, in bytes
+ */
+void json_stream_arr_parse_init(struct json_stream_parser *parser,
+				const struct json_obj_descr *descr, void *val,
+				char *buf, size_t buf_size);
+
+/**
+ * @brief Feed the next chunk of JSON data to a streaming parser
+ *
+ * Tokens may be split across chunks in any way.  Data following the
+ * end of the top-level object or array is ignored.
+ *
+ * @param parser Parser state
+ * @param data Next chunk of the JSON-encoded value
+ * @param len Length of @a data, in bytes
+ *
+ * @return 0 if the chunk has been consumed, or a negative error code:
+ * -EINVAL for malformed data or values not matching the descriptor,
+ * -ENOSPC if an array has more elements than fit, -ENOMEM if the
+ * string storage is exhausted, -E2BIG if the data is nested deeper than
+ * CONFIG_JSON_STREAM_MAX_DEPTH.  Once an error has been returned, the
+ * parser keeps returning it.
+ */
+int json_stream_parse_feed(struct json_stream_parser *parser, const char *data,
+			   size_t len);
+
+/**
+ * @brief Finish streaming parsing
+ *
+ * @param parser Parser state
+ *
+ * @return < 0 if error, including -EINVAL if the data fed so far does
+ * not hold a complete object or array.  Otherwise the return value of
+ * json_obj_parse() or json_arr_parse() for the same data: the bitmap
+ * of the decoded fields for an object, 0 for an array.
+ */
+int64_t json_stream_parse_finish(struct json_stream_parser *parser);
+
+/**
+ * @brief Get the amount of string storage a streaming parser has used
+ *
+ * @param parser Parser state
+ *
+ * @return Number of bytes of the buffer passed at initialization in use
+ */
+static inline size_t json_stream_parse_buf_used(const struct json_stream_parser *parser)
+{
+	return parser->buf_used;
+}
+
 /**
  * @brief Escapes the string so it can be used to encode JSON objects
  *
@@ -764,6 +920,52 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+/**
+ * @brief Encodes an object through a buffer
+ *
+ * Like json_obj_encode(), but the output is collected in @a buffer and
+ * passed to @a append_bytes only when it is full, and once more at the
+ * end, so that a writer such as a socket send sees few large writes
+ * instead of many small ones, and the encoded object never has to fit
+ * in memory as a whole.
+ *
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array
+ * @param val Struct holding the values
+ * @param append_bytes Function to append bytes to the output
+ * @param data Data pointer to be passed to the append_bytes callback
+ * function.
+ * @param buffer Buffer to collect the output in
+ * @param buf_size Size of buffer, in bytes
+ *
+ * @return 0 if object has been successfully encoded. A negative value
+ * indicates an error.
+ */
+int json_obj_encode_buffered(const struct json_obj_descr *descr, size_t descr_len,
+			     const void *val, json_append_bytes_t append_bytes,
+			     void *data, char *buffer, size_t buf_size);
+
+/**
+ * @brief Encodes an array through a buffer
+ *
+ * Like json_arr_encode(), collecting the output as
+ * json_obj_encode_buffered() does.
+ *
+ * @param descr Pointer to the descriptor array
+ * @param val Struct holding the values
+ * @param append_bytes Function to append bytes to the output
+ * @param data Data pointer to be passed to the append_bytes callback
+ * function.
+ * @param buffer Buffer to collect the output in
+ * @param buf_size Size of buffer, in bytes
+ *
+ * @return 0 if object has been successfully encoded. A negative value
+ * indicates an error.
+ */
+int json_arr_encode_buffered(const struct json_obj_descr *descr, const void *val,
+			     json_append_bytes_t append_bytes, void *data,
+			     char *buffer, size_t buf_size);
+
 #ifdef __cplusplus
 }
 #endif
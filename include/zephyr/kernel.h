@@ -21,6 +21,7 @@
 #include <zephyr/toolchain.h>
 #include <zephyr/tracing/tracing_macros.h>
 #include <zephyr/sys/mem_stats.h>
+#include <zephyr/sys/sys_heap_internal.h>
 #include <zephyr/sys/iterable_sections.h>
 
 #ifdef __cplusplus
@@ -68,6 +69,7 @@ BUILD_ASSERT(sizeof(intptr_t) == sizeof(long));
 
 struct k_thread;
 struct k_mutex;
+struct k_rwlock;
 struct k_sem;
 struct k_msgq;
 struct k_mbox;
@@ -2815,6 +2817,21 @@ extern struct k_work_q k_sys_work_q;
  * @{
  */
 
+/**
+ * @brief Contention statistics of a mutex or semaphore
+ *
+ * Kept with @kconfig{CONFIG_KERNEL_CONTENTION_STATS}.  The counters are
+ * free-running and wrap around.
+ */
+struct k_obj_contention {
+	/** Number of lock or take calls that found the object unavailable */
+	uint32_t contended;
+	/** Of those, number that got it while spinning */
+	uint32_t spin_acquired;
+	/** Of those, number that pended on the object */
+	uint32_t blocked;
+};
+
 /**
  * Mutex Structure
  * @ingroup mutex_apis
@@ -2831,6 +2848,11 @@ struct k_mutex {
 	/** Original thread priority */
 	int owner_orig_prio;
 
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+	/** Contention statistics */
+	struct k_obj_contention contention;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 };
 
@@ -2922,6 +2944,19 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
  */
 __syscall int k_mutex_unlock(struct k_mutex *mutex);
 
+#if defined(CONFIG_KERNEL_CONTENTION_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the contention statistics of a mutex.
+ *
+ * Only available with @kconfig{CONFIG_KERNEL_CONTENTION_STATS}.
+ *
+ * @param mutex Address of the mutex.
+ * @param stats Where to store the statistics.
+ */
+void k_mutex_contention_get(struct k_mutex *mutex,
+			    struct k_obj_contention *stats);
+#endif
+
 /**
  * @}
  */
@@ -3004,6 +3039,173 @@ __syscall int k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
  * @}
  */
 
+/**
+ * @defgroup rwlock_apis Reader/Writer Lock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Give waiting writers precedence over new readers.
+ *
+ * By default, readers get the lock as long as no writer holds it, which
+ * gives the best read throughput but may starve writers.  With this flag,
+ * readers wait as soon as a writer is waiting.
+ */
+#define K_RWLOCK_PREFER_WRITER BIT(0)
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* Layout of k_rwlock::state: number of readers holding the lock, and
+ * flags telling that a writer holds it, and that threads may be waiting
+ * for it, which sends lockers and unlockers to the slow path.
+ */
+#define Z_RWLOCK_READERS_MASK BIT_MASK(29)
+#define Z_RWLOCK_WRITER       BIT(29)
+#define Z_RWLOCK_WAITERS      BIT(30)
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * Reader/Writer Lock Structure
+ * @ingroup rwlock_apis
+ */
+struct k_rwlock {
+	/** Lock state, changed without a lock when there are no waiters */
+	atomic_t state;
+
+	/** Readers wait queue */
+	_wait_q_t rd_wait_q;
+
+	/** Writers wait queue */
+	_wait_q_t wr_wait_q;
+
+	/** Writer holding the lock */
+	struct k_thread *writer;
+
+	/** Original priority of the writer */
+	int writer_orig_prio;
+
+	/** K_RWLOCK_* flags */
+	uint32_t flags;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_RWLOCK_INITIALIZER(obj, rwlock_flags) \
+	{ \
+	.state = ATOMIC_INIT(0), \
+	.rd_wait_q = Z_WAIT_Q_INIT(&obj.rd_wait_q), \
+	.wr_wait_q = Z_WAIT_Q_INIT(&obj.wr_wait_q), \
+	.writer = NULL, \
+	.writer_orig_prio = K_LOWEST_APPLICATION_THREAD_PRIO, \
+	.flags = rwlock_flags, \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize a reader/writer lock.
+ *
+ * The lock can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_rwlock <name>; @endcode
+ *
+ * @param name Name of the lock.
+ * @param flags K_RWLOCK_* flags, or 0.
+ */
+#define K_RWLOCK_DEFINE(name, flags) \
+	STRUCT_SECTION_ITERABLE(k_rwlock, name) = \
+		Z_RWLOCK_INITIALIZER(name, flags)
+
+/**
+ * @brief Initialize a reader/writer lock.
+ *
+ * This routine initializes a reader/writer lock object, prior to its first
+ * use.  Upon completion, the lock is not held.
+ *
+ * @param rwlock Address of the lock.
+ * @param flags K_RWLOCK_* flags, or 0.
+ *
+ * @retval 0 Lock initialized
+ * @retval -EINVAL Invalid flags
+ */
+__syscall int k_rwlock_init(struct k_rwlock *rwlock, uint32_t flags);
+
+/**
+ * @brief Lock a reader/writer lock for reading.
+ *
+ * Any number of threads may hold the lock for reading at the same time, as
+ * long as no thread holds it for writing.  Taking an uncontended lock only
+ * takes an atomic operation on the lock state.
+ *
+ * The writer holding the lock inherits the priority of the waiting threads,
+ * like the owner of a mutex.  Readers holding the lock do not.
+ *
+ * Reader/writer locks may not be locked in ISRs.
+ *
+ * @param rwlock Address of the lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Lock held for reading.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a reader/writer lock held for reading.
+ *
+ * @param rwlock Address of the lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EINVAL The lock is not held for reading.
+ */
+__syscall int k_rwlock_read_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @brief Lock a reader/writer lock for writing.
+ *
+ * Only one thread may hold the lock for writing, and no thread may hold it
+ * for reading at the same time.  Unlike mutexes, the lock is not recursive.
+ *
+ * Reader/writer locks may not be locked in ISRs.
+ *
+ * @param rwlock Address of the lock.
+ * @param timeout Waiting period to lock the lock,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @retval 0 Lock held for writing.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EDEADLK The current thread already holds the lock for writing.
+ */
+__syscall int k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout);
+
+/**
+ * @brief Unlock a reader/writer lock held for writing.
+ *
+ * @param rwlock Address of the lock.
+ *
+ * @retval 0 Lock released.
+ * @retval -EPERM The current thread does not hold the lock for writing.
+ */
+__syscall int k_rwlock_write_unlock(struct k_rwlock *rwlock);
+
+/**
+ * @}
+ */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -3015,6 +3217,10 @@ struct k_sem {
 
 	_POLL_EVENT;
 
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+	struct k_obj_contention contention;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_sem)
 
 };
@@ -3127,6 +3333,18 @@ static inline unsigned int z_impl_k_sem_count_get(struct k_sem *sem)
 	return sem->count;
 }
 
+#if defined(CONFIG_KERNEL_CONTENTION_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the contention statistics of a semaphore.
+ *
+ * Only available with @kconfig{CONFIG_KERNEL_CONTENTION_STATS}.
+ *
+ * @param sem Address of the semaphore.
+ * @param stats Where to store the statistics.
+ */
+void k_sem_contention_get(struct k_sem *sem, struct k_obj_contention *stats);
+#endif
+
 /**
  * @brief Statically define and initialize a semaphore.
  *
@@ -3252,6 +3470,42 @@ int k_work_submit_to_queue(struct k_work_q *queue,
  */
 extern int k_work_submit(struct k_work *work);
 
+/** @brief Submit several work items to a queue in one operation.
+ *
+ * All items are queued under a single acquisition of the work lock,
+ * so the queue thread is woken at most once and sees the whole batch,
+ * and the caller reschedules at most once.  This is much cheaper than
+ * calling k_work_submit_to_queue() for each item.
+ *
+ * Each item is handled as by k_work_submit_to_queue(): items already
+ * queued are left alone, items currently running are queued to the
+ * queue running them, and items being cancelled are skipped.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param queue pointer to the work queue on which the items should run.
+ * @param works array of pointers to the work items.
+ * @param n number of work items in @p works.
+ *
+ * @return the number of work items queued by this call.
+ * @retval -EBUSY if @p queue is draining or plugged.
+ * @retval -EINVAL if @p queue is null.
+ * @retval -ENODEV if @p queue has not been started.
+ */
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work *const *works, size_t n);
+
+/** @brief Submit several work items to the system queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param works array of pointers to the work items.
+ * @param n number of work items in @p works.
+ *
+ * @return as with k_work_submit_batch_to_queue().
+ */
+int k_work_submit_batch(struct k_work *const *works, size_t n);
+
 /** @brief Wait for last-submitted instance to complete.
  *
  * Resubmissions may occur while waiting, including chained submissions (from
@@ -3906,6 +4160,16 @@ struct k_work_queue_config {
 	 * control.
 	 */
 	bool no_yield;
+
+	/** Maximum number of work items to process between yields.
+	 *
+	 * A yielding work queue thread normally yields after each item.
+	 * With a budget of N it runs up to N pending items back to back
+	 * before yielding, which saves context switches when many small
+	 * items are submitted at once.  Zero is the same as 1.  Ignored
+	 * if @c no_yield is set.
+	 */
+	uint16_t budget;
 };
 
 /** @brief A structure used to hold work until it can be processed. */
@@ -3928,6 +4192,9 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+	/* Number of items to process between yields. */
+	uint16_t budget;
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -4300,6 +4567,29 @@ extern int k_work_poll_cancel(struct k_work_poll *work);
  * @{
  */
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+/**
+ * @brief Lock-free ring state of a message queue
+ *
+ * Only used by message queues initialized with k_msgq_lockless_init()
+ * or K_MSGQ_LOCKLESS_DEFINE().
+ */
+struct z_msgq_lockless {
+	/** Per-slot sequence numbers, relative to the slot index */
+	atomic_t *seq;
+	/** Next ring position to be claimed by a writer */
+	atomic_t head;
+	/** Next ring position to be claimed by a reader */
+	atomic_t tail;
+	/** Number of threads blocked in a receive */
+	atomic_t get_waiters;
+	/** Number of threads blocked in a send */
+	atomic_t put_waiters;
+	/** Threads waiting for a free slot, readers wait on wait_q */
+	_wait_q_t put_wait_q;
+};
+#endif
+
 /**
  * @brief Message Queue Structure
  */
@@ -4328,6 +4618,11 @@ struct k_msgq {
 	/** Message queue */
 	uint8_t flags;
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	/** Lock-free ring, see K_MSGQ_FLAG_LOCKLESS */
+	struct z_msgq_lockless lockless;
+#endif
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_msgq)
 };
 /**
@@ -4348,6 +4643,24 @@ struct k_msgq {
 	_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
+#define Z_MSGQ_LOCKLESS_INITIALIZER(obj, q_buffer, q_seq, q_msg_size, q_max_msgs) \
+	{ \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	.msg_size = q_msg_size, \
+	.max_msgs = q_max_msgs, \
+	.buffer_start = q_buffer, \
+	.buffer_end = q_buffer + (q_max_msgs * q_msg_size), \
+	.read_ptr = q_buffer, \
+	.write_ptr = q_buffer, \
+	.used_msgs = 0, \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	.flags = K_MSGQ_FLAG_LOCKLESS, \
+	.lockless = { \
+		.seq = q_seq, \
+		.put_wait_q = Z_WAIT_Q_INIT(&obj.lockless.put_wait_q), \
+	}, \
+	}
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -4355,6 +4668,13 @@ struct k_msgq {
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
 
+/**
+ * @brief Message queue uses the lock-free ring
+ *
+ * Set by k_msgq_lockless_init() and K_MSGQ_LOCKLESS_DEFINE().
+ */
+#define K_MSGQ_FLAG_LOCKLESS	BIT(1)
+
 /**
  * @brief Message Queue Attributes
  */
@@ -4395,6 +4715,28 @@ struct k_msgq_attrs {
 	       Z_MSGQ_INITIALIZER(q_name, _k_fifo_buf_##q_name,	\
 				  (q_msg_size), (q_max_msgs))
 
+/**
+ * @brief Statically define and initialize a lock-free message queue.
+ *
+ * Same as K_MSGQ_DEFINE(), but the message queue is initialized as with
+ * k_msgq_lockless_init(). @a q_max_msgs must be a power of 2.
+ *
+ * @param q_name Name of the message queue.
+ * @param q_msg_size Message size (in bytes).
+ * @param q_max_msgs Maximum number of messages that can be queued.
+ * @param q_align Alignment of the message queue's ring buffer.
+ */
+#define K_MSGQ_LOCKLESS_DEFINE(q_name, q_msg_size, q_max_msgs, q_align)	\
+	BUILD_ASSERT(IS_POWER_OF_TWO(q_max_msgs),			\
+		     "lock-free msgq length must be a power of 2");	\
+	static char __noinit __aligned(q_align)				\
+		_k_fifo_buf_##q_name[(q_max_msgs) * (q_msg_size)];	\
+	static atomic_t _k_msgq_seq_##q_name[q_max_msgs];		\
+	STRUCT_SECTION_ITERABLE(k_msgq, q_name) =			\
+	       Z_MSGQ_LOCKLESS_INITIALIZER(q_name, _k_fifo_buf_##q_name, \
+					   _k_msgq_seq_##q_name,	\
+					   (q_msg_size), (q_max_msgs))
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4414,6 +4756,35 @@ struct k_msgq_attrs {
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs);
 
+/**
+ * @brief Initialize a lock-free message queue.
+ *
+ * This routine initializes a message queue object like k_msgq_init(),
+ * but backed by a ring of sequence-numbered slots which senders and
+ * receivers claim with atomic operations.  As long as the queue is
+ * neither full nor empty, k_msgq_put() and k_msgq_get() never take the
+ * message queue lock, so several ISRs and threads can send and receive
+ * concurrently; the lock is only taken to block, and to wake up
+ * blocked threads.
+ *
+ * Compared to a regular message queue, k_msgq_peek() and
+ * k_msgq_peek_at() are not supported, message queue polling events
+ * are not supported, and k_msgq_num_used_get() is approximate while
+ * transfers are in progress.
+ *
+ * @param msgq Address of the message queue.
+ * @param buffer Pointer to ring buffer that holds queued messages.
+ * @param seq Array of @a max_msgs atomic variables for the ring slots.
+ * @param msg_size Message size (in bytes).
+ * @param max_msgs Maximum number of messages that can be queued,
+ *	must be a power of 2.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL @a max_msgs is not a power of 2.
+ */
+int k_msgq_lockless_init(struct k_msgq *msgq, char *buffer, atomic_t *seq,
+			 size_t msg_size, uint32_t max_msgs);
+
 /**
  * @brief Initialize a message queue.
  *
@@ -4493,6 +4864,60 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a n consecutive messages from @a data to
+ * message queue @a msgq in a single operation, as many as fit.  It
+ * only waits if not even the first message fits, and returns as soon
+ * as at least one message has been sent.  Messages sent by one call
+ * are received in order, but may be interleaved with messages from
+ * other senders.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to an array of @a n messages.
+ * @param n Number of messages in @a data.
+ * @param timeout Waiting period to send the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent, at least 1 on success.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a n is 0.
+ */
+__syscall int k_msgq_put_n(struct k_msgq *msgq, const void *data, uint32_t n,
+			   k_timeout_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a n messages from message queue
+ * @a msgq in a single operation, as many as are queued.  It only
+ * waits if the queue is empty, and returns as soon as at least one
+ * message has been received.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of an area to hold @a n messages.
+ * @param n Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, at least 1 on success.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL @a n is 0.
+ */
+__syscall int k_msgq_get_n(struct k_msgq *msgq, void *data, uint32_t n,
+			   k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4506,6 +4931,7 @@ __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  *
  * @retval 0 Message read.
  * @retval -ENOMSG Returned when the queue has no message.
+ * @retval -ENOTSUP Lock-free message queue.
  */
 __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
 
@@ -4524,6 +4950,7 @@ __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
  *
  * @retval 0 Message read.
  * @retval -ENOMSG Returned when the queue has no message at index.
+ * @retval -ENOTSUP Lock-free message queue.
  */
 __syscall int k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx);
 
@@ -4561,10 +4988,29 @@ __syscall uint32_t k_msgq_num_free_get(struct k_msgq *msgq);
 __syscall void  k_msgq_get_attrs(struct k_msgq *msgq,
 				 struct k_msgq_attrs *attrs);
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+static inline uint32_t z_msgq_used(struct k_msgq *msgq)
+{
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if ((msgq->flags & K_MSGQ_FLAG_LOCKLESS) != 0U) {
+		/* Tail first: it can't pass the head read afterwards */
+		uint32_t tail = (uint32_t)atomic_get(&msgq->lockless.tail);
+		uint32_t head = (uint32_t)atomic_get(&msgq->lockless.head);
+
+		return MIN(head - tail, msgq->max_msgs);
+	}
+#endif
+	return msgq->used_msgs;
+}
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
 
 static inline uint32_t z_impl_k_msgq_num_free_get(struct k_msgq *msgq)
 {
-	return msgq->max_msgs - msgq->used_msgs;
+	return msgq->max_msgs - z_msgq_used(msgq);
 }
 
 /**
@@ -4580,7 +5026,7 @@ __syscall uint32_t k_msgq_num_used_get(struct k_msgq *msgq);
 
 static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 {
-	return msgq->used_msgs;
+	return z_msgq_used(msgq);
 }
 
 /** @} */
@@ -4756,6 +5202,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4782,6 +5230,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -4871,6 +5321,8 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  *                or one of the special values K_NO_WAIT and K_FOREVER.
  *
  * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EBUSY Space of the pipe is claimed with k_pipe_put_claim();
+ *                zero data bytes were written.
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
@@ -4894,6 +5346,8 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  *
  * @retval 0 At least @a min_xfer bytes of data were read.
  * @retval -EINVAL invalid parameters supplied
+ * @retval -EBUSY Data of the pipe is claimed with k_pipe_get_claim();
+ *                zero data bytes were read.
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
@@ -4928,7 +5382,8 @@ __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
  * This routine flushes the pipe. Flushing the pipe is equivalent to reading
  * both all the data in the pipe's buffer and all the data waiting to go into
  * that pipe into a large temporary buffer and discarding the buffer. Any
- * writers that were previously pended become unpended.
+ * writers that were previously pended become unpended. Data claimed with
+ * k_pipe_get_claim() is discarded as well, and the claim is released.
  *
  * @param pipe Address of the pipe.
  */
@@ -4941,12 +5396,163 @@ __syscall void k_pipe_flush(struct k_pipe *pipe);
  * reading up to N bytes from the pipe (where N is the size of the pipe's
  * buffer) into a temporary buffer and then discarding that buffer. If there
  * were writers previously pending, then some may unpend as they try to fill
- * up the pipe's emptied buffer.
+ * up the pipe's emptied buffer. Data claimed with k_pipe_get_claim() is
+ * discarded as well, and the claim is released.
  *
  * @param pipe Address of the pipe.
  */
 __syscall void k_pipe_buffer_flush(struct k_pipe *pipe);
 
+/**
+ * @brief Claim space of a pipe's buffer for writing
+ *
+ * This routine gives direct access to free space of the pipe's ring buffer,
+ * so that data can be produced in place, for instance by DMA or by a decoder,
+ * instead of being copied in by k_pipe_put(). Once written, the data must be
+ * committed with k_pipe_put_finish(). Successive claims extend the claimed
+ * area, each returning the space following the previous one.
+ *
+ * The claimed space is contiguous, so it can be smaller than requested when
+ * the pipe is close to full or the space wraps around the end of the buffer.
+ *
+ * While space is claimed, k_pipe_put() fails with -EBUSY, and writers
+ * already waiting on the pipe keep waiting until the claim is finished.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed space.
+ * @param size Requested size (in bytes).
+ *
+ * @return Size of the claimed space, zero if the pipe is full or unbuffered.
+ */
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Commit data written to claimed space of a pipe
+ *
+ * This routine makes the first @a size bytes of the space claimed with
+ * k_pipe_put_claim() available to readers, and releases the whole claim.
+ * Readers waiting on the pipe are served from the buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, up to the total size claimed.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL @a size exceeds the claimed space; nothing was committed
+ *                 but the claim was released.
+ */
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data of a pipe's buffer for reading
+ *
+ * This routine gives direct access to data in the pipe's ring buffer, so
+ * that it can be consumed in place instead of being copied out by
+ * k_pipe_get(). Once consumed, the data must be released with
+ * k_pipe_get_finish(). Successive claims extend the claimed area, each
+ * returning the data following the previous one.
+ *
+ * The claimed data is contiguous, so it can be smaller than requested when
+ * the data wraps around the end of the buffer.
+ *
+ * While data is claimed, k_pipe_get() fails with -EBUSY. Flushing the pipe
+ * discards the claimed data and releases the claim, after which
+ * k_pipe_get_finish() can only release zero bytes.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed data.
+ * @param size Requested size (in bytes).
+ *
+ * @return Size of the claimed data, zero if the pipe is empty or unbuffered.
+ */
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size);
+
+/**
+ * @brief Release data read from a pipe
+ *
+ * This routine frees the first @a size bytes of the data claimed with
+ * k_pipe_get_claim() and releases the whole claim; data beyond @a size stays
+ * in the pipe. Writers waiting on the pipe refill the freed space.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, up to the total size claimed.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL @a size exceeds the claimed data; nothing was freed but
+ *                 the claim was released.
+ */
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
+/** Pipe I/O vector, one segment of a vectored transfer */
+struct k_pipe_iovec {
+	void  *base;	/**< Address of the segment */
+	size_t len;	/**< Length of the segment (in bytes) */
+};
+
+/**
+ * @brief Write data from several buffers to a pipe.
+ *
+ * This routine writes the segments described by @a iov in order, without
+ * the caller having to gather them into one buffer, and @a min_xfer applies
+ * to their total length.
+ *
+ * The transfer is not atomic: each segment is written with its own
+ * k_pipe_put(), so data of other writers may come between two segments,
+ * and readers may see the first segments before the next ones are written.
+ * It stops at the first segment not written in full.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to write.
+ * @param iovcnt Number of segments.
+ * @param bytes_written Address of area to hold the number of bytes written.
+ * @param min_xfer Minimum number of bytes to write.
+ * @param timeout Waiting period to wait for the data to be written,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were written.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EBUSY Space of the pipe is claimed with k_pipe_put_claim();
+ *                @a bytes_written holds what was written before.
+ * @retval -EIO Returned without waiting; zero data bytes were written.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were written.
+ */
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_written, size_t min_xfer,
+		   k_timeout_t timeout);
+
+/**
+ * @brief Read data from a pipe to several buffers.
+ *
+ * This routine fills the segments described by @a iov in order, without
+ * the caller having to scatter the data afterwards, and @a min_xfer applies
+ * to their total length.
+ *
+ * The transfer is not atomic: each segment is filled with its own
+ * k_pipe_get(), so other readers may take data between two segments. It
+ * stops at the first segment not filled in full.
+ *
+ * @param pipe Address of the pipe.
+ * @param iov Array of segments to fill.
+ * @param iovcnt Number of segments.
+ * @param bytes_read Address of area to hold the number of bytes read.
+ * @param min_xfer Minimum number of data bytes to read.
+ * @param timeout Waiting period to wait for the data to be read,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least @a min_xfer bytes of data were read.
+ * @retval -EINVAL invalid parameters supplied
+ * @retval -EBUSY Data of the pipe is claimed with k_pipe_get_claim();
+ *                @a bytes_read holds what was read before.
+ * @retval -EIO Returned without waiting; zero data bytes were read.
+ * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
+ *                 minus one data bytes were read.
+ */
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_read, size_t min_xfer,
+		   k_timeout_t timeout);
+
 /** @} */
 
 /**
@@ -5269,11 +5875,6 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
-/* Hand-calculated minimum heap sizes needed to return a successful
- * 1-byte allocation.  See details in lib/os/heap.[ch]
- */
-#define Z_HEAP_MIN_SIZE (sizeof(void *) > 4 ? 56 : 44)
-
 /**
  * @brief Define a static k_heap in the specified linker section
  *
@@ -5719,6 +6320,108 @@ __syscall void k_poll_signal_check(struct k_poll_signal *sig,
 
 __syscall int k_poll_signal_raise(struct k_poll_signal *sig, int result);
 
+/**
+ * @brief Poll set
+ *
+ * A set of poll events registered once with their objects, see
+ * k_poll_set_add() and k_poll_set_wait().
+ */
+struct k_poll_set {
+	/** PRIVATE - DO NOT TOUCH */
+	struct z_poller poller;
+
+	/** PRIVATE - DO NOT TOUCH */
+	sys_dlist_t ready;
+
+	/** PRIVATE - DO NOT TOUCH */
+	_wait_q_t wait_q;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+#define Z_POLL_SET_INITIALIZER(obj)					\
+	{								\
+	.ready = SYS_DLIST_STATIC_INIT(&obj.ready),			\
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q),				\
+	}
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize a poll set.
+ *
+ * @param name Name of the poll set.
+ */
+#define K_POLL_SET_DEFINE(name)						\
+	struct k_poll_set name = Z_POLL_SET_INITIALIZER(name)
+
+/**
+ * @brief Initialize a poll set.
+ *
+ * @param set Poll set to initialize.
+ */
+void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * Unlike with k_poll(), where every event is registered with its object and
+ * torn down again on each call, an event added to a set stays registered
+ * with its object until it is removed from the set. Objects becoming
+ * available put their events on the set's ready list, so that waiting on
+ * the set with k_poll_set_wait() only costs as much as the number of ready
+ * events, however many events the set holds.
+ *
+ * The event must have been initialized with k_poll_event_init() and must
+ * not be passed to k_poll() or to another set while it is in this one. The
+ * same precedence rules as for k_poll() apply: threads pending on an object
+ * are served before the object signals its poll events.
+ *
+ * @param set Poll set.
+ * @param event Event to add.
+ *
+ * @retval 0 Event added.
+ * @retval -EBUSY Event is already in use by a set or a poller.
+ */
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set Poll set.
+ * @param event Event to remove.
+ *
+ * @retval 0 Event removed.
+ * @retval -EINVAL Event is not in the set.
+ */
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to be ready.
+ *
+ * This routine returns up to @a max_events events of @a set that are ready,
+ * waiting for one to be if none is. The state field of each returned event
+ * is set to its current state. Readiness is level-triggered: an event keeps
+ * being returned as long as its object is available, e.g. until a semaphore
+ * is taken or a poll signal is reset. When more events are ready than fit in
+ * @a events, the next call returns the others first.
+ *
+ * @param set Poll set.
+ * @param events Array to hold the addresses of the ready events.
+ * @param max_events Size of @a events.
+ * @param timeout Waiting period for an event to be ready,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of ready events stored in @a events, at least 1.
+ * @retval -EAGAIN Waiting period timed out, or no event is ready and
+ *         @a timeout is K_NO_WAIT.
+ * @retval -EINVAL @a max_events is not positive.
+ */
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout);
+
 /**
  * @internal
  */
@@ -23,6 +23,10 @@ struct k_cycle_stats {
 	uint32_t  num_windows;  /* # of usage windows */
 #endif
 	bool      track_usage;  /* true if gathering usage stats */
+#ifdef CONFIG_WORK_QUEUE_STATS
+	uint32_t  work_items;   /* # of work items run (work queue threads) */
+	uint32_t  work_wakeups; /* # of wakeups to look for work */
+#endif
 };
 
 #endif
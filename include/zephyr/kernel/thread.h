@@ -223,6 +223,16 @@ typedef struct k_thread_runtime_stats {
 	uint64_t idle_cycles;
 #endif
 
+#ifdef CONFIG_WORK_QUEUE_STATS
+	/*
+	 * Only meaningful for work queue threads. The number of work items
+	 * run per wakeup tells how well submissions are batched.
+	 */
+
+	uint32_t work_items;          /* # of work items run */
+	uint32_t work_wakeups;        /* # of wakeups to look for work */
+#endif
+
 #if defined(__cplusplus) && !defined(CONFIG_SCHED_THREAD_USAGE) &&                                 \
 	!defined(CONFIG_SCHED_THREAD_USAGE_ANALYSIS) && !defined(CONFIG_SCHED_THREAD_USAGE_ALL)
 	/* If none of the above Kconfig values are defined, this struct will have a size 0 in C
@@ -184,8 +184,10 @@ struct z_kernel {
 #endif
 
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	/* Need to signal an IPI at the next scheduling point */
-	bool pending_ipi;
+	/* Bitmask of CPUs that need to be signaled an IPI at the next
+	 * scheduling point
+	 */
+	atomic_t pending_ipi;
 #endif
 };
 
@@ -224,24 +224,33 @@ enum z_log_msg_mode {
 
 #define Z_LOG_ARM64_VLA_PROTECT() compiler_barrier()
 
+/* Flags must be a constant expression when the package layout is precompiled. */
+#define Z_LOG_MSG_PACKAGE(_buf, _inlen, _outlen, _flags, ...) \
+	COND_CODE_1(CONFIG_CBPRINTF_PACKAGE_PRECOMPILED, \
+		(CBPRINTF_PRECOMPILED_PACKAGE(_buf, _inlen, _outlen, \
+					      Z_LOG_MSG_ALIGN_OFFSET, _flags, \
+					      __VA_ARGS__)), \
+		(CBPRINTF_STATIC_PACKAGE(_buf, _inlen, _outlen, \
+					 Z_LOG_MSG_ALIGN_OFFSET, _flags, \
+					 __VA_ARGS__)))
+
 #define Z_LOG_MSG_STACK_CREATE(_cstr_cnt, _domain_id, _source, _level, _data, _dlen, ...) \
 do { \
 	int _plen; \
-	uint32_t _options = Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt) | \
-			  CBPRINTF_PACKAGE_ADD_RW_STR_POS; \
 	if (GET_ARG_N(1, __VA_ARGS__) == NULL) { \
 		_plen = 0; \
 	} else { \
-		CBPRINTF_STATIC_PACKAGE(NULL, 0, _plen, Z_LOG_MSG_ALIGN_OFFSET, _options, \
-					__VA_ARGS__); \
+		Z_LOG_MSG_PACKAGE(NULL, 0, _plen, \
+				  Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt) | \
+				  CBPRINTF_PACKAGE_ADD_RW_STR_POS, __VA_ARGS__); \
 	} \
 	struct log_msg *_msg; \
 	Z_LOG_MSG_ON_STACK_ALLOC(_msg, Z_LOG_MSG_LEN(_plen, 0)); \
 	Z_LOG_ARM64_VLA_PROTECT(); \
 	if (_plen != 0) { \
-		CBPRINTF_STATIC_PACKAGE(_msg->data, _plen, \
-					_plen, Z_LOG_MSG_ALIGN_OFFSET, _options, \
-					__VA_ARGS__);\
+		Z_LOG_MSG_PACKAGE(_msg->data, _plen, _plen, \
+				  Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt) | \
+				  CBPRINTF_PACKAGE_ADD_RW_STR_POS, __VA_ARGS__); \
 	} \
 	struct log_msg_desc _desc = \
 		Z_LOG_MSG_DESC_INITIALIZER(_domain_id, _level, \
@@ -254,9 +263,8 @@ do { \
 #ifdef CONFIG_LOG_SPEED
 #define Z_LOG_MSG_SIMPLE_CREATE(_cstr_cnt, _domain_id, _source, _level, ...) do { \
 	int _plen; \
-	CBPRINTF_STATIC_PACKAGE(NULL, 0, _plen, Z_LOG_MSG_ALIGN_OFFSET, \
-				Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt), \
-				__VA_ARGS__); \
+	Z_LOG_MSG_PACKAGE(NULL, 0, _plen, Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt), \
+			  __VA_ARGS__); \
 	size_t _msg_wlen = Z_LOG_MSG_ALIGNED_WLEN(_plen, 0); \
 	struct log_msg *_msg = z_log_msg_alloc(_msg_wlen); \
 	struct log_msg_desc _desc = \
@@ -264,10 +272,9 @@ do { \
 	LOG_MSG_DBG("creating message zero copy: package len: %d, msg: %p\n", \
 			_plen, _msg); \
 	if (_msg) { \
-		CBPRINTF_STATIC_PACKAGE(_msg->data, _plen, _plen, \
-					Z_LOG_MSG_ALIGN_OFFSET, \
-					Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt), \
-					__VA_ARGS__); \
+		Z_LOG_MSG_PACKAGE(_msg->data, _plen, _plen, \
+				  Z_LOG_MSG_CBPRINTF_FLAGS(_cstr_cnt), \
+				  __VA_ARGS__); \
 	} \
 	z_log_msg_finalize(_msg, (void *)_source, _desc, NULL); \
 } while (false)
@@ -173,6 +173,12 @@ enum ethernet_hw_caps {
 
 	/** TXTIME supported */
 	ETHERNET_TXTIME			= BIT(19),
+
+	/** TCP segmentation offload supported. The device cuts TCP packets
+	 * having a non zero net_pkt_gso_size() into segments of that many
+	 * bytes of payload, and computes their IP and TCP checksums.
+	 */
+	ETHERNET_HW_TX_TCP_SEG_OFFLOAD	= BIT(20),
 };
 
 /** @cond INTERNAL_HIDDEN */
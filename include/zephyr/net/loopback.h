@@ -33,6 +33,17 @@ int loopback_set_packet_drop_ratio(float ratio);
 int loopback_get_num_dropped_packets(void);
 #endif
 
+#ifdef CONFIG_NET_LOOPBACK_SIMULATE_DELAY
+/**
+ * @brief Set the packet delay
+ *
+ * @param[in] delay_ms Time packets take to go through the interface, in ms
+ *
+ * @return 0 on success, otherwise a negative integer.
+ */
+int loopback_set_packet_delay(uint32_t delay_ms);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
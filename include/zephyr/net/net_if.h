@@ -2208,6 +2208,17 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if a TCP packet larger than the MSS needs to be cut into
+ * segments by the IP stack before it is sent, or if the network device
+ * does it.
+ *
+ * @param iface Network interface
+ *
+ * @return True if the packet needs to be segmented, false otherwise.
+ */
+bool net_if_need_tx_segmentation(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
@@ -476,6 +476,18 @@ static inline uint32_t arch_proc_id(void);
  */
 void arch_sched_ipi(void);
 
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on the CPUs whose bit is set in
+ * @a cpu_bitmap.  The bit of the calling CPU is ignored.
+ *
+ * @param cpu_bitmap Bitmap of CPU indices to interrupt
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+#endif
+
 #endif /* CONFIG_SMP */
 
 /**
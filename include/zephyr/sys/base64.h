@@ -72,6 +72,113 @@ int base64_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 		  size_t slen);
 
+/**
+ * @brief          Streaming base64 encoder
+ *
+ * Holds the input bytes which do not yet make a whole group of three,
+ * so that data can be encoded in chunks of any size.
+ */
+struct base64_encoder {
+	uint8_t buf[3];
+	uint8_t len;
+};
+
+/**
+ * @brief          Streaming base64 decoder
+ *
+ * Holds the characters which do not yet make a whole group of four,
+ * and the state of the whitespace and padding checks, so that data
+ * can be decoded in chunks of any size.
+ */
+struct base64_decoder {
+	uint32_t x;
+	uint8_t n;
+	uint8_t pad;
+	uint8_t flags;
+};
+
+/**
+ * @brief          Initialize a streaming encoder
+ *
+ * @param enc      encoder
+ */
+void base64_encoder_init(struct base64_encoder *enc);
+
+/**
+ * @brief          Encode a chunk of data into base64 format
+ *
+ * Only whole groups of four characters are written, up to two bytes
+ * are kept in the encoder until the next update or the finish. The
+ * output is not null-terminated.
+ *
+ * @param enc      encoder
+ * @param dst      destination buffer
+ * @param dlen     size of the destination buffer
+ * @param olen     number of bytes written
+ * @param src      source buffer
+ * @param slen     amount of data to be encoded
+ *
+ * @return         0 if successful, or -ENOMEM if the buffer is too small,
+ *                 in which case no data is consumed and *olen is set to
+ *                 the required size.
+ */
+int base64_encoder_update(struct base64_encoder *enc, uint8_t *dst, size_t dlen,
+			  size_t *olen, const uint8_t *src, size_t slen);
+
+/**
+ * @brief          Encode the data kept in the encoder, with padding
+ *
+ * @param enc      encoder
+ * @param dst      destination buffer
+ * @param dlen     size of the destination buffer, at most 4 bytes are written
+ * @param olen     number of bytes written
+ *
+ * @return         0 if successful, or -ENOMEM if the buffer is too small,
+ *                 in which case *olen is set to the required size.
+ */
+int base64_encoder_finish(struct base64_encoder *enc, uint8_t *dst, size_t dlen,
+			  size_t *olen);
+
+/**
+ * @brief          Initialize a streaming decoder
+ *
+ * @param dec      decoder
+ */
+void base64_decoder_init(struct base64_decoder *dec);
+
+/**
+ * @brief          Decode a chunk of base64-formatted data
+ *
+ * The input is checked as with base64_decode(), across chunks.
+ *
+ * @param dec      decoder
+ * @param dst      destination buffer
+ * @param dlen     size of the destination buffer, which must hold 3 bytes
+ *                 for each group of 4 characters which can be completed
+ *                 with the chunk
+ * @param olen     number of bytes written
+ * @param src      source buffer
+ * @param slen     amount of data to be decoded
+ *
+ * @return         0 if successful, -ENOMEM if the buffer is too small, in
+ *                 which case no data is consumed and *olen is set to the
+ *                 required size, or -EINVAL if the input data is not
+ *                 correct, after which the decoder must be initialized
+ *                 again.
+ */
+int base64_decoder_update(struct base64_decoder *dec, uint8_t *dst, size_t dlen,
+			  size_t *olen, const uint8_t *src, size_t slen);
+
+/**
+ * @brief          Check the end of the base64-formatted data
+ *
+ * @param dec      decoder
+ *
+ * @return         0 if successful, or -EINVAL if the data ended inside a
+ *                 group of four characters or a line ending.
+ */
+int base64_decoder_finish(struct base64_decoder *dec);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,10 +29,22 @@ struct sys_bitarray {
 
 	/* Spinlock guarding access to this bit array */
 	struct k_spinlock lock;
+
+	/* One bit per bundle, set if the bundle is known to be all set,
+	 * so that searching for clear bits can skip it. NULL for small
+	 * bit arrays, which do not need it.
+	 */
+	uint32_t *summary;
 };
 
 typedef struct sys_bitarray sys_bitarray_t;
 
+/* Bit arrays with more bundles than this have a summary */
+#define _SYS_BITARRAY_SUMMARY_MIN_BUNDLES 8
+
+#define _SYS_BITARRAY_NUM_BUNDLES(total_bits)				\
+	DIV_ROUND_UP(DIV_ROUND_UP(total_bits, 8), sizeof(uint32_t))
+
 /**
  * @brief Create a bitarray object.
  *
@@ -42,13 +54,19 @@ typedef struct sys_bitarray sys_bitarray_t;
  */
 #define _SYS_BITARRAY_DEFINE(name, total_bits, sba_mod)			\
 	sba_mod uint32_t _sys_bitarray_bundles_##name			\
-		[DIV_ROUND_UP(DIV_ROUND_UP(total_bits, 8),		\
-			       sizeof(uint32_t))] = {0};		\
+		[_SYS_BITARRAY_NUM_BUNDLES(total_bits)] = {0};		\
+	sba_mod uint32_t _sys_bitarray_summary_##name			\
+		[(_SYS_BITARRAY_NUM_BUNDLES(total_bits) >		\
+		  _SYS_BITARRAY_SUMMARY_MIN_BUNDLES) ?			\
+		 DIV_ROUND_UP(_SYS_BITARRAY_NUM_BUNDLES(total_bits), 32) \
+		 : 1] = {0};						\
 	sba_mod sys_bitarray_t name = {					\
 		.num_bits = total_bits,					\
-		.num_bundles = DIV_ROUND_UP(				\
-			DIV_ROUND_UP(total_bits, 8), sizeof(uint32_t)),	\
+		.num_bundles = _SYS_BITARRAY_NUM_BUNDLES(total_bits),	\
 		.bundles = _sys_bitarray_bundles_##name,		\
+		.summary = (_SYS_BITARRAY_NUM_BUNDLES(total_bits) >	\
+			    _SYS_BITARRAY_SUMMARY_MIN_BUNDLES) ?		\
+			   _sys_bitarray_summary_##name : NULL,		\
 	}
 
 /**
@@ -154,6 +172,29 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset);
 
+/**
+ * Allocate several regions of bits in a bit array
+ *
+ * This allocates @p count regions of @p num_bits bits each, as
+ * sys_bitarray_alloc() would if called @p count times, but in a single
+ * operation and search of the bit array. Either all the regions are
+ * allocated or none is.
+ *
+ * @param[in]  bitarray Bitarray struct
+ * @param[in]  num_bits Number of bits in each region
+ * @param[in]  count    Number of regions to allocate
+ * @param[out] offsets  Array of @p count entries receiving the offset to
+ *                      the start of each allocated region if successful
+ *
+ * @retval 0       Allocation successful
+ * @retval -EINVAL Invalid argument (e.g. allocating more bits than
+ *                 the bitarray has, trying to allocate 0 bits, etc.)
+ * @retval -ENOSPC Not enough free regions to accommodate all the
+ *                 allocations
+ */
+int sys_bitarray_alloc_multi(sys_bitarray_t *bitarray, size_t num_bits,
+			     size_t count, size_t *offsets);
+
 /**
  * Free bits in a bit array
  *
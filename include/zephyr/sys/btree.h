@@ -0,0 +1,280 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief B+tree ordered map
+ *
+ * This implements an ordered map of 64-bit keys to 64-bit values as a
+ * B+tree, as a complement to the intrusive red/black tree for large
+ * sets. The keys of a node are stored contiguously, so that a lookup
+ * touches one or two cache lines per level of a shallow tree instead
+ * of one node per level of a binary tree, and all entries are kept in
+ * linked leaves, for cheap ordered and range iteration.
+ *
+ * Nodes hold up to CONFIG_BTREE_ORDER keys and are obtained from an
+ * allocator with the same interface as the @ref sys_hashmap one. The
+ * tree is not synchronized, and iterators are invalidated by any
+ * modification of the tree.
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_BTREE_H_
+#define ZEPHYR_INCLUDE_SYS_BTREE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup btree_apis B+tree ordered map
+ * @ingroup datastructure_apis
+ * @{
+ */
+
+struct sys_btree_node;
+
+/**
+ * @brief Allocator interface for @ref sys_btree
+ *
+ * The allocator behaves like `realloc()`, and like `free()` when
+ * @p new_size is zero. It is only used to allocate and free nodes.
+ *
+ * @param ptr Previously allocated memory region or `NULL` to make a new allocation.
+ * @param new_size The new size of the allocation, in bytes.
+ */
+typedef void *(*sys_btree_allocator_t)(void *ptr, size_t new_size);
+
+/**
+ * @brief Callback interface for @ref sys_btree
+ *
+ * @param key Key corresponding to @p value
+ * @param value Value corresponding to @p key
+ * @param cookie User-specified variable
+ */
+typedef void (*sys_btree_callback_t)(uint64_t key, uint64_t value, void *cookie);
+
+/**
+ * @brief B+tree ordered map
+ *
+ * @param root Root node, or NULL when the tree is empty
+ * @param alloc Node allocator
+ * @param size Number of entries
+ * @param height Number of levels of nodes, 1 when the root is a leaf
+ */
+struct sys_btree {
+	struct sys_btree_node *root;
+	sys_btree_allocator_t alloc;
+	size_t size;
+	uint8_t height;
+};
+
+/**
+ * @brief B+tree iterator
+ *
+ * An iterator is positioned on an entry, whose key and value it
+ * holds, or past the last entry, when @a node is NULL.
+ *
+ * @param node Leaf of the current entry, or NULL at the end
+ * @param pos Position of the current entry in its leaf
+ * @param key Key of the current entry
+ * @param value Value of the current entry
+ */
+struct sys_btree_iterator {
+	const struct sys_btree_node *node;
+	uint16_t pos;
+	uint64_t key;
+	uint64_t value;
+};
+
+/*
+ * A safe wrapper for realloc(), invariant of which libc provides it.
+ */
+static inline void *sys_btree_default_allocator(void *ptr, size_t size)
+{
+	if (size == 0) {
+		free(ptr);
+		return NULL;
+	}
+
+	return realloc(ptr, size);
+}
+
+#define SYS_BTREE_DEFAULT_ALLOCATOR sys_btree_default_allocator
+
+/**
+ * @brief Statically define and initialize an empty B+tree
+ *
+ * @param _name Name of the B+tree
+ * @param _alloc Node allocator
+ */
+#define SYS_BTREE_DEFINE(_name, _alloc)                                                            \
+	struct sys_btree _name = {                                                                 \
+		.alloc = (_alloc),                                                                 \
+	}
+
+/**
+ * @brief Initialize an empty B+tree
+ *
+ * @param tree B+tree to initialize
+ * @param alloc Node allocator
+ */
+static inline void sys_btree_init(struct sys_btree *tree, sys_btree_allocator_t alloc)
+{
+	tree->root = NULL;
+	tree->alloc = alloc;
+	tree->size = 0;
+	tree->height = 0;
+}
+
+/**
+ * @brief Get the number of entries of a B+tree
+ *
+ * @param tree B+tree
+ * @return the number of entries
+ */
+static inline size_t sys_btree_size(const struct sys_btree *tree)
+{
+	return tree->size;
+}
+
+/**
+ * @brief Check if a B+tree is empty
+ *
+ * @param tree B+tree
+ * @return true if @p tree has no entries
+ */
+static inline bool sys_btree_is_empty(const struct sys_btree *tree)
+{
+	return tree->size == 0;
+}
+
+/**
+ * @brief Insert an entry into a B+tree
+ *
+ * @param tree B+tree to insert into
+ * @param key Key to associate with @p value
+ * @param value Value to associate with @p key
+ * @param old_value Location to store the value previously associated with @p key or `NULL`
+ * @retval 0 if @p value was set for an existing key, in which case @p old_value will contain
+ * the previous value
+ * @retval 1 if a new entry was inserted
+ * @retval -ENOMEM if a node could not be allocated
+ */
+int sys_btree_insert(struct sys_btree *tree, uint64_t key, uint64_t value, uint64_t *old_value);
+
+/**
+ * @brief Remove an entry from a B+tree
+ *
+ * @param tree B+tree to remove from
+ * @param key Key to remove from @p tree
+ * @param value Location to store the value associated with @p key or `NULL`
+ * @retval true if the entry was removed
+ * @retval false if @p tree does not contain @p key
+ */
+bool sys_btree_remove(struct sys_btree *tree, uint64_t key, uint64_t *value);
+
+/**
+ * @brief Get a value from a B+tree
+ *
+ * @param tree B+tree to search through
+ * @param key Key with which to search @p tree
+ * @param value Location to store the value associated with @p key or `NULL`
+ * @retval true if @p tree contains @p key
+ * @retval false otherwise
+ */
+bool sys_btree_get(const struct sys_btree *tree, uint64_t key, uint64_t *value);
+
+/**
+ * @brief Remove all entries of a B+tree
+ *
+ * @param tree B+tree to clear
+ * @param cb Callback to call for each entry, in key order, or `NULL`
+ * @param cookie User-specified variable
+ */
+void sys_btree_clear(struct sys_btree *tree, sys_btree_callback_t cb, void *cookie);
+
+/**
+ * @brief Fill an empty B+tree from sorted entries
+ *
+ * The tree is built bottom up, with evenly filled nodes, which is
+ * much faster than inserting the entries one at a time.
+ *
+ * @param tree Empty B+tree to fill
+ * @param keys Keys, in strictly increasing order
+ * @param values Values associated with @p keys
+ * @param n Number of entries
+ * @retval 0 on success
+ * @retval -EBUSY if @p tree is not empty
+ * @retval -EINVAL if @p keys are not strictly increasing
+ * @retval -ENOMEM if a node could not be allocated, in which case @p tree is left empty
+ */
+int sys_btree_bulk_load(struct sys_btree *tree, const uint64_t *keys, const uint64_t *values,
+			size_t n);
+
+/**
+ * @brief Position an iterator on the first entry of a B+tree
+ *
+ * @param tree B+tree
+ * @param it Iterator to position
+ * @retval true if @p it is positioned on an entry
+ * @retval false if @p tree is empty
+ */
+bool sys_btree_first(const struct sys_btree *tree, struct sys_btree_iterator *it);
+
+/**
+ * @brief Position an iterator on the first entry not below a key
+ *
+ * @param tree B+tree
+ * @param key Key to search for
+ * @param it Iterator to position
+ * @retval true if @p it is positioned on an entry
+ * @retval false if all keys of @p tree are below @p key
+ */
+bool sys_btree_lower_bound(const struct sys_btree *tree, uint64_t key,
+			   struct sys_btree_iterator *it);
+
+/**
+ * @brief Move an iterator to the next entry
+ *
+ * @param it Iterator positioned on an entry
+ * @retval true if @p it is positioned on an entry
+ * @retval false if there are no more entries
+ */
+bool sys_btree_next(struct sys_btree_iterator *it);
+
+/**
+ * @brief Iterate over all entries of a B+tree, in key order
+ *
+ * @param tree B+tree
+ * @param it Iterator, holding the key and value of each entry
+ */
+#define SYS_BTREE_FOR_EACH(tree, it)                                                               \
+	for (sys_btree_first((tree), (it)); (it)->node != NULL; sys_btree_next(it))
+
+/**
+ * @brief Iterate over the entries of a B+tree with keys in [@p lo, @p hi)
+ *
+ * @param tree B+tree
+ * @param it Iterator, holding the key and value of each entry
+ * @param lo Lowest key
+ * @param hi Key above the highest key
+ */
+#define SYS_BTREE_FOR_EACH_RANGE(tree, it, lo, hi)                                                 \
+	for (sys_btree_lower_bound((tree), (lo), (it)); (it)->node != NULL && (it)->key < (hi);     \
+	     sys_btree_next(it))
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_BTREE_H_ */
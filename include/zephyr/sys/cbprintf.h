@@ -106,6 +106,21 @@ struct cbprintf_package_hdr_ext {
 	 */
 } __packed;
 
+/** @brief Precompiled package layout.
+ *
+ * Descriptor created at compile time for each call site of
+ * @ref CBPRINTF_PRECOMPILED_PACKAGE.
+ */
+struct cbprintf_package_layout {
+	/** Format string, null if it is not a literal */
+	const char *fmt;
+
+	/** String locations appended to the package */
+	const uint8_t *str_pos;
+
+	/** Header of the package */
+	union cbprintf_package_hdr hdr;
+};
 
 /**
  * @cond INTERNAL_HIDDEN
@@ -382,6 +397,54 @@ typedef int (*cbvprintf_external_formatter_func)(cbprintf_cb out, void *ctx,
 	Z_CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, \
 				  align_offset, flags, __VA_ARGS__)
 
+/** @brief Package string using a layout precompiled at compile time.
+ *
+ * Equivalent of @ref CBPRINTF_STATIC_PACKAGE which creates an identical
+ * package, but the package length, argument offsets and string locations
+ * are compile time constants stored in a @ref cbprintf_package_layout
+ * descriptor, so packaging does not compute them at runtime. When the buffer
+ * is too small nothing is stored.
+ *
+ * If @kconfig{CONFIG_CBPRINTF_PACKAGE_PRECOMPILED} is not enabled, in C++ or
+ * when _Generic is not supported @ref CBPRINTF_STATIC_PACKAGE is used.
+ *
+ * @param packaged pointer to where the packaged data can be stored. Pass a null
+ * pointer to skip packaging but still calculate the total space required.
+ *
+ * @param inlen set to the number of bytes available at @p packaged. If
+ * @p packaged is NULL the value is ignored.
+ *
+ * @param outlen variable updated to the number of bytes required to completely
+ * store the packed information. If input buffer was too small it is set to
+ * -ENOSPC.
+ *
+ * @param align_offset input buffer alignment offset in bytes. Must be a
+ * compile time constant.
+ *
+ * @param flags option flags. See @ref CBPRINTF_PACKAGE_FLAGS. Must be a
+ * compile time constant.
+ *
+ * @param ... formatted string with arguments. Format string must be constant.
+ */
+#define CBPRINTF_PRECOMPILED_PACKAGE(packaged, inlen, outlen, align_offset, flags, \
+				     ... /* fmt, ... */) \
+	Z_CBPRINTF_PRECOMPILED_PACKAGE(packaged, inlen, outlen, \
+				       align_offset, flags, __VA_ARGS__)
+
+/** @brief Check precompiled package layouts against their format strings.
+ *
+ * Character pointers are packaged as strings by @ref CBPRINTF_PRECOMPILED_PACKAGE.
+ * Function finds call sites which use a character pointer with %p by parsing,
+ * once, the format string of each layout descriptor which has one. It is
+ * called during initialization and each offending call site is reported with
+ * a logging warning. Call sites with a format string which is not a literal
+ * are not covered, so it does not replace
+ * @ref CBPRINTF_PACKAGE_CONVERT_PTR_CHECK when the package is converted.
+ *
+ * @return Number of call sites which use a character pointer with %p.
+ */
+int cbprintf_package_layouts_check(void);
+
 /** @brief Capture state required to output formatted data later.
  *
  * Like cbprintf() but instead of processing the arguments and emitting the
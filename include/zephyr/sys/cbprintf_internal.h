@@ -515,6 +515,189 @@ do { \
 } while (false)
 #endif /* Z_C_GENERIC */
 
+/** @brief Get storage size for given argument as a constant expression.
+ *
+ * Same as Z_CBPRINTF_ARG_SIZE() but it can be used in an integer constant
+ * expression.
+ *
+ * @param v argument.
+ *
+ * @return Number of bytes used for storing the argument.
+ */
+#define Z_CBPRINTF_ARG_SIZE_CONST(v) \
+	sizeof(_Generic((v) + 0, float : (double)0, default : (v) + 0))
+
+/* Name of the precompiled layout constant of the last argument plus one. */
+#define Z_CBPRINTF_PRE_LAST(_name, ...) \
+	UTIL_CAT(_name, UTIL_INC(NUM_VA_ARGS_LESS_1(__VA_ARGS__)))
+
+/** @brief Compute layout of a single argument as enumeration constants.
+ *
+ * Offset of the argument is the end of the previous one rounded up to the
+ * argument alignment, as done by Z_CBPRINTF_PACK_ARG2(), and the argument is
+ * classified the same way as a read-only or a read-write string location.
+ * Counts of string locations before the argument are its index in the list of
+ * string locations.
+ *
+ * @param idx Argument index (0 is the format string).
+ * @param arg Argument.
+ */
+#define Z_CBPRINTF_PRE_ARG_LAYOUT(idx, arg) \
+	UTIL_CAT(_z_cbp_off_, idx) = \
+		ROUND_UP(UTIL_CAT(_z_cbp_end_, idx) + _z_cbp_align, \
+			 Z_CBPRINTF_ALIGNMENT(arg)) - _z_cbp_align, \
+	UTIL_CAT(_z_cbp_end_, UTIL_INC(idx)) = \
+		UTIL_CAT(_z_cbp_off_, idx) + Z_CBPRINTF_ARG_SIZE_CONST(arg), \
+	UTIL_CAT(_z_cbp_isro_, idx) = (idx < 1 + _z_cbp_fros_cnt) || \
+		(Z_CBPRINTF_IS_PCHAR(arg, 0) && _z_cbp_cros_en && \
+		 !Z_CBPRINTF_IS_PCHAR(arg, _z_cbp_flags)), \
+	UTIL_CAT(_z_cbp_isrw_, idx) = (idx >= 1 + _z_cbp_fros_cnt) && \
+		Z_CBPRINTF_IS_PCHAR(arg, 0) && !UTIL_CAT(_z_cbp_isro_, idx), \
+	UTIL_CAT(_z_cbp_ros_, UTIL_INC(idx)) = \
+		UTIL_CAT(_z_cbp_ros_, idx) + UTIL_CAT(_z_cbp_isro_, idx), \
+	UTIL_CAT(_z_cbp_rws_, UTIL_INC(idx)) = \
+		UTIL_CAT(_z_cbp_rws_, idx) + UTIL_CAT(_z_cbp_isrw_, idx)
+
+/** @brief Initialize string locations of a single argument.
+ *
+ * Designated initializers of arguments which are not string locations all
+ * write to the spare element at the end of the array.
+ *
+ * @param idx Argument index (0 is the format string).
+ * @param arg Argument.
+ */
+#define Z_CBPRINTF_PRE_STR_POS(idx, arg) \
+	[(_z_cbp_ros_en && UTIL_CAT(_z_cbp_isro_, idx)) ? \
+	 UTIL_CAT(_z_cbp_ros_, idx) : _z_cbp_str_len] = \
+		UTIL_CAT(_z_cbp_off_, idx) / sizeof(int), \
+	[UTIL_CAT(_z_cbp_isrw_, idx) ? \
+	 _z_cbp_ros_cnt + 2 * UTIL_CAT(_z_cbp_rws_, idx) : _z_cbp_str_len] = \
+		UTIL_CAT(_z_cbp_isrw_, idx) ? idx - 1 : 0, \
+	[UTIL_CAT(_z_cbp_isrw_, idx) ? \
+	 _z_cbp_ros_cnt + 2 * UTIL_CAT(_z_cbp_rws_, idx) + 1 : _z_cbp_str_len] = \
+		UTIL_CAT(_z_cbp_off_, idx) / sizeof(int),
+
+/** @brief Store single argument at its precompiled offset.
+ *
+ * @param idx Argument index (0 is the format string).
+ * @param arg Argument.
+ */
+#define Z_CBPRINTF_PRE_STORE_ARG(idx, arg) \
+do { \
+	BUILD_ASSERT(!((sizeof(double) < VA_STACK_ALIGN(long double)) && \
+			Z_CBPRINTF_IS_LONGDOUBLE(arg) && \
+			!IS_ENABLED(CONFIG_CBPRINTF_PACKAGE_LONGDOUBLE)),\
+			"Packaging of long double not enabled in Kconfig."); \
+	Z_CBPRINTF_STORE_ARG(&_pbuf[UTIL_CAT(_z_cbp_off_, idx)], arg); \
+} while (false)
+
+/** @brief Package a formatted string using a layout computed at compile time.
+ *
+ * Creates the same package as Z_CBPRINTF_STATIC_PACKAGE_GENERIC(). Offsets of
+ * the arguments, the header and string locations are enumeration constants,
+ * the two latter stored in a constant descriptor placed in the
+ * cbprintf_package_layout section. Descriptor is only referenced when the
+ * package is stored, so the one of a length calculation is discarded.
+ *
+ * @param buf buffer. If null then only length is calculated.
+ *
+ * @param _inlen buffer capacity on input. Ignored when @p buf is null.
+ *
+ * @param _outlen number of bytes required to store the package.
+ *
+ * @param _align_offset Input buffer alignment offset in bytes. Must be constant.
+ *
+ * @param flags Option flags. See @ref CBPRINTF_PACKAGE_FLAGS. Must be constant.
+ *
+ * @param ... String with variable list of arguments.
+ */
+#define Z_CBPRINTF_PRECOMPILED_PACKAGE_GENERIC(buf, _inlen, _outlen, _align_offset, \
+					       flags, ... /* fmt, ... */) \
+do { \
+	_Pragma("GCC diagnostic push") \
+	_Pragma("GCC diagnostic ignored \"-Wpointer-arith\"") \
+	_Pragma("GCC diagnostic ignored \"-Woverride-init\"") \
+	Z_CBPRINTF_SUPPRESS_SIZEOF_ARRAY_DECAY \
+	BUILD_ASSERT(!IS_ENABLED(CONFIG_XTENSA) || \
+		     (IS_ENABLED(CONFIG_XTENSA) && \
+		      !(_align_offset % CBPRINTF_PACKAGE_ALIGNMENT)), \
+			"Xtensa requires aligned package."); \
+	BUILD_ASSERT((_align_offset % sizeof(int)) == 0, \
+			"Alignment offset must be multiply of a word."); \
+	IF_ENABLED(CONFIG_CBPRINTF_STATIC_PACKAGE_CHECK_ALIGNMENT, \
+		(__ASSERT(!((uintptr_t)buf & (CBPRINTF_PACKAGE_ALIGNMENT - 1)), \
+			  "Buffer must be aligned.");)) \
+	enum { \
+		_z_cbp_flags = (flags), \
+		_z_cbp_align = (_align_offset), \
+		_z_cbp_ros_en = !!(_z_cbp_flags & CBPRINTF_PACKAGE_ADD_RO_STR_POS), \
+		_z_cbp_cros_en = !!(_z_cbp_flags & CBPRINTF_PACKAGE_CONST_CHAR_RO), \
+		_z_cbp_fros_cnt = Z_CBPRINTF_PACKAGE_FIRST_RO_STR_CNT_GET(_z_cbp_flags), \
+		_z_cbp_end_0 = sizeof(union cbprintf_package_hdr), \
+		_z_cbp_ros_0 = 0, \
+		_z_cbp_rws_0 = 0, \
+		FOR_EACH_IDX(Z_CBPRINTF_PRE_ARG_LAYOUT, (,), __VA_ARGS__), \
+		_z_cbp_args_len = Z_CBPRINTF_PRE_LAST(_z_cbp_end_, __VA_ARGS__), \
+		_z_cbp_ros_cnt = _z_cbp_ros_en ? \
+			Z_CBPRINTF_PRE_LAST(_z_cbp_ros_, __VA_ARGS__) : 0, \
+		_z_cbp_rws_cnt = Z_CBPRINTF_PRE_LAST(_z_cbp_rws_, __VA_ARGS__), \
+		_z_cbp_str_len = _z_cbp_ros_cnt + 2 * _z_cbp_rws_cnt, \
+		_z_cbp_len = _z_cbp_args_len + _z_cbp_str_len \
+	}; \
+	uint8_t *_pbuf = buf; \
+	/* If string has rw string arguments CBPRINTF_PACKAGE_ADD_RW_STR_POS is a must. */ \
+	if (_z_cbp_rws_cnt && !(_z_cbp_flags & CBPRINTF_PACKAGE_ADD_RW_STR_POS)) { \
+		_outlen = -EINVAL; \
+		break; \
+	} \
+	if (___is_null(buf)) { \
+		_outlen = _z_cbp_len; \
+		break; \
+	} \
+	if ((size_t)(_inlen) < (size_t)_z_cbp_len) { \
+		_outlen = -ENOSPC; \
+		break; \
+	} \
+	static const uint8_t _z_cbp_str_pos[_z_cbp_str_len + 1] = { \
+		FOR_EACH_IDX(Z_CBPRINTF_PRE_STR_POS, (), __VA_ARGS__) \
+	}; \
+	static const Z_DECL_ALIGN(struct cbprintf_package_layout) _z_cbp_layout \
+		__in_section(_cbprintf_package_layout, static, _z_cbp_layout_) \
+		__noasan = { \
+		.fmt = __builtin_choose_expr( \
+				__builtin_constant_p(GET_ARG_N(1, __VA_ARGS__)), \
+				GET_ARG_N(1, __VA_ARGS__), (const char *)NULL), \
+		.str_pos = _z_cbp_str_pos, \
+		.hdr = { \
+			.desc = { \
+				.len = (uint8_t)(_z_cbp_args_len / sizeof(int)), \
+				.str_cnt = 0, \
+				.ro_str_cnt = _z_cbp_ros_cnt, \
+				.rw_str_cnt = _z_cbp_rws_cnt, \
+				IF_ENABLED(CONFIG_CBPRINTF_PACKAGE_HEADER_STORE_CREATION_FLAGS, \
+					   (.pkg_flags = _z_cbp_flags,)) \
+			} \
+		} \
+	}; \
+	*(union cbprintf_package_hdr *)_pbuf = _z_cbp_layout.hdr; \
+	FOR_EACH_IDX(Z_CBPRINTF_PRE_STORE_ARG, (;), __VA_ARGS__); \
+	memcpy(&_pbuf[_z_cbp_args_len], _z_cbp_layout.str_pos, _z_cbp_str_len); \
+	_outlen = _z_cbp_len; \
+	_Pragma("GCC diagnostic pop") \
+} while (false)
+
+#if Z_C_GENERIC && !defined(__cplusplus) && defined(CONFIG_CBPRINTF_PACKAGE_PRECOMPILED)
+#define Z_CBPRINTF_PRECOMPILED_PACKAGE(packaged, inlen, outlen, align_offset, flags, \
+				       ... /* fmt, ... */) \
+	Z_CBPRINTF_PRECOMPILED_PACKAGE_GENERIC(packaged, inlen, outlen, \
+					       align_offset, flags, __VA_ARGS__)
+#else
+#define Z_CBPRINTF_PRECOMPILED_PACKAGE(packaged, inlen, outlen, align_offset, flags, \
+				       ... /* fmt, ... */) \
+	Z_CBPRINTF_STATIC_PACKAGE(packaged, inlen, outlen, align_offset, flags, \
+				  __VA_ARGS__)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -107,6 +107,41 @@ void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err);
 void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 			      struct k_mutex **lock);
 
+/**
+ * @brief Get a reference to the object and vtable of a file descriptor.
+ *
+ * Unlike z_get_fd_obj_and_vtable(), this takes a reference to the
+ * descriptor, without locking the table, so that the descriptor is not
+ * released, and the object not passed to a new descriptor, by a
+ * concurrent close() until the reference is dropped with z_fd_put().
+ * Descriptors which were reserved but not finalized are not valid.
+ *
+ * @note The reference keeps the descriptor, not the object: close() calls
+ * the close method of the vtable right away, even while other threads
+ * still hold references and may be inside other methods of the object.
+ * Objects which can be closed while in use, such as sockets, must make
+ * their other methods fail, or wake them up, once closed, and must not
+ * free what those methods may still access.
+ *
+ * @param fd File descriptor previously returned by z_reserve_fd()
+ * @param obj A pointer to a pointer variable to store the object
+ * @param vtable A pointer to a pointer variable to store the vtable
+ * @param lock An optional pointer to a pointer variable to store the mutex
+ *        preventing concurrent descriptor access, as for
+ *        z_get_fd_obj_and_vtable(). Pass NULL if it is not needed.
+ *
+ * @return 0 on success, -1 with errno set to EBADF otherwise
+ */
+int z_fd_get(int fd, void **obj, const struct fd_op_vtable **vtable,
+	     struct k_mutex **lock);
+
+/**
+ * @brief Drop a reference taken with z_fd_get().
+ *
+ * @param fd File descriptor passed to z_fd_get()
+ */
+void z_fd_put(int fd);
+
 /**
  * @brief Get the mutex and condition variable associated with the given object and vtable.
  *
@@ -0,0 +1,153 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Concurrent Robin Hood Hashmap Implementation
+ *
+ * An open-addressing Hashmap using Robin Hood probing, which keeps the probe
+ * sequences short and sorted by distance, so that lookups can stop early and
+ * scan a compact array of per-bucket metadata before touching any entry.
+ *
+ * The Hashmap is thread-safe. Updates are serialized by a mutex and may not
+ * be made from interrupt context. Lookups are lock-free and may be made from
+ * any context: they are validated with a sequence counter and retried if an
+ * update was made concurrently. Tables replaced by an update are reclaimed by
+ * a later update once no lookup is in progress.
+ *
+ * When the load factor is exceeded, a table twice as large is allocated and
+ * the entries are migrated incrementally, a few buckets with each update,
+ * rather than all at once in the insertion that triggered the growth. The
+ * table is only released once the Hashmap is empty.
+ *
+ * Iterating over the Hashmap, e.g. with @ref sys_hashmap_foreach, requires
+ * that no update is made concurrently.
+ *
+ * @note Enable with @kconfig{CONFIG_SYS_HASH_MAP_RH}
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_HASH_MAP_RH_H_
+#define ZEPHYR_INCLUDE_SYS_HASH_MAP_RH_H_
+
+#include <stddef.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/hash_function.h>
+#include <zephyr/sys/hash_map_api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct sys_hashmap_rh_data {
+	void *buckets;
+	size_t n_buckets;
+	size_t size;
+	/* Table being migrated into @a buckets, or NULL */
+	void *old;
+	/* Buckets of @a old below this index have been migrated */
+	size_t migrate_pos;
+	/* Replaced tables waiting for the lookups in progress */
+	void *retired;
+	atomic_t seq;
+	atomic_t readers;
+	struct k_spinlock lock;
+	struct k_mutex mutex;
+};
+
+/**
+ * @brief Declare a Concurrent Robin Hood Hashmap (advanced)
+ *
+ * Declare a Concurrent Robin Hood Hashmap with control over advanced parameters.
+ *
+ * @note The allocator @p _alloc is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _hash_func Hash function pointer of type @ref sys_hash_func32_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param ... Variant-specific details for @ref sys_hashmap_config.
+ */
+#define SYS_HASHMAP_RH_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, ...)                        \
+	const struct sys_hashmap_config _name##_config = __VA_ARGS__;                              \
+	struct sys_hashmap_rh_data _name##_data = {                                                \
+		.mutex = Z_MUTEX_INITIALIZER(_name##_data.mutex),                                  \
+	};                                                                                         \
+	struct sys_hashmap _name = {                                                               \
+		.api = &sys_hashmap_rh_api,                                                        \
+		.config = &_name##_config,                                                         \
+		.data = (struct sys_hashmap_data *)&_name##_data,                                  \
+		.hash_func = (_hash_func),                                                         \
+		.alloc_func = (_alloc_func),                                                       \
+	}
+
+/**
+ * @brief Declare a Concurrent Robin Hood Hashmap statically (advanced)
+ *
+ * Declare a Concurrent Robin Hood Hashmap statically with control over advanced parameters.
+ *
+ * @note The allocator @p _alloc is used for allocating internal Hashmap
+ * entries and does not interact with any user-provided keys or values.
+ *
+ * @param _name Name of the Hashmap.
+ * @param _hash_func Hash function pointer of type @ref sys_hash_func32_t.
+ * @param _alloc_func Allocator function pointer of type @ref sys_hashmap_allocator_t.
+ * @param ... Details for @ref sys_hashmap_config.
+ */
+#define SYS_HASHMAP_RH_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, ...)                 \
+	static const struct sys_hashmap_config _name##_config = __VA_ARGS__;                       \
+	static struct sys_hashmap_rh_data _name##_data = {                                         \
+		.mutex = Z_MUTEX_INITIALIZER(_name##_data.mutex),                                  \
+	};                                                                                         \
+	static struct sys_hashmap _name = {                                                        \
+		.api = &sys_hashmap_rh_api,                                                        \
+		.config = &_name##_config,                                                         \
+		.data = (struct sys_hashmap_data *)&_name##_data,                                  \
+		.hash_func = (_hash_func),                                                         \
+		.alloc_func = (_alloc_func),                                                       \
+	}
+
+/**
+ * @brief Declare a Concurrent Robin Hood Hashmap statically
+ *
+ * Declare a Concurrent Robin Hood Hashmap statically with default parameters.
+ *
+ * @param _name Name of the Hashmap.
+ */
+#define SYS_HASHMAP_RH_DEFINE_STATIC(_name)                                                        \
+	SYS_HASHMAP_RH_DEFINE_STATIC_ADVANCED(                                                     \
+		_name, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,                                  \
+		SYS_HASHMAP_CONFIG(SIZE_MAX, SYS_HASHMAP_DEFAULT_LOAD_FACTOR))
+
+/**
+ * @brief Declare a Concurrent Robin Hood Hashmap
+ *
+ * Declare a Concurrent Robin Hood Hashmap with default parameters.
+ *
+ * @param _name Name of the Hashmap.
+ */
+#define SYS_HASHMAP_RH_DEFINE(_name)                                                               \
+	SYS_HASHMAP_RH_DEFINE_ADVANCED(                                                            \
+		_name, sys_hash32, SYS_HASHMAP_DEFAULT_ALLOCATOR,                                  \
+		SYS_HASHMAP_CONFIG(SIZE_MAX, SYS_HASHMAP_DEFAULT_LOAD_FACTOR))
+
+#ifdef CONFIG_SYS_HASH_MAP_CHOICE_RH
+#define SYS_HASHMAP_DEFAULT_DEFINE(_name)	 SYS_HASHMAP_RH_DEFINE(_name)
+#define SYS_HASHMAP_DEFAULT_DEFINE_STATIC(_name) SYS_HASHMAP_RH_DEFINE_STATIC(_name)
+#define SYS_HASHMAP_DEFAULT_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, ...)                   \
+	SYS_HASHMAP_RH_DEFINE_ADVANCED(_name, _hash_func, _alloc_func, __VA_ARGS__)
+#define SYS_HASHMAP_DEFAULT_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, ...)            \
+	SYS_HASHMAP_RH_DEFINE_STATIC_ADVANCED(_name, _hash_func, _alloc_func, __VA_ARGS__)
+#endif
+
+extern const struct sys_hashmap_api sys_hashmap_rh_api;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_HASH_MAP_RH_H_ */
@@ -25,6 +25,14 @@ struct sys_memory_stats {
 	size_t  free_bytes;
 	size_t  allocated_bytes;
 	size_t  max_allocated_bytes;
+#ifdef CONFIG_SYS_HEAP_TCACHE
+	/* sys_heap only: bytes parked in the per-CPU block caches (also
+	 * counted in allocated_bytes), and cache fast path hits/misses
+	 */
+	size_t  cached_bytes;
+	size_t  cache_hits;
+	size_t  cache_misses;
+#endif
 };
 
 #ifdef __cplusplus
@@ -39,6 +39,14 @@ extern "C" {
  * Reading packets is performed in two steps. First packet is claimed. Claiming
  * returns pointer to the packet within the buffer. Packet is freed when no
  * longer in use.
+ *
+ * Packets may be claimed by multiple consumers, each packet being claimed only
+ * once, and freed in any order. Space of a packet freed out of order is
+ * reclaimed once all the packets claimed before it are freed.
+ *
+ * On SMP, producers running on different CPUs contend on the buffer lock.
+ * The packet buffer with per-CPU lanes (@ref mpsc_pbuf_lanes) gives each CPU
+ * its own buffer and merges the packets by timestamp when claiming.
  */
 
 /**@defgroup MPSC_PBUF_FLAGS MPSC packet buffer flags
@@ -124,6 +132,9 @@ struct mpsc_pbuf_buffer {
 	/* Store max buffer usage. */
 	uint32_t max_usage;
 
+	/* Number of dropped packets. */
+	uint32_t drops;
+
 	struct k_sem sem;
 };
 
@@ -267,6 +278,169 @@ void mpsc_pbuf_get_utilization(struct mpsc_pbuf_buffer *buffer,
  * retval -ENOTSUP if Collecting utilization data is not supported.
  */
 int mpsc_pbuf_get_max_utilization(struct mpsc_pbuf_buffer *buffer, uint32_t *max);
+
+/** @brief Get the number of dropped packets.
+ *
+ * Packets are dropped when overwritten in overwrite mode, or when they cannot
+ * be stored otherwise.
+ *
+ * @param buffer Buffer.
+ *
+ * @return Number of packets dropped since the buffer was initialized.
+ */
+uint32_t mpsc_pbuf_get_drops(struct mpsc_pbuf_buffer *buffer);
+
+/** @brief Callback prototype for getting the timestamp of a packet.
+ *
+ * @param packet User packet.
+ *
+ * @return Timestamp of the packet, increasing monotonically.
+ */
+typedef uint64_t (*mpsc_pbuf_get_timestamp)(const union mpsc_pbuf_generic *packet);
+
+/** @brief MPSC packet buffer with per-CPU lanes.
+ *
+ * Each CPU stores packets in its own lane, a packet buffer using a part of the
+ * memory, so that producers on different CPUs do not contend on a lock. The
+ * consumers claim the oldest packet, by timestamp, among the first pending
+ * packet of each lane, so that packets are read in the order in which they
+ * were timestamped across lanes.
+ *
+ * The notify_drop callback is called with the lane buffer.
+ *
+ * @note Enable with @kconfig{CONFIG_MPSC_PBUF_LANES}
+ */
+struct mpsc_pbuf_lanes {
+	/** Lanes, indexed by CPU. */
+	struct mpsc_pbuf_buffer lanes[CONFIG_MP_MAX_NUM_CPUS];
+
+	/** First pending packet of each lane, claimed for merging. */
+	const union mpsc_pbuf_generic *heads[CONFIG_MP_MAX_NUM_CPUS];
+
+	/** Number of lanes. */
+	uint32_t num_lanes;
+
+	/** Callback for getting packet timestamp. */
+	mpsc_pbuf_get_timestamp get_timestamp;
+
+	/** Lock serializing the consumers. */
+	struct k_spinlock lock;
+};
+
+/** @brief Configuration of the MPSC packet buffer with per-CPU lanes. */
+struct mpsc_pbuf_lanes_config {
+	/* Configuration of the whole buffer, split evenly between lanes. */
+	struct mpsc_pbuf_buffer_config buffer;
+
+	/* Callback for getting packet timestamp. */
+	mpsc_pbuf_get_timestamp get_timestamp;
+
+	/* Number of lanes, at most the number of CPUs. 0 for one per CPU. */
+	uint32_t num_lanes;
+};
+
+/** @brief Statistics of a lane. */
+struct mpsc_pbuf_lane_stats {
+	/** Lane size in bytes. */
+	uint32_t size;
+
+	/** Current lane usage in bytes. */
+	uint32_t now;
+
+	/** Maximum lane usage in bytes, if tracked, or 0. */
+	uint32_t max;
+
+	/** Number of packets dropped from or for the lane. */
+	uint32_t drops;
+};
+
+/** @brief Initialize a packet buffer with per-CPU lanes.
+ *
+ * @param lanes  Buffer.
+ *
+ * @param config Configuration.
+ */
+void mpsc_pbuf_lanes_init(struct mpsc_pbuf_lanes *lanes,
+			  const struct mpsc_pbuf_lanes_config *config);
+
+/** @brief Allocate a packet in the lane of the current CPU.
+ *
+ * @see mpsc_pbuf_alloc
+ *
+ * @param lanes   Buffer.
+ *
+ * @param wlen    Number of words to allocate.
+ *
+ * @param timeout Timeout.
+ *
+ * @return Pointer to the allocated space or null if it cannot be allocated.
+ */
+union mpsc_pbuf_generic *mpsc_pbuf_lanes_alloc(struct mpsc_pbuf_lanes *lanes,
+					       size_t wlen, k_timeout_t timeout);
+
+/** @brief Commit a packet.
+ *
+ * The packet may be committed from another CPU than the one it was allocated
+ * on.
+ *
+ * @param lanes  Buffer.
+ *
+ * @param packet Pointer to a packet allocated by @ref mpsc_pbuf_lanes_alloc.
+ */
+void mpsc_pbuf_lanes_commit(struct mpsc_pbuf_lanes *lanes,
+			    union mpsc_pbuf_generic *packet);
+
+/** @brief Put a packet into the lane of the current CPU.
+ *
+ * @see mpsc_pbuf_put_data
+ *
+ * @param lanes Buffer.
+ *
+ * @param data  First word of data must contain MPSC_PBUF_HDR with valid bit set.
+ *
+ * @param wlen  Packet size in words.
+ */
+void mpsc_pbuf_lanes_put_data(struct mpsc_pbuf_lanes *lanes,
+			      const uint32_t *data, size_t wlen);
+
+/** @brief Claim the oldest pending packet of all lanes.
+ *
+ * @param lanes Buffer.
+ *
+ * @return Pointer to the claimed packet or null if none available.
+ */
+const union mpsc_pbuf_generic *mpsc_pbuf_lanes_claim(struct mpsc_pbuf_lanes *lanes);
+
+/** @brief Free a packet.
+ *
+ * @param lanes  Buffer.
+ *
+ * @param packet Packet.
+ */
+void mpsc_pbuf_lanes_free(struct mpsc_pbuf_lanes *lanes,
+			  const union mpsc_pbuf_generic *packet);
+
+/** @brief Check if there are any message pending in any lane.
+ *
+ * @param lanes Buffer.
+ *
+ * @retval true if pending.
+ * @retval false if no message is pending.
+ */
+bool mpsc_pbuf_lanes_is_pending(struct mpsc_pbuf_lanes *lanes);
+
+/** @brief Get the statistics of a lane.
+ *
+ * @param[in]  lanes Buffer.
+ * @param[in]  lane  Lane index.
+ * @param[out] stats Statistics.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if the lane does not exist.
+ */
+int mpsc_pbuf_lanes_get_stats(struct mpsc_pbuf_lanes *lanes, uint32_t lane,
+			      struct mpsc_pbuf_lane_stats *stats);
+
 /**
  * @}
  */
@@ -53,10 +53,28 @@ extern "C" {
  * put the two values somewhere else, though it would make
  * SYS_HEAP_DEFINE a little hairy to write.
  */
+#ifdef CONFIG_SYS_HEAP_TCACHE
+/* Per-CPU cache of free small blocks, see sys_heap_tcache_alloc().
+ * Each bin is a singly linked list threaded through the first word
+ * of the cached blocks themselves.
+ */
+struct z_heap_tcache {
+	void *bins[CONFIG_SYS_HEAP_TCACHE_CLASSES];
+	uint8_t count[CONFIG_SYS_HEAP_TCACHE_CLASSES];
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	uint32_t hits;
+	uint32_t misses;
+#endif
+};
+#endif
+
 struct sys_heap {
 	struct z_heap *heap;
 	void *init_mem;
 	size_t init_bytes;
+#ifdef CONFIG_SYS_HEAP_TCACHE
+	struct z_heap_tcache tcache[CONFIG_MP_MAX_NUM_CPUS];
+#endif
 };
 
 struct z_heap_stress_result {
@@ -71,6 +89,12 @@ struct z_heap_stress_result {
 /**
  * @brief Get the runtime statistics of a sys_heap
  *
+ * With CONFIG_SYS_HEAP_TCACHE, blocks held in the per-CPU caches are
+ * still allocated from the heap's point of view and are counted in
+ * allocated_bytes.  They are also reported in cached_bytes, along
+ * with the number of cache hits and misses, summed over all CPUs.
+ * These values are sampled without synchronizing with the other CPUs.
+ *
  * @param heap Pointer to specified sys_heap
  * @param stats_t Pointer to struct to copy statistics into
  * @return -EINVAL if null pointers, otherwise 0
@@ -195,6 +219,89 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
  */
 size_t sys_heap_usable_size(struct sys_heap *heap, void *mem);
 
+#ifdef CONFIG_SYS_HEAP_TCACHE
+
+/** @brief Allocate a small block from the current CPU's cache
+ *
+ * Lock-free fast path of the per-CPU block caches.  If @a bytes falls
+ * in one of the cached size classes and the current CPU's cache holds
+ * a block of that class satisfying @a align, that block is removed
+ * from the cache and returned.  Otherwise NULL is returned and the
+ * caller should fall back to sys_heap_tcache_refill().
+ *
+ * Unlike the other sys_heap functions this does not require the
+ * caller's heap lock.  It must however run on the same CPU from start
+ * to end and must not be preempted by another user of the cache on
+ * that CPU, which in practice means with local interrupts locked
+ * (e.g. with arch_irq_lock()).
+ *
+ * @param heap Heap from which to allocate
+ * @param align Alignment in bytes, or 0
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_tcache_alloc(struct sys_heap *heap, size_t align, size_t bytes);
+
+/** @brief Return a small block to the current CPU's cache
+ *
+ * Lock-free fast path counterpart of sys_heap_tcache_alloc(), with
+ * the same context requirements.  If @a mem is a block of one of the
+ * cached size classes and the current CPU's cache for that class is
+ * not full, the block is cached and true is returned.  Otherwise
+ * nothing is done and the caller must release the block with
+ * sys_heap_tcache_flush() or sys_heap_free().
+ *
+ * @param heap Heap to which to return the memory
+ * @param mem A pointer previously returned from this heap
+ * @return true if the block was taken by the cache
+ */
+bool sys_heap_tcache_free(struct sys_heap *heap, void *mem);
+
+/** @brief Allocate memory and refill the current CPU's cache
+ *
+ * Behaves like sys_heap_aligned_alloc().  In addition, if @a bytes
+ * falls in a cached size class, a batch of blocks of that class is
+ * allocated into the current CPU's cache so that subsequent
+ * sys_heap_tcache_alloc() calls can be served without the heap lock.
+ *
+ * Must be called with the heap lock held and on the same CPU
+ * throughout (a spinlock satisfies both).
+ *
+ * @param heap Heap from which to allocate
+ * @param align Alignment in bytes, or 0
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_tcache_refill(struct sys_heap *heap, size_t align, size_t bytes);
+
+/** @brief Free memory, flushing the current CPU's cache as needed
+ *
+ * Behaves like sys_heap_free(), except that blocks of a cached size
+ * class are put in the current CPU's cache, after returning a batch
+ * of cached blocks to the heap if the cache for that class is full.
+ *
+ * Same context requirements as sys_heap_tcache_refill().
+ *
+ * @param heap Heap to which to return the memory
+ * @param mem A pointer previously returned from this heap, or NULL
+ */
+void sys_heap_tcache_flush(struct sys_heap *heap, void *mem);
+
+/** @brief Return all of the current CPU's cached blocks to the heap
+ *
+ * Memory held in a CPU's cache can only be reused for allocations of
+ * the same size class on that CPU.  This makes it available again for
+ * allocations of any size, e.g. before giving up on an allocation.
+ *
+ * Same context requirements as sys_heap_tcache_refill().
+ *
+ * @param heap Heap whose cache is to be drained
+ * @return true if any block was returned to the heap
+ */
+bool sys_heap_tcache_drain(struct sys_heap *heap);
+
+#endif /* CONFIG_SYS_HEAP_TCACHE */
+
 /** @brief Validate heap integrity
  *
  * Validates the internal integrity of a sys_heap.  Intended for unit
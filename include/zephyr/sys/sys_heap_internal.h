@@ -0,0 +1,113 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SYS_HEAP_INTERNAL_H_
+#define ZEPHYR_INCLUDE_SYS_SYS_HEAP_INTERNAL_H_
+
+#include <zephyr/types.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Layout of the sys_heap metadata.  This is private to the heap
+ * implementation in lib/os/heap.[ch], and is only here so that
+ * Z_HEAP_MIN_SIZE, which K_HEAP_DEFINE() needs in a constant
+ * expression, is derived from the very definitions the heap uses.
+ */
+
+#define Z_HEAP_CHUNK_UNIT 8U
+
+/* True if heaps small enough to count their chunks in 15 bits still
+ * use 8 byte chunk headers, see big_heap_chunks()
+ */
+#define Z_HEAP_SMALL_IS_BIG						\
+	(!IS_ENABLED(CONFIG_SYS_HEAP_SMALL_ONLY) &&			\
+	 (IS_ENABLED(CONFIG_SYS_HEAP_BIG_ONLY) || sizeof(void *) > 4U))
+
+#ifdef CONFIG_SYS_HEAP_BUCKETS_TLSF
+#define Z_HEAP_TLSF_SL_BITS CONFIG_SYS_HEAP_TLSF_SL_BITS
+#define Z_HEAP_TLSF_ROWS						\
+	((IS_ENABLED(CONFIG_SYS_HEAP_SMALL_ONLY) ? 16 : 32) -		\
+	 Z_HEAP_TLSF_SL_BITS)
+
+/* Right shift of a usable size to its second level index: zero while
+ * the sizes of a row are fewer than its lists
+ */
+#define Z_HEAP_TLSF_SHIFT(usable_sz)					\
+	(LOG2(usable_sz) > Z_HEAP_TLSF_SL_BITS ?			\
+	 LOG2(usable_sz) - Z_HEAP_TLSF_SL_BITS : 0)
+
+#define Z_HEAP_BUCKET_IDX(usable_sz)					\
+	((int)(LOG2(usable_sz) <= Z_HEAP_TLSF_SL_BITS ? (usable_sz) :	\
+	       ((Z_HEAP_TLSF_SHIFT(usable_sz) + 1) << Z_HEAP_TLSF_SL_BITS) | \
+	       (((usable_sz) >> Z_HEAP_TLSF_SHIFT(usable_sz)) &		\
+		(BIT(Z_HEAP_TLSF_SL_BITS) - 1U))))
+#else
+#define Z_HEAP_BUCKET_IDX(usable_sz) ((int)LOG2(usable_sz))
+#endif
+
+struct z_heap_bucket {
+	uint32_t next;
+};
+
+struct z_heap {
+	uint32_t chunk0_hdr[2];
+	uint32_t end_chunk;
+	/* One bit per non-empty bucket, or per row of buckets with a
+	 * non-empty one with CONFIG_SYS_HEAP_BUCKETS_TLSF
+	 */
+	uint32_t avail_buckets;
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	size_t free_bytes;
+	size_t allocated_bytes;
+	size_t max_allocated_bytes;
+#endif
+#ifdef CONFIG_SYS_HEAP_BUCKETS_TLSF
+	uint32_t avail_sl[Z_HEAP_TLSF_ROWS];
+#endif
+	struct z_heap_bucket buckets[0];
+};
+
+/* Chunk header size and smallest chunk of the heaps Z_HEAP_MIN_SIZE
+ * is about
+ */
+#define Z_HEAP_MIN_HDR_BYTES (Z_HEAP_SMALL_IS_BIG ? 8U : 4U)
+#define Z_HEAP_MIN_CHUNK						\
+	DIV_ROUND_UP(Z_HEAP_MIN_HDR_BYTES + 1U, Z_HEAP_CHUNK_UNIT)
+
+/* Chunk 0 of a heap of @chunks chunks, as sys_heap_init() lays it
+ * out: struct z_heap followed by one bucket per bucket index
+ */
+#define Z_HEAP_CHUNK0(chunks)						\
+	DIV_ROUND_UP(sizeof(struct z_heap) +				\
+		     (Z_HEAP_BUCKET_IDX((chunks) - Z_HEAP_MIN_CHUNK + 1U) + 1U) * \
+		     sizeof(struct z_heap_bucket), Z_HEAP_CHUNK_UNIT)
+
+/* Chunks needed for chunk 0 and a 1 byte allocation, by a heap of
+ * @chunks chunks.  It grows with the heap size, as more buckets come
+ * with more chunks, so iterate from a lower bound up to the smallest
+ * heap that fits its own chunk 0 and one allocation.  heap.c checks
+ * that the iteration converged.
+ */
+#define Z_HEAP_MIN_NEXT(chunks) (Z_HEAP_CHUNK0(chunks) + Z_HEAP_MIN_CHUNK)
+
+enum {
+	Z_HEAP_MIN_CHUNKS_0 = DIV_ROUND_UP(sizeof(struct z_heap),
+					   Z_HEAP_CHUNK_UNIT) + Z_HEAP_MIN_CHUNK + 1U,
+	Z_HEAP_MIN_CHUNKS_1 = Z_HEAP_MIN_NEXT(Z_HEAP_MIN_CHUNKS_0),
+	Z_HEAP_MIN_CHUNKS_2 = Z_HEAP_MIN_NEXT(Z_HEAP_MIN_CHUNKS_1),
+	Z_HEAP_MIN_CHUNKS_3 = Z_HEAP_MIN_NEXT(Z_HEAP_MIN_CHUNKS_2),
+	Z_HEAP_MIN_CHUNKS_4 = Z_HEAP_MIN_NEXT(Z_HEAP_MIN_CHUNKS_3),
+	Z_HEAP_MIN_CHUNKS_5 = Z_HEAP_MIN_NEXT(Z_HEAP_MIN_CHUNKS_4),
+	Z_HEAP_MIN_CHUNKS = Z_HEAP_MIN_NEXT(Z_HEAP_MIN_CHUNKS_5),
+};
+
+/* Minimum heap size needed to return a successful 1-byte allocation:
+ * the chunks above, and the header of the end marker chunk
+ */
+#define Z_HEAP_MIN_SIZE							\
+	(Z_HEAP_MIN_CHUNKS * Z_HEAP_CHUNK_UNIT + Z_HEAP_MIN_HDR_BYTES)
+
+#endif /* ZEPHYR_INCLUDE_SYS_SYS_HEAP_INTERNAL_H_ */
@@ -0,0 +1,177 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_WORK_POOL_H_
+#define ZEPHYR_INCLUDE_SYS_WORK_POOL_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup work_pool_apis Work Pool APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/* Work-stealing pool of work queue threads
+ *
+ * Each worker thread owns a bounded deque of work items.  Items
+ * submitted by a worker (typically from a work item fanning out
+ * more work) go to the bottom of its own deque, and the worker runs
+ * its deque newest first, which keeps related data cache-hot.  Items
+ * submitted from other threads and ISRs go to a shared injection
+ * list.  A worker which runs out of work takes from the injection
+ * list, then steals the oldest item of another worker's deque, and
+ * only sleeps when there is nothing left to steal.
+ */
+
+/**
+ * @brief Work pool worker
+ *
+ * Reserved for the implementation, apart from the statistics.
+ */
+struct k_work_pool_worker {
+	struct k_thread thread;
+	struct k_spinlock lock;
+
+	/* Deque ring: the owner pushes and pops at tail, thieves
+	 * take from head
+	 */
+	struct k_work *items[CONFIG_WORK_POOL_DEQUE_SIZE];
+	uint32_t head;
+	uint32_t tail;
+
+	/** Number of work items run by this worker */
+	uint32_t executed;
+	/** Number of them stolen from other workers */
+	uint32_t stolen;
+};
+
+/**
+ * @brief Work pool
+ *
+ * A pool of worker threads running ordinary work items, see
+ * k_work_pool_submit().
+ */
+struct k_work_pool {
+	/* Protects the injection list */
+	struct k_spinlock lock;
+
+	/* Items submitted from outside the pool */
+	sys_slist_t injected;
+
+	/* Idle workers sleep here */
+	struct k_sem wake;
+	atomic_t idle;
+
+	struct k_work_pool_worker *workers;
+	k_thread_stack_t *stacks;
+	size_t stack_size;
+	uint32_t num_workers;
+};
+
+/**
+ * @brief Statically define a work pool with a given number of workers
+ *
+ * The pool must be started with k_work_pool_start() before use.
+ *
+ * @param name Symbol name of the struct k_work_pool
+ * @param n_threads Number of worker threads
+ * @param stack_sz Stack size of each worker thread, in bytes
+ */
+#define K_WORK_POOL_DEFINE_WORKERS(name, n_threads, stack_sz)		\
+	static K_THREAD_STACK_ARRAY_DEFINE(_wpstacks_##name,		\
+					   n_threads, stack_sz);	\
+	static struct k_work_pool_worker _wpworkers_##name[n_threads];	\
+	static struct k_work_pool name = {				\
+		.workers = _wpworkers_##name,				\
+		.stacks = &(_wpstacks_##name[0][0]),			\
+		.stack_size = stack_sz,					\
+		.num_workers = n_threads,				\
+	}
+
+/**
+ * @brief Statically define a work pool
+ *
+ * Defines a pool with one worker per CPU, i.e. CONFIG_MP_MAX_NUM_CPUS
+ * workers, which is the natural choice for CPU-bound work.  The pool
+ * must be started with k_work_pool_start() before use.
+ *
+ * @param name Symbol name of the struct k_work_pool
+ * @param stack_sz Stack size of each worker thread, in bytes
+ */
+#define K_WORK_POOL_DEFINE(name, stack_sz)				\
+	K_WORK_POOL_DEFINE_WORKERS(name, CONFIG_MP_MAX_NUM_CPUS, stack_sz)
+
+/**
+ * @brief Start the worker threads of a work pool
+ *
+ * @param pool Work pool, defined with K_WORK_POOL_DEFINE() or
+ *	K_WORK_POOL_DEFINE_WORKERS()
+ * @param prio Priority of the worker threads
+ */
+void k_work_pool_start(struct k_work_pool *pool, int prio);
+
+/**
+ * @brief Submit a work item to a work pool
+ *
+ * The handler of @p work, initialized with k_work_init(), will run on
+ * one of the worker threads, on any CPU.  Unlike with work queues,
+ * nothing prevents handlers of different items from running in
+ * parallel, and the item may be submitted again as soon as its handler
+ * has been entered, but not before.  The k_work state functions such
+ * as k_work_busy_get() and k_work_cancel() don't apply to items
+ * submitted to a pool.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param pool Work pool
+ * @param work Work item
+ */
+void k_work_pool_submit(struct k_work_pool *pool, struct k_work *work);
+
+/**
+ * @brief Range callback of k_work_pool_parallel_for()
+ *
+ * @param begin First index of the range
+ * @param end Index after the last one of the range
+ * @param arg Argument given to k_work_pool_parallel_for()
+ */
+typedef void (*k_work_pool_range_fn_t)(size_t begin, size_t end, void *arg);
+
+/**
+ * @brief Run a loop in parallel on a work pool
+ *
+ * Splits the indices [0, @p n) into ranges of @p grain indices and
+ * calls @p fn on each of them, from the calling thread and from as
+ * many workers of @p pool as there are ranges to spare, then waits for
+ * all ranges to be done.  Ranges are handed out dynamically, so uneven
+ * ranges balance out.  This can be called from a work item running on
+ * the pool itself: while waiting, the caller runs other items of the
+ * pool.
+ *
+ * @param pool Work pool
+ * @param n Number of indices
+ * @param grain Number of indices per call to @p fn, the last range may
+ *	be smaller
+ * @param fn Callback run on each range
+ * @param arg Argument passed to @p fn
+ *
+ * @retval 0 on success
+ * @retval -EINVAL @p grain is 0
+ */
+int k_work_pool_parallel_for(struct k_work_pool *pool, size_t n, size_t grain,
+			     k_work_pool_range_fn_t fn, void *arg);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_WORK_POOL_H_ */
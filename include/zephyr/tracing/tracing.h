@@ -346,6 +346,38 @@
  */
 #define sys_port_trace_k_work_submit_exit(work, ret)
 
+/**
+ * @brief Trace submit of a batch of work to work queue call entry
+ * @param queue Work queue structure
+ * @param works Array of work structures
+ * @param n Number of work structures
+ */
+#define sys_port_trace_k_work_submit_batch_to_queue_enter(queue, works, n)
+
+/**
+ * @brief Trace submit of a batch of work to work queue call exit
+ * @param queue Work queue structure
+ * @param works Array of work structures
+ * @param n Number of work structures
+ * @param ret Return value
+ */
+#define sys_port_trace_k_work_submit_batch_to_queue_exit(queue, works, n, ret)
+
+/**
+ * @brief Trace submit of a batch of work to system work queue call entry
+ * @param works Array of work structures
+ * @param n Number of work structures
+ */
+#define sys_port_trace_k_work_submit_batch_enter(works, n)
+
+/**
+ * @brief Trace submit of a batch of work to system work queue call exit
+ * @param works Array of work structures
+ * @param n Number of work structures
+ * @param ret Return value
+ */
+#define sys_port_trace_k_work_submit_batch_exit(works, n, ret)
+
 /**
  * @brief Trace flush work call entry
  * @param work Work structure
@@ -804,6 +836,91 @@
 
 /** @} */ /* end of subsys_tracing_apis_mutex */
 
+/**
+ * @brief Reader/Writer Lock Tracing APIs
+ * @defgroup subsys_tracing_apis_rwlock Reader/Writer Lock Tracing APIs
+ * @{
+ */
+
+/**
+ * @brief Trace initialization of Reader/Writer Lock
+ * @param rwlock Reader/Writer Lock object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_init(rwlock, ret)
+
+/**
+ * @brief Trace Reader/Writer Lock read lock attempt start
+ * @param rwlock Reader/Writer Lock object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_rwlock_read_lock_enter(rwlock, timeout)
+
+/**
+ * @brief Trace Reader/Writer Lock read lock attempt blocking
+ * @param rwlock Reader/Writer Lock object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_rwlock_read_lock_blocking(rwlock, timeout)
+
+/**
+ * @brief Trace Reader/Writer Lock read lock attempt outcome
+ * @param rwlock Reader/Writer Lock object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_read_lock_exit(rwlock, timeout, ret)
+
+/**
+ * @brief Trace Reader/Writer Lock read unlock entry
+ * @param rwlock Reader/Writer Lock object
+ */
+#define sys_port_trace_k_rwlock_read_unlock_enter(rwlock)
+
+/**
+ * @brief Trace Reader/Writer Lock read unlock exit
+ * @param rwlock Reader/Writer Lock object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_read_unlock_exit(rwlock, ret)
+
+/**
+ * @brief Trace Reader/Writer Lock write lock attempt start
+ * @param rwlock Reader/Writer Lock object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_rwlock_write_lock_enter(rwlock, timeout)
+
+/**
+ * @brief Trace Reader/Writer Lock write lock attempt blocking
+ * @param rwlock Reader/Writer Lock object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_rwlock_write_lock_blocking(rwlock, timeout)
+
+/**
+ * @brief Trace Reader/Writer Lock write lock attempt outcome
+ * @param rwlock Reader/Writer Lock object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_write_lock_exit(rwlock, timeout, ret)
+
+/**
+ * @brief Trace Reader/Writer Lock write unlock entry
+ * @param rwlock Reader/Writer Lock object
+ */
+#define sys_port_trace_k_rwlock_write_unlock_enter(rwlock)
+
+/**
+ * @brief Trace Reader/Writer Lock write unlock exit
+ * @param rwlock Reader/Writer Lock object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_rwlock_write_unlock_exit(rwlock, ret)
+
+/** @} */ /* end of subsys_tracing_apis_rwlock */
+
 /**
  * @brief Conditional Variable Tracing APIs
  * @defgroup subsys_tracing_apis_condvar Conditional Variable Tracing APIs
@@ -1419,6 +1536,56 @@
  */
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
 
+/**
+ * @brief Trace Message Queue put of several messages attempt entry
+ * @param msgq Message Queue object
+ * @param n Number of messages
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_n_enter(msgq, n, timeout)
+
+/**
+ * @brief Trace Message Queue put of several messages attempt blocking
+ * @param msgq Message Queue object
+ * @param n Number of messages
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_n_blocking(msgq, n, timeout)
+
+/**
+ * @brief Trace Message Queue put of several messages attempt outcome
+ * @param msgq Message Queue object
+ * @param n Number of messages
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_put_n_exit(msgq, n, timeout, ret)
+
+/**
+ * @brief Trace Message Queue get of several messages attempt entry
+ * @param msgq Message Queue object
+ * @param n Number of messages
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_n_enter(msgq, n, timeout)
+
+/**
+ * @brief Trace Message Queue get of several messages attempt blocking
+ * @param msgq Message Queue object
+ * @param n Number of messages
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_n_blocking(msgq, n, timeout)
+
+/**
+ * @brief Trace Message Queue get of several messages attempt outcome
+ * @param msgq Message Queue object
+ * @param n Number of messages
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_get_n_exit(msgq, n, timeout, ret)
+
 /**
  * @brief Trace Message Queue peek
  * @param msgq Message Queue object
@@ -99,6 +99,12 @@
 	#define sys_port_trace_type_mask_k_mutex(trace_call)
 #endif
 
+#if defined(CONFIG_TRACING_RWLOCK)
+	#define sys_port_trace_type_mask_k_rwlock(trace_call) trace_call
+#else
+	#define sys_port_trace_type_mask_k_rwlock(trace_call)
+#endif
+
 #if defined(CONFIG_TRACING_CONDVAR)
 	#define sys_port_trace_type_mask_k_condvar(trace_call) trace_call
 #else
@@ -75,6 +75,7 @@ extern struct k_event *_track_list_k_event;
 	sys_track_k_queue_init(queue)
 #define sys_port_track_k_pipe_init(pipe) \
 	sys_track_k_pipe_init(pipe)
+#define sys_port_track_k_rwlock_init(rwlock, ret)
 #define sys_port_track_k_condvar_init(condvar, ret)
 #define sys_port_track_k_stack_init(stack) \
 	sys_track_k_stack_init(stack)
@@ -129,6 +130,7 @@ void sys_track_k_event_init(struct k_event *event);
 #define sys_port_track_k_queue_cancel_wait(queue)
 #define sys_port_track_k_queue_init(queue)
 #define sys_port_track_k_pipe_init(pipe)
+#define sys_port_track_k_rwlock_init(rwlock, ret)
 #define sys_port_track_k_condvar_init(condvar, ret)
 #define sys_port_track_k_stack_init(stack)
 #define sys_port_track_k_thread_name_set(thread, ret)
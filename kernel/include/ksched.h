@@ -138,6 +138,34 @@ static inline bool z_is_thread_queued(struct k_thread *thread)
 	return z_is_thread_state_set(thread, _THREAD_QUEUED);
 }
 
+#ifdef CONFIG_SMP
+/* True if the thread is the current thread of some CPU.  This is read
+ * without any lock, so it is only a hint that may be stale by the time
+ * the caller looks at it.
+ */
+static inline bool z_is_thread_running(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		if (*(struct k_thread *volatile *)&_kernel.cpus[i].current == thread) {
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
+
+/* Contention counters of mutexes and semaphores, updated under the
+ * object's lock
+ */
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+#define Z_CONTENTION_INC(obj, counter) ((obj)->contention.counter++)
+#else
+#define Z_CONTENTION_INC(obj, counter) do { } while (false)
+#endif
+
 static inline void z_mark_thread_as_suspended(struct k_thread *thread)
 {
 	thread->base.thread_state |= _THREAD_SUSPENDED;
@@ -69,6 +69,22 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 
 	end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX : end;
 
+#ifdef CONFIG_SYS_HEAP_TCACHE
+	/* Lock-free fast path: this CPU's cache only needs the CPU to
+	 * stay put, which locking local interrupts guarantees.
+	 */
+	unsigned int irq_key = arch_irq_lock();
+
+	ret = sys_heap_tcache_alloc(&h->heap, align, bytes);
+	arch_irq_unlock(irq_key);
+
+	if (ret != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+		return ret;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
@@ -78,7 +94,19 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	bool blocked_alloc = false;
 
 	while (ret == NULL) {
+#ifdef CONFIG_SYS_HEAP_TCACHE
+		ret = sys_heap_tcache_refill(&h->heap, align, bytes);
+
+		/* Blocks parked in our own cache may add up to enough
+		 * memory once returned to the heap, retry with them before
+		 * giving up or blocking.
+		 */
+		if ((ret == NULL) && sys_heap_tcache_drain(&h->heap)) {
+			continue;
+		}
+#else
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
+#endif
 
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
@@ -120,9 +148,37 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+#ifdef CONFIG_SYS_HEAP_TCACHE
+	/* Cached blocks are invisible to other allocators, so only cache
+	 * when nobody is waiting for memory.  The check is racy, but a
+	 * waiter drains its own CPU's cache before pending and its
+	 * timeout bounds the effect of any block cached meanwhile.
+	 */
+	if (z_waitq_head(&h->wait_q) == NULL) {
+		unsigned int irq_key = arch_irq_lock();
+		bool cached = sys_heap_tcache_free(&h->heap, mem);
+
+		arch_irq_unlock(irq_key);
+
+		if (cached) {
+			SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+			return;
+		}
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
+#ifdef CONFIG_SYS_HEAP_TCACHE
+	if (z_waitq_head(&h->wait_q) == NULL) {
+		sys_heap_tcache_flush(&h->heap, mem);
+	} else {
+		sys_heap_free(&h->heap, mem);
+		(void)sys_heap_tcache_drain(&h->heap);
+	}
+#else
 	sys_heap_free(&h->heap, mem);
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
 	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
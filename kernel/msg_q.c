@@ -54,6 +54,245 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	z_object_init(msgq);
 }
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+/*
+ * Lock-free mode: a bounded MPMC ring in which every slot carries a
+ * sequence number telling which lap of the ring it is ready for.  A
+ * writer claims position pos (slot pos % max_msgs) once the slot's
+ * sequence equals pos, copies the message in and publishes pos + 1; a
+ * reader claims pos once the sequence equals pos + 1, copies the
+ * message out and publishes pos + max_msgs, handing the slot to the
+ * writer of the next lap.  Positions are claimed by advancing head or
+ * tail with a CAS, several at a time for batch operations.
+ *
+ * Sequence numbers are stored minus the slot index, so that an all
+ * zero array is an empty ring and static queues need no runtime init.
+ *
+ * The lock only serializes the wait queues.  A thread about to block
+ * bumps get_waiters/put_waiters, then checks the ring once more under
+ * the lock; a thread completing a transfer publishes its slots, then
+ * only takes the lock if the other side has waiters.  As all these
+ * atomics are sequentially consistent, either the blocking thread sees
+ * the transfer or the other thread sees the waiter, and no wakeup is
+ * lost.
+ */
+
+static inline uint32_t slot_idx(struct k_msgq *msgq, uint32_t pos)
+{
+	return pos & (msgq->max_msgs - 1U);
+}
+
+static inline uint32_t slot_seq(struct k_msgq *msgq, uint32_t pos)
+{
+	uint32_t idx = slot_idx(msgq, pos);
+
+	return (uint32_t)atomic_get(&msgq->lockless.seq[idx]) + idx;
+}
+
+static inline void slot_publish(struct k_msgq *msgq, uint32_t pos, uint32_t seq)
+{
+	uint32_t idx = slot_idx(msgq, pos);
+
+	(void)atomic_set(&msgq->lockless.seq[idx], (atomic_val_t)(seq - idx));
+}
+
+/* Claims up to n consecutive positions at cursor whose slots have a
+ * sequence of position + ready.  Returns how many were claimed and the
+ * first one in *first, 0 if the ring is full (writers) or empty
+ * (readers) at the cursor.
+ */
+static uint32_t ring_claim(struct k_msgq *msgq, atomic_t *cursor,
+			   uint32_t ready, uint32_t n, uint32_t *first)
+{
+	uint32_t pos, k;
+	int32_t diff;
+
+	do {
+		pos = (uint32_t)atomic_get(cursor);
+		diff = 0;
+
+		for (k = 0U; k < n; k++) {
+			diff = (int32_t)(slot_seq(msgq, pos + k) - (pos + k + ready));
+			if (diff != 0) {
+				break;
+			}
+		}
+
+		/* A slot still owned by the previous lap means full/empty,
+		 * one already ahead means someone claimed pos: reload.
+		 */
+		if (k == 0U && diff < 0) {
+			return 0U;
+		}
+	} while (k == 0U ||
+		 !atomic_cas(cursor, (atomic_val_t)pos, (atomic_val_t)(pos + k)));
+
+	*first = pos;
+	return k;
+}
+
+/* Copies k messages between data and the ring slots at pos */
+static void ring_copy(struct k_msgq *msgq, uint32_t pos, uint32_t k,
+		      char *data, bool put)
+{
+	uint32_t idx = slot_idx(msgq, pos);
+	uint32_t part = MIN(k, msgq->max_msgs - idx);
+	char *slot = msgq->buffer_start + idx * msgq->msg_size;
+
+	if (data == NULL) {
+		return;
+	}
+
+	if (put) {
+		(void)memcpy(slot, data, part * msgq->msg_size);
+		(void)memcpy(msgq->buffer_start, data + part * msgq->msg_size,
+			     (k - part) * msgq->msg_size);
+	} else {
+		(void)memcpy(data, slot, part * msgq->msg_size);
+		(void)memcpy(data + part * msgq->msg_size, msgq->buffer_start,
+			     (k - part) * msgq->msg_size);
+	}
+}
+
+/* Moves up to n messages without blocking, data may be NULL to drop
+ * received messages
+ */
+static uint32_t ring_xfer(struct k_msgq *msgq, char *data, uint32_t n, bool put)
+{
+	struct z_msgq_lockless *ll = &msgq->lockless;
+	uint32_t pos, k;
+
+	k = ring_claim(msgq, put ? &ll->head : &ll->tail, put ? 0U : 1U, n, &pos);
+
+	ring_copy(msgq, pos, k, data, put);
+
+	for (uint32_t i = 0U; i < k; i++) {
+		slot_publish(msgq, pos + i,
+			     pos + i + (put ? 1U : msgq->max_msgs));
+	}
+
+	return k;
+}
+
+/* Wakes up to n threads blocked on the other side of a transfer */
+static void lockless_wake(struct k_msgq *msgq, bool put, uint32_t n)
+{
+	struct z_msgq_lockless *ll = &msgq->lockless;
+	_wait_q_t *wait_q = put ? &msgq->wait_q : &ll->put_wait_q;
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+	bool woken = false;
+
+	if (atomic_get(put ? &ll->get_waiters : &ll->put_waiters) == 0) {
+		return;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	while (n-- > 0U && (thread = z_unpend_first_thread(wait_q)) != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		woken = true;
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+}
+
+static int lockless_xfer(struct k_msgq *msgq, char *data, uint32_t n,
+			 bool put, k_timeout_t timeout)
+{
+	struct z_msgq_lockless *ll = &msgq->lockless;
+	atomic_t *waiters = put ? &ll->put_waiters : &ll->get_waiters;
+	int64_t now, end;
+	k_spinlock_key_t key;
+	uint32_t done;
+	int result = -ENOMSG;
+
+	done = ring_xfer(msgq, data, n, put);
+
+	if (done == 0U && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		end = sys_clock_timeout_end_calc(timeout);
+		end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX : end;
+
+		key = k_spin_lock(&msgq->lock);
+		(void)atomic_inc(waiters);
+
+		while ((done = ring_xfer(msgq, data, n, put)) == 0U) {
+			now = sys_clock_tick_get();
+			if ((end - now) <= 0) {
+				result = -EAGAIN;
+				break;
+			}
+
+			result = z_pend_curr(&msgq->lock, key,
+					     put ? &ll->put_wait_q : &msgq->wait_q,
+					     K_TICKS(end - now));
+			key = k_spin_lock(&msgq->lock);
+
+			/* k_msgq_purge() fails blocked writers */
+			if (result == -ENOMSG) {
+				break;
+			}
+		}
+
+		(void)atomic_dec(waiters);
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	if (done == 0U) {
+		return result;
+	}
+
+	lockless_wake(msgq, put, done);
+
+	return (int)done;
+}
+
+int k_msgq_lockless_init(struct k_msgq *msgq, char *buffer, atomic_t *seq,
+			 size_t msg_size, uint32_t max_msgs)
+{
+	CHECKIF(!IS_POWER_OF_TWO(max_msgs)) {
+		return -EINVAL;
+	}
+
+	k_msgq_init(msgq, buffer, msg_size, max_msgs);
+
+	for (uint32_t i = 0U; i < max_msgs; i++) {
+		atomic_clear(&seq[i]);
+	}
+
+	msgq->lockless = (struct z_msgq_lockless) {
+		.seq = seq,
+	};
+	z_waitq_init(&msgq->lockless.put_wait_q);
+	msgq->flags = K_MSGQ_FLAG_LOCKLESS;
+
+	return 0;
+}
+
+static inline bool is_lockless(struct k_msgq *msgq)
+{
+	return (msgq->flags & K_MSGQ_FLAG_LOCKLESS) != 0U;
+}
+#else
+static inline bool is_lockless(struct k_msgq *msgq)
+{
+	ARG_UNUSED(msgq);
+
+	return false;
+}
+
+static inline int lockless_xfer(struct k_msgq *msgq, char *data, uint32_t n,
+				bool put, k_timeout_t timeout)
+{
+	return -ENOTSUP;
+}
+#endif /* CONFIG_MSGQ_LOCKLESS */
+
 int z_impl_k_msgq_alloc_init(struct k_msgq *msgq, size_t msg_size,
 			    uint32_t max_msgs)
 {
@@ -102,6 +341,15 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	CHECKIF(is_lockless(msgq) &&
+		z_waitq_head(&msgq->lockless.put_wait_q) != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, cleanup, msgq, -EBUSY);
+
+		return -EBUSY;
+	}
+#endif
+
 	if ((msgq->flags & K_MSGQ_FLAG_ALLOC) != 0U) {
 		k_free(msgq->buffer_start);
 		msgq->flags &= ~K_MSGQ_FLAG_ALLOC;
@@ -121,6 +369,17 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 	k_spinlock_key_t key;
 	int result;
 
+	if (is_lockless(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
+
+		result = lockless_xfer(msgq, (char *)data, 1U, true, timeout);
+		result = MIN(result, 0);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, result);
+
+		return result;
+	}
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
@@ -191,7 +450,7 @@ void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
 	attrs->max_msgs = msgq->max_msgs;
-	attrs->used_msgs = msgq->used_msgs;
+	attrs->used_msgs = z_msgq_used(msgq);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -213,6 +472,17 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	struct k_thread *pending_thread;
 	int result;
 
+	if (is_lockless(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
+
+		result = lockless_xfer(msgq, data, 1U, false, timeout);
+		result = MIN(result, 0);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, result);
+
+		return result;
+	}
+
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
@@ -285,11 +555,228 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+/* Copies up to n messages from data into the ring.  must be locked */
+static uint32_t ring_put_n(struct k_msgq *msgq, const char *data, uint32_t n)
+{
+	uint32_t done = 0U;
+
+	while (done < n && msgq->used_msgs < msgq->max_msgs) {
+		uint32_t k = MIN(n - done, msgq->max_msgs - msgq->used_msgs);
+
+		k = MIN(k, (msgq->buffer_end - msgq->write_ptr) / msgq->msg_size);
+
+		(void)memcpy(msgq->write_ptr, data + done * msgq->msg_size,
+			     k * msgq->msg_size);
+		msgq->write_ptr += k * msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs += k;
+		done += k;
+	}
+
+	return done;
+}
+
+int z_impl_k_msgq_put_n(struct k_msgq *msgq, const void *data, uint32_t n,
+			k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	const char *src = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t done = 0U;
+	bool woken = false;
+	int result;
+
+	CHECKIF(n == 0U) {
+		return -EINVAL;
+	}
+
+	if (is_lockless(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_n, msgq, n, timeout);
+
+		result = lockless_xfer(msgq, (char *)data, n, true, timeout);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_n, msgq, n, timeout, result);
+
+		return result;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_n, msgq, n, timeout);
+
+	/* Readers can only be waiting on an empty queue: give them the
+	 * first messages directly
+	 */
+	while (done < n && msgq->used_msgs == 0U &&
+	       (pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
+		(void)memcpy(pending_thread->base.swap_data,
+			     src + done * msgq->msg_size, msgq->msg_size);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		woken = true;
+		done++;
+	}
+
+	done += ring_put_n(msgq, src + done * msgq->msg_size, n - done);
+
+	if (done == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_n, msgq, n, timeout, -ENOMSG);
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put_n, msgq, n, timeout);
+
+		/* wait for the first message to be taken, as k_msgq_put() */
+		_current->base.swap_data = (void *)data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = (result == 0) ? 1 : result;
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_n, msgq, n, timeout, result);
+		return result;
+	}
+
+#ifdef CONFIG_POLL
+	if (msgq->used_msgs > 0U) {
+		handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+	}
+#endif /* CONFIG_POLL */
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_n, msgq, n, timeout, (int)done);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return (int)done;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_n(struct k_msgq *msgq, const void *data,
+				      uint32_t n, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, n, msgq->msg_size));
+
+	return z_impl_k_msgq_put_n(msgq, data, n, timeout);
+}
+#include <syscalls/k_msgq_put_n_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_n(struct k_msgq *msgq, void *data, uint32_t n,
+			k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	char *dst = data;
+	struct k_thread *pending_thread;
+	k_spinlock_key_t key;
+	uint32_t done = 0U;
+	bool woken = false;
+	int result;
+
+	CHECKIF(n == 0U) {
+		return -EINVAL;
+	}
+
+	if (is_lockless(msgq)) {
+		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_n, msgq, n, timeout);
+
+		result = lockless_xfer(msgq, data, n, false, timeout);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_n, msgq, n, timeout, result);
+
+		return result;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_n, msgq, n, timeout);
+
+	while (done < n && msgq->used_msgs > 0U) {
+		uint32_t k = MIN(n - done, msgq->used_msgs);
+
+		k = MIN(k, (msgq->buffer_end - msgq->read_ptr) / msgq->msg_size);
+
+		(void)memcpy(dst + done * msgq->msg_size, msgq->read_ptr,
+			     k * msgq->msg_size);
+		msgq->read_ptr += k * msgq->msg_size;
+		if (msgq->read_ptr == msgq->buffer_end) {
+			msgq->read_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs -= k;
+		done += k;
+	}
+
+	if (done == 0U) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_n, msgq, n, timeout, -ENOMSG);
+			k_spin_unlock(&msgq->lock, key);
+			return -ENOMSG;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get_n, msgq, n, timeout);
+
+		/* wait for a message, as k_msgq_get() */
+		_current->base.swap_data = data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = (result == 0) ? 1 : result;
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_n, msgq, n, timeout, result);
+		return result;
+	}
+
+	/* The queue wasn't empty, so any waiters are writers: refill the
+	 * freed slots with their messages
+	 */
+	while (msgq->used_msgs < msgq->max_msgs &&
+	       (pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
+		(void)ring_put_n(msgq, pending_thread->base.swap_data, 1U);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		woken = true;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_n, msgq, n, timeout, (int)done);
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return (int)done;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_n(struct k_msgq *msgq, void *data,
+				      uint32_t n, k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, n, msgq->msg_size));
+
+	return z_impl_k_msgq_get_n(msgq, data, n, timeout);
+}
+#include <syscalls/k_msgq_get_n_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
 	int result;
 
+	/* Slots may be recycled while being read without the lock */
+	if (is_lockless(msgq)) {
+		return -ENOTSUP;
+	}
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > 0U) {
@@ -327,6 +814,10 @@ int z_impl_k_msgq_peek_at(struct k_msgq *msgq, void *data, uint32_t idx)
 	uint32_t byte_offset;
 	char *start_addr;
 
+	if (is_lockless(msgq)) {
+		return -ENOTSUP;
+	}
+
 	key = k_spin_lock(&msgq->lock);
 
 	if (msgq->used_msgs > idx) {
@@ -374,6 +865,26 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, purge, msgq);
 
+#ifdef CONFIG_MSGQ_LOCKLESS
+	if (is_lockless(msgq)) {
+		/* Drop whatever can be received, and fail blocked writers
+		 * as for a regular queue.  Messages sent concurrently may
+		 * survive.
+		 */
+		while (ring_xfer(msgq, NULL, msgq->max_msgs, false) != 0U) {
+		}
+
+		while ((pending_thread =
+			z_unpend_first_thread(&msgq->lockless.put_wait_q)) != NULL) {
+			arch_thread_return_value_set(pending_thread, -ENOMSG);
+			z_ready_thread(pending_thread);
+		}
+
+		z_reschedule(&msgq->lock, key);
+		return;
+	}
+#endif
+
 	/* wake up any threads that are waiting to write */
 	while ((pending_thread = z_unpend_first_thread(&msgq->wait_q)) != NULL) {
 		arch_thread_return_value_set(pending_thread, -ENOMSG);
@@ -50,6 +50,9 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0U;
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+	mutex->contention = (struct k_obj_contention){ 0 };
+#endif
 
 	z_waitq_init(&mutex->wait_q);
 
@@ -92,11 +95,69 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_KERNEL_ADAPTIVE_SPIN
+/* An owner running on another CPU is likely to unlock sooner than it
+ * takes to pend and be woken up again, so spin, without the lock, as
+ * long as that stays true.  There is no point spinning behind threads
+ * already pending: unlocking hands the mutex over to them directly.
+ * The spin never outlasts @a timeout, which is left with the time
+ * still to wait.
+ *
+ * Called and returns with the lock held.  Returns true if the mutex
+ * is free.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key,
+		       k_timeout_t *timeout)
+{
+	struct k_thread *owner = mutex->owner;
+	int64_t end = sys_clock_timeout_end_calc(*timeout);
+	uint32_t max_cycles = UINT32_MAX;
+	uint32_t start;
+
+	if ((z_waitq_head(&mutex->wait_q) != NULL) ||
+	    !z_is_thread_running(owner)) {
+		return false;
+	}
+
+	if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		max_cycles = MIN(k_ticks_to_cyc_floor64(MAX(end - sys_clock_tick_get(), 0)),
+				 UINT32_MAX);
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_KERNEL_ADAPTIVE_SPIN_LIMIT; i++) {
+		if ((*(volatile uint32_t *)&mutex->lock_count == 0U) ||
+		    (*(struct k_thread *volatile *)&mutex->owner != owner) ||
+		    !z_is_thread_running(owner) ||
+		    (k_cycle_get_32() - start >= max_cycles)) {
+			break;
+		}
+
+		arch_spin_relax();
+	}
+
+	*key = k_spin_lock(&lock);
+
+	if (mutex->lock_count == 0U) {
+		return true;
+	}
+
+	if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		*timeout = K_TICKS(MAX(end - sys_clock_tick_get(), 0));
+	}
+
+	return false;
+}
+#endif
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
 	k_spinlock_key_t key;
 	bool resched = false;
+	bool available;
 
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
@@ -104,7 +165,21 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+	available = (mutex->lock_count == 0U) || (mutex->owner == _current);
+
+	if (unlikely(!available)) {
+		Z_CONTENTION_INC(mutex, contended);
+
+#ifdef CONFIG_KERNEL_ADAPTIVE_SPIN
+		if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+		    mutex_spin(mutex, &key, &timeout)) {
+			Z_CONTENTION_INC(mutex, spin_acquired);
+			available = true;
+		}
+#endif
+	}
+
+	if (likely(available)) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
 					_current->base.prio :
@@ -143,6 +218,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
+	Z_CONTENTION_INC(mutex, blocked);
+
 	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
 
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
@@ -281,3 +358,14 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 }
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
+
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+void k_mutex_contention_get(struct k_mutex *mutex,
+			    struct k_obj_contention *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = mutex->contention;
+	k_spin_unlock(&lock, key);
+}
+#endif
@@ -39,6 +39,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0U;
 	pipe->read_index = 0U;
 	pipe->write_index = 0U;
+	pipe->put_claimed = 0U;
+	pipe->get_claimed = 0U;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -105,6 +107,9 @@ void z_impl_k_pipe_flush(struct k_pipe *pipe)
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	/* Claimed data is flushed with the rest */
+	pipe->get_claimed = 0U;
+
 	(void) pipe_get_internal(key, pipe, NULL, (size_t) -1, &bytes_read, 0U,
 				 K_NO_WAIT);
 
@@ -129,6 +134,9 @@ void z_impl_k_pipe_buffer_flush(struct k_pipe *pipe)
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	/* Claimed data is flushed with the rest */
+	pipe->get_claimed = 0U;
+
 	if (pipe->buffer != NULL) {
 		(void) pipe_get_internal(key, pipe, NULL, pipe->size,
 					 &bytes_read, 0U, K_NO_WAIT);
@@ -176,6 +184,8 @@ int k_pipe_cleanup(struct k_pipe *pipe)
 		pipe->bytes_used = 0U;
 		pipe->read_index = 0U;
 		pipe->write_index = 0U;
+		pipe->put_claimed = 0U;
+		pipe->get_claimed = 0U;
 		pipe->flags &= ~K_PIPE_FLAG_ALLOC;
 	}
 
@@ -369,6 +379,73 @@ static size_t pipe_write(struct k_pipe *pipe, sys_dlist_t *src_list,
 	return num_bytes_written;
 }
 
+/**
+ * @brief Refill the pipe buffer from the waiting writer(s)
+ */
+static void pipe_refill(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	sys_dlist_t         src_list;
+	sys_dlist_t         pipe_list;
+
+	/* Writers wait for the claimed space to be committed */
+	if ((pipe->bytes_used == pipe->size) || (pipe->put_claimed != 0U) ||
+	    (z_waitq_head(&pipe->wait_q.writers) == NULL)) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&pipe_list);
+
+	(void) pipe_waiter_list_populate(&src_list,
+					 &pipe->wait_q.writers,
+					 pipe->size - pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->write_index,
+					 pipe->read_index);
+
+	(void) pipe_write(pipe, &src_list, &pipe_list, reschedule);
+}
+
+/**
+ * @brief Serve the waiting reader(s) from the pipe buffer
+ */
+static void pipe_drain(struct k_pipe *pipe, bool *reschedule)
+{
+	struct _pipe_desc   pipe_desc[2];
+	sys_dlist_t         src_list;
+	sys_dlist_t         dest_list;
+	size_t              num_bytes_read;
+
+	if ((pipe->bytes_used == 0U) ||
+	    (z_waitq_head(&pipe->wait_q.readers) == NULL)) {
+		return;
+	}
+
+	sys_dlist_init(&src_list);
+	sys_dlist_init(&dest_list);
+
+	(void) pipe_waiter_list_populate(&dest_list,
+					 &pipe->wait_q.readers,
+					 pipe->bytes_used);
+
+	(void) pipe_buffer_list_populate(&src_list, pipe_desc,
+					 pipe->buffer, pipe->size,
+					 pipe->read_index,
+					 pipe->write_index);
+
+	/* Readers are threads: pipe_write() leaves the buffer alone */
+	num_bytes_read = pipe_write(pipe, &src_list, &dest_list, reschedule);
+
+	pipe->bytes_used -= num_bytes_read;
+	pipe->read_index += num_bytes_read;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+}
+
 int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		     size_t *bytes_written, size_t min_xfer,
 		      k_timeout_t timeout)
@@ -398,6 +475,17 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if (pipe->put_claimed != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+
+		*bytes_written = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout,
+					       -EBUSY);
+
+		return -EBUSY;
+	}
+
 	/*
 	 * First, write to any waiting readers, if any exist.
 	 * Second, write to the pipe buffer, if it exists.
@@ -542,6 +630,8 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 	 * 3. Refill the pipe buffer from the waiting writer(s).
 	 */
 
+	__ASSERT(pipe->get_claimed == 0U, "pipe data is claimed");
+
 	sys_dlist_init(&src_list);
 
 	if (pipe->bytes_used != 0) {
@@ -617,29 +707,12 @@ static int pipe_get_internal(k_spinlock_key_t key, struct k_pipe *pipe,
 		src_desc = (struct _pipe_desc *)sys_dlist_get(&src_list);
 	}
 
-	if (pipe->bytes_used != pipe->size) {
-		sys_dlist_t         pipe_list;
-
-		/*
-		 * The pipe is not full. If there are any waiting writers,
-		 * refill the pipe.
-		 */
-
-		sys_dlist_init(&src_list);
-		sys_dlist_init(&pipe_list);
-
-		(void) pipe_waiter_list_populate(&src_list,
-						 &pipe->wait_q.writers,
-						 pipe->size - pipe->bytes_used);
-
-		(void) pipe_buffer_list_populate(&pipe_list, pipe_desc,
-						 pipe->buffer, pipe->size,
-						 pipe->write_index,
-						 pipe->read_index);
+	/*
+	 * If the pipe is not full and there are any waiting writers,
+	 * refill the pipe.
+	 */
 
-		(void) pipe_write(pipe, &src_list,
-				  &pipe_list, &reschedule_needed);
-	}
+	pipe_refill(pipe, &reschedule_needed);
 
 	/*
 	 * The immediate success conditions below are backwards
@@ -705,6 +778,17 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if (pipe->get_claimed != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+
+		*bytes_read = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout,
+					       -EBUSY);
+
+		return -EBUSY;
+	}
+
 	int ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
 				    min_xfer, timeout);
 
@@ -801,3 +885,215 @@ size_t z_vrfy_k_pipe_write_avail(struct k_pipe *pipe)
 }
 #include <syscalls/k_pipe_write_avail_mrsh.c>
 #endif
+
+size_t k_pipe_put_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t start;
+	size_t claimed;
+
+	/* Claimed space follows whatever is already claimed */
+	start = pipe->write_index + pipe->put_claimed;
+	if (start >= pipe->size) {
+		start -= pipe->size;
+	}
+
+	claimed = MIN(size, pipe->size - pipe->bytes_used - pipe->put_claimed);
+	claimed = MIN(claimed, pipe->size - start);
+
+	pipe->put_claimed += claimed;
+	*data = (pipe->buffer != NULL) ? &pipe->buffer[start] : NULL;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_put_finish(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool reschedule_needed = false;
+
+	CHECKIF(size > pipe->put_claimed) {
+		pipe->put_claimed = 0U;
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0U;
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index >= pipe->size) {
+		pipe->write_index -= pipe->size;
+	}
+
+	/* Readers only pend on an empty buffer, serve them first */
+	pipe_drain(pipe, &reschedule_needed);
+
+	if ((pipe->bytes_used != 0U) && (size != 0U)) {
+		handle_poll_events(pipe);
+	}
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+size_t k_pipe_get_claim(struct k_pipe *pipe, unsigned char **data,
+			size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	size_t start;
+	size_t claimed;
+
+	/* Claimed data follows whatever is already claimed */
+	start = pipe->read_index + pipe->get_claimed;
+	if (start >= pipe->size) {
+		start -= pipe->size;
+	}
+
+	claimed = MIN(size, pipe->bytes_used - pipe->get_claimed);
+	claimed = MIN(claimed, pipe->size - start);
+
+	pipe->get_claimed += claimed;
+	*data = (pipe->buffer != NULL) ? &pipe->buffer[start] : NULL;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return claimed;
+}
+
+int k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+	bool reschedule_needed = false;
+
+	CHECKIF(size > pipe->get_claimed) {
+		pipe->get_claimed = 0U;
+		k_spin_unlock(&pipe->lock, key);
+
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0U;
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index >= pipe->size) {
+		pipe->read_index -= pipe->size;
+	}
+
+	pipe_refill(pipe, &reschedule_needed);
+
+	if (reschedule_needed) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+typedef int (*pipe_iov_op_t)(struct k_pipe *pipe, void *data, size_t bytes,
+			     size_t *bytes_xferred, size_t min_xfer,
+			     k_timeout_t timeout);
+
+/**
+ * @brief Transfer segments one after the other, each straight to or from
+ *        the pipe
+ *
+ * Each segment takes the pipe lock on its own, so the vector as a whole is
+ * not transferred atomically. Only the segments carrying what is still owed
+ * of @a min_xfer may block, within what is left of the overall timeout.
+ * Beyond that, segments are transferred as far as they go without waiting.
+ */
+static int pipe_iov_xfer(pipe_iov_op_t op, struct k_pipe *pipe,
+			 const struct k_pipe_iovec *iov, size_t iovcnt,
+			 size_t *bytes_xferred, size_t min_xfer,
+			 k_timeout_t timeout)
+{
+	int64_t end = sys_clock_timeout_end_calc(timeout);
+	size_t total = 0U;
+	size_t done = 0U;
+	int ret;
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		total += iov[i].len;
+	}
+
+	CHECKIF((min_xfer > total) || bytes_xferred == NULL) {
+		return -EINVAL;
+	}
+
+	for (size_t i = 0; i < iovcnt; i++) {
+		size_t seg_min = MIN(iov[i].len, min_xfer - MIN(min_xfer, done));
+		k_timeout_t seg_timeout = K_NO_WAIT;
+		size_t seg_done = 0U;
+
+		if (iov[i].len == 0U) {
+			continue;
+		}
+
+		if ((seg_min > 0U) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			if (K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+				seg_timeout = K_FOREVER;
+			} else {
+				seg_timeout = K_TICKS(MAX(end - sys_clock_tick_get(), 0));
+			}
+		} else {
+			seg_min = 0U;
+		}
+
+		ret = op(pipe, iov[i].base, iov[i].len, &seg_done, seg_min,
+			 seg_timeout);
+
+		done += seg_done;
+
+		/* Short transfers end with -EIO or -EAGAIN, anything else is
+		 * the pipe refusing the segment, such as while it is claimed.
+		 */
+		if ((ret != 0) && (ret != -EIO) && (ret != -EAGAIN)) {
+			*bytes_xferred = done;
+			return ret;
+		}
+
+		if (seg_done < iov[i].len) {
+			break;
+		}
+	}
+
+	*bytes_xferred = done;
+
+	if (done >= min_xfer) {
+		return 0;
+	}
+
+	return K_TIMEOUT_EQ(timeout, K_NO_WAIT) ? -EIO : -EAGAIN;
+}
+
+int k_pipe_put_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_written, size_t min_xfer,
+		   k_timeout_t timeout)
+{
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	return pipe_iov_xfer(z_impl_k_pipe_put, pipe, iov, iovcnt,
+			     bytes_written, min_xfer, timeout);
+}
+
+int k_pipe_get_iov(struct k_pipe *pipe, const struct k_pipe_iovec *iov,
+		   size_t iovcnt, size_t *bytes_read, size_t min_xfer,
+		   k_timeout_t timeout)
+{
+	__ASSERT(((arch_is_in_isr() == false) ||
+		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
+
+	return pipe_iov_xfer(z_impl_k_pipe_get, pipe, iov, iovcnt,
+			     bytes_read, min_xfer, timeout);
+}
@@ -34,10 +34,11 @@
  */
 static struct k_spinlock lock;
 
-enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED };
+enum POLL_MODE { MODE_NONE, MODE_POLL, MODE_TRIGGERED, MODE_SET };
 
 static int signal_poller(struct k_poll_event *event, uint32_t state);
 static int signal_triggered_work(struct k_poll_event *event, uint32_t status);
+static void signal_poll_set(struct k_poll_event *event, uint32_t state);
 
 void k_poll_event_init(struct k_poll_event *event, uint32_t type,
 		       int mode, void *obj)
@@ -108,22 +109,32 @@ static struct k_thread *poller_thread(struct z_poller *p)
 	return p ? CONTAINER_OF(p, struct k_thread, poller) : NULL;
 }
 
+/* Only threads in k_poll() have a priority: other pollers, i.e. triggered
+ * work items and poll sets, queue up behind them.
+ */
+static inline bool poller_has_prio(struct z_poller *poller)
+{
+	return poller->mode == MODE_POLL;
+}
+
 static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 			     struct z_poller *poller)
 {
 	struct k_poll_event *pending;
 
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if ((pending == NULL) ||
-		(z_sched_prio_cmp(poller_thread(pending->poller),
-							   poller_thread(poller)) > 0)) {
+	if ((pending == NULL) || !poller_has_prio(poller) ||
+		(poller_has_prio(pending->poller) &&
+		 z_sched_prio_cmp(poller_thread(pending->poller),
+				  poller_thread(poller)) > 0)) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (z_sched_prio_cmp(poller_thread(poller),
-					poller_thread(pending->poller)) > 0) {
+		if (!poller_has_prio(pending->poller) ||
+		    z_sched_prio_cmp(poller_thread(poller),
+				     poller_thread(pending->poller)) > 0) {
 			sys_dlist_insert(&pending->_node, &event->_node);
 			return;
 		}
@@ -151,6 +162,8 @@ static inline void register_event(struct k_poll_event *event,
 		break;
 	case K_POLL_TYPE_MSGQ_DATA_AVAILABLE:
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
+		__ASSERT((event->msgq->flags & K_MSGQ_FLAG_LOCKLESS) == 0U,
+			 "lock-free message queues can't be polled\n");
 		add_event(&event->msgq->poll_events, event, poller);
 		break;
 #ifdef CONFIG_PIPES
@@ -447,7 +460,11 @@ static int signal_poll_event(struct k_poll_event *event, uint32_t state)
 	int retcode = 0;
 
 	if (poller != NULL) {
-		if (poller->mode == MODE_POLL) {
+		if (poller->mode == MODE_SET) {
+			/* Set events stay bound to their poller */
+			signal_poll_set(event, state);
+			return 0;
+		} else if (poller->mode == MODE_POLL) {
 			retcode = signal_poller(event, state);
 		} else if (poller->mode == MODE_TRIGGERED) {
 			retcode = signal_triggered_work(event, state);
@@ -813,3 +830,173 @@ int k_work_poll_cancel(struct k_work_poll *work)
 
 	return retval;
 }
+
+/* Called from the signaling object's context, like signal_poller(): the
+ * event has just been taken off the object's list and now goes to the
+ * set's ready list.
+ */
+static void signal_poll_set(struct k_poll_event *event, uint32_t state)
+{
+	struct k_poll_set *set = CONTAINER_OF(event->poller, struct k_poll_set,
+					      poller);
+	struct k_thread *thread;
+
+	/* Whatever was reported last time is stale by now */
+	event->state = state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = z_unpend_first_thread(&set->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+	sys_dlist_init(&set->ready);
+	z_waitq_init(&set->wait_q);
+}
+
+int k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	uint32_t state;
+
+	if (event->poller != NULL) {
+		k_spin_unlock(&lock, key);
+		return -EBUSY;
+	}
+
+	/* Statically defined sets get their mode here */
+	set->poller.is_polling = true;
+	set->poller.mode = MODE_SET;
+
+	event->state = K_POLL_STATE_NOT_READY;
+	if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		signal_poll_set(event, state);
+		z_reschedule(&lock, key);
+		return 0;
+	}
+
+	register_event(event, &set->poller);
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+int k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (event->poller != &set->poller) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	/* On either the object's list or the ready list */
+	if (sys_dnode_is_linked(&event->_node)) {
+		sys_dlist_remove(&event->_node);
+	}
+	event->poller = NULL;
+	event->state = K_POLL_STATE_NOT_READY;
+
+	k_spin_unlock(&lock, key);
+
+	return 0;
+}
+
+/* Goes through the ready list only.  Events still ready are reported and
+ * stay there, moved to the back so that events beyond max_events get
+ * their turn next time; the others go back to their object's list.
+ * must be called with the lock held
+ */
+static int poll_set_collect(struct k_poll_set *set,
+			    struct k_poll_event **events, int max_events)
+{
+	struct k_poll_event *event, *next;
+	int num_ready = 0;
+
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&set->ready, event, next, _node) {
+		uint32_t state = event->state & K_POLL_STATE_CANCELLED;
+		uint32_t met;
+
+		if (num_ready == max_events) {
+			break;
+		}
+
+		if (is_condition_met(event, &met)) {
+			state |= met;
+		}
+
+		event->state = state;
+		if (state != K_POLL_STATE_NOT_READY) {
+			events[num_ready++] = event;
+		}
+
+		if ((state & ~K_POLL_STATE_CANCELLED) == 0U) {
+			sys_dlist_remove(&event->_node);
+			register_event(event, &set->poller);
+		}
+	}
+
+	for (int i = 0; i < num_ready; i++) {
+		if ((events[i]->state & ~K_POLL_STATE_CANCELLED) != 0U) {
+			sys_dlist_remove(&events[i]->_node);
+			sys_dlist_append(&set->ready, &events[i]->_node);
+		}
+	}
+
+	return num_ready;
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, k_timeout_t timeout)
+{
+	int64_t end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "");
+
+	if (max_events <= 0) {
+		return -EINVAL;
+	}
+
+	end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX : end;
+
+	while (true) {
+		int64_t remaining;
+
+		key = k_spin_lock(&lock);
+
+		ret = poll_set_collect(set, events, max_events);
+		if (ret > 0) {
+			break;
+		}
+
+		remaining = end - sys_clock_tick_get();
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || remaining <= 0) {
+			ret = -EAGAIN;
+			break;
+		}
+
+		/* Readiness can be gone again once we run, e.g. when
+		 * someone else took the semaphore: wait for the rest of
+		 * the period then.
+		 */
+		ret = z_pend_curr(&lock, key, &set->wait_q,
+				  K_TIMEOUT_EQ(timeout, K_FOREVER) ?
+				  K_FOREVER : K_TICKS(remaining));
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
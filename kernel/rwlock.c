@@ -0,0 +1,499 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file @brief reader/writer lock kernel services
+ *
+ * Readers and writers take and release an uncontended lock with a single
+ * atomic operation on the lock state.  As soon as a thread waits for the
+ * lock, the waiters flag is set in the state, which sends every locker and
+ * unlocker to the slow path, under a spinlock, until the waiters are gone.
+ *
+ * While the waiters flag is set, the state only changes under the spinlock,
+ * or when a reader holding the lock releases it.  The thread releasing the
+ * lock last hands it over to the waiting threads: the first waiting writer,
+ * or all the waiting readers.
+ *
+ * The writer holding the lock inherits the priority of the waiting threads,
+ * as the owner of a mutex does, with the same nesting rules.  Readers are not
+ * tracked, so readers holding the lock do not.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+#include <zephyr/toolchain.h>
+#include <ksched.h>
+#include <zephyr/wait_q.h>
+#include <errno.h>
+#include <zephyr/syscall_handler.h>
+#include <zephyr/sys/check.h>
+
+/* Global for the same reason as the mutex one: priority inheritance
+ * changes the priority of the writer thread.
+ */
+static struct k_spinlock lock;
+
+int z_impl_k_rwlock_init(struct k_rwlock *rwlock, uint32_t flags)
+{
+	CHECKIF((flags & ~K_RWLOCK_PREFER_WRITER) != 0U) {
+		SYS_PORT_TRACING_OBJ_INIT(k_rwlock, rwlock, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	atomic_set(&rwlock->state, 0);
+	rwlock->writer = NULL;
+	rwlock->writer_orig_prio = K_LOWEST_APPLICATION_THREAD_PRIO;
+	rwlock->flags = flags;
+
+	z_waitq_init(&rwlock->rd_wait_q);
+	z_waitq_init(&rwlock->wr_wait_q);
+
+	z_object_init(rwlock);
+
+	SYS_PORT_TRACING_OBJ_INIT(k_rwlock, rwlock, 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_init(struct k_rwlock *rwlock, uint32_t flags)
+{
+	Z_OOPS(Z_SYSCALL_OBJ_INIT(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_init(rwlock, flags);
+}
+#include <syscalls/k_rwlock_init_mrsh.c>
+#endif
+
+static int32_t new_prio_for_inheritance(int32_t target, int32_t limit)
+{
+	int new_prio = z_is_prio_higher(target, limit) ? target : limit;
+
+	new_prio = z_get_new_prio_with_ceiling(new_prio);
+
+	return new_prio;
+}
+
+/* Raise the priority of the writer holding the lock to the one of the
+ * current thread, about to wait for it.
+ */
+static void writer_prio_raise(struct k_rwlock *rwlock)
+{
+	struct k_thread *writer = rwlock->writer;
+	int new_prio;
+
+	if (writer == NULL) {
+		return;
+	}
+
+	new_prio = new_prio_for_inheritance(_current->base.prio, writer->base.prio);
+	if (z_is_prio_higher(new_prio, writer->base.prio)) {
+		(void)z_set_prio(writer, new_prio);
+	}
+}
+
+/* Set the priority of the writer holding the lock back to the highest of
+ * its own and the ones of the threads still waiting, after a waiter timed
+ * out.
+ */
+static bool writer_prio_update(struct k_rwlock *rwlock)
+{
+	struct k_thread *writer = rwlock->writer;
+	struct k_thread *waiter;
+	int new_prio;
+
+	if (writer == NULL) {
+		return false;
+	}
+
+	new_prio = rwlock->writer_orig_prio;
+
+	waiter = z_waitq_head(&rwlock->rd_wait_q);
+	if (waiter != NULL) {
+		new_prio = new_prio_for_inheritance(waiter->base.prio, new_prio);
+	}
+
+	waiter = z_waitq_head(&rwlock->wr_wait_q);
+	if (waiter != NULL) {
+		new_prio = new_prio_for_inheritance(waiter->base.prio, new_prio);
+	}
+
+	if (writer->base.prio != new_prio) {
+		return z_set_prio(writer, new_prio);
+	}
+
+	return false;
+}
+
+/* Take the lock if none of the busy bits is set in its state, adding taken
+ * to it.
+ */
+static inline bool try_lock(struct k_rwlock *rwlock, atomic_val_t busy,
+			    atomic_val_t taken)
+{
+	atomic_val_t state = atomic_get(&rwlock->state);
+
+	while ((state & busy) == 0) {
+		if (atomic_cas(&rwlock->state, state, state + taken)) {
+			return true;
+		}
+
+		state = atomic_get(&rwlock->state);
+	}
+
+	return false;
+}
+
+/* Take the lock, or set the waiters flag so that the thread releasing it
+ * goes through the slow path and wakes the current thread up.  Called with
+ * the spinlock held.  Returns -EAGAIN if the current thread must wait.
+ */
+static int lock_or_flag(struct k_rwlock *rwlock, atomic_val_t busy,
+			atomic_val_t taken)
+{
+	atomic_val_t state;
+
+	do {
+		if (try_lock(rwlock, busy, taken)) {
+			return 0;
+		}
+
+		state = atomic_get(&rwlock->state);
+	} while (((state & busy) == 0) ||
+		 (((state & Z_RWLOCK_WAITERS) == 0) &&
+		  !atomic_cas(&rwlock->state, state, state | Z_RWLOCK_WAITERS)));
+
+	return -EAGAIN;
+}
+
+static void wake_readers(struct k_rwlock *rwlock)
+{
+	struct k_thread *thread;
+
+	/* Account for each reader before it can run and release the lock. */
+	while ((thread = z_unpend_first_thread(&rwlock->rd_wait_q)) != NULL) {
+		__ASSERT_NO_MSG((atomic_get(&rwlock->state) & Z_RWLOCK_READERS_MASK) <
+				Z_RWLOCK_READERS_MASK);
+
+		atomic_inc(&rwlock->state);
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+}
+
+static void waiters_update(struct k_rwlock *rwlock)
+{
+	if ((z_waitq_head(&rwlock->rd_wait_q) == NULL) &&
+	    (z_waitq_head(&rwlock->wr_wait_q) == NULL)) {
+		atomic_and(&rwlock->state, ~Z_RWLOCK_WAITERS);
+	}
+}
+
+/* Hand the lock over to the waiting threads.  Called with the spinlock held
+ * and the lock state only holding the waiters flag, which keeps it from
+ * changing.
+ */
+static void handoff(struct k_rwlock *rwlock, k_spinlock_key_t key)
+{
+	struct k_thread *writer = NULL;
+
+	if (((rwlock->flags & K_RWLOCK_PREFER_WRITER) != 0U) ||
+	    (z_waitq_head(&rwlock->rd_wait_q) == NULL)) {
+		writer = z_unpend_first_thread(&rwlock->wr_wait_q);
+	}
+
+	if (writer != NULL) {
+		/*
+		 * The new writer is already of higher or equal priority than
+		 * the other waiting writers, since the wait queue is priority
+		 * based.
+		 */
+		rwlock->writer = writer;
+		rwlock->writer_orig_prio = writer->base.prio;
+		atomic_or(&rwlock->state, Z_RWLOCK_WRITER);
+		arch_thread_return_value_set(writer, 0);
+		z_ready_thread(writer);
+	} else {
+		wake_readers(rwlock);
+	}
+
+	waiters_update(rwlock);
+
+	z_reschedule(&lock, key);
+}
+
+int z_impl_k_rwlock_read_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	atomic_val_t busy = Z_RWLOCK_WRITER;
+	bool resched;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_rwlock, read_lock, rwlock, timeout);
+
+	if (likely(try_lock(rwlock, Z_RWLOCK_WRITER | Z_RWLOCK_WAITERS, 1))) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_lock, rwlock, timeout, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (unlikely(rwlock->writer == _current)) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_lock, rwlock, timeout, -EDEADLK);
+
+		return -EDEADLK;
+	}
+
+	/* Readers may only pass waiting writers in reader preference mode. */
+	if (((rwlock->flags & K_RWLOCK_PREFER_WRITER) != 0U) &&
+	    (z_waitq_head(&rwlock->wr_wait_q) != NULL)) {
+		busy = ~(atomic_val_t)0;
+	}
+
+	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		ret = try_lock(rwlock, busy, 1) ? 0 : -EBUSY;
+	} else {
+		ret = lock_or_flag(rwlock, busy, 1);
+	}
+
+	if (ret != -EAGAIN) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_lock, rwlock, timeout, ret);
+
+		return ret;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_rwlock, read_lock, rwlock, timeout);
+
+	writer_prio_raise(rwlock);
+
+	ret = z_pend_curr(&lock, key, &rwlock->rd_wait_q, timeout);
+	if (ret == 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_lock, rwlock, timeout, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	resched = writer_prio_update(rwlock);
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_lock, rwlock, timeout, -EAGAIN);
+
+	return -EAGAIN;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_lock(struct k_rwlock *rwlock,
+					    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_lock(rwlock, timeout);
+}
+#include <syscalls/k_rwlock_read_lock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key;
+	atomic_val_t state;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_rwlock, read_unlock, rwlock);
+
+	do {
+		state = atomic_get(&rwlock->state);
+
+		CHECKIF((state & Z_RWLOCK_READERS_MASK) == 0) {
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_unlock, rwlock, -EINVAL);
+
+			return -EINVAL;
+		}
+	} while (!atomic_cas(&rwlock->state, state, state - 1));
+
+	if (likely(state != (Z_RWLOCK_WAITERS | 1))) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_unlock, rwlock, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Another reader may have taken the lock in the meantime. */
+	if (atomic_get(&rwlock->state) == Z_RWLOCK_WAITERS) {
+		handoff(rwlock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, read_unlock, rwlock, 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_read_unlock(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_read_unlock(rwlock);
+}
+#include <syscalls/k_rwlock_read_unlock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_write_lock(struct k_rwlock *rwlock, k_timeout_t timeout)
+{
+	const atomic_val_t busy = Z_RWLOCK_READERS_MASK | Z_RWLOCK_WRITER;
+	k_spinlock_key_t key;
+	bool resched;
+	int ret;
+
+	__ASSERT(!arch_is_in_isr(), "rwlocks cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_rwlock, write_lock, rwlock, timeout);
+
+	if (likely(atomic_cas(&rwlock->state, 0, Z_RWLOCK_WRITER))) {
+		rwlock->writer = _current;
+		rwlock->writer_orig_prio = _current->base.prio;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (unlikely(rwlock->writer == _current)) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, -EDEADLK);
+
+		return -EDEADLK;
+	}
+
+	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
+		ret = try_lock(rwlock, busy, Z_RWLOCK_WRITER) ? 0 : -EBUSY;
+	} else {
+		ret = lock_or_flag(rwlock, busy, Z_RWLOCK_WRITER);
+	}
+
+	if (ret == 0) {
+		rwlock->writer = _current;
+		rwlock->writer_orig_prio = _current->base.prio;
+	}
+
+	if (ret != -EAGAIN) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, ret);
+
+		return ret;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_rwlock, write_lock, rwlock, timeout);
+
+	writer_prio_raise(rwlock);
+
+	ret = z_pend_curr(&lock, key, &rwlock->wr_wait_q, timeout);
+	if (ret == 0) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	resched = writer_prio_update(rwlock);
+
+	/* Readers may have been waiting for this writer only. */
+	if (((rwlock->flags & K_RWLOCK_PREFER_WRITER) != 0U) &&
+	    (z_waitq_head(&rwlock->wr_wait_q) == NULL) &&
+	    (z_waitq_head(&rwlock->rd_wait_q) != NULL) &&
+	    ((atomic_get(&rwlock->state) & Z_RWLOCK_WRITER) == 0)) {
+		wake_readers(rwlock);
+		waiters_update(rwlock);
+		resched = true;
+	}
+
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_lock, rwlock, timeout, -EAGAIN);
+
+	return -EAGAIN;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_lock(struct k_rwlock *rwlock,
+					     k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_lock(rwlock, timeout);
+}
+#include <syscalls/k_rwlock_write_lock_mrsh.c>
+#endif
+
+int z_impl_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	k_spinlock_key_t key;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_rwlock, write_unlock, rwlock);
+
+	CHECKIF(rwlock->writer != _current) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_unlock, rwlock, -EPERM);
+
+		return -EPERM;
+	}
+
+	rwlock->writer = NULL;
+
+	if (likely(atomic_cas(&rwlock->state, Z_RWLOCK_WRITER, 0))) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_unlock, rwlock, 0);
+
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+	/* Drop the priority inherited from the waiters, if any */
+	if (_current->base.prio != rwlock->writer_orig_prio) {
+		(void)z_set_prio(_current, rwlock->writer_orig_prio);
+	}
+
+	/* The waiters may have timed out in the meantime. */
+	if (atomic_cas(&rwlock->state, Z_RWLOCK_WRITER, 0)) {
+		z_reschedule(&lock, key);
+	} else {
+		atomic_set(&rwlock->state, Z_RWLOCK_WAITERS);
+		handoff(rwlock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_rwlock, write_unlock, rwlock, 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_rwlock_write_unlock(struct k_rwlock *rwlock)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(rwlock, K_OBJ_RWLOCK));
+	return z_impl_k_rwlock_write_unlock(rwlock);
+}
+#include <syscalls/k_rwlock_write_unlock_mrsh.c>
+#endif
@@ -276,17 +276,28 @@ static void signal_pending_ipi(void)
 {
 	/* Synchronization note: you might think we need to lock these
 	 * two steps, but an IPI is idempotent.  It's OK if we do it
-	 * twice.  All we require is that if a CPU sees the flag true,
-	 * it is guaranteed to send the IPI, and if a core sets
+	 * twice.  All we require is that if a CPU sees a bit set, it
+	 * is guaranteed to send the IPI, and if a core sets a bit in
 	 * pending_ipi, the IPI will be sent the next time through
 	 * this code.
 	 */
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	if (arch_num_cpus() > 1) {
-		if (_kernel.pending_ipi) {
-			_kernel.pending_ipi = false;
-			arch_sched_ipi();
+	unsigned int num_cpus = arch_num_cpus();
+
+	if (num_cpus > 1) {
+		uint32_t cpu_bitmap = (uint32_t)atomic_clear(&_kernel.pending_ipi);
+
+		if (cpu_bitmap == 0U) {
+			return;
 		}
+
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+		if (cpu_bitmap != BIT_MASK(num_cpus)) {
+			arch_sched_directed_ipi(cpu_bitmap);
+			return;
+		}
+#endif
+		arch_sched_ipi();
 	}
 #endif
 }
@@ -400,13 +411,64 @@ static void move_thread_to_end_of_prio_q(struct k_thread *thread)
 
 static void flag_ipi(void)
 {
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+	unsigned int num_cpus = arch_num_cpus();
+
+	if (num_cpus > 1) {
+		atomic_or(&_kernel.pending_ipi, BIT_MASK(num_cpus));
+	}
+#endif
+}
+
+/* Like flag_ipi(), but only the CPUs in @cpu_bitmap need to reschedule */
+static void flag_ipi_cpus(uint32_t cpu_bitmap)
+{
 #if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
 	if (arch_num_cpus() > 1) {
-		_kernel.pending_ipi = true;
+		atomic_or(&_kernel.pending_ipi, cpu_bitmap);
 	}
+#else
+	ARG_UNUSED(cpu_bitmap);
 #endif
 }
 
+/* The other CPUs that would switch to @thread if it became runnable
+ * now: those its CPU mask allows, currently idle or running a thread
+ * of lower priority.  The rest will find it in the run queue the next
+ * time they reschedule on their own, and need not be interrupted.
+ */
+static uint32_t ready_ipi_cpus(struct k_thread *thread)
+{
+	uint32_t cpu_bitmap = 0U;
+
+#ifdef CONFIG_SMP
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (unsigned int i = 0; i < num_cpus; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if ((i == _current_cpu->id) || (curr == NULL)) {
+			continue;
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0) {
+			continue;
+		}
+#endif
+
+		if (z_is_idle_thread_object(curr) ||
+		    (z_sched_prio_cmp(thread, curr) > 0)) {
+			cpu_bitmap |= BIT(i);
+		}
+	}
+#else
+	ARG_UNUSED(thread);
+#endif
+
+	return cpu_bitmap;
+}
+
 #ifdef CONFIG_TIMESLICING
 
 static int slice_ticks = DIV_ROUND_UP(CONFIG_TIMESLICE_SIZE * Z_HZ_ticks, Z_HZ_ms);
@@ -457,11 +519,10 @@ static void slice_timeout(struct _timeout *t)
 	slice_expired[cpu] = true;
 
 	/* We need an IPI if we just handled a timeslice expiration
-	 * for a different CPU.  Ideally this would be able to target
-	 * the specific core, but that's not part of the API yet.
+	 * for a different CPU.
 	 */
 	if (IS_ENABLED(CONFIG_SMP) && cpu != _current_cpu->id) {
-		flag_ipi();
+		flag_ipi_cpus(BIT(cpu));
 	}
 }
 
@@ -611,7 +672,7 @@ static void ready_thread(struct k_thread *thread)
 
 		queue_thread(thread);
 		update_cache(0);
-		flag_ipi();
+		flag_ipi_cpus(ready_ipi_cpus(thread));
 	}
 }
 
@@ -52,6 +52,9 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 
 	sem->count = initial_count;
 	sem->limit = limit;
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+	sem->contention = (struct k_obj_contention){ 0 };
+#endif
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, init, sem, 0);
 
@@ -121,6 +124,58 @@ static inline void z_vrfy_k_sem_give(struct k_sem *sem)
 #include <syscalls/k_sem_give_mrsh.c>
 #endif
 
+#ifdef CONFIG_KERNEL_ADAPTIVE_SPIN
+/* A semaphore has no owner to watch, so this spins for a bounded time
+ * in the hope that another CPU gives it soon, unless other threads are
+ * already pending, in which case they would get it first anyway.  The
+ * spin never outlasts @a timeout, which is left with the time still to
+ * wait.
+ *
+ * Called and returns with the lock held.  Returns true if the
+ * semaphore is available.
+ */
+static bool sem_spin(struct k_sem *sem, k_spinlock_key_t *key,
+		     k_timeout_t *timeout)
+{
+	int64_t end = sys_clock_timeout_end_calc(*timeout);
+	uint32_t max_cycles = UINT32_MAX;
+	uint32_t start;
+
+	if ((arch_num_cpus() == 1U) || (z_waitq_head(&sem->wait_q) != NULL)) {
+		return false;
+	}
+
+	if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		max_cycles = MIN(k_ticks_to_cyc_floor64(MAX(end - sys_clock_tick_get(), 0)),
+				 UINT32_MAX);
+	}
+
+	k_spin_unlock(&lock, *key);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < CONFIG_KERNEL_ADAPTIVE_SPIN_LIMIT; i++) {
+		if ((*(volatile unsigned int *)&sem->count != 0U) ||
+		    (k_cycle_get_32() - start >= max_cycles)) {
+			break;
+		}
+
+		arch_spin_relax();
+	}
+
+	*key = k_spin_lock(&lock);
+
+	if (sem->count > 0U) {
+		return true;
+	}
+
+	if (!K_TIMEOUT_EQ(*timeout, K_FOREVER)) {
+		*timeout = K_TICKS(MAX(end - sys_clock_tick_get(), 0));
+	}
+
+	return false;
+}
+#endif
+
 int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
 	int ret = 0;
@@ -139,14 +194,28 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 		goto out;
 	}
 
+	Z_CONTENTION_INC(sem, contended);
+
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
 		k_spin_unlock(&lock, key);
 		ret = -EBUSY;
 		goto out;
 	}
 
+#ifdef CONFIG_KERNEL_ADAPTIVE_SPIN
+	if (sem_spin(sem, &key, &timeout)) {
+		Z_CONTENTION_INC(sem, spin_acquired);
+		sem->count--;
+		k_spin_unlock(&lock, key);
+		ret = 0;
+		goto out;
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
+	Z_CONTENTION_INC(sem, blocked);
+
 	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
 
 out:
@@ -177,6 +246,16 @@ void z_impl_k_sem_reset(struct k_sem *sem)
 	z_reschedule(&lock, key);
 }
 
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+void k_sem_contention_get(struct k_sem *sem, struct k_obj_contention *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = sem->contention;
+	k_spin_unlock(&lock, key);
+}
+#endif
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 {
@@ -11,11 +11,10 @@
 #include <zephyr/syscall_handler.h>
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/sys_clock.h>
+#include <zephyr/sys/math_extras.h>
 
 static uint64_t curr_tick;
 
-static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
-
 static struct k_spinlock timeout_lock;
 
 #define MAX_WAIT (IS_ENABLED(CONFIG_SYSTEM_CLOCK_SLOPPY_IDLE) \
@@ -36,6 +35,201 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+static int32_t elapsed(void)
+{
+	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
+}
+
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+
+/*
+ * Hierarchical timing wheel.  A queued timeout stores its absolute
+ * expiry tick in dticks and lives in a slot of the lowest level whose
+ * digit is the most significant one in which the expiry differs from
+ * curr_tick.  Timeouts too far out for the top level are parked on an
+ * overflow list.  When curr_tick reaches the start of an occupied
+ * higher-level slot, that slot is "cascaded" into the lower levels, so
+ * every timeout fires out of a level 0 slot at exactly its expiry tick.
+ *
+ * Slots are only ever appended to by z_add_timeout(), and cascades
+ * prepend (entries living in a higher level were always queued before
+ * anything in a lower level with the same expiry), which keeps the
+ * FIFO ordering of equal expiries that the list backend provides.
+ */
+#define WHEEL_BITS   CONFIG_TIMEOUT_WHEEL_SLOT_BITS
+#define WHEEL_SLOTS  BIT(WHEEL_BITS)
+#define WHEEL_MASK   (WHEEL_SLOTS - 1U)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+
+BUILD_ASSERT(WHEEL_BITS * WHEEL_LEVELS < 64);
+
+struct timeout_wheel_level {
+	/* One bit per slot that may be non-empty.  Bits are set when a
+	 * slot is first used (which also initializes its list) and are
+	 * cleared lazily once the slot is found empty, so that removal
+	 * never needs to know where a timeout lives.
+	 */
+	uint64_t occupied;
+	sys_dlist_t slots[WHEEL_SLOTS];
+};
+
+static struct timeout_wheel_level wheel[WHEEL_LEVELS];
+
+static sys_dlist_t wheel_overflow = SYS_DLIST_STATIC_INIT(&wheel_overflow);
+
+static inline uint64_t wheel_expiry(const struct _timeout *t)
+{
+	return (uint64_t)t->dticks;
+}
+
+/* must be locked */
+static void wheel_insert(struct _timeout *to, bool prepend)
+{
+	uint64_t diff = wheel_expiry(to) ^ curr_tick;
+	int level = 0;
+	sys_dlist_t *list;
+
+	if (diff != 0U) {
+		level = (63 - u64_count_leading_zeros(diff)) / WHEEL_BITS;
+	}
+
+	if (level >= WHEEL_LEVELS) {
+		list = &wheel_overflow;
+	} else {
+		unsigned int slot = (wheel_expiry(to) >> (level * WHEEL_BITS)) &
+				    WHEEL_MASK;
+
+		list = &wheel[level].slots[slot];
+		if ((wheel[level].occupied & BIT64(slot)) == 0U) {
+			sys_dlist_init(list);
+			wheel[level].occupied |= BIT64(slot);
+		}
+	}
+
+	if (prepend) {
+		sys_dlist_prepend(list, &to->node);
+	} else {
+		sys_dlist_append(list, &to->node);
+	}
+}
+
+/* Re-files, in order, every timeout of @list that is now due for a
+ * lower level.  must be locked
+ */
+static void wheel_cascade_list(sys_dlist_t *list)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_peek_tail(list)) != NULL) {
+		sys_dlist_remove(node);
+		wheel_insert(CONTAINER_OF(node, struct _timeout, node), true);
+	}
+}
+
+/* Cascades every slot starting at curr_tick.  must be locked */
+static void wheel_cascade(void)
+{
+	if ((curr_tick & (BIT64(WHEEL_LEVELS * WHEEL_BITS) - 1U)) == 0U &&
+	    !sys_dlist_is_empty(&wheel_overflow)) {
+		sys_dlist_t parked = SYS_DLIST_STATIC_INIT(&parked);
+		sys_dnode_t *node;
+
+		while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+			sys_dlist_append(&parked, node);
+		}
+		wheel_cascade_list(&parked);
+	}
+
+	for (int level = WHEEL_LEVELS - 1; level > 0; level--) {
+		unsigned int shift = level * WHEEL_BITS;
+		unsigned int slot = (curr_tick >> shift) & WHEEL_MASK;
+
+		if ((curr_tick & (BIT64(shift) - 1U)) != 0U) {
+			continue;
+		}
+
+		if ((wheel[level].occupied & BIT64(slot)) != 0U) {
+			wheel_cascade_list(&wheel[level].slots[slot]);
+			wheel[level].occupied &= ~BIT64(slot);
+		}
+	}
+}
+
+/* Returns the absolute tick at which the wheel next needs service,
+ * either to expire a timeout or to cascade a slot, or UINT64_MAX if
+ * it is empty.  Because lower levels only ever cover ticks before the
+ * next slot of the level above, the first occupied slot found
+ * walking up from level 0 is the earliest.  must be locked
+ */
+static uint64_t wheel_next_event(void)
+{
+	for (int level = 0; level < WHEEL_LEVELS; level++) {
+		unsigned int shift = level * WHEEL_BITS;
+		unsigned int digit = (curr_tick >> shift) & WHEEL_MASK;
+		uint64_t pending = wheel[level].occupied & ~(BIT64(digit) - 1U);
+
+		while (pending != 0U) {
+			unsigned int slot = u64_count_trailing_zeros(pending);
+
+			if (!sys_dlist_is_empty(&wheel[level].slots[slot])) {
+				uint64_t base = curr_tick &
+					~(BIT64(shift + WHEEL_BITS) - 1U);
+
+				return base | ((uint64_t)slot << shift);
+			}
+
+			wheel[level].occupied &= ~BIT64(slot);
+			pending &= ~BIT64(slot);
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel_overflow)) {
+		unsigned int shift = WHEEL_LEVELS * WHEEL_BITS;
+
+		return ((curr_tick >> shift) + 1U) << shift;
+	}
+
+	return UINT64_MAX;
+}
+
+/* Returns a timeout expiring at curr_tick, if any.  must be locked */
+static struct _timeout *wheel_expired(void)
+{
+	unsigned int slot = curr_tick & WHEEL_MASK;
+	sys_dnode_t *n = NULL;
+
+	if ((wheel[0].occupied & BIT64(slot)) != 0U) {
+		n = sys_dlist_peek_head(&wheel[0].slots[slot]);
+	}
+
+	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	sys_dlist_remove(&t->node);
+}
+
+static int32_t next_timeout(void)
+{
+	uint64_t next = wheel_next_event();
+	int32_t ticks_elapsed = elapsed();
+	int32_t ret;
+
+	if ((next == UINT64_MAX) ||
+	    ((int64_t)(next - curr_tick - ticks_elapsed) > (int64_t)INT_MAX)) {
+		ret = MAX_WAIT;
+	} else {
+		ret = MAX(0, (int64_t)(next - curr_tick) - ticks_elapsed);
+	}
+
+	return ret;
+}
+
+#else /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
+static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,11 +253,6 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
-static int32_t elapsed(void)
-{
-	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
-}
-
 static int32_t next_timeout(void)
 {
 	struct _timeout *to = first();
@@ -80,6 +269,8 @@ static int32_t next_timeout(void)
 	return ret;
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
+
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout)
 {
@@ -95,8 +286,6 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -106,6 +295,18 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		uint64_t prev = wheel_next_event();
+
+		to->dticks = curr_tick + MAX(0, to->dticks);
+		wheel_insert(to, false);
+
+		if (wheel_next_event() < prev) {
+			sys_clock_set_timeout(next_timeout(), false);
+		}
+#else
+		struct _timeout *t;
+
 		for (t = first(); t != NULL; t = next(t)) {
 			if (t->dticks > to->dticks) {
 				t->dticks -= to->dticks;
@@ -122,6 +323,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		if (to == first()) {
 			sys_clock_set_timeout(next_timeout(), false);
 		}
+#endif
 	}
 }
 
@@ -148,12 +350,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	ticks = wheel_expiry(timeout) - curr_tick;
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -208,6 +414,29 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	for (uint64_t ev = wheel_next_event();
+	     (ev != UINT64_MAX) &&
+	     ((int64_t)(ev - curr_tick) <= announce_remaining);
+	     ev = wheel_next_event()) {
+		int dt = ev - curr_tick;
+		struct _timeout *t;
+
+		curr_tick = ev;
+		wheel_cascade();
+
+		t = wheel_expired();
+		if (t != NULL) {
+			t->dticks = 0;
+			remove_timeout(t);
+
+			k_spin_unlock(&timeout_lock, key);
+			t->fn(t);
+			key = k_spin_lock(&timeout_lock);
+		}
+		announce_remaining -= dt;
+	}
+#else
 	struct _timeout *t = first();
 
 	for (t = first();
@@ -228,6 +457,7 @@ void sys_clock_announce(int32_t ticks)
 	if (t != NULL) {
 		t->dticks -= announce_remaining;
 	}
+#endif
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -340,7 +570,44 @@ uint64_t sys_clock_timeout_end_calc(k_timeout_t timeout)
 #ifdef CONFIG_ZTEST
 void z_impl_sys_clock_tick_set(uint64_t tick)
 {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	/* Queued timeouts keep their remaining tick count, as they do
+	 * with the list backend, so shift them and refile everything
+	 * relative to the new tick.
+	 */
+	LOCKED(&timeout_lock) {
+		sys_dlist_t all = SYS_DLIST_STATIC_INIT(&all);
+		sys_dnode_t *node;
+
+		while ((node = sys_dlist_get(&wheel_overflow)) != NULL) {
+			sys_dlist_append(&all, node);
+		}
+
+		for (int level = WHEEL_LEVELS - 1; level >= 0; level--) {
+			for (int slot = 0; slot < WHEEL_SLOTS; slot++) {
+				if ((wheel[level].occupied & BIT64(slot)) == 0U) {
+					continue;
+				}
+				while ((node = sys_dlist_get(&wheel[level].slots[slot])) != NULL) {
+					sys_dlist_append(&all, node);
+				}
+			}
+			wheel[level].occupied = 0U;
+		}
+
+		uint64_t shift = tick - curr_tick;
+
+		curr_tick = tick;
+		while ((node = sys_dlist_get(&all)) != NULL) {
+			struct _timeout *t = CONTAINER_OF(node, struct _timeout, node);
+
+			t->dticks += shift;
+			wheel_insert(t, false);
+		}
+	}
+#else
 	curr_tick = tick;
+#endif
 }
 
 void z_vrfy_sys_clock_tick_set(uint64_t tick)
@@ -219,6 +219,10 @@ void z_sched_thread_usage(struct k_thread *thread,
 
 #ifdef CONFIG_SCHED_THREAD_USAGE_ALL
 	stats->idle_cycles = 0;
+#endif
+#ifdef CONFIG_WORK_QUEUE_STATS
+	stats->work_items = thread->base.usage.work_items;
+	stats->work_wakeups = thread->base.usage.work_wakeups;
 #endif
 	stats->execution_cycles = thread->base.usage.total;
 
@@ -62,6 +62,13 @@ static inline uint32_t flags_get(const uint32_t *flagp)
  */
 static struct k_spinlock lock;
 
+/* Work queue activity counters, kept in the queue thread's usage stats */
+#ifdef CONFIG_WORK_QUEUE_STATS
+#define queue_stat_inc(queue, stat) ((queue)->thread.base.usage.stat++)
+#else
+#define queue_stat_inc(queue, stat) do { } while (false)
+#endif
+
 /* Invoked by work thread */
 static void handle_flush(struct k_work *work)
 {
@@ -229,27 +236,23 @@ static inline bool notify_queue_locked(struct k_work_q *queue)
 	return rv;
 }
 
-/* Submit an work item to a queue if queue state allows new work.
+/* Check whether queue state allows new work.
  *
  * Submission is rejected if no queue is provided, or if the queue is
  * draining and the work isn't being submitted from the queue's
  * thread (chained submission).
  *
  * Invoked with work lock held.
- * Conditionally notifies queue.
  *
  * @param queue the queue to which work should be submitted.  This may
  * be null, in which case the submission will fail.
  *
- * @param work to be submitted
- *
- * @retval 1 if successfully queued
+ * @retval 0 if new work is accepted
  * @retval -EINVAL if no queue is provided
  * @retval -ENODEV if the queue is not started
  * @retval -EBUSY if the submission was rejected (draining, plugged)
  */
-static inline int queue_submit_locked(struct k_work_q *queue,
-				      struct k_work *work)
+static inline int queue_accept_locked(struct k_work_q *queue)
 {
 	if (queue == NULL) {
 		return -EINVAL;
@@ -274,6 +277,31 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
+		ret = 0;
+	}
+
+	return ret;
+}
+
+/* Submit an work item to a queue if queue state allows new work.
+ *
+ * Invoked with work lock held.
+ * Conditionally notifies queue.
+ *
+ * @param queue the queue to which work should be submitted.  This may
+ * be null, in which case the submission will fail.
+ *
+ * @param work to be submitted
+ *
+ * @retval 1 if successfully queued
+ * @retval see queue_accept_locked() otherwise
+ */
+static inline int queue_submit_locked(struct k_work_q *queue,
+				      struct k_work *work)
+{
+	int ret = queue_accept_locked(queue);
+
+	if (ret == 0) {
 		sys_slist_append(&queue->pending, &work->node);
 		ret = 1;
 		(void)notify_queue_locked(queue);
@@ -412,6 +440,53 @@ int k_work_submit(struct k_work *work)
 	return ret;
 }
 
+int k_work_submit_batch_to_queue(struct k_work_q *queue,
+				 struct k_work *const *works, size_t n)
+{
+	__ASSERT_NO_MSG((works != NULL) || (n == 0U));
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, submit_batch_to_queue, queue, works, n);
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	/* Check the queue once so that the batch is either entirely
+	 * rejected or submitted.  Only the first submission wakes the
+	 * queue thread, which can't run before the lock is released.
+	 */
+	int ret = queue_accept_locked(queue);
+
+	for (size_t i = 0; (ret >= 0) && (i < n); i++) {
+		struct k_work_q *target = queue;
+
+		__ASSERT_NO_MSG(works[i] != NULL);
+
+		if (submit_to_queue_locked(works[i], &target) > 0) {
+			ret++;
+		}
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (ret > 0) {
+		z_reschedule_unlocked();
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, submit_batch_to_queue, queue, works, n, ret);
+
+	return ret;
+}
+
+int k_work_submit_batch(struct k_work *const *works, size_t n)
+{
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work, submit_batch, works, n);
+
+	int ret = k_work_submit_batch_to_queue(&k_sys_work_q, works, n);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work, submit_batch, works, n, ret);
+
+	return ret;
+}
+
 /* Flush the work item if necessary.
  *
  * Flushing is necessary only if the work is either queued or running.
@@ -599,13 +674,14 @@ bool k_work_cancel_sync(struct k_work *work,
 static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 {
 	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
+	/* Items processed since the last yield */
+	unsigned int processed = 0U;
+	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	while (true) {
 		sys_snode_t *node;
 		struct k_work *work = NULL;
 		k_work_handler_t handler = NULL;
-		k_spinlock_key_t key = k_spin_lock(&lock);
-		bool yield;
 
 		/* Check for and prepare any new work. */
 		node = sys_slist_get(&queue->pending);
@@ -657,8 +733,11 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 			 * work thread will be woken and we can check again.
 			 */
 
+			processed = 0U;
 			(void)z_sched_wait(&lock, key, &queue->notifyq,
 					   K_FOREVER, NULL);
+			key = k_spin_lock(&lock);
+			queue_stat_inc(queue, work_wakeups);
 			continue;
 		}
 
@@ -670,7 +749,8 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		/* Mark the work item as no longer running and deal
 		 * with any cancellation issued while it was running.
 		 * Clear the BUSY flag and optionally yield to prevent
-		 * starving other threads.
+		 * starving other threads.  The lock stays held to look
+		 * for the next item.
 		 */
 		key = k_spin_lock(&lock);
 
@@ -680,14 +760,18 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 		}
 
 		flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
-		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
-		k_spin_unlock(&lock, key);
+		queue_stat_inc(queue, work_items);
 
 		/* Optionally yield to prevent the work queue from
-		 * starving other threads.
+		 * starving other threads, once the budget of items
+		 * is spent.
 		 */
-		if (yield) {
+		if (!flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT) &&
+		    (++processed >= queue->budget)) {
+			processed = 0U;
+			k_spin_unlock(&lock, key);
 			k_yield();
+			key = k_spin_lock(&lock);
 		}
 	}
 }
@@ -724,6 +808,8 @@ void k_work_queue_start(struct k_work_q *queue,
 		flags |= K_WORK_QUEUE_NO_YIELD;
 	}
 
+	queue->budget = ((cfg != NULL) && (cfg->budget > 1U)) ? cfg->budget : 1U;
+
 	/* It hasn't actually been started yet, but all the state is in place
 	 * so we can submit things and once the thread gets control it's ready
 	 * to roll.
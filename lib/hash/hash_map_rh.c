@@ -0,0 +1,575 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/hash_map_rh.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Bucket metadata, one word per bucket, kept apart from the entries so that
+ * probing scans a compact array:
+ *
+ * [31:16] tag, the upper half of the hash of the key
+ * [15]    the entry was removed from a table being migrated
+ * [14:0]  distance from the home bucket plus one, 0 if the bucket is unused
+ */
+#define RH_DIST_MASK	 BIT_MASK(15)
+#define RH_REMOVED	 BIT(15)
+#define RH_TAG_SHIFT	 16
+#define RH_DIST(_meta)	 ((_meta) & RH_DIST_MASK)
+#define RH_META(_hash)	 (((_hash) & ~BIT_MASK(RH_TAG_SHIFT)) | 1)
+#define RH_TAG_EQ(_m, _h) ((((_m) ^ (_h)) >> RH_TAG_SHIFT) == 0)
+
+/* Open addressing needs unused buckets to stop probing */
+#define RH_MAX_LOAD_FACTOR 95
+
+struct rh_entry {
+	uint64_t key;
+	uint64_t value;
+};
+
+struct rh_table {
+	/* Next table on the retired list */
+	struct rh_table *next;
+	size_t n_buckets;
+	uint32_t *meta;
+	struct rh_entry entries[];
+};
+
+BUILD_ASSERT(offsetof(struct sys_hashmap_rh_data, buckets) ==
+	     offsetof(struct sys_hashmap_data, buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_rh_data, n_buckets) ==
+	     offsetof(struct sys_hashmap_data, n_buckets));
+BUILD_ASSERT(offsetof(struct sys_hashmap_rh_data, size) ==
+	     offsetof(struct sys_hashmap_data, size));
+
+static inline uint32_t rh_hash(const struct sys_hashmap *map, uint64_t key)
+{
+	return map->hash_func(&key, sizeof(key));
+}
+
+/* Returns the bucket holding @p key, or SIZE_MAX */
+static size_t rh_table_find(const struct rh_table *table, uint32_t hash, uint64_t key)
+{
+	const size_t mask = table->n_buckets - 1;
+	uint32_t meta;
+
+	/* Bounded, as a lookup may race with an update and see a torn table */
+	for (size_t i = hash & mask, dist = 1; dist <= table->n_buckets;
+	     i = (i + 1) & mask, ++dist) {
+		meta = table->meta[i];
+		/* entries are sorted by distance, so @p key would have been found */
+		if (RH_DIST(meta) < dist) {
+			break;
+		}
+
+		if (RH_TAG_EQ(meta, hash) && table->entries[i].key == key) {
+			return i;
+		}
+	}
+
+	return SIZE_MAX;
+}
+
+/* @p key must not be in @p table and @p table must have an unused bucket */
+static void rh_table_insert(struct rh_table *table, uint32_t hash, uint64_t key, uint64_t value)
+{
+	const size_t mask = table->n_buckets - 1;
+	struct rh_entry entry = {key, value};
+	struct rh_entry tmp_entry;
+	uint32_t meta = RH_META(hash);
+	uint32_t tmp_meta;
+
+	for (size_t i = hash & mask;; i = (i + 1) & mask) {
+		if (table->meta[i] == 0) {
+			table->entries[i] = entry;
+			table->meta[i] = meta;
+			return;
+		}
+
+		/* rob the richer entry of its bucket */
+		if (RH_DIST(table->meta[i]) < RH_DIST(meta)) {
+			tmp_meta = table->meta[i];
+			tmp_entry = table->entries[i];
+			table->meta[i] = meta;
+			table->entries[i] = entry;
+			meta = tmp_meta;
+			entry = tmp_entry;
+		}
+
+		__ASSERT(RH_DIST(meta) < RH_DIST_MASK, "Probe sequence too long");
+		++meta;
+	}
+}
+
+/* Removes the entry in bucket @p i by shifting the following entries back */
+static void rh_table_remove(struct rh_table *table, size_t i)
+{
+	const size_t mask = table->n_buckets - 1;
+	size_t next;
+
+	for (;; i = next) {
+		next = (i + 1) & mask;
+		if (RH_DIST(table->meta[next]) <= 1) {
+			table->meta[i] = 0;
+			return;
+		}
+
+		table->entries[i] = table->entries[next];
+		table->meta[i] = table->meta[next] - 1;
+	}
+}
+
+static struct rh_table *rh_table_alloc(const struct sys_hashmap *map, size_t n_buckets)
+{
+	struct rh_table *table;
+
+	table = map->alloc_func(NULL, sizeof(*table) + n_buckets * (sizeof(table->entries[0]) +
+								     sizeof(table->meta[0])));
+	if (table == NULL) {
+		return NULL;
+	}
+
+	table->next = NULL;
+	table->n_buckets = n_buckets;
+	table->meta = (uint32_t *)&table->entries[n_buckets];
+	memset(table->meta, 0, n_buckets * sizeof(table->meta[0]));
+
+	return table;
+}
+
+/* Returns the bucket of @p old, the table being migrated, holding @p key, or SIZE_MAX.
+ * The caller loads @p old once, as a concurrent update may clear data->old.
+ */
+static size_t rh_old_find(const struct sys_hashmap_rh_data *data, const struct rh_table *old,
+			  uint32_t hash, uint64_t key)
+{
+	size_t i;
+
+	if (old == NULL) {
+		return SIZE_MAX;
+	}
+
+	/* buckets below migrate_pos only hold stale copies */
+	i = rh_table_find(old, hash, key);
+	if (i == SIZE_MAX || i < data->migrate_pos || (old->meta[i] & RH_REMOVED) != 0) {
+		return SIZE_MAX;
+	}
+
+	return i;
+}
+
+/* Looks up @p key in both tables, the caller serializes with the updates */
+static struct rh_entry *rh_lookup(struct sys_hashmap_rh_data *data, uint32_t hash, uint64_t key)
+{
+	struct rh_table *table;
+	struct rh_table *old;
+	size_t i;
+
+	table = atomic_ptr_get(&data->buckets);
+	if (table == NULL) {
+		return NULL;
+	}
+
+	i = rh_table_find(table, hash, key);
+	if (i != SIZE_MAX) {
+		return &table->entries[i];
+	}
+
+	old = atomic_ptr_get(&data->old);
+	i = rh_old_find(data, old, hash, key);
+	if (i != SIZE_MAX) {
+		return &old->entries[i];
+	}
+
+	return NULL;
+}
+
+static void rh_retire(struct sys_hashmap_rh_data *data, struct rh_table *table)
+{
+	table->next = data->retired;
+	data->retired = table;
+}
+
+/* Moves the next buckets of the old table into the current one */
+static void rh_migrate(const struct sys_hashmap *map)
+{
+	struct sys_hashmap_rh_data *data = (struct sys_hashmap_rh_data *)map->data;
+	struct rh_table *old = data->old;
+	struct rh_entry *entry;
+	size_t end;
+
+	if (old == NULL) {
+		return;
+	}
+
+	end = MIN(old->n_buckets, data->migrate_pos + CONFIG_SYS_HASH_MAP_RH_REHASH_STEP);
+
+	for (size_t i = data->migrate_pos; i < end; ++i) {
+		if (old->meta[i] != 0 && !(old->meta[i] & RH_REMOVED)) {
+			entry = &old->entries[i];
+			rh_table_insert(data->buckets, rh_hash(map, entry->key), entry->key,
+					entry->value);
+		}
+	}
+
+	data->migrate_pos = end;
+
+	if (end == old->n_buckets) {
+		atomic_ptr_set(&data->old, NULL);
+		rh_retire(data, old);
+	}
+}
+
+/* Retires both tables without migrating, once their entries are no longer needed */
+static void rh_retire_all(struct sys_hashmap_rh_data *data)
+{
+	struct rh_table *table = data->buckets;
+	struct rh_table *old = data->old;
+
+	if (old != NULL) {
+		atomic_ptr_set(&data->old, NULL);
+		rh_retire(data, old);
+	}
+
+	if (table != NULL) {
+		atomic_ptr_set(&data->buckets, NULL);
+		data->n_buckets = 0;
+		rh_retire(data, table);
+	}
+}
+
+/* Frees the replaced tables, unless a lookup may still be reading them */
+static void rh_reclaim(const struct sys_hashmap *map)
+{
+	struct sys_hashmap_rh_data *data = (struct sys_hashmap_rh_data *)map->data;
+	struct rh_table *table;
+
+	/* tables are retired before checking for lookups, which register before
+	 * loading the table pointers, so a lookup started after this check
+	 * cannot reach a retired table
+	 */
+	if (data->retired == NULL || atomic_get(&data->readers) != 0) {
+		return;
+	}
+
+	while (data->retired != NULL) {
+		table = data->retired;
+		data->retired = table->next;
+		map->alloc_func(table, 0);
+	}
+}
+
+static inline k_spinlock_key_t rh_write_begin(struct sys_hashmap_rh_data *data)
+{
+	k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+	atomic_inc(&data->seq);
+	barrier_dmem_fence_full();
+
+	return key;
+}
+
+static inline void rh_write_end(struct sys_hashmap_rh_data *data, k_spinlock_key_t key)
+{
+	barrier_dmem_fence_full();
+	atomic_inc(&data->seq);
+
+	k_spin_unlock(&data->lock, key);
+}
+
+static size_t rh_grow_n_buckets(const struct sys_hashmap *map)
+{
+	const struct sys_hashmap_data *data = map->data;
+	const size_t load_factor = MIN(map->config->load_factor, RH_MAX_LOAD_FACTOR);
+	size_t n_buckets;
+
+	n_buckets = data->n_buckets == 0 ? MAX(map->config->initial_n_buckets, 1)
+					 : data->n_buckets;
+	if ((data->size + 1) * 100 <= n_buckets * load_factor && data->n_buckets != 0) {
+		return 0;
+	}
+
+	while ((data->size + 1) * 100 > n_buckets * load_factor) {
+		n_buckets <<= 1;
+	}
+
+	return n_buckets;
+}
+
+static void sys_hashmap_rh_iter_next(struct sys_hashmap_iterator *it)
+{
+	const struct sys_hashmap *map = it->map;
+	struct sys_hashmap_rh_data *data = (struct sys_hashmap_rh_data *)map->data;
+	struct rh_table *table = data->buckets;
+	struct rh_table *old = data->old;
+	size_t i = (uintptr_t)it->state;
+
+	__ASSERT(it->size == map->data->size, "Concurrent modification!");
+	__ASSERT(sys_hashmap_iterator_has_next(it), "Attempt to access beyond current bound!");
+
+	/* the current table, then the buckets of the old table yet to be migrated */
+	for (; i < table->n_buckets; ++i) {
+		if (table->meta[i] != 0) {
+			it->state = (void *)(uintptr_t)(i + 1);
+			it->key = table->entries[i].key;
+			it->value = table->entries[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	for (i = MAX(i - table->n_buckets, data->migrate_pos); old != NULL && i < old->n_buckets;
+	     ++i) {
+		if (old->meta[i] != 0 && !(old->meta[i] & RH_REMOVED)) {
+			it->state = (void *)(uintptr_t)(table->n_buckets + i + 1);
+			it->key = old->entries[i].key;
+			it->value = old->entries[i].value;
+			++it->pos;
+			return;
+		}
+	}
+
+	__ASSERT(false, "Entire Hashmap traversed and no entry was found");
+}
+
+/*
+ * Concurrent Robin Hood Hashmap API
+ */
+
+static void sys_hashmap_rh_iter(const struct sys_hashmap *map, struct sys_hashmap_iterator *it)
+{
+	it->map = map;
+	it->next = sys_hashmap_rh_iter_next;
+	it->state = (void *)0;
+	it->pos = 0;
+	*((size_t *)&it->size) = map->data->size;
+}
+
+static void sys_hashmap_rh_clear(struct sys_hashmap *map, sys_hashmap_callback_t cb, void *cookie)
+{
+	struct sys_hashmap_rh_data *data = (struct sys_hashmap_rh_data *)map->data;
+	struct sys_hashmap_iterator it = {0};
+	k_spinlock_key_t key;
+
+	(void)k_mutex_lock(&data->mutex, K_FOREVER);
+
+	for (sys_hashmap_rh_iter(map, &it); cb != NULL && sys_hashmap_iterator_has_next(&it);) {
+		it.next(&it);
+		cb(it.key, it.value, cookie);
+	}
+
+	key = rh_write_begin(data);
+
+	rh_retire_all(data);
+	data->size = 0;
+
+	rh_write_end(data, key);
+
+	rh_reclaim(map);
+
+	k_mutex_unlock(&data->mutex);
+}
+
+static int sys_hashmap_rh_insert(struct sys_hashmap *map, uint64_t key, uint64_t value,
+				 uint64_t *old_value)
+{
+	struct sys_hashmap_rh_data *data = (struct sys_hashmap_rh_data *)map->data;
+	const uint32_t hash = rh_hash(map, key);
+	struct rh_table *table = NULL;
+	struct rh_table *old;
+	k_spinlock_key_t spin_key;
+	size_t n_buckets = 0;
+	size_t i;
+	int ret;
+
+	(void)k_mutex_lock(&data->mutex, K_FOREVER);
+
+	/* the only writer, so no need to validate the lookup */
+	if (rh_lookup(data, hash, key) == NULL) {
+		if (data->size == map->config->max_size) {
+			ret = -ENOSPC;
+			goto out;
+		}
+
+		/* allocate outside of the critical section */
+		n_buckets = rh_grow_n_buckets(map);
+		if (n_buckets != 0) {
+			table = rh_table_alloc(map, n_buckets);
+			if (table == NULL) {
+				ret = -ENOMEM;
+				goto out;
+			}
+		}
+	}
+
+	/* Only one table can be migrated at a time.  Finish the previous
+	 * migration one step per critical section, rather than masking
+	 * interrupts for the whole table.
+	 */
+	while (table != NULL && data->old != NULL) {
+		spin_key = rh_write_begin(data);
+		rh_migrate(map);
+		rh_write_end(data, spin_key);
+	}
+
+	spin_key = rh_write_begin(data);
+
+	if (table != NULL) {
+		if (data->buckets != NULL) {
+			atomic_ptr_set(&data->old, data->buckets);
+			data->migrate_pos = 0;
+		}
+		atomic_ptr_set(&data->buckets, table);
+		data->n_buckets = n_buckets;
+	}
+
+	rh_migrate(map);
+
+	/* the migration may have moved the entry */
+	table = data->buckets;
+	i = rh_table_find(table, hash, key);
+	if (i != SIZE_MAX) {
+		if (old_value != NULL) {
+			*old_value = table->entries[i].value;
+		}
+		table->entries[i].value = value;
+		ret = 0;
+		goto done;
+	}
+
+	old = data->old;
+	i = rh_old_find(data, old, hash, key);
+	if (i != SIZE_MAX) {
+		if (old_value != NULL) {
+			*old_value = old->entries[i].value;
+		}
+		/* the old table is still probed, so leave a marker */
+		old->meta[i] |= RH_REMOVED;
+		ret = 0;
+	} else {
+		++data->size;
+		ret = 1;
+	}
+
+	rh_table_insert(table, hash, key, value);
+
+done:
+	rh_write_end(data, spin_key);
+
+	rh_reclaim(map);
+
+out:
+	k_mutex_unlock(&data->mutex);
+
+	return ret;
+}
+
+static bool sys_hashmap_rh_remove(struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct sys_hashmap_rh_data *data = (struct sys_hashmap_rh_data *)map->data;
+	const uint32_t hash = rh_hash(map, key);
+	struct rh_table *table;
+	k_spinlock_key_t spin_key;
+	size_t i;
+	bool ret = false;
+
+	(void)k_mutex_lock(&data->mutex, K_FOREVER);
+
+	if (rh_lookup(data, hash, key) == NULL) {
+		goto out;
+	}
+
+	spin_key = rh_write_begin(data);
+
+	rh_migrate(map);
+
+	table = data->buckets;
+	i = rh_table_find(table, hash, key);
+	if (i != SIZE_MAX) {
+		if (value != NULL) {
+			*value = table->entries[i].value;
+		}
+		rh_table_remove(table, i);
+	} else {
+		table = data->old;
+		i = rh_old_find(data, table, hash, key);
+		__ASSERT_NO_MSG(i != SIZE_MAX);
+		if (value != NULL) {
+			*value = table->entries[i].value;
+		}
+		table->meta[i] |= RH_REMOVED;
+	}
+
+	/* release the memory once empty, the old table has nothing left to migrate */
+	if (--data->size == 0) {
+		rh_retire_all(data);
+	}
+
+	rh_write_end(data, spin_key);
+
+	rh_reclaim(map);
+	ret = true;
+
+out:
+	k_mutex_unlock(&data->mutex);
+
+	return ret;
+}
+
+static bool sys_hashmap_rh_get(const struct sys_hashmap *map, uint64_t key, uint64_t *value)
+{
+	struct sys_hashmap_rh_data *data = (struct sys_hashmap_rh_data *)map->data;
+	const uint32_t hash = rh_hash(map, key);
+	struct rh_entry *entry;
+	atomic_val_t seq;
+	uint64_t val = 0;
+
+	atomic_inc(&data->readers);
+
+	do {
+		/* an update is in progress on another CPU */
+		while (((seq = atomic_get(&data->seq)) & 1) != 0) {
+			arch_spin_relax();
+		}
+
+		entry = rh_lookup(data, hash, key);
+		if (entry != NULL) {
+			val = entry->value;
+		}
+
+		barrier_dmem_fence_full();
+	} while (atomic_get(&data->seq) != seq);
+
+	atomic_dec(&data->readers);
+
+	if (entry == NULL) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = val;
+	}
+
+	return true;
+}
+
+const struct sys_hashmap_api sys_hashmap_rh_api = {
+	.iter = sys_hashmap_rh_iter,
+	.clear = sys_hashmap_rh_clear,
+	.insert = sys_hashmap_rh_insert,
+	.remove = sys_hashmap_rh_remove,
+	.get = sys_hashmap_rh_get,
+};
@@ -115,16 +115,113 @@ extern char _heap_sentry[];
 POOL_SECTION static struct sys_heap z_malloc_heap;
 MALLOC_SECTION SYS_MUTEX_DEFINE(z_malloc_heap_mutex);
 
+#ifdef CONFIG_SYS_HEAP_TCACHE
+/* The per-CPU block caches need local interrupts locked to keep the
+ * CPU stable, which user mode can't do: user threads always go
+ * through the mutex and the heap proper.
+ */
+static void *malloc_cache_get(size_t align, size_t size)
+{
+	void *ret = NULL;
+
+	if (!k_is_user_context()) {
+		unsigned int key = arch_irq_lock();
+
+		ret = sys_heap_tcache_alloc(&z_malloc_heap, align, size);
+		arch_irq_unlock(key);
+	}
+
+	return ret;
+}
+
+static bool malloc_cache_put(void *ptr)
+{
+	bool ret = false;
+
+	if (!k_is_user_context()) {
+		unsigned int key = arch_irq_lock();
+
+		ret = sys_heap_tcache_free(&z_malloc_heap, ptr);
+		arch_irq_unlock(key);
+	}
+
+	return ret;
+}
+
+/* must hold z_malloc_heap_mutex */
+static void *malloc_heap_alloc(size_t align, size_t size)
+{
+	unsigned int key;
+	void *ret;
+
+	if (k_is_user_context()) {
+		return sys_heap_aligned_alloc(&z_malloc_heap, align, size);
+	}
+
+	key = arch_irq_lock();
+	ret = sys_heap_tcache_refill(&z_malloc_heap, align, size);
+	if (ret == NULL && sys_heap_tcache_drain(&z_malloc_heap)) {
+		ret = sys_heap_tcache_refill(&z_malloc_heap, align, size);
+	}
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+/* must hold z_malloc_heap_mutex */
+static void malloc_heap_free(void *ptr)
+{
+	unsigned int key;
+
+	if (k_is_user_context()) {
+		sys_heap_free(&z_malloc_heap, ptr);
+		return;
+	}
+
+	key = arch_irq_lock();
+	sys_heap_tcache_flush(&z_malloc_heap, ptr);
+	arch_irq_unlock(key);
+}
+#else
+static inline void *malloc_cache_get(size_t align, size_t size)
+{
+	ARG_UNUSED(align);
+	ARG_UNUSED(size);
+
+	return NULL;
+}
+
+static inline bool malloc_cache_put(void *ptr)
+{
+	ARG_UNUSED(ptr);
+
+	return false;
+}
+
+static inline void *malloc_heap_alloc(size_t align, size_t size)
+{
+	return sys_heap_aligned_alloc(&z_malloc_heap, align, size);
+}
+
+static inline void malloc_heap_free(void *ptr)
+{
+	sys_heap_free(&z_malloc_heap, ptr);
+}
+#endif /* CONFIG_SYS_HEAP_TCACHE */
+
 void *malloc(size_t size)
 {
 	int lock_ret;
+	void *ret = malloc_cache_get(__alignof__(z_max_align_t), size);
+
+	if (ret != NULL) {
+		return ret;
+	}
 
 	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
 	__ASSERT_NO_MSG(lock_ret == 0);
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
+	ret = malloc_heap_alloc(__alignof__(z_max_align_t), size);
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -137,13 +234,16 @@ void *malloc(size_t size)
 void *aligned_alloc(size_t alignment, size_t size)
 {
 	int lock_ret;
+	void *ret = malloc_cache_get(alignment, size);
+
+	if (ret != NULL) {
+		return ret;
+	}
 
 	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
 	__ASSERT_NO_MSG(lock_ret == 0);
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   alignment,
-					   size);
+	ret = malloc_heap_alloc(alignment, size);
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
@@ -223,9 +323,13 @@ void free(void *ptr)
 {
 	int lock_ret;
 
+	if (malloc_cache_put(ptr)) {
+		return;
+	}
+
 	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
 	__ASSERT_NO_MSG(lock_ret == 0);
-	sys_heap_free(&z_malloc_heap, ptr);
+	malloc_heap_free(ptr);
 	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
 }
 
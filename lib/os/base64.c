@@ -23,8 +23,13 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <zephyr/sys/base64.h>
+#include <zephyr/sys/util.h>
+
+#include "base64_internal.h"
 
 static const uint8_t base64_enc_map[64] = {
 	'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J',
@@ -54,14 +59,91 @@ static const uint8_t base64_dec_map[128] = {
 
 #define BASE64_SIZE_T_MAX	((size_t) -1) /* SIZE_T_MAX is not standard */
 
+#define DECODER_SPACE		BIT(0)
+#define DECODER_CR		BIT(1)
+
+/*
+ * Decode four characters of the alphabet into 24 bits, fails on any pad,
+ * whitespace or invalid character so that the caller takes the slow path.
+ */
+static inline bool decode_quad(const uint8_t *src, uint32_t *x)
+{
+	uint32_t a, b, c, d;
+
+	if (((src[0] | src[1] | src[2] | src[3]) & 0x80) != 0U) {
+		return false;
+	}
+
+	a = base64_dec_map[src[0]];
+	b = base64_dec_map[src[1]];
+	c = base64_dec_map[src[2]];
+	d = base64_dec_map[src[3]];
+
+	/* Pads are 64 and invalid characters 127 */
+	if (((a | b | c | d) & 0xC0) != 0U) {
+		return false;
+	}
+
+	*x = (a << 18) | (b << 12) | (c << 6) | d;
+
+	return true;
+}
+
+/*
+ * Encode whole groups of three bytes, n is a multiple of 3
+ */
+static uint8_t *encode_groups(uint8_t *p, const uint8_t *src, size_t n)
+{
+	size_t done = z_base64_encode_simd(p, src, n);
+	uint32_t x;
+
+	p += done / 3 * 4;
+	src += done;
+	n -= done;
+
+	for (; n > 0; n -= 3, src += 3) {
+		x = ((uint32_t)src[0] << 16) | ((uint32_t)src[1] << 8) | src[2];
+
+		*p++ = base64_enc_map[(x >> 18) & 0x3F];
+		*p++ = base64_enc_map[(x >> 12) & 0x3F];
+		*p++ = base64_enc_map[(x >> 6) & 0x3F];
+		*p++ = base64_enc_map[x & 0x3F];
+	}
+
+	return p;
+}
+
+/*
+ * Encode the last one or two bytes, with padding
+ */
+static uint8_t *encode_tail(uint8_t *p, const uint8_t *src, size_t n)
+{
+	int C1, C2;
+
+	C1 = src[0];
+	C2 = (n > 1) ? src[1] : 0;
+
+	*p++ = base64_enc_map[(C1 >> 2) & 0x3F];
+	*p++ = base64_enc_map[(((C1 & 3) << 4) + (C2 >> 4)) & 0x3F];
+
+	if (n > 1) {
+		*p++ = base64_enc_map[((C2 & 15) << 2) & 0x3F];
+	} else {
+		*p++ = '=';
+	}
+
+	*p++ = '=';
+
+	return p;
+}
+
 /*
  * Encode a buffer into base64 format
  */
 int base64_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 		  size_t slen)
 {
-	size_t i, n;
-	int C1, C2, C3;
+	size_t n;
 	uint8_t *p;
 
 	if (slen == 0) {
@@ -85,31 +167,10 @@ int base64_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 
 	n = (slen / 3) * 3;
 
-	for (i = 0, p = dst; i < n; i += 3) {
-		C1 = *src++;
-		C2 = *src++;
-		C3 = *src++;
-
-		*p++ = base64_enc_map[(C1 >> 2) & 0x3F];
-		*p++ = base64_enc_map[(((C1 &  3) << 4) + (C2 >> 4)) & 0x3F];
-		*p++ = base64_enc_map[(((C2 & 15) << 2) + (C3 >> 6)) & 0x3F];
-		*p++ = base64_enc_map[C3 & 0x3F];
-	}
-
-	if (i < slen) {
-		C1 = *src++;
-		C2 = ((i + 1) < slen) ? *src++ : 0;
-
-		*p++ = base64_enc_map[(C1 >> 2) & 0x3F];
-		*p++ = base64_enc_map[(((C1 & 3) << 4) + (C2 >> 4)) & 0x3F];
-
-		if ((i + 1) < slen) {
-			*p++ = base64_enc_map[((C2 & 15) << 2) & 0x3F];
-		} else {
-			*p++ = '=';
-		}
+	p = encode_groups(dst, src, n);
 
-		*p++ = '=';
+	if (n < slen) {
+		p = encode_tail(p, src + n, slen - n);
 	}
 
 	*olen = p - dst;
@@ -124,12 +185,28 @@ int base64_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 		  size_t slen)
 {
-	size_t i, n;
+	size_t i, n, done;
 	uint32_t j, x;
 	uint8_t *p;
 
 	/* First pass: check for validity and get output length */
 	for (i = n = j = 0U; i < slen; i++) {
+		/* Skip whole groups of alphabet characters at once */
+		if (j == 0U) {
+			done = z_base64_check_simd(&src[i], slen - i);
+			i += done;
+			n += done;
+		}
+
+		while (j == 0U && (slen - i) >= 4 && decode_quad(&src[i], &x)) {
+			i += 4;
+			n += 4;
+		}
+
+		if (i == slen) {
+			break;
+		}
+
 		/* Skip spaces before checking for EOL */
 		x = 0U;
 		while (i < slen && src[i] == ' ') {
@@ -189,6 +266,26 @@ int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 
 	for (j = 3U, n = x = 0U, p = dst; i > 0; i--, src++) {
 
+		if (n == 0U) {
+			done = z_base64_decode_simd(p, src, i);
+			if (done > 0U) {
+				/* The loop steps over the last character */
+				p += done / 4 * 3;
+				i -= done - 1;
+				src += done - 1;
+				continue;
+			}
+		}
+
+		if (n == 0U && i >= 4 && decode_quad(src, &x)) {
+			*p++ = (unsigned char)(x >> 16);
+			*p++ = (unsigned char)(x >> 8);
+			*p++ = (unsigned char)(x);
+			i -= 3;
+			src += 3;
+			continue;
+		}
+
 		if (*src == '\r' || *src == '\n' || *src == ' ') {
 			continue;
 		}
@@ -214,3 +311,193 @@ int base64_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
 
 	return 0;
 }
+
+void base64_encoder_init(struct base64_encoder *enc)
+{
+	enc->len = 0U;
+}
+
+int base64_encoder_update(struct base64_encoder *enc, uint8_t *dst, size_t dlen,
+			  size_t *olen, const uint8_t *src, size_t slen)
+{
+	size_t n;
+	uint8_t *p;
+
+	if (slen / 3 >= (BASE64_SIZE_T_MAX - 4) / 4) {
+		*olen = BASE64_SIZE_T_MAX;
+		return -ENOMEM;
+	}
+
+	n = ((enc->len + slen) / 3) * 4;
+
+	if ((dlen < n) || (!dst && n > 0)) {
+		*olen = n;
+		return -ENOMEM;
+	}
+
+	p = dst;
+
+	/* Complete the group left over by the previous update */
+	if (enc->len > 0U) {
+		while (enc->len < 3U && slen > 0) {
+			enc->buf[enc->len++] = *src++;
+			slen--;
+		}
+
+		if (enc->len < 3U) {
+			*olen = 0;
+			return 0;
+		}
+
+		p = encode_groups(p, enc->buf, 3);
+		enc->len = 0U;
+	}
+
+	n = (slen / 3) * 3;
+	p = encode_groups(p, src, n);
+
+	memcpy(enc->buf, src + n, slen - n);
+	enc->len = slen - n;
+
+	*olen = p - dst;
+
+	return 0;
+}
+
+int base64_encoder_finish(struct base64_encoder *enc, uint8_t *dst, size_t dlen,
+			  size_t *olen)
+{
+	uint8_t *p;
+
+	if (enc->len == 0U) {
+		*olen = 0;
+		return 0;
+	}
+
+	if ((dlen < 4) || (!dst)) {
+		*olen = 4;
+		return -ENOMEM;
+	}
+
+	p = encode_tail(dst, enc->buf, enc->len);
+	enc->len = 0U;
+
+	*olen = p - dst;
+
+	return 0;
+}
+
+void base64_decoder_init(struct base64_decoder *dec)
+{
+	memset(dec, 0, sizeof(*dec));
+}
+
+int base64_decoder_update(struct base64_decoder *dec, uint8_t *dst, size_t dlen,
+			  size_t *olen, const uint8_t *src, size_t slen)
+{
+	const uint8_t *end = src + slen;
+	uint8_t *p = dst;
+	uint32_t x;
+	size_t n, done;
+
+	/* Whitespace and pads make the actual output shorter */
+	n = (dec->n + slen) / 4;
+	if (n > BASE64_SIZE_T_MAX / 3) {
+		*olen = BASE64_SIZE_T_MAX;
+		return -ENOMEM;
+	}
+
+	n *= 3;
+
+	if ((dlen < n) || (!dst && n > 0)) {
+		*olen = n;
+		return -ENOMEM;
+	}
+
+	while (src < end) {
+		if (dec->n == 0U && dec->pad == 0U && dec->flags == 0U) {
+			done = z_base64_decode_simd(p, src, end - src);
+			p += done / 4 * 3;
+			src += done;
+
+			while ((end - src) >= 4 && decode_quad(src, &x)) {
+				*p++ = (uint8_t)(x >> 16);
+				*p++ = (uint8_t)(x >> 8);
+				*p++ = (uint8_t)(x);
+				src += 4;
+			}
+
+			if (src == end) {
+				break;
+			}
+		}
+
+		/* CR is only allowed as part of a CRLF line ending */
+		if ((dec->flags & DECODER_CR) != 0U && *src != '\n') {
+			return -EINVAL;
+		}
+
+		if (*src == '\n') {
+			dec->flags = 0U;
+			src++;
+			continue;
+		}
+
+		if (*src == '\r') {
+			dec->flags |= DECODER_CR;
+			src++;
+			continue;
+		}
+
+		/* Spaces are only allowed at the end of a line or of the data */
+		if (*src == ' ') {
+			dec->flags |= DECODER_SPACE;
+			src++;
+			continue;
+		}
+
+		if (dec->flags != 0U) {
+			return -EINVAL;
+		}
+
+		if (*src == '=' && ++dec->pad > 2) {
+			return -EINVAL;
+		}
+
+		if (*src > 127 || base64_dec_map[*src] == 127U) {
+			return -EINVAL;
+		}
+
+		if (base64_dec_map[*src] < 64 && dec->pad != 0U) {
+			return -EINVAL;
+		}
+
+		dec->x = (dec->x << 6) | (base64_dec_map[*src] & 0x3F);
+		src++;
+
+		if (++dec->n == 4) {
+			dec->n = 0U;
+
+			*p++ = (uint8_t)(dec->x >> 16);
+			if (dec->pad < 2) {
+				*p++ = (uint8_t)(dec->x >> 8);
+			}
+			if (dec->pad < 1) {
+				*p++ = (uint8_t)(dec->x);
+			}
+		}
+	}
+
+	*olen = p - dst;
+
+	return 0;
+}
+
+int base64_decoder_finish(struct base64_decoder *dec)
+{
+	if ((dec->flags & DECODER_CR) != 0U || dec->n != 0U) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <arm_neon.h>
+
+#include "base64_internal.h"
+
+/*
+ * 48 bytes to 64 characters and back per step: the structure loads and
+ * stores split bytes and characters by their position in a group, and
+ * table lookups translate between characters and sextets.
+ */
+
+static const uint8_t enc_map[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+				   "abcdefghijklmnopqrstuvwxyz"
+				   "0123456789+/";
+
+/* Flags of the characters of each nibble, a character is in the alphabet
+ * when the flags of its nibbles have no bit in common
+ */
+static const uint8_t dec_lut_lo[16] = {
+	0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+	0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+};
+
+static const uint8_t dec_lut_hi[16] = {
+	0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+	0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+};
+
+/* Index minus character, from the high nibble, and 1 for '/' */
+static const int8_t dec_lut_roll[16] = {
+	0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+/* Nonzero bytes for characters out of the alphabet */
+static inline uint8x16_t dec_invalid(uint8x16_t in)
+{
+	uint8x16_t lo = vqtbl1q_u8(vld1q_u8(dec_lut_lo), vandq_u8(in, vdupq_n_u8(0x0f)));
+	uint8x16_t hi = vqtbl1q_u8(vld1q_u8(dec_lut_hi), vshrq_n_u8(in, 4));
+
+	return vandq_u8(lo, hi);
+}
+
+/* Sextets of alphabet characters */
+static inline uint8x16_t dec_sextets(uint8x16_t in)
+{
+	uint8x16_t slash = vceqq_u8(in, vdupq_n_u8('/'));
+	uint8x16_t roll = vqtbl1q_u8(vreinterpretq_u8_s8(vld1q_s8(dec_lut_roll)),
+				     vaddq_u8(slash, vshrq_n_u8(in, 4)));
+
+	return vaddq_u8(in, roll);
+}
+
+size_t z_base64_encode_simd(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	const uint8x16x4_t map = {{
+		vld1q_u8(&enc_map[0]), vld1q_u8(&enc_map[16]),
+		vld1q_u8(&enc_map[32]), vld1q_u8(&enc_map[48]),
+	}};
+	const uint8x16_t mask = vdupq_n_u8(0x3f);
+	size_t done;
+
+	for (done = 0; len - done >= 48; done += 48, dst += 64) {
+		uint8x16x3_t in = vld3q_u8(&src[done]);
+		uint8x16x4_t out;
+
+		out.val[0] = vshrq_n_u8(in.val[0], 2);
+		out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4),
+					       vshrq_n_u8(in.val[1], 4)), mask);
+		out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2),
+					       vshrq_n_u8(in.val[2], 6)), mask);
+		out.val[3] = vandq_u8(in.val[2], mask);
+
+		for (int i = 0; i < 4; i++) {
+			out.val[i] = vqtbl4q_u8(map, out.val[i]);
+		}
+
+		vst4q_u8(dst, out);
+	}
+
+	return done;
+}
+
+size_t z_base64_check_simd(const uint8_t *src, size_t len)
+{
+	size_t done;
+
+	for (done = 0; len - done >= 64; done += 64) {
+		uint8x16x4_t in = vld4q_u8(&src[done]);
+		uint8x16_t invalid = vorrq_u8(vorrq_u8(dec_invalid(in.val[0]),
+						       dec_invalid(in.val[1])),
+					      vorrq_u8(dec_invalid(in.val[2]),
+						       dec_invalid(in.val[3])));
+
+		if (vmaxvq_u8(invalid) != 0U) {
+			break;
+		}
+	}
+
+	return done;
+}
+
+size_t z_base64_decode_simd(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	size_t done;
+
+	for (done = 0; len - done >= 64; done += 64, dst += 48) {
+		uint8x16x4_t in = vld4q_u8(&src[done]);
+		uint8x16_t invalid = vdupq_n_u8(0);
+		uint8x16x3_t out;
+
+		for (int i = 0; i < 4; i++) {
+			invalid = vorrq_u8(invalid, dec_invalid(in.val[i]));
+			in.val[i] = dec_sextets(in.val[i]);
+		}
+
+		if (vmaxvq_u8(invalid) != 0U) {
+			break;
+		}
+
+		out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+		out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+		out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+
+		vst3q_u8(dst, out);
+	}
+
+	return done;
+}
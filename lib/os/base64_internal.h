@@ -0,0 +1,50 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_OS_BASE64_INTERNAL_H_
+#define ZEPHYR_LIB_OS_BASE64_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Vector conversions of whole blocks of the standard alphabet: any pad,
+ * whitespace or invalid character ends them, and the caller takes over
+ * with the portable code from there.
+ */
+
+#if defined(CONFIG_BASE64_X86_SSSE3) || defined(CONFIG_BASE64_ARM64_NEON)
+/* Encodes the leading blocks of len bytes, returns the number of bytes
+ * encoded, a multiple of 3
+ */
+size_t z_base64_encode_simd(uint8_t *dst, const uint8_t *src, size_t len);
+
+/* Returns the length of the leading blocks of len characters that only
+ * hold alphabet characters, a multiple of 4
+ */
+size_t z_base64_check_simd(const uint8_t *src, size_t len);
+
+/* Decodes the leading blocks of len characters that only hold alphabet
+ * characters, returns the number of characters decoded, a multiple of 4
+ */
+size_t z_base64_decode_simd(uint8_t *dst, const uint8_t *src, size_t len);
+#else
+static inline size_t z_base64_encode_simd(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	return 0;
+}
+
+static inline size_t z_base64_check_simd(const uint8_t *src, size_t len)
+{
+	return 0;
+}
+
+static inline size_t z_base64_decode_simd(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	return 0;
+}
+#endif
+
+#endif /* ZEPHYR_LIB_OS_BASE64_INTERNAL_H_ */
@@ -0,0 +1,152 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/toolchain.h>
+#include <immintrin.h>
+
+#include "base64_internal.h"
+
+/*
+ * 12 bytes to 16 characters and back per step, with the pshufb based
+ * algorithms of W. Mula and D. Lemire, "Faster Base64 Encoding and
+ * Decoding Using AVX2 Instructions" (2018), on 128-bit vectors.
+ */
+
+/* Sextet indices of 12 bytes, one per byte of the result */
+__attribute__((target("ssse3")))
+static inline __m128i enc_reshuffle(__m128i in)
+{
+	__m128i t0, t1, t2, t3;
+
+	/* Bytes 1, 0, 2, 1 of each group of three, for each 32-bit lane */
+	in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7,
+					       4, 5, 3, 4, 1, 2, 0, 1));
+
+	/* Move sextets a and c, then b and d, into place with multiplications */
+	t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+	t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+	t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+	t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+
+	return _mm_or_si128(t1, t3);
+}
+
+/* Characters of sextet indices: each range of the alphabet is offset by
+ * a constant from its indices, looked up from a class of the index
+ */
+__attribute__((target("ssse3")))
+static inline __m128i enc_translate(__m128i idx)
+{
+	const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52,
+					      '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+					      '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+					      '/' - 63, 'A', 0, 0);
+	/* 0 for 26 to 51, 1 to 12 for 52 to 63 and 13 for 0 to 25 */
+	__m128i class = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+	__m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), idx);
+
+	class = _mm_or_si128(class, _mm_and_si128(upper, _mm_set1_epi8(13)));
+
+	return _mm_add_epi8(idx, _mm_shuffle_epi8(offsets, class));
+}
+
+/* Flags of the characters of each nibble, a character is in the alphabet
+ * when the flags of its nibbles have no bit in common
+ */
+__attribute__((target("ssse3")))
+static inline bool dec_valid(__m128i in, __m128i hi_nibbles)
+{
+	const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+					     0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+	const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+					     0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	__m128i lo_nibbles = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+	__m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+	__m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi),
+						_mm_setzero_si128())) == 0xffff;
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i dec_hi_nibbles(__m128i in)
+{
+	return _mm_and_si128(_mm_srli_epi32(in, 4), _mm_set1_epi8(0x0f));
+}
+
+__attribute__((target("ssse3")))
+size_t z_base64_encode_simd(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	size_t done;
+
+	/* 16 bytes are loaded for 12 */
+	for (done = 0; len - done >= 16; done += 12, dst += 16) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&src[done]);
+
+		_mm_storeu_si128((__m128i *)dst, enc_translate(enc_reshuffle(in)));
+	}
+
+	return done;
+}
+
+__attribute__((target("ssse3")))
+size_t z_base64_check_simd(const uint8_t *src, size_t len)
+{
+	size_t done;
+
+	for (done = 0; len - done >= 16; done += 16) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&src[done]);
+
+		if (!dec_valid(in, dec_hi_nibbles(in))) {
+			break;
+		}
+	}
+
+	return done;
+}
+
+__attribute__((target("ssse3")))
+size_t z_base64_decode_simd(uint8_t *dst, const uint8_t *src, size_t len)
+{
+	/* Index minus character, from the high nibble, and 1 for '/' */
+	const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+					       0, 0, 0, 0, 0, 0, 0, 0);
+	size_t done;
+
+	for (done = 0; len - done >= 16; done += 16, dst += 12) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&src[done]);
+		__m128i hi_nibbles = dec_hi_nibbles(in);
+		__m128i slash, idx, out;
+		uint32_t last;
+
+		if (!dec_valid(in, hi_nibbles)) {
+			break;
+		}
+
+		slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+		idx = _mm_add_epi8(in, _mm_shuffle_epi8(lut_roll,
+							_mm_add_epi8(slash, hi_nibbles)));
+
+		/* Merge pairs of sextets, then pairs of 12-bit halves, and
+		 * gather the 3 bytes of each 32-bit lane, most significant first
+		 */
+		out = _mm_maddubs_epi16(idx, _mm_set1_epi32(0x01400140));
+		out = _mm_madd_epi16(out, _mm_set1_epi32(0x00011000));
+		out = _mm_shuffle_epi8(out, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9,
+							  8, 14, 13, 12, -1, -1, -1, -1));
+
+		/* Only 12 bytes are left in the destination */
+		_mm_storel_epi64((__m128i *)dst, out);
+		last = _mm_cvtsi128_si32(_mm_srli_si128(out, 8));
+		memcpy(&dst[8], &last, sizeof(last));
+	}
+
+	return done;
+}
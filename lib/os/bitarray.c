@@ -10,6 +10,7 @@
 #include <stdio.h>
 #include <zephyr/sys/bitarray.h>
 #include <zephyr/sys/check.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/sys_io.h>
 
 /* Number of bits represented by one bundle */
@@ -45,6 +46,159 @@ static void setup_bundle_data(sys_bitarray_t *bitarray,
 	}
 }
 
+/*
+ * Update the summary bits of a range of bundles after they were modified.
+ *
+ * @param bitarray Bitarray struct
+ * @param sidx     Index of the first modified bundle
+ * @param eidx     Index of the last modified bundle
+ */
+static void update_summary(sys_bitarray_t *bitarray, size_t sidx, size_t eidx)
+{
+	size_t idx;
+
+	if (bitarray->summary == NULL) {
+		return;
+	}
+
+	for (idx = sidx; idx <= eidx; idx++) {
+		if (bitarray->bundles[idx] == ~0U) {
+			bitarray->summary[idx / 32] |= BIT(idx % 32);
+		} else {
+			bitarray->summary[idx / 32] &= ~BIT(idx % 32);
+		}
+	}
+}
+
+/*
+ * Find the first bundle, from @p idx, which may have clear bits.
+ *
+ * @param bitarray Bitarray struct
+ * @param idx      Index of the bundle to start from
+ * @param nidx     Number of bundles to look through
+ *
+ * @return Index of the bundle, or @p nidx if all are set.
+ */
+static size_t next_clear_bundle(sys_bitarray_t *bitarray, size_t idx,
+				size_t nidx)
+{
+	uint32_t word;
+
+	if (bitarray->summary == NULL) {
+		return idx;
+	}
+
+	while (idx < nidx) {
+		word = ~bitarray->summary[idx / 32] & ~BIT_MASK(idx % 32);
+		if (word != 0U) {
+			idx = ROUND_DOWN(idx, 32) + u32_count_trailing_zeros(word);
+			break;
+		}
+
+		idx = ROUND_DOWN(idx, 32) + 32;
+	}
+
+	return MIN(idx, nidx);
+}
+
+/*
+ * Find the first region of clear bits large enough for an allocation.
+ *
+ * The bundles are scanned a word at a time, counting the trailing zeros
+ * to find the runs of clear bits, rather than matching the region at
+ * every candidate offset.
+ *
+ * @param[in]  bitarray Bitarray struct
+ * @param[in]  num_bits Number of bits in the region
+ * @param[in]  start    Bit location to start searching from
+ * @param[out] offset   Starting bit location of the region
+ *
+ * @retval     true     If a region was found
+ * @retval     false    No region is large enough
+ */
+static bool find_region(sys_bitarray_t *bitarray, size_t num_bits,
+			size_t start, size_t *offset)
+{
+	size_t nidx = DIV_ROUND_UP(bitarray->num_bits, bundle_bitness(bitarray));
+	size_t tail = bitarray->num_bits % bundle_bitness(bitarray);
+	size_t run_start = start;
+	size_t run_len = 0;
+	size_t idx, next, pos, len;
+	uint32_t bundle, rest;
+
+	for (idx = start / bundle_bitness(bitarray); idx < nidx; idx++) {
+		/* Skip the bundles known to be all set */
+		next = next_clear_bundle(bitarray, idx, nidx);
+		if (next != idx) {
+			run_len = 0;
+			idx = next;
+			if (idx == nidx) {
+				break;
+			}
+		}
+
+		bundle = bitarray->bundles[idx];
+
+		/* Bits before the start or after the end are not available */
+		if (idx == start / bundle_bitness(bitarray)) {
+			bundle |= BIT_MASK(start % bundle_bitness(bitarray));
+		}
+
+		if ((idx == nidx - 1) && (tail != 0)) {
+			bundle |= ~BIT_MASK(tail);
+		}
+
+		if (run_len == 0) {
+			run_start = idx * bundle_bitness(bitarray);
+		}
+
+		if (bundle == 0U) {
+			run_len += bundle_bitness(bitarray);
+			if (run_len >= num_bits) {
+				goto found;
+			}
+
+			continue;
+		}
+
+		/* Clear bits at the start of the bundle extend the current run */
+		pos = u32_count_trailing_zeros(bundle);
+		run_len += pos;
+		if (run_len >= num_bits) {
+			goto found;
+		}
+
+		/* Then look for runs starting within the bundle */
+		while (pos < bundle_bitness(bitarray)) {
+			rest = ~bundle >> pos;
+			if (rest == 0U) {
+				/* All remaining bits are set */
+				run_len = 0;
+				break;
+			}
+
+			pos += u32_count_trailing_zeros(rest);
+			rest = bundle >> pos;
+			len = (rest == 0U) ? (bundle_bitness(bitarray) - pos)
+					   : u32_count_trailing_zeros(rest);
+
+			run_start = idx * bundle_bitness(bitarray) + pos;
+			run_len = len;
+			if (run_len >= num_bits) {
+				goto found;
+			}
+
+			pos += len;
+		}
+	}
+
+	return false;
+
+found:
+	*offset = run_start;
+	return true;
+}
+
 /*
  * Find out if the bits in a region is all set or all clear.
  *
@@ -208,6 +362,8 @@ static void set_region(sys_bitarray_t *bitarray, size_t offset,
 			}
 		}
 	}
+
+	update_summary(bitarray, bd->sidx, bd->eidx);
 }
 
 int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
@@ -230,6 +386,7 @@ int sys_bitarray_set_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -258,6 +415,7 @@ int sys_bitarray_clear_bit(sys_bitarray_t *bitarray, size_t bit)
 	off = bit % bundle_bitness(bitarray);
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -334,6 +492,7 @@ int sys_bitarray_test_and_set_bit(sys_bitarray_t *bitarray, size_t bit, int *pre
 	}
 
 	bitarray->bundles[idx] |= BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -373,6 +532,7 @@ int sys_bitarray_test_and_clear_bit(sys_bitarray_t *bitarray, size_t bit, int *p
 	}
 
 	bitarray->bundles[idx] &= ~BIT(off);
+	update_summary(bitarray, idx, idx);
 
 	ret = 0;
 
@@ -385,11 +545,7 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		       size_t *offset)
 {
 	k_spinlock_key_t key;
-	uint32_t bit_idx;
 	int ret;
-	struct bundle_data bd;
-	size_t off_start, off_end;
-	size_t mismatch;
 
 	__ASSERT_NO_MSG(bitarray != NULL);
 	__ASSERT_NO_MSG(bitarray->num_bits > 0);
@@ -406,48 +562,66 @@ int sys_bitarray_alloc(sys_bitarray_t *bitarray, size_t num_bits,
 		goto out;
 	}
 
-	bit_idx = 0;
+	if (find_region(bitarray, num_bits, 0, offset)) {
+		set_region(bitarray, *offset, num_bits, true, NULL);
+		ret = 0;
+	} else {
+		ret = -ENOSPC;
+	}
 
-	/* Find the first non-allocated bit by looking at bundles
-	 * instead of individual bits.
-	 *
-	 * On RISC-V 64-bit, it complains about undefined reference to `ffs`.
-	 * So don't use this on RISCV64.
-	 */
-	for (size_t idx = 0; idx < bitarray->num_bundles; idx++) {
-		if (~bitarray->bundles[idx] == 0U) {
-			/* bundle is all 1s => all allocated, skip */
-			bit_idx += bundle_bitness(bitarray);
-			continue;
-		}
+out:
+	k_spin_unlock(&bitarray->lock, key);
+	return ret;
+}
 
-		if (bitarray->bundles[idx] != 0U) {
-			/* Find the first free bit in bundle if not all free */
-			off_start = find_lsb_set(~bitarray->bundles[idx]) - 1;
-			bit_idx += off_start;
-		}
+int sys_bitarray_alloc_multi(sys_bitarray_t *bitarray, size_t num_bits,
+			     size_t count, size_t *offsets)
+{
+	k_spinlock_key_t key;
+	size_t start = 0;
+	size_t i;
+	int ret;
 
-		break;
+	__ASSERT_NO_MSG(bitarray != NULL);
+	__ASSERT_NO_MSG(bitarray->num_bits > 0);
+
+	key = k_spin_lock(&bitarray->lock);
+
+	CHECKIF(offsets == NULL) {
+		ret = -EINVAL;
+		goto out;
 	}
 
-	off_end = bitarray->num_bits - num_bits;
-	ret = -ENOSPC;
-	while (bit_idx <= off_end) {
-		if (match_region(bitarray, bit_idx, num_bits, false,
-				 &bd, &mismatch)) {
-			set_region(bitarray, bit_idx, num_bits, true, &bd);
+	if ((num_bits == 0) || (num_bits > bitarray->num_bits) ||
+	    (count > bitarray->num_bits / num_bits)) {
+		ret = -EINVAL;
+		goto out;
+	}
 
-			*offset = bit_idx;
-			ret = 0;
+	/* As the first region found is taken every time, the next one
+	 * can only be after it.
+	 */
+	for (i = 0; i < count; i++) {
+		if (!find_region(bitarray, num_bits, start, &offsets[i])) {
 			break;
 		}
 
-		/* Fast-forward to the bit just after
-		 * the mismatched bit.
-		 */
-		bit_idx = mismatch + 1;
+		set_region(bitarray, offsets[i], num_bits, true, NULL);
+		start = offsets[i] + num_bits;
 	}
 
+	if (i == count) {
+		ret = 0;
+		goto out;
+	}
+
+	/* Not enough space, undo the allocations */
+	while (i-- > 0) {
+		set_region(bitarray, offsets[i], num_bits, false, NULL);
+	}
+
+	ret = -ENOSPC;
+
 out:
 	k_spin_unlock(&bitarray->lock, key);
 	return ret;
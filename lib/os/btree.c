@@ -0,0 +1,625 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/btree.h>
+#include <zephyr/sys/util.h>
+
+/*
+ * Inner nodes route a key to the child after the keys it is not below,
+ * i.e. each key of an inner node is not above the keys of the subtree
+ * on its right and above those of the subtree on its left. The leaves
+ * hold all the entries.
+ *
+ * Nodes are split on the way down when full, and refilled on the way
+ * down when at their minimum, so that an insertion or a removal only
+ * needs a single pass from the root, without a stack of parents.
+ */
+
+#define MAX_KEYS CONFIG_BTREE_ORDER
+#define MIN_KEYS ((MAX_KEYS - 1) / 2)
+
+struct sys_btree_node {
+	uint64_t keys[MAX_KEYS];
+	union {
+		uint64_t values[MAX_KEYS];
+		struct sys_btree_node *children[MAX_KEYS + 1];
+	};
+	/* Next leaf, in key order */
+	struct sys_btree_node *next;
+	uint16_t n;
+};
+
+static struct sys_btree_node *node_alloc(struct sys_btree *tree)
+{
+	struct sys_btree_node *node = tree->alloc(NULL, sizeof(*node));
+
+	if (node != NULL) {
+		node->next = NULL;
+		node->n = 0;
+	}
+
+	return node;
+}
+
+static inline void node_free(struct sys_btree *tree, struct sys_btree_node *node)
+{
+	(void)tree->alloc(node, 0);
+}
+
+/* Index of the first key of the node which is not below key */
+static inline uint16_t lower_idx(const struct sys_btree_node *node, uint64_t key)
+{
+	uint16_t lo = 0, hi = node->n, mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (node->keys[mid] < key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+/* Index of the first key of the node which is above key, which is the
+ * child of an inner node holding key.
+ */
+static inline uint16_t upper_idx(const struct sys_btree_node *node, uint64_t key)
+{
+	uint16_t lo = 0, hi = node->n, mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (node->keys[mid] <= key) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static struct sys_btree_node *find_leaf(const struct sys_btree *tree, uint64_t key)
+{
+	struct sys_btree_node *node = tree->root;
+
+	for (uint8_t h = tree->height; h > 1; h--) {
+		node = node->children[upper_idx(node, key)];
+	}
+
+	return node;
+}
+
+/* Split the full child i of parent into two nodes */
+static int split_child(struct sys_btree *tree, struct sys_btree_node *parent, uint16_t i,
+		       bool leaf)
+{
+	struct sys_btree_node *left = parent->children[i];
+	struct sys_btree_node *right = node_alloc(tree);
+	uint16_t mid = MAX_KEYS / 2;
+	uint64_t sep;
+
+	if (right == NULL) {
+		return -ENOMEM;
+	}
+
+	if (leaf) {
+		right->n = MAX_KEYS - mid;
+		memcpy(right->keys, &left->keys[mid], right->n * sizeof(uint64_t));
+		memcpy(right->values, &left->values[mid], right->n * sizeof(uint64_t));
+		right->next = left->next;
+		left->next = right;
+		sep = right->keys[0];
+	} else {
+		/* The middle key moves up to the parent */
+		right->n = MAX_KEYS - mid - 1;
+		memcpy(right->keys, &left->keys[mid + 1], right->n * sizeof(uint64_t));
+		memcpy(right->children, &left->children[mid + 1],
+		       (right->n + 1) * sizeof(struct sys_btree_node *));
+		sep = left->keys[mid];
+	}
+
+	left->n = mid;
+
+	memmove(&parent->keys[i + 1], &parent->keys[i], (parent->n - i) * sizeof(uint64_t));
+	memmove(&parent->children[i + 2], &parent->children[i + 1],
+		(parent->n - i) * sizeof(struct sys_btree_node *));
+	parent->keys[i] = sep;
+	parent->children[i + 1] = right;
+	parent->n++;
+
+	return 0;
+}
+
+/* Set the value of an existing key, for when the tree could not be
+ * split to insert it.
+ */
+static int replace(struct sys_btree *tree, uint64_t key, uint64_t value, uint64_t *old_value)
+{
+	struct sys_btree_node *leaf = find_leaf(tree, key);
+	uint16_t i = lower_idx(leaf, key);
+
+	if (i == leaf->n || leaf->keys[i] != key) {
+		return -ENOMEM;
+	}
+
+	if (old_value != NULL) {
+		*old_value = leaf->values[i];
+	}
+	leaf->values[i] = value;
+
+	return 0;
+}
+
+int sys_btree_insert(struct sys_btree *tree, uint64_t key, uint64_t value, uint64_t *old_value)
+{
+	struct sys_btree_node *node;
+	uint16_t i;
+
+	if (tree->root == NULL) {
+		tree->root = node_alloc(tree);
+		if (tree->root == NULL) {
+			return -ENOMEM;
+		}
+		tree->height = 1;
+	}
+
+	if (tree->root->n == MAX_KEYS) {
+		/* Grow the tree with a new root above the one to split */
+		node = node_alloc(tree);
+		if (node == NULL) {
+			return replace(tree, key, value, old_value);
+		}
+
+		node->children[0] = tree->root;
+		if (split_child(tree, node, 0, tree->height == 1) < 0) {
+			node_free(tree, node);
+			return replace(tree, key, value, old_value);
+		}
+
+		tree->root = node;
+		tree->height++;
+	}
+
+	node = tree->root;
+	for (uint8_t h = tree->height; h > 1; h--) {
+		i = upper_idx(node, key);
+
+		if (node->children[i]->n == MAX_KEYS) {
+			if (split_child(tree, node, i, h == 2) < 0) {
+				return replace(tree, key, value, old_value);
+			}
+
+			if (key >= node->keys[i]) {
+				i++;
+			}
+		}
+
+		node = node->children[i];
+	}
+
+	i = lower_idx(node, key);
+	if (i < node->n && node->keys[i] == key) {
+		if (old_value != NULL) {
+			*old_value = node->values[i];
+		}
+		node->values[i] = value;
+		return 0;
+	}
+
+	memmove(&node->keys[i + 1], &node->keys[i], (node->n - i) * sizeof(uint64_t));
+	memmove(&node->values[i + 1], &node->values[i], (node->n - i) * sizeof(uint64_t));
+	node->keys[i] = key;
+	node->values[i] = value;
+	node->n++;
+	tree->size++;
+
+	return 1;
+}
+
+/* Move the last entry of the child i - 1 of parent to the child i */
+static void borrow_left(struct sys_btree_node *parent, uint16_t i, bool leaf)
+{
+	struct sys_btree_node *left = parent->children[i - 1];
+	struct sys_btree_node *child = parent->children[i];
+
+	memmove(&child->keys[1], &child->keys[0], child->n * sizeof(uint64_t));
+
+	if (leaf) {
+		memmove(&child->values[1], &child->values[0], child->n * sizeof(uint64_t));
+		child->keys[0] = left->keys[left->n - 1];
+		child->values[0] = left->values[left->n - 1];
+		parent->keys[i - 1] = child->keys[0];
+	} else {
+		memmove(&child->children[1], &child->children[0],
+			(child->n + 1) * sizeof(struct sys_btree_node *));
+		child->keys[0] = parent->keys[i - 1];
+		child->children[0] = left->children[left->n];
+		parent->keys[i - 1] = left->keys[left->n - 1];
+	}
+
+	left->n--;
+	child->n++;
+}
+
+/* Move the first entry of the child i + 1 of parent to the child i */
+static void borrow_right(struct sys_btree_node *parent, uint16_t i, bool leaf)
+{
+	struct sys_btree_node *child = parent->children[i];
+	struct sys_btree_node *right = parent->children[i + 1];
+
+	if (leaf) {
+		child->keys[child->n] = right->keys[0];
+		child->values[child->n] = right->values[0];
+		memmove(&right->values[0], &right->values[1], (right->n - 1) * sizeof(uint64_t));
+	} else {
+		child->keys[child->n] = parent->keys[i];
+		child->children[child->n + 1] = right->children[0];
+		memmove(&right->children[0], &right->children[1],
+			right->n * sizeof(struct sys_btree_node *));
+	}
+
+	parent->keys[i] = leaf ? right->keys[1] : right->keys[0];
+	memmove(&right->keys[0], &right->keys[1], (right->n - 1) * sizeof(uint64_t));
+
+	right->n--;
+	child->n++;
+}
+
+/* Merge the child i + 1 of parent into the child i */
+static void merge(struct sys_btree *tree, struct sys_btree_node *parent, uint16_t i, bool leaf)
+{
+	struct sys_btree_node *left = parent->children[i];
+	struct sys_btree_node *right = parent->children[i + 1];
+
+	if (leaf) {
+		memcpy(&left->keys[left->n], right->keys, right->n * sizeof(uint64_t));
+		memcpy(&left->values[left->n], right->values, right->n * sizeof(uint64_t));
+		left->n += right->n;
+		left->next = right->next;
+	} else {
+		/* The separator moves down between the keys of both */
+		left->keys[left->n] = parent->keys[i];
+		memcpy(&left->keys[left->n + 1], right->keys, right->n * sizeof(uint64_t));
+		memcpy(&left->children[left->n + 1], right->children,
+		       (right->n + 1) * sizeof(struct sys_btree_node *));
+		left->n += right->n + 1;
+	}
+
+	memmove(&parent->keys[i], &parent->keys[i + 1], (parent->n - i - 1) * sizeof(uint64_t));
+	memmove(&parent->children[i + 1], &parent->children[i + 2],
+		(parent->n - i - 1) * sizeof(struct sys_btree_node *));
+	parent->n--;
+
+	node_free(tree, right);
+}
+
+/* Refill the child i of parent, at its minimum, from a sibling, and
+ * return the index of the child now covering its keys.
+ */
+static uint16_t refill_child(struct sys_btree *tree, struct sys_btree_node *parent, uint16_t i,
+			     bool leaf)
+{
+	if (i > 0 && parent->children[i - 1]->n > MIN_KEYS) {
+		borrow_left(parent, i, leaf);
+		return i;
+	}
+
+	if (i < parent->n && parent->children[i + 1]->n > MIN_KEYS) {
+		borrow_right(parent, i, leaf);
+		return i;
+	}
+
+	if (i > 0) {
+		merge(tree, parent, i - 1, leaf);
+		return i - 1;
+	}
+
+	merge(tree, parent, i, leaf);
+	return i;
+}
+
+bool sys_btree_remove(struct sys_btree *tree, uint64_t key, uint64_t *value)
+{
+	struct sys_btree_node *node = tree->root;
+	uint8_t h = tree->height;
+	uint16_t i;
+
+	if (node == NULL) {
+		return false;
+	}
+
+	while (h > 1) {
+		i = upper_idx(node, key);
+
+		if (node->children[i]->n <= MIN_KEYS) {
+			i = refill_child(tree, node, i, h == 2);
+
+			if (node->n == 0) {
+				/* The root merged its last two children */
+				tree->root = node->children[0];
+				tree->height--;
+				node_free(tree, node);
+				node = tree->root;
+				h--;
+				continue;
+			}
+		}
+
+		node = node->children[i];
+		h--;
+	}
+
+	i = lower_idx(node, key);
+	if (i == node->n || node->keys[i] != key) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = node->values[i];
+	}
+
+	memmove(&node->keys[i], &node->keys[i + 1], (node->n - i - 1) * sizeof(uint64_t));
+	memmove(&node->values[i], &node->values[i + 1], (node->n - i - 1) * sizeof(uint64_t));
+	node->n--;
+	tree->size--;
+
+	if (tree->size == 0) {
+		node_free(tree, tree->root);
+		tree->root = NULL;
+		tree->height = 0;
+	}
+
+	return true;
+}
+
+bool sys_btree_get(const struct sys_btree *tree, uint64_t key, uint64_t *value)
+{
+	const struct sys_btree_node *leaf;
+	uint16_t i;
+
+	if (tree->root == NULL) {
+		return false;
+	}
+
+	leaf = find_leaf(tree, key);
+	i = lower_idx(leaf, key);
+	if (i == leaf->n || leaf->keys[i] != key) {
+		return false;
+	}
+
+	if (value != NULL) {
+		*value = leaf->values[i];
+	}
+
+	return true;
+}
+
+static void clear_node(struct sys_btree *tree, struct sys_btree_node *node, uint8_t h,
+		       sys_btree_callback_t cb, void *cookie)
+{
+	if (h > 1) {
+		for (uint16_t i = 0; i <= node->n; i++) {
+			clear_node(tree, node->children[i], h - 1, cb, cookie);
+		}
+	} else if (cb != NULL) {
+		for (uint16_t i = 0; i < node->n; i++) {
+			cb(node->keys[i], node->values[i], cookie);
+		}
+	}
+
+	node_free(tree, node);
+}
+
+void sys_btree_clear(struct sys_btree *tree, sys_btree_callback_t cb, void *cookie)
+{
+	if (tree->root != NULL) {
+		clear_node(tree, tree->root, tree->height, cb, cookie);
+	}
+
+	tree->root = NULL;
+	tree->size = 0;
+	tree->height = 0;
+}
+
+/* Free the nodes of a level, linked by their next pointer, with their
+ * subtrees of height h.
+ */
+static void clear_level(struct sys_btree *tree, struct sys_btree_node *node, uint8_t h)
+{
+	struct sys_btree_node *next;
+
+	while (node != NULL) {
+		next = node->next;
+		clear_node(tree, node, h, NULL, NULL);
+		node = next;
+	}
+}
+
+static uint64_t subtree_min(const struct sys_btree_node *node, uint8_t h)
+{
+	for (; h > 1; h--) {
+		node = node->children[0];
+	}
+
+	return node->keys[0];
+}
+
+/* Build the level above count nodes of height h, linked from first,
+ * spreading them evenly, and return its first node.
+ */
+static struct sys_btree_node *build_level(struct sys_btree *tree, struct sys_btree_node *first,
+					  size_t count, uint8_t h, size_t *parents)
+{
+	size_t p = DIV_ROUND_UP(count, MAX_KEYS + 1);
+	struct sys_btree_node *head = NULL, *prev = NULL, *node;
+	struct sys_btree_node *child = first;
+
+	for (size_t j = 0; j < p; j++) {
+		size_t n = count / p + (j < count % p ? 1 : 0);
+
+		node = node_alloc(tree);
+		if (node == NULL) {
+			clear_level(tree, head, h + 1);
+			clear_level(tree, child, h);
+			return NULL;
+		}
+
+		for (size_t k = 0; k < n; k++) {
+			if (k > 0) {
+				node->keys[k - 1] = subtree_min(child, h);
+			}
+			node->children[k] = child;
+			child = child->next;
+		}
+		node->n = n - 1;
+
+		if (prev != NULL) {
+			prev->next = node;
+		} else {
+			head = node;
+		}
+		prev = node;
+	}
+
+	/* Only leaves are kept linked */
+	if (h > 1) {
+		for (node = first; node != NULL; node = child) {
+			child = node->next;
+			node->next = NULL;
+		}
+	}
+
+	*parents = p;
+
+	return head;
+}
+
+int sys_btree_bulk_load(struct sys_btree *tree, const uint64_t *keys, const uint64_t *values,
+			size_t n)
+{
+	struct sys_btree_node *head = NULL, *prev = NULL, *node;
+	size_t count, off = 0;
+	uint8_t h = 1;
+
+	if (tree->root != NULL) {
+		return -EBUSY;
+	}
+
+	for (size_t i = 1; i < n; i++) {
+		if (keys[i] <= keys[i - 1]) {
+			return -EINVAL;
+		}
+	}
+
+	if (n == 0) {
+		return 0;
+	}
+
+	count = DIV_ROUND_UP(n, MAX_KEYS);
+
+	for (size_t j = 0; j < count; j++) {
+		size_t len = n / count + (j < n % count ? 1 : 0);
+
+		node = node_alloc(tree);
+		if (node == NULL) {
+			clear_level(tree, head, 1);
+			return -ENOMEM;
+		}
+
+		memcpy(node->keys, &keys[off], len * sizeof(uint64_t));
+		memcpy(node->values, &values[off], len * sizeof(uint64_t));
+		node->n = len;
+		off += len;
+
+		if (prev != NULL) {
+			prev->next = node;
+		} else {
+			head = node;
+		}
+		prev = node;
+	}
+
+	while (count > 1) {
+		head = build_level(tree, head, count, h, &count);
+		if (head == NULL) {
+			return -ENOMEM;
+		}
+		h++;
+	}
+
+	tree->root = head;
+	tree->height = h;
+	tree->size = n;
+
+	return 0;
+}
+
+static inline bool iterator_load(struct sys_btree_iterator *it)
+{
+	if (it->node == NULL) {
+		return false;
+	}
+
+	it->key = it->node->keys[it->pos];
+	it->value = it->node->values[it->pos];
+
+	return true;
+}
+
+bool sys_btree_first(const struct sys_btree *tree, struct sys_btree_iterator *it)
+{
+	const struct sys_btree_node *node = tree->root;
+
+	for (uint8_t h = tree->height; h > 1; h--) {
+		node = node->children[0];
+	}
+
+	it->node = node;
+	it->pos = 0;
+
+	return iterator_load(it);
+}
+
+bool sys_btree_lower_bound(const struct sys_btree *tree, uint64_t key,
+			   struct sys_btree_iterator *it)
+{
+	const struct sys_btree_node *leaf;
+
+	it->node = NULL;
+	it->pos = 0;
+
+	if (tree->root == NULL) {
+		return false;
+	}
+
+	leaf = find_leaf(tree, key);
+	it->pos = lower_idx(leaf, key);
+	it->node = leaf;
+
+	/* All keys of the next leaf are above key */
+	if (it->pos == leaf->n) {
+		it->node = leaf->next;
+		it->pos = 0;
+	}
+
+	return iterator_load(it);
+}
+
+bool sys_btree_next(struct sys_btree_iterator *it)
+{
+	if (++it->pos == it->node->n) {
+		it->node = it->node->next;
+		it->pos = 0;
+	}
+
+	return iterator_load(it);
+}
@@ -15,6 +15,10 @@
 #include <zephyr/sys/util.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/logging/log.h>
+#ifdef CONFIG_CBPRINTF_PACKAGE_PRECOMPILED
+#include <zephyr/init.h>
+#include <zephyr/sys/iterable_sections.h>
+#endif
 LOG_MODULE_REGISTER(cbprintf_package, CONFIG_CBPRINTF_PACKAGE_LOG_LEVEL);
 
 #if defined(CONFIG_CBPRINTF_PACKAGE_SUPPORT_TAGGED_ARGUMENTS) && \
@@ -1163,3 +1167,42 @@ calculate_string_length:
 
 	return out_len;
 }
+
+#ifdef CONFIG_CBPRINTF_PACKAGE_PRECOMPILED
+int cbprintf_package_layouts_check(void)
+{
+	int cnt = 0;
+
+	STRUCT_SECTION_FOREACH(cbprintf_package_layout, layout) {
+		const uint8_t *str_pos = &layout->str_pos[layout->hdr.desc.ro_str_cnt];
+
+		if (layout->fmt == NULL) {
+			continue;
+		}
+
+		for (unsigned int i = 0; i < layout->hdr.desc.rw_str_cnt; i++) {
+			uint8_t arg_idx = str_pos[2 * i];
+
+			if (is_ptr(layout->fmt, arg_idx)) {
+				LOG_WRN("(unsigned) char * used for %%p argument. "
+					"It must be cast to void * because it is packaged "
+					"as a string. String:\"%s\" argument:%d",
+					layout->fmt, arg_idx);
+				cnt++;
+				break;
+			}
+		}
+	}
+
+	return cnt;
+}
+
+static int layouts_check_init(void)
+{
+	(void)cbprintf_package_layouts_check();
+
+	return 0;
+}
+
+SYS_INIT(layouts_check_init, POST_KERNEL, 0);
+#endif /* CONFIG_CBPRINTF_PACKAGE_PRECOMPILED */
@@ -6,11 +6,622 @@
 
 #include <zephyr/sys/crc.h>
 
+#include "crc_internal.h"
+
+#ifdef CONFIG_CRC_SLICING_BY_8
+/* Slicing-by-8 tables generated from polynomial 0x8408 (0x1021 reflected) */
+static const uint16_t crc16_ccitt_table[8][256] = {
+	{
+		0x0000U, 0x1189U, 0x2312U, 0x329BU, 0x4624U, 0x57ADU, 0x6536U, 0x74BFU,
+		0x8C48U, 0x9DC1U, 0xAF5AU, 0xBED3U, 0xCA6CU, 0xDBE5U, 0xE97EU, 0xF8F7U,
+		0x1081U, 0x0108U, 0x3393U, 0x221AU, 0x56A5U, 0x472CU, 0x75B7U, 0x643EU,
+		0x9CC9U, 0x8D40U, 0xBFDBU, 0xAE52U, 0xDAEDU, 0xCB64U, 0xF9FFU, 0xE876U,
+		0x2102U, 0x308BU, 0x0210U, 0x1399U, 0x6726U, 0x76AFU, 0x4434U, 0x55BDU,
+		0xAD4AU, 0xBCC3U, 0x8E58U, 0x9FD1U, 0xEB6EU, 0xFAE7U, 0xC87CU, 0xD9F5U,
+		0x3183U, 0x200AU, 0x1291U, 0x0318U, 0x77A7U, 0x662EU, 0x54B5U, 0x453CU,
+		0xBDCBU, 0xAC42U, 0x9ED9U, 0x8F50U, 0xFBEFU, 0xEA66U, 0xD8FDU, 0xC974U,
+		0x4204U, 0x538DU, 0x6116U, 0x709FU, 0x0420U, 0x15A9U, 0x2732U, 0x36BBU,
+		0xCE4CU, 0xDFC5U, 0xED5EU, 0xFCD7U, 0x8868U, 0x99E1U, 0xAB7AU, 0xBAF3U,
+		0x5285U, 0x430CU, 0x7197U, 0x601EU, 0x14A1U, 0x0528U, 0x37B3U, 0x263AU,
+		0xDECDU, 0xCF44U, 0xFDDFU, 0xEC56U, 0x98E9U, 0x8960U, 0xBBFBU, 0xAA72U,
+		0x6306U, 0x728FU, 0x4014U, 0x519DU, 0x2522U, 0x34ABU, 0x0630U, 0x17B9U,
+		0xEF4EU, 0xFEC7U, 0xCC5CU, 0xDDD5U, 0xA96AU, 0xB8E3U, 0x8A78U, 0x9BF1U,
+		0x7387U, 0x620EU, 0x5095U, 0x411CU, 0x35A3U, 0x242AU, 0x16B1U, 0x0738U,
+		0xFFCFU, 0xEE46U, 0xDCDDU, 0xCD54U, 0xB9EBU, 0xA862U, 0x9AF9U, 0x8B70U,
+		0x8408U, 0x9581U, 0xA71AU, 0xB693U, 0xC22CU, 0xD3A5U, 0xE13EU, 0xF0B7U,
+		0x0840U, 0x19C9U, 0x2B52U, 0x3ADBU, 0x4E64U, 0x5FEDU, 0x6D76U, 0x7CFFU,
+		0x9489U, 0x8500U, 0xB79BU, 0xA612U, 0xD2ADU, 0xC324U, 0xF1BFU, 0xE036U,
+		0x18C1U, 0x0948U, 0x3BD3U, 0x2A5AU, 0x5EE5U, 0x4F6CU, 0x7DF7U, 0x6C7EU,
+		0xA50AU, 0xB483U, 0x8618U, 0x9791U, 0xE32EU, 0xF2A7U, 0xC03CU, 0xD1B5U,
+		0x2942U, 0x38CBU, 0x0A50U, 0x1BD9U, 0x6F66U, 0x7EEFU, 0x4C74U, 0x5DFDU,
+		0xB58BU, 0xA402U, 0x9699U, 0x8710U, 0xF3AFU, 0xE226U, 0xD0BDU, 0xC134U,
+		0x39C3U, 0x284AU, 0x1AD1U, 0x0B58U, 0x7FE7U, 0x6E6EU, 0x5CF5U, 0x4D7CU,
+		0xC60CU, 0xD785U, 0xE51EU, 0xF497U, 0x8028U, 0x91A1U, 0xA33AU, 0xB2B3U,
+		0x4A44U, 0x5BCDU, 0x6956U, 0x78DFU, 0x0C60U, 0x1DE9U, 0x2F72U, 0x3EFBU,
+		0xD68DU, 0xC704U, 0xF59FU, 0xE416U, 0x90A9U, 0x8120U, 0xB3BBU, 0xA232U,
+		0x5AC5U, 0x4B4CU, 0x79D7U, 0x685EU, 0x1CE1U, 0x0D68U, 0x3FF3U, 0x2E7AU,
+		0xE70EU, 0xF687U, 0xC41CU, 0xD595U, 0xA12AU, 0xB0A3U, 0x8238U, 0x93B1U,
+		0x6B46U, 0x7ACFU, 0x4854U, 0x59DDU, 0x2D62U, 0x3CEBU, 0x0E70U, 0x1FF9U,
+		0xF78FU, 0xE606U, 0xD49DU, 0xC514U, 0xB1ABU, 0xA022U, 0x92B9U, 0x8330U,
+		0x7BC7U, 0x6A4EU, 0x58D5U, 0x495CU, 0x3DE3U, 0x2C6AU, 0x1EF1U, 0x0F78U
+	},
+	{
+		0x0000U, 0x19D8U, 0x33B0U, 0x2A68U, 0x6760U, 0x7EB8U, 0x54D0U, 0x4D08U,
+		0xCEC0U, 0xD718U, 0xFD70U, 0xE4A8U, 0xA9A0U, 0xB078U, 0x9A10U, 0x83C8U,
+		0x9591U, 0x8C49U, 0xA621U, 0xBFF9U, 0xF2F1U, 0xEB29U, 0xC141U, 0xD899U,
+		0x5B51U, 0x4289U, 0x68E1U, 0x7139U, 0x3C31U, 0x25E9U, 0x0F81U, 0x1659U,
+		0x2333U, 0x3AEBU, 0x1083U, 0x095BU, 0x4453U, 0x5D8BU, 0x77E3U, 0x6E3BU,
+		0xEDF3U, 0xF42BU, 0xDE43U, 0xC79BU, 0x8A93U, 0x934BU, 0xB923U, 0xA0FBU,
+		0xB6A2U, 0xAF7AU, 0x8512U, 0x9CCAU, 0xD1C2U, 0xC81AU, 0xE272U, 0xFBAAU,
+		0x7862U, 0x61BAU, 0x4BD2U, 0x520AU, 0x1F02U, 0x06DAU, 0x2CB2U, 0x356AU,
+		0x4666U, 0x5FBEU, 0x75D6U, 0x6C0EU, 0x2106U, 0x38DEU, 0x12B6U, 0x0B6EU,
+		0x88A6U, 0x917EU, 0xBB16U, 0xA2CEU, 0xEFC6U, 0xF61EU, 0xDC76U, 0xC5AEU,
+		0xD3F7U, 0xCA2FU, 0xE047U, 0xF99FU, 0xB497U, 0xAD4FU, 0x8727U, 0x9EFFU,
+		0x1D37U, 0x04EFU, 0x2E87U, 0x375FU, 0x7A57U, 0x638FU, 0x49E7U, 0x503FU,
+		0x6555U, 0x7C8DU, 0x56E5U, 0x4F3DU, 0x0235U, 0x1BEDU, 0x3185U, 0x285DU,
+		0xAB95U, 0xB24DU, 0x9825U, 0x81FDU, 0xCCF5U, 0xD52DU, 0xFF45U, 0xE69DU,
+		0xF0C4U, 0xE91CU, 0xC374U, 0xDAACU, 0x97A4U, 0x8E7CU, 0xA414U, 0xBDCCU,
+		0x3E04U, 0x27DCU, 0x0DB4U, 0x146CU, 0x5964U, 0x40BCU, 0x6AD4U, 0x730CU,
+		0x8CCCU, 0x9514U, 0xBF7CU, 0xA6A4U, 0xEBACU, 0xF274U, 0xD81CU, 0xC1C4U,
+		0x420CU, 0x5BD4U, 0x71BCU, 0x6864U, 0x256CU, 0x3CB4U, 0x16DCU, 0x0F04U,
+		0x195DU, 0x0085U, 0x2AEDU, 0x3335U, 0x7E3DU, 0x67E5U, 0x4D8DU, 0x5455U,
+		0xD79DU, 0xCE45U, 0xE42DU, 0xFDF5U, 0xB0FDU, 0xA925U, 0x834DU, 0x9A95U,
+		0xAFFFU, 0xB627U, 0x9C4FU, 0x8597U, 0xC89FU, 0xD147U, 0xFB2FU, 0xE2F7U,
+		0x613FU, 0x78E7U, 0x528FU, 0x4B57U, 0x065FU, 0x1F87U, 0x35EFU, 0x2C37U,
+		0x3A6EU, 0x23B6U, 0x09DEU, 0x1006U, 0x5D0EU, 0x44D6U, 0x6EBEU, 0x7766U,
+		0xF4AEU, 0xED76U, 0xC71EU, 0xDEC6U, 0x93CEU, 0x8A16U, 0xA07EU, 0xB9A6U,
+		0xCAAAU, 0xD372U, 0xF91AU, 0xE0C2U, 0xADCAU, 0xB412U, 0x9E7AU, 0x87A2U,
+		0x046AU, 0x1DB2U, 0x37DAU, 0x2E02U, 0x630AU, 0x7AD2U, 0x50BAU, 0x4962U,
+		0x5F3BU, 0x46E3U, 0x6C8BU, 0x7553U, 0x385BU, 0x2183U, 0x0BEBU, 0x1233U,
+		0x91FBU, 0x8823U, 0xA24BU, 0xBB93U, 0xF69BU, 0xEF43U, 0xC52BU, 0xDCF3U,
+		0xE999U, 0xF041U, 0xDA29U, 0xC3F1U, 0x8EF9U, 0x9721U, 0xBD49U, 0xA491U,
+		0x2759U, 0x3E81U, 0x14E9U, 0x0D31U, 0x4039U, 0x59E1U, 0x7389U, 0x6A51U,
+		0x7C08U, 0x65D0U, 0x4FB8U, 0x5660U, 0x1B68U, 0x02B0U, 0x28D8U, 0x3100U,
+		0xB2C8U, 0xAB10U, 0x8178U, 0x98A0U, 0xD5A8U, 0xCC70U, 0xE618U, 0xFFC0U
+	},
+	{
+		0x0000U, 0x5ADCU, 0xB5B8U, 0xEF64U, 0x6361U, 0x39BDU, 0xD6D9U, 0x8C05U,
+		0xC6C2U, 0x9C1EU, 0x737AU, 0x29A6U, 0xA5A3U, 0xFF7FU, 0x101BU, 0x4AC7U,
+		0x8595U, 0xDF49U, 0x302DU, 0x6AF1U, 0xE6F4U, 0xBC28U, 0x534CU, 0x0990U,
+		0x4357U, 0x198BU, 0xF6EFU, 0xAC33U, 0x2036U, 0x7AEAU, 0x958EU, 0xCF52U,
+		0x033BU, 0x59E7U, 0xB683U, 0xEC5FU, 0x605AU, 0x3A86U, 0xD5E2U, 0x8F3EU,
+		0xC5F9U, 0x9F25U, 0x7041U, 0x2A9DU, 0xA698U, 0xFC44U, 0x1320U, 0x49FCU,
+		0x86AEU, 0xDC72U, 0x3316U, 0x69CAU, 0xE5CFU, 0xBF13U, 0x5077U, 0x0AABU,
+		0x406CU, 0x1AB0U, 0xF5D4U, 0xAF08U, 0x230DU, 0x79D1U, 0x96B5U, 0xCC69U,
+		0x0676U, 0x5CAAU, 0xB3CEU, 0xE912U, 0x6517U, 0x3FCBU, 0xD0AFU, 0x8A73U,
+		0xC0B4U, 0x9A68U, 0x750CU, 0x2FD0U, 0xA3D5U, 0xF909U, 0x166DU, 0x4CB1U,
+		0x83E3U, 0xD93FU, 0x365BU, 0x6C87U, 0xE082U, 0xBA5EU, 0x553AU, 0x0FE6U,
+		0x4521U, 0x1FFDU, 0xF099U, 0xAA45U, 0x2640U, 0x7C9CU, 0x93F8U, 0xC924U,
+		0x054DU, 0x5F91U, 0xB0F5U, 0xEA29U, 0x662CU, 0x3CF0U, 0xD394U, 0x8948U,
+		0xC38FU, 0x9953U, 0x7637U, 0x2CEBU, 0xA0EEU, 0xFA32U, 0x1556U, 0x4F8AU,
+		0x80D8U, 0xDA04U, 0x3560U, 0x6FBCU, 0xE3B9U, 0xB965U, 0x5601U, 0x0CDDU,
+		0x461AU, 0x1CC6U, 0xF3A2U, 0xA97EU, 0x257BU, 0x7FA7U, 0x90C3U, 0xCA1FU,
+		0x0CECU, 0x5630U, 0xB954U, 0xE388U, 0x6F8DU, 0x3551U, 0xDA35U, 0x80E9U,
+		0xCA2EU, 0x90F2U, 0x7F96U, 0x254AU, 0xA94FU, 0xF393U, 0x1CF7U, 0x462BU,
+		0x8979U, 0xD3A5U, 0x3CC1U, 0x661DU, 0xEA18U, 0xB0C4U, 0x5FA0U, 0x057CU,
+		0x4FBBU, 0x1567U, 0xFA03U, 0xA0DFU, 0x2CDAU, 0x7606U, 0x9962U, 0xC3BEU,
+		0x0FD7U, 0x550BU, 0xBA6FU, 0xE0B3U, 0x6CB6U, 0x366AU, 0xD90EU, 0x83D2U,
+		0xC915U, 0x93C9U, 0x7CADU, 0x2671U, 0xAA74U, 0xF0A8U, 0x1FCCU, 0x4510U,
+		0x8A42U, 0xD09EU, 0x3FFAU, 0x6526U, 0xE923U, 0xB3FFU, 0x5C9BU, 0x0647U,
+		0x4C80U, 0x165CU, 0xF938U, 0xA3E4U, 0x2FE1U, 0x753DU, 0x9A59U, 0xC085U,
+		0x0A9AU, 0x5046U, 0xBF22U, 0xE5FEU, 0x69FBU, 0x3327U, 0xDC43U, 0x869FU,
+		0xCC58U, 0x9684U, 0x79E0U, 0x233CU, 0xAF39U, 0xF5E5U, 0x1A81U, 0x405DU,
+		0x8F0FU, 0xD5D3U, 0x3AB7U, 0x606BU, 0xEC6EU, 0xB6B2U, 0x59D6U, 0x030AU,
+		0x49CDU, 0x1311U, 0xFC75U, 0xA6A9U, 0x2AACU, 0x7070U, 0x9F14U, 0xC5C8U,
+		0x09A1U, 0x537DU, 0xBC19U, 0xE6C5U, 0x6AC0U, 0x301CU, 0xDF78U, 0x85A4U,
+		0xCF63U, 0x95BFU, 0x7ADBU, 0x2007U, 0xAC02U, 0xF6DEU, 0x19BAU, 0x4366U,
+		0x8C34U, 0xD6E8U, 0x398CU, 0x6350U, 0xEF55U, 0xB589U, 0x5AEDU, 0x0031U,
+		0x4AF6U, 0x102AU, 0xFF4EU, 0xA592U, 0x2997U, 0x734BU, 0x9C2FU, 0xC6F3U
+	},
+	{
+		0x0000U, 0x1CBBU, 0x3976U, 0x25CDU, 0x72ECU, 0x6E57U, 0x4B9AU, 0x5721U,
+		0xE5D8U, 0xF963U, 0xDCAEU, 0xC015U, 0x9734U, 0x8B8FU, 0xAE42U, 0xB2F9U,
+		0xC3A1U, 0xDF1AU, 0xFAD7U, 0xE66CU, 0xB14DU, 0xADF6U, 0x883BU, 0x9480U,
+		0x2679U, 0x3AC2U, 0x1F0FU, 0x03B4U, 0x5495U, 0x482EU, 0x6DE3U, 0x7158U,
+		0x8F53U, 0x93E8U, 0xB625U, 0xAA9EU, 0xFDBFU, 0xE104U, 0xC4C9U, 0xD872U,
+		0x6A8BU, 0x7630U, 0x53FDU, 0x4F46U, 0x1867U, 0x04DCU, 0x2111U, 0x3DAAU,
+		0x4CF2U, 0x5049U, 0x7584U, 0x693FU, 0x3E1EU, 0x22A5U, 0x0768U, 0x1BD3U,
+		0xA92AU, 0xB591U, 0x905CU, 0x8CE7U, 0xDBC6U, 0xC77DU, 0xE2B0U, 0xFE0BU,
+		0x16B7U, 0x0A0CU, 0x2FC1U, 0x337AU, 0x645BU, 0x78E0U, 0x5D2DU, 0x4196U,
+		0xF36FU, 0xEFD4U, 0xCA19U, 0xD6A2U, 0x8183U, 0x9D38U, 0xB8F5U, 0xA44EU,
+		0xD516U, 0xC9ADU, 0xEC60U, 0xF0DBU, 0xA7FAU, 0xBB41U, 0x9E8CU, 0x8237U,
+		0x30CEU, 0x2C75U, 0x09B8U, 0x1503U, 0x4222U, 0x5E99U, 0x7B54U, 0x67EFU,
+		0x99E4U, 0x855FU, 0xA092U, 0xBC29U, 0xEB08U, 0xF7B3U, 0xD27EU, 0xCEC5U,
+		0x7C3CU, 0x6087U, 0x454AU, 0x59F1U, 0x0ED0U, 0x126BU, 0x37A6U, 0x2B1DU,
+		0x5A45U, 0x46FEU, 0x6333U, 0x7F88U, 0x28A9U, 0x3412U, 0x11DFU, 0x0D64U,
+		0xBF9DU, 0xA326U, 0x86EBU, 0x9A50U, 0xCD71U, 0xD1CAU, 0xF407U, 0xE8BCU,
+		0x2D6EU, 0x31D5U, 0x1418U, 0x08A3U, 0x5F82U, 0x4339U, 0x66F4U, 0x7A4FU,
+		0xC8B6U, 0xD40DU, 0xF1C0U, 0xED7BU, 0xBA5AU, 0xA6E1U, 0x832CU, 0x9F97U,
+		0xEECFU, 0xF274U, 0xD7B9U, 0xCB02U, 0x9C23U, 0x8098U, 0xA555U, 0xB9EEU,
+		0x0B17U, 0x17ACU, 0x3261U, 0x2EDAU, 0x79FBU, 0x6540U, 0x408DU, 0x5C36U,
+		0xA23DU, 0xBE86U, 0x9B4BU, 0x87F0U, 0xD0D1U, 0xCC6AU, 0xE9A7U, 0xF51CU,
+		0x47E5U, 0x5B5EU, 0x7E93U, 0x6228U, 0x3509U, 0x29B2U, 0x0C7FU, 0x10C4U,
+		0x619CU, 0x7D27U, 0x58EAU, 0x4451U, 0x1370U, 0x0FCBU, 0x2A06U, 0x36BDU,
+		0x8444U, 0x98FFU, 0xBD32U, 0xA189U, 0xF6A8U, 0xEA13U, 0xCFDEU, 0xD365U,
+		0x3BD9U, 0x2762U, 0x02AFU, 0x1E14U, 0x4935U, 0x558EU, 0x7043U, 0x6CF8U,
+		0xDE01U, 0xC2BAU, 0xE777U, 0xFBCCU, 0xACEDU, 0xB056U, 0x959BU, 0x8920U,
+		0xF878U, 0xE4C3U, 0xC10EU, 0xDDB5U, 0x8A94U, 0x962FU, 0xB3E2U, 0xAF59U,
+		0x1DA0U, 0x011BU, 0x24D6U, 0x386DU, 0x6F4CU, 0x73F7U, 0x563AU, 0x4A81U,
+		0xB48AU, 0xA831U, 0x8DFCU, 0x9147U, 0xC666U, 0xDADDU, 0xFF10U, 0xE3ABU,
+		0x5152U, 0x4DE9U, 0x6824U, 0x749FU, 0x23BEU, 0x3F05U, 0x1AC8U, 0x0673U,
+		0x772BU, 0x6B90U, 0x4E5DU, 0x52E6U, 0x05C7U, 0x197CU, 0x3CB1U, 0x200AU,
+		0x92F3U, 0x8E48U, 0xAB85U, 0xB73EU, 0xE01FU, 0xFCA4U, 0xD969U, 0xC5D2U
+	},
+	{
+		0x0000U, 0x0B44U, 0x1688U, 0x1DCCU, 0x2D10U, 0x2654U, 0x3B98U, 0x30DCU,
+		0x5A20U, 0x5164U, 0x4CA8U, 0x47ECU, 0x7730U, 0x7C74U, 0x61B8U, 0x6AFCU,
+		0xB440U, 0xBF04U, 0xA2C8U, 0xA98CU, 0x9950U, 0x9214U, 0x8FD8U, 0x849CU,
+		0xEE60U, 0xE524U, 0xF8E8U, 0xF3ACU, 0xC370U, 0xC834U, 0xD5F8U, 0xDEBCU,
+		0x6091U, 0x6BD5U, 0x7619U, 0x7D5DU, 0x4D81U, 0x46C5U, 0x5B09U, 0x504DU,
+		0x3AB1U, 0x31F5U, 0x2C39U, 0x277DU, 0x17A1U, 0x1CE5U, 0x0129U, 0x0A6DU,
+		0xD4D1U, 0xDF95U, 0xC259U, 0xC91DU, 0xF9C1U, 0xF285U, 0xEF49U, 0xE40DU,
+		0x8EF1U, 0x85B5U, 0x9879U, 0x933DU, 0xA3E1U, 0xA8A5U, 0xB569U, 0xBE2DU,
+		0xC122U, 0xCA66U, 0xD7AAU, 0xDCEEU, 0xEC32U, 0xE776U, 0xFABAU, 0xF1FEU,
+		0x9B02U, 0x9046U, 0x8D8AU, 0x86CEU, 0xB612U, 0xBD56U, 0xA09AU, 0xABDEU,
+		0x7562U, 0x7E26U, 0x63EAU, 0x68AEU, 0x5872U, 0x5336U, 0x4EFAU, 0x45BEU,
+		0x2F42U, 0x2406U, 0x39CAU, 0x328EU, 0x0252U, 0x0916U, 0x14DAU, 0x1F9EU,
+		0xA1B3U, 0xAAF7U, 0xB73BU, 0xBC7FU, 0x8CA3U, 0x87E7U, 0x9A2BU, 0x916FU,
+		0xFB93U, 0xF0D7U, 0xED1BU, 0xE65FU, 0xD683U, 0xDDC7U, 0xC00BU, 0xCB4FU,
+		0x15F3U, 0x1EB7U, 0x037BU, 0x083FU, 0x38E3U, 0x33A7U, 0x2E6BU, 0x252FU,
+		0x4FD3U, 0x4497U, 0x595BU, 0x521FU, 0x62C3U, 0x6987U, 0x744BU, 0x7F0FU,
+		0x8A55U, 0x8111U, 0x9CDDU, 0x9799U, 0xA745U, 0xAC01U, 0xB1CDU, 0xBA89U,
+		0xD075U, 0xDB31U, 0xC6FDU, 0xCDB9U, 0xFD65U, 0xF621U, 0xEBEDU, 0xE0A9U,
+		0x3E15U, 0x3551U, 0x289DU, 0x23D9U, 0x1305U, 0x1841U, 0x058DU, 0x0EC9U,
+		0x6435U, 0x6F71U, 0x72BDU, 0x79F9U, 0x4925U, 0x4261U, 0x5FADU, 0x54E9U,
+		0xEAC4U, 0xE180U, 0xFC4CU, 0xF708U, 0xC7D4U, 0xCC90U, 0xD15CU, 0xDA18U,
+		0xB0E4U, 0xBBA0U, 0xA66CU, 0xAD28U, 0x9DF4U, 0x96B0U, 0x8B7CU, 0x8038U,
+		0x5E84U, 0x55C0U, 0x480CU, 0x4348U, 0x7394U, 0x78D0U, 0x651CU, 0x6E58U,
+		0x04A4U, 0x0FE0U, 0x122CU, 0x1968U, 0x29B4U, 0x22F0U, 0x3F3CU, 0x3478U,
+		0x4B77U, 0x4033U, 0x5DFFU, 0x56BBU, 0x6667U, 0x6D23U, 0x70EFU, 0x7BABU,
+		0x1157U, 0x1A13U, 0x07DFU, 0x0C9BU, 0x3C47U, 0x3703U, 0x2ACFU, 0x218BU,
+		0xFF37U, 0xF473U, 0xE9BFU, 0xE2FBU, 0xD227U, 0xD963U, 0xC4AFU, 0xCFEBU,
+		0xA517U, 0xAE53U, 0xB39FU, 0xB8DBU, 0x8807U, 0x8343U, 0x9E8FU, 0x95CBU,
+		0x2BE6U, 0x20A2U, 0x3D6EU, 0x362AU, 0x06F6U, 0x0DB2U, 0x107EU, 0x1B3AU,
+		0x71C6U, 0x7A82U, 0x674EU, 0x6C0AU, 0x5CD6U, 0x5792U, 0x4A5EU, 0x411AU,
+		0x9FA6U, 0x94E2U, 0x892EU, 0x826AU, 0xB2B6U, 0xB9F2U, 0xA43EU, 0xAF7AU,
+		0xC586U, 0xCEC2U, 0xD30EU, 0xD84AU, 0xE896U, 0xE3D2U, 0xFE1EU, 0xF55AU
+	},
+	{
+		0x0000U, 0x042BU, 0x0856U, 0x0C7DU, 0x10ACU, 0x1487U, 0x18FAU, 0x1CD1U,
+		0x2158U, 0x2573U, 0x290EU, 0x2D25U, 0x31F4U, 0x35DFU, 0x39A2U, 0x3D89U,
+		0x42B0U, 0x469BU, 0x4AE6U, 0x4ECDU, 0x521CU, 0x5637U, 0x5A4AU, 0x5E61U,
+		0x63E8U, 0x67C3U, 0x6BBEU, 0x6F95U, 0x7344U, 0x776FU, 0x7B12U, 0x7F39U,
+		0x8560U, 0x814BU, 0x8D36U, 0x891DU, 0x95CCU, 0x91E7U, 0x9D9AU, 0x99B1U,
+		0xA438U, 0xA013U, 0xAC6EU, 0xA845U, 0xB494U, 0xB0BFU, 0xBCC2U, 0xB8E9U,
+		0xC7D0U, 0xC3FBU, 0xCF86U, 0xCBADU, 0xD77CU, 0xD357U, 0xDF2AU, 0xDB01U,
+		0xE688U, 0xE2A3U, 0xEEDEU, 0xEAF5U, 0xF624U, 0xF20FU, 0xFE72U, 0xFA59U,
+		0x02D1U, 0x06FAU, 0x0A87U, 0x0EACU, 0x127DU, 0x1656U, 0x1A2BU, 0x1E00U,
+		0x2389U, 0x27A2U, 0x2BDFU, 0x2FF4U, 0x3325U, 0x370EU, 0x3B73U, 0x3F58U,
+		0x4061U, 0x444AU, 0x4837U, 0x4C1CU, 0x50CDU, 0x54E6U, 0x589BU, 0x5CB0U,
+		0x6139U, 0x6512U, 0x696FU, 0x6D44U, 0x7195U, 0x75BEU, 0x79C3U, 0x7DE8U,
+		0x87B1U, 0x839AU, 0x8FE7U, 0x8BCCU, 0x971DU, 0x9336U, 0x9F4BU, 0x9B60U,
+		0xA6E9U, 0xA2C2U, 0xAEBFU, 0xAA94U, 0xB645U, 0xB26EU, 0xBE13U, 0xBA38U,
+		0xC501U, 0xC12AU, 0xCD57U, 0xC97CU, 0xD5ADU, 0xD186U, 0xDDFBU, 0xD9D0U,
+		0xE459U, 0xE072U, 0xEC0FU, 0xE824U, 0xF4F5U, 0xF0DEU, 0xFCA3U, 0xF888U,
+		0x05A2U, 0x0189U, 0x0DF4U, 0x09DFU, 0x150EU, 0x1125U, 0x1D58U, 0x1973U,
+		0x24FAU, 0x20D1U, 0x2CACU, 0x2887U, 0x3456U, 0x307DU, 0x3C00U, 0x382BU,
+		0x4712U, 0x4339U, 0x4F44U, 0x4B6FU, 0x57BEU, 0x5395U, 0x5FE8U, 0x5BC3U,
+		0x664AU, 0x6261U, 0x6E1CU, 0x6A37U, 0x76E6U, 0x72CDU, 0x7EB0U, 0x7A9BU,
+		0x80C2U, 0x84E9U, 0x8894U, 0x8CBFU, 0x906EU, 0x9445U, 0x9838U, 0x9C13U,
+		0xA19AU, 0xA5B1U, 0xA9CCU, 0xADE7U, 0xB136U, 0xB51DU, 0xB960U, 0xBD4BU,
+		0xC272U, 0xC659U, 0xCA24U, 0xCE0FU, 0xD2DEU, 0xD6F5U, 0xDA88U, 0xDEA3U,
+		0xE32AU, 0xE701U, 0xEB7CU, 0xEF57U, 0xF386U, 0xF7ADU, 0xFBD0U, 0xFFFBU,
+		0x0773U, 0x0358U, 0x0F25U, 0x0B0EU, 0x17DFU, 0x13F4U, 0x1F89U, 0x1BA2U,
+		0x262BU, 0x2200U, 0x2E7DU, 0x2A56U, 0x3687U, 0x32ACU, 0x3ED1U, 0x3AFAU,
+		0x45C3U, 0x41E8U, 0x4D95U, 0x49BEU, 0x556FU, 0x5144U, 0x5D39U, 0x5912U,
+		0x649BU, 0x60B0U, 0x6CCDU, 0x68E6U, 0x7437U, 0x701CU, 0x7C61U, 0x784AU,
+		0x8213U, 0x8638U, 0x8A45U, 0x8E6EU, 0x92BFU, 0x9694U, 0x9AE9U, 0x9EC2U,
+		0xA34BU, 0xA760U, 0xAB1DU, 0xAF36U, 0xB3E7U, 0xB7CCU, 0xBBB1U, 0xBF9AU,
+		0xC0A3U, 0xC488U, 0xC8F5U, 0xCCDEU, 0xD00FU, 0xD424U, 0xD859U, 0xDC72U,
+		0xE1FBU, 0xE5D0U, 0xE9ADU, 0xED86U, 0xF157U, 0xF57CU, 0xF901U, 0xFD2AU
+	},
+	{
+		0x0000U, 0x9FD5U, 0x37BBU, 0xA86EU, 0x6F76U, 0xF0A3U, 0x58CDU, 0xC718U,
+		0xDEECU, 0x4139U, 0xE957U, 0x7682U, 0xB19AU, 0x2E4FU, 0x8621U, 0x19F4U,
+		0xB5C9U, 0x2A1CU, 0x8272U, 0x1DA7U, 0xDABFU, 0x456AU, 0xED04U, 0x72D1U,
+		0x6B25U, 0xF4F0U, 0x5C9EU, 0xC34BU, 0x0453U, 0x9B86U, 0x33E8U, 0xAC3DU,
+		0x6383U, 0xFC56U, 0x5438U, 0xCBEDU, 0x0CF5U, 0x9320U, 0x3B4EU, 0xA49BU,
+		0xBD6FU, 0x22BAU, 0x8AD4U, 0x1501U, 0xD219U, 0x4DCCU, 0xE5A2U, 0x7A77U,
+		0xD64AU, 0x499FU, 0xE1F1U, 0x7E24U, 0xB93CU, 0x26E9U, 0x8E87U, 0x1152U,
+		0x08A6U, 0x9773U, 0x3F1DU, 0xA0C8U, 0x67D0U, 0xF805U, 0x506BU, 0xCFBEU,
+		0xC706U, 0x58D3U, 0xF0BDU, 0x6F68U, 0xA870U, 0x37A5U, 0x9FCBU, 0x001EU,
+		0x19EAU, 0x863FU, 0x2E51U, 0xB184U, 0x769CU, 0xE949U, 0x4127U, 0xDEF2U,
+		0x72CFU, 0xED1AU, 0x4574U, 0xDAA1U, 0x1DB9U, 0x826CU, 0x2A02U, 0xB5D7U,
+		0xAC23U, 0x33F6U, 0x9B98U, 0x044DU, 0xC355U, 0x5C80U, 0xF4EEU, 0x6B3BU,
+		0xA485U, 0x3B50U, 0x933EU, 0x0CEBU, 0xCBF3U, 0x5426U, 0xFC48U, 0x639DU,
+		0x7A69U, 0xE5BCU, 0x4DD2U, 0xD207U, 0x151FU, 0x8ACAU, 0x22A4U, 0xBD71U,
+		0x114CU, 0x8E99U, 0x26F7U, 0xB922U, 0x7E3AU, 0xE1EFU, 0x4981U, 0xD654U,
+		0xCFA0U, 0x5075U, 0xF81BU, 0x67CEU, 0xA0D6U, 0x3F03U, 0x976DU, 0x08B8U,
+		0x861DU, 0x19C8U, 0xB1A6U, 0x2E73U, 0xE96BU, 0x76BEU, 0xDED0U, 0x4105U,
+		0x58F1U, 0xC724U, 0x6F4AU, 0xF09FU, 0x3787U, 0xA852U, 0x003CU, 0x9FE9U,
+		0x33D4U, 0xAC01U, 0x046FU, 0x9BBAU, 0x5CA2U, 0xC377U, 0x6B19U, 0xF4CCU,
+		0xED38U, 0x72EDU, 0xDA83U, 0x4556U, 0x824EU, 0x1D9BU, 0xB5F5U, 0x2A20U,
+		0xE59EU, 0x7A4BU, 0xD225U, 0x4DF0U, 0x8AE8U, 0x153DU, 0xBD53U, 0x2286U,
+		0x3B72U, 0xA4A7U, 0x0CC9U, 0x931CU, 0x5404U, 0xCBD1U, 0x63BFU, 0xFC6AU,
+		0x5057U, 0xCF82U, 0x67ECU, 0xF839U, 0x3F21U, 0xA0F4U, 0x089AU, 0x974FU,
+		0x8EBBU, 0x116EU, 0xB900U, 0x26D5U, 0xE1CDU, 0x7E18U, 0xD676U, 0x49A3U,
+		0x411BU, 0xDECEU, 0x76A0U, 0xE975U, 0x2E6DU, 0xB1B8U, 0x19D6U, 0x8603U,
+		0x9FF7U, 0x0022U, 0xA84CU, 0x3799U, 0xF081U, 0x6F54U, 0xC73AU, 0x58EFU,
+		0xF4D2U, 0x6B07U, 0xC369U, 0x5CBCU, 0x9BA4U, 0x0471U, 0xAC1FU, 0x33CAU,
+		0x2A3EU, 0xB5EBU, 0x1D85U, 0x8250U, 0x4548U, 0xDA9DU, 0x72F3U, 0xED26U,
+		0x2298U, 0xBD4DU, 0x1523U, 0x8AF6U, 0x4DEEU, 0xD23BU, 0x7A55U, 0xE580U,
+		0xFC74U, 0x63A1U, 0xCBCFU, 0x541AU, 0x9302U, 0x0CD7U, 0xA4B9U, 0x3B6CU,
+		0x9751U, 0x0884U, 0xA0EAU, 0x3F3FU, 0xF827U, 0x67F2U, 0xCF9CU, 0x5049U,
+		0x49BDU, 0xD668U, 0x7E06U, 0xE1D3U, 0x26CBU, 0xB91EU, 0x1170U, 0x8EA5U
+	},
+	{
+		0x0000U, 0x81BFU, 0x0B6FU, 0x8AD0U, 0x16DEU, 0x9761U, 0x1DB1U, 0x9C0EU,
+		0x2DBCU, 0xAC03U, 0x26D3U, 0xA76CU, 0x3B62U, 0xBADDU, 0x300DU, 0xB1B2U,
+		0x5B78U, 0xDAC7U, 0x5017U, 0xD1A8U, 0x4DA6U, 0xCC19U, 0x46C9U, 0xC776U,
+		0x76C4U, 0xF77BU, 0x7DABU, 0xFC14U, 0x601AU, 0xE1A5U, 0x6B75U, 0xEACAU,
+		0xB6F0U, 0x374FU, 0xBD9FU, 0x3C20U, 0xA02EU, 0x2191U, 0xAB41U, 0x2AFEU,
+		0x9B4CU, 0x1AF3U, 0x9023U, 0x119CU, 0x8D92U, 0x0C2DU, 0x86FDU, 0x0742U,
+		0xED88U, 0x6C37U, 0xE6E7U, 0x6758U, 0xFB56U, 0x7AE9U, 0xF039U, 0x7186U,
+		0xC034U, 0x418BU, 0xCB5BU, 0x4AE4U, 0xD6EAU, 0x5755U, 0xDD85U, 0x5C3AU,
+		0x65F1U, 0xE44EU, 0x6E9EU, 0xEF21U, 0x732FU, 0xF290U, 0x7840U, 0xF9FFU,
+		0x484DU, 0xC9F2U, 0x4322U, 0xC29DU, 0x5E93U, 0xDF2CU, 0x55FCU, 0xD443U,
+		0x3E89U, 0xBF36U, 0x35E6U, 0xB459U, 0x2857U, 0xA9E8U, 0x2338U, 0xA287U,
+		0x1335U, 0x928AU, 0x185AU, 0x99E5U, 0x05EBU, 0x8454U, 0x0E84U, 0x8F3BU,
+		0xD301U, 0x52BEU, 0xD86EU, 0x59D1U, 0xC5DFU, 0x4460U, 0xCEB0U, 0x4F0FU,
+		0xFEBDU, 0x7F02U, 0xF5D2U, 0x746DU, 0xE863U, 0x69DCU, 0xE30CU, 0x62B3U,
+		0x8879U, 0x09C6U, 0x8316U, 0x02A9U, 0x9EA7U, 0x1F18U, 0x95C8U, 0x1477U,
+		0xA5C5U, 0x247AU, 0xAEAAU, 0x2F15U, 0xB31BU, 0x32A4U, 0xB874U, 0x39CBU,
+		0xCBE2U, 0x4A5DU, 0xC08DU, 0x4132U, 0xDD3CU, 0x5C83U, 0xD653U, 0x57ECU,
+		0xE65EU, 0x67E1U, 0xED31U, 0x6C8EU, 0xF080U, 0x713FU, 0xFBEFU, 0x7A50U,
+		0x909AU, 0x1125U, 0x9BF5U, 0x1A4AU, 0x8644U, 0x07FBU, 0x8D2BU, 0x0C94U,
+		0xBD26U, 0x3C99U, 0xB649U, 0x37F6U, 0xABF8U, 0x2A47U, 0xA097U, 0x2128U,
+		0x7D12U, 0xFCADU, 0x767DU, 0xF7C2U, 0x6BCCU, 0xEA73U, 0x60A3U, 0xE11CU,
+		0x50AEU, 0xD111U, 0x5BC1U, 0xDA7EU, 0x4670U, 0xC7CFU, 0x4D1FU, 0xCCA0U,
+		0x266AU, 0xA7D5U, 0x2D05U, 0xACBAU, 0x30B4U, 0xB10BU, 0x3BDBU, 0xBA64U,
+		0x0BD6U, 0x8A69U, 0x00B9U, 0x8106U, 0x1D08U, 0x9CB7U, 0x1667U, 0x97D8U,
+		0xAE13U, 0x2FACU, 0xA57CU, 0x24C3U, 0xB8CDU, 0x3972U, 0xB3A2U, 0x321DU,
+		0x83AFU, 0x0210U, 0x88C0U, 0x097FU, 0x9571U, 0x14CEU, 0x9E1EU, 0x1FA1U,
+		0xF56BU, 0x74D4U, 0xFE04U, 0x7FBBU, 0xE3B5U, 0x620AU, 0xE8DAU, 0x6965U,
+		0xD8D7U, 0x5968U, 0xD3B8U, 0x5207U, 0xCE09U, 0x4FB6U, 0xC566U, 0x44D9U,
+		0x18E3U, 0x995CU, 0x138CU, 0x9233U, 0x0E3DU, 0x8F82U, 0x0552U, 0x84EDU,
+		0x355FU, 0xB4E0U, 0x3E30U, 0xBF8FU, 0x2381U, 0xA23EU, 0x28EEU, 0xA951U,
+		0x439BU, 0xC224U, 0x48F4U, 0xC94BU, 0x5545U, 0xD4FAU, 0x5E2AU, 0xDF95U,
+		0x6E27U, 0xEF98U, 0x6548U, 0xE4F7U, 0x78F9U, 0xF946U, 0x7396U, 0xF229U
+	}
+};
+
+/* Slicing-by-8 tables generated from polynomial 0x1021 */
+static const uint16_t crc16_itu_t_table[8][256] = {
+	{
+		0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+		0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+		0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+		0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+		0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+		0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+		0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+		0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+		0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+		0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+		0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+		0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+		0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+		0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+		0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+		0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+		0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+		0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+		0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+		0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+		0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+		0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+		0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+		0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+		0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+		0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+		0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+		0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+		0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+		0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+		0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+		0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U
+	},
+	{
+		0x0000U, 0x3331U, 0x6662U, 0x5553U, 0xCCC4U, 0xFFF5U, 0xAAA6U, 0x9997U,
+		0x89A9U, 0xBA98U, 0xEFCBU, 0xDCFAU, 0x456DU, 0x765CU, 0x230FU, 0x103EU,
+		0x0373U, 0x3042U, 0x6511U, 0x5620U, 0xCFB7U, 0xFC86U, 0xA9D5U, 0x9AE4U,
+		0x8ADAU, 0xB9EBU, 0xECB8U, 0xDF89U, 0x461EU, 0x752FU, 0x207CU, 0x134DU,
+		0x06E6U, 0x35D7U, 0x6084U, 0x53B5U, 0xCA22U, 0xF913U, 0xAC40U, 0x9F71U,
+		0x8F4FU, 0xBC7EU, 0xE92DU, 0xDA1CU, 0x438BU, 0x70BAU, 0x25E9U, 0x16D8U,
+		0x0595U, 0x36A4U, 0x63F7U, 0x50C6U, 0xC951U, 0xFA60U, 0xAF33U, 0x9C02U,
+		0x8C3CU, 0xBF0DU, 0xEA5EU, 0xD96FU, 0x40F8U, 0x73C9U, 0x269AU, 0x15ABU,
+		0x0DCCU, 0x3EFDU, 0x6BAEU, 0x589FU, 0xC108U, 0xF239U, 0xA76AU, 0x945BU,
+		0x8465U, 0xB754U, 0xE207U, 0xD136U, 0x48A1U, 0x7B90U, 0x2EC3U, 0x1DF2U,
+		0x0EBFU, 0x3D8EU, 0x68DDU, 0x5BECU, 0xC27BU, 0xF14AU, 0xA419U, 0x9728U,
+		0x8716U, 0xB427U, 0xE174U, 0xD245U, 0x4BD2U, 0x78E3U, 0x2DB0U, 0x1E81U,
+		0x0B2AU, 0x381BU, 0x6D48U, 0x5E79U, 0xC7EEU, 0xF4DFU, 0xA18CU, 0x92BDU,
+		0x8283U, 0xB1B2U, 0xE4E1U, 0xD7D0U, 0x4E47U, 0x7D76U, 0x2825U, 0x1B14U,
+		0x0859U, 0x3B68U, 0x6E3BU, 0x5D0AU, 0xC49DU, 0xF7ACU, 0xA2FFU, 0x91CEU,
+		0x81F0U, 0xB2C1U, 0xE792U, 0xD4A3U, 0x4D34U, 0x7E05U, 0x2B56U, 0x1867U,
+		0x1B98U, 0x28A9U, 0x7DFAU, 0x4ECBU, 0xD75CU, 0xE46DU, 0xB13EU, 0x820FU,
+		0x9231U, 0xA100U, 0xF453U, 0xC762U, 0x5EF5U, 0x6DC4U, 0x3897U, 0x0BA6U,
+		0x18EBU, 0x2BDAU, 0x7E89U, 0x4DB8U, 0xD42FU, 0xE71EU, 0xB24DU, 0x817CU,
+		0x9142U, 0xA273U, 0xF720U, 0xC411U, 0x5D86U, 0x6EB7U, 0x3BE4U, 0x08D5U,
+		0x1D7EU, 0x2E4FU, 0x7B1CU, 0x482DU, 0xD1BAU, 0xE28BU, 0xB7D8U, 0x84E9U,
+		0x94D7U, 0xA7E6U, 0xF2B5U, 0xC184U, 0x5813U, 0x6B22U, 0x3E71U, 0x0D40U,
+		0x1E0DU, 0x2D3CU, 0x786FU, 0x4B5EU, 0xD2C9U, 0xE1F8U, 0xB4ABU, 0x879AU,
+		0x97A4U, 0xA495U, 0xF1C6U, 0xC2F7U, 0x5B60U, 0x6851U, 0x3D02U, 0x0E33U,
+		0x1654U, 0x2565U, 0x7036U, 0x4307U, 0xDA90U, 0xE9A1U, 0xBCF2U, 0x8FC3U,
+		0x9FFDU, 0xACCCU, 0xF99FU, 0xCAAEU, 0x5339U, 0x6008U, 0x355BU, 0x066AU,
+		0x1527U, 0x2616U, 0x7345U, 0x4074U, 0xD9E3U, 0xEAD2U, 0xBF81U, 0x8CB0U,
+		0x9C8EU, 0xAFBFU, 0xFAECU, 0xC9DDU, 0x504AU, 0x637BU, 0x3628U, 0x0519U,
+		0x10B2U, 0x2383U, 0x76D0U, 0x45E1U, 0xDC76U, 0xEF47U, 0xBA14U, 0x8925U,
+		0x991BU, 0xAA2AU, 0xFF79U, 0xCC48U, 0x55DFU, 0x66EEU, 0x33BDU, 0x008CU,
+		0x13C1U, 0x20F0U, 0x75A3U, 0x4692U, 0xDF05U, 0xEC34U, 0xB967U, 0x8A56U,
+		0x9A68U, 0xA959U, 0xFC0AU, 0xCF3BU, 0x56ACU, 0x659DU, 0x30CEU, 0x03FFU
+	},
+	{
+		0x0000U, 0x3730U, 0x6E60U, 0x5950U, 0xDCC0U, 0xEBF0U, 0xB2A0U, 0x8590U,
+		0xA9A1U, 0x9E91U, 0xC7C1U, 0xF0F1U, 0x7561U, 0x4251U, 0x1B01U, 0x2C31U,
+		0x4363U, 0x7453U, 0x2D03U, 0x1A33U, 0x9FA3U, 0xA893U, 0xF1C3U, 0xC6F3U,
+		0xEAC2U, 0xDDF2U, 0x84A2U, 0xB392U, 0x3602U, 0x0132U, 0x5862U, 0x6F52U,
+		0x86C6U, 0xB1F6U, 0xE8A6U, 0xDF96U, 0x5A06U, 0x6D36U, 0x3466U, 0x0356U,
+		0x2F67U, 0x1857U, 0x4107U, 0x7637U, 0xF3A7U, 0xC497U, 0x9DC7U, 0xAAF7U,
+		0xC5A5U, 0xF295U, 0xABC5U, 0x9CF5U, 0x1965U, 0x2E55U, 0x7705U, 0x4035U,
+		0x6C04U, 0x5B34U, 0x0264U, 0x3554U, 0xB0C4U, 0x87F4U, 0xDEA4U, 0xE994U,
+		0x1DADU, 0x2A9DU, 0x73CDU, 0x44FDU, 0xC16DU, 0xF65DU, 0xAF0DU, 0x983DU,
+		0xB40CU, 0x833CU, 0xDA6CU, 0xED5CU, 0x68CCU, 0x5FFCU, 0x06ACU, 0x319CU,
+		0x5ECEU, 0x69FEU, 0x30AEU, 0x079EU, 0x820EU, 0xB53EU, 0xEC6EU, 0xDB5EU,
+		0xF76FU, 0xC05FU, 0x990FU, 0xAE3FU, 0x2BAFU, 0x1C9FU, 0x45CFU, 0x72FFU,
+		0x9B6BU, 0xAC5BU, 0xF50BU, 0xC23BU, 0x47ABU, 0x709BU, 0x29CBU, 0x1EFBU,
+		0x32CAU, 0x05FAU, 0x5CAAU, 0x6B9AU, 0xEE0AU, 0xD93AU, 0x806AU, 0xB75AU,
+		0xD808U, 0xEF38U, 0xB668U, 0x8158U, 0x04C8U, 0x33F8U, 0x6AA8U, 0x5D98U,
+		0x71A9U, 0x4699U, 0x1FC9U, 0x28F9U, 0xAD69U, 0x9A59U, 0xC309U, 0xF439U,
+		0x3B5AU, 0x0C6AU, 0x553AU, 0x620AU, 0xE79AU, 0xD0AAU, 0x89FAU, 0xBECAU,
+		0x92FBU, 0xA5CBU, 0xFC9BU, 0xCBABU, 0x4E3BU, 0x790BU, 0x205BU, 0x176BU,
+		0x7839U, 0x4F09U, 0x1659U, 0x2169U, 0xA4F9U, 0x93C9U, 0xCA99U, 0xFDA9U,
+		0xD198U, 0xE6A8U, 0xBFF8U, 0x88C8U, 0x0D58U, 0x3A68U, 0x6338U, 0x5408U,
+		0xBD9CU, 0x8AACU, 0xD3FCU, 0xE4CCU, 0x615CU, 0x566CU, 0x0F3CU, 0x380CU,
+		0x143DU, 0x230DU, 0x7A5DU, 0x4D6DU, 0xC8FDU, 0xFFCDU, 0xA69DU, 0x91ADU,
+		0xFEFFU, 0xC9CFU, 0x909FU, 0xA7AFU, 0x223FU, 0x150FU, 0x4C5FU, 0x7B6FU,
+		0x575EU, 0x606EU, 0x393EU, 0x0E0EU, 0x8B9EU, 0xBCAEU, 0xE5FEU, 0xD2CEU,
+		0x26F7U, 0x11C7U, 0x4897U, 0x7FA7U, 0xFA37U, 0xCD07U, 0x9457U, 0xA367U,
+		0x8F56U, 0xB866U, 0xE136U, 0xD606U, 0x5396U, 0x64A6U, 0x3DF6U, 0x0AC6U,
+		0x6594U, 0x52A4U, 0x0BF4U, 0x3CC4U, 0xB954U, 0x8E64U, 0xD734U, 0xE004U,
+		0xCC35U, 0xFB05U, 0xA255U, 0x9565U, 0x10F5U, 0x27C5U, 0x7E95U, 0x49A5U,
+		0xA031U, 0x9701U, 0xCE51U, 0xF961U, 0x7CF1U, 0x4BC1U, 0x1291U, 0x25A1U,
+		0x0990U, 0x3EA0U, 0x67F0U, 0x50C0U, 0xD550U, 0xE260U, 0xBB30U, 0x8C00U,
+		0xE352U, 0xD462U, 0x8D32U, 0xBA02U, 0x3F92U, 0x08A2U, 0x51F2U, 0x66C2U,
+		0x4AF3U, 0x7DC3U, 0x2493U, 0x13A3U, 0x9633U, 0xA103U, 0xF853U, 0xCF63U
+	},
+	{
+		0x0000U, 0x76B4U, 0xED68U, 0x9BDCU, 0xCAF1U, 0xBC45U, 0x2799U, 0x512DU,
+		0x85C3U, 0xF377U, 0x68ABU, 0x1E1FU, 0x4F32U, 0x3986U, 0xA25AU, 0xD4EEU,
+		0x1BA7U, 0x6D13U, 0xF6CFU, 0x807BU, 0xD156U, 0xA7E2U, 0x3C3EU, 0x4A8AU,
+		0x9E64U, 0xE8D0U, 0x730CU, 0x05B8U, 0x5495U, 0x2221U, 0xB9FDU, 0xCF49U,
+		0x374EU, 0x41FAU, 0xDA26U, 0xAC92U, 0xFDBFU, 0x8B0BU, 0x10D7U, 0x6663U,
+		0xB28DU, 0xC439U, 0x5FE5U, 0x2951U, 0x787CU, 0x0EC8U, 0x9514U, 0xE3A0U,
+		0x2CE9U, 0x5A5DU, 0xC181U, 0xB735U, 0xE618U, 0x90ACU, 0x0B70U, 0x7DC4U,
+		0xA92AU, 0xDF9EU, 0x4442U, 0x32F6U, 0x63DBU, 0x156FU, 0x8EB3U, 0xF807U,
+		0x6E9CU, 0x1828U, 0x83F4U, 0xF540U, 0xA46DU, 0xD2D9U, 0x4905U, 0x3FB1U,
+		0xEB5FU, 0x9DEBU, 0x0637U, 0x7083U, 0x21AEU, 0x571AU, 0xCCC6U, 0xBA72U,
+		0x753BU, 0x038FU, 0x9853U, 0xEEE7U, 0xBFCAU, 0xC97EU, 0x52A2U, 0x2416U,
+		0xF0F8U, 0x864CU, 0x1D90U, 0x6B24U, 0x3A09U, 0x4CBDU, 0xD761U, 0xA1D5U,
+		0x59D2U, 0x2F66U, 0xB4BAU, 0xC20EU, 0x9323U, 0xE597U, 0x7E4BU, 0x08FFU,
+		0xDC11U, 0xAAA5U, 0x3179U, 0x47CDU, 0x16E0U, 0x6054U, 0xFB88U, 0x8D3CU,
+		0x4275U, 0x34C1U, 0xAF1DU, 0xD9A9U, 0x8884U, 0xFE30U, 0x65ECU, 0x1358U,
+		0xC7B6U, 0xB102U, 0x2ADEU, 0x5C6AU, 0x0D47U, 0x7BF3U, 0xE02FU, 0x969BU,
+		0xDD38U, 0xAB8CU, 0x3050U, 0x46E4U, 0x17C9U, 0x617DU, 0xFAA1U, 0x8C15U,
+		0x58FBU, 0x2E4FU, 0xB593U, 0xC327U, 0x920AU, 0xE4BEU, 0x7F62U, 0x09D6U,
+		0xC69FU, 0xB02BU, 0x2BF7U, 0x5D43U, 0x0C6EU, 0x7ADAU, 0xE106U, 0x97B2U,
+		0x435CU, 0x35E8U, 0xAE34U, 0xD880U, 0x89ADU, 0xFF19U, 0x64C5U, 0x1271U,
+		0xEA76U, 0x9CC2U, 0x071EU, 0x71AAU, 0x2087U, 0x5633U, 0xCDEFU, 0xBB5BU,
+		0x6FB5U, 0x1901U, 0x82DDU, 0xF469U, 0xA544U, 0xD3F0U, 0x482CU, 0x3E98U,
+		0xF1D1U, 0x8765U, 0x1CB9U, 0x6A0DU, 0x3B20U, 0x4D94U, 0xD648U, 0xA0FCU,
+		0x7412U, 0x02A6U, 0x997AU, 0xEFCEU, 0xBEE3U, 0xC857U, 0x538BU, 0x253FU,
+		0xB3A4U, 0xC510U, 0x5ECCU, 0x2878U, 0x7955U, 0x0FE1U, 0x943DU, 0xE289U,
+		0x3667U, 0x40D3U, 0xDB0FU, 0xADBBU, 0xFC96U, 0x8A22U, 0x11FEU, 0x674AU,
+		0xA803U, 0xDEB7U, 0x456BU, 0x33DFU, 0x62F2U, 0x1446U, 0x8F9AU, 0xF92EU,
+		0x2DC0U, 0x5B74U, 0xC0A8U, 0xB61CU, 0xE731U, 0x9185U, 0x0A59U, 0x7CEDU,
+		0x84EAU, 0xF25EU, 0x6982U, 0x1F36U, 0x4E1BU, 0x38AFU, 0xA373U, 0xD5C7U,
+		0x0129U, 0x779DU, 0xEC41U, 0x9AF5U, 0xCBD8U, 0xBD6CU, 0x26B0U, 0x5004U,
+		0x9F4DU, 0xE9F9U, 0x7225U, 0x0491U, 0x55BCU, 0x2308U, 0xB8D4U, 0xCE60U,
+		0x1A8EU, 0x6C3AU, 0xF7E6U, 0x8152U, 0xD07FU, 0xA6CBU, 0x3D17U, 0x4BA3U
+	},
+	{
+		0x0000U, 0xAA51U, 0x4483U, 0xEED2U, 0x8906U, 0x2357U, 0xCD85U, 0x67D4U,
+		0x022DU, 0xA87CU, 0x46AEU, 0xECFFU, 0x8B2BU, 0x217AU, 0xCFA8U, 0x65F9U,
+		0x045AU, 0xAE0BU, 0x40D9U, 0xEA88U, 0x8D5CU, 0x270DU, 0xC9DFU, 0x638EU,
+		0x0677U, 0xAC26U, 0x42F4U, 0xE8A5U, 0x8F71U, 0x2520U, 0xCBF2U, 0x61A3U,
+		0x08B4U, 0xA2E5U, 0x4C37U, 0xE666U, 0x81B2U, 0x2BE3U, 0xC531U, 0x6F60U,
+		0x0A99U, 0xA0C8U, 0x4E1AU, 0xE44BU, 0x839FU, 0x29CEU, 0xC71CU, 0x6D4DU,
+		0x0CEEU, 0xA6BFU, 0x486DU, 0xE23CU, 0x85E8U, 0x2FB9U, 0xC16BU, 0x6B3AU,
+		0x0EC3U, 0xA492U, 0x4A40U, 0xE011U, 0x87C5U, 0x2D94U, 0xC346U, 0x6917U,
+		0x1168U, 0xBB39U, 0x55EBU, 0xFFBAU, 0x986EU, 0x323FU, 0xDCEDU, 0x76BCU,
+		0x1345U, 0xB914U, 0x57C6U, 0xFD97U, 0x9A43U, 0x3012U, 0xDEC0U, 0x7491U,
+		0x1532U, 0xBF63U, 0x51B1U, 0xFBE0U, 0x9C34U, 0x3665U, 0xD8B7U, 0x72E6U,
+		0x171FU, 0xBD4EU, 0x539CU, 0xF9CDU, 0x9E19U, 0x3448U, 0xDA9AU, 0x70CBU,
+		0x19DCU, 0xB38DU, 0x5D5FU, 0xF70EU, 0x90DAU, 0x3A8BU, 0xD459U, 0x7E08U,
+		0x1BF1U, 0xB1A0U, 0x5F72U, 0xF523U, 0x92F7U, 0x38A6U, 0xD674U, 0x7C25U,
+		0x1D86U, 0xB7D7U, 0x5905U, 0xF354U, 0x9480U, 0x3ED1U, 0xD003U, 0x7A52U,
+		0x1FABU, 0xB5FAU, 0x5B28U, 0xF179U, 0x96ADU, 0x3CFCU, 0xD22EU, 0x787FU,
+		0x22D0U, 0x8881U, 0x6653U, 0xCC02U, 0xABD6U, 0x0187U, 0xEF55U, 0x4504U,
+		0x20FDU, 0x8AACU, 0x647EU, 0xCE2FU, 0xA9FBU, 0x03AAU, 0xED78U, 0x4729U,
+		0x268AU, 0x8CDBU, 0x6209U, 0xC858U, 0xAF8CU, 0x05DDU, 0xEB0FU, 0x415EU,
+		0x24A7U, 0x8EF6U, 0x6024U, 0xCA75U, 0xADA1U, 0x07F0U, 0xE922U, 0x4373U,
+		0x2A64U, 0x8035U, 0x6EE7U, 0xC4B6U, 0xA362U, 0x0933U, 0xE7E1U, 0x4DB0U,
+		0x2849U, 0x8218U, 0x6CCAU, 0xC69BU, 0xA14FU, 0x0B1EU, 0xE5CCU, 0x4F9DU,
+		0x2E3EU, 0x846FU, 0x6ABDU, 0xC0ECU, 0xA738U, 0x0D69U, 0xE3BBU, 0x49EAU,
+		0x2C13U, 0x8642U, 0x6890U, 0xC2C1U, 0xA515U, 0x0F44U, 0xE196U, 0x4BC7U,
+		0x33B8U, 0x99E9U, 0x773BU, 0xDD6AU, 0xBABEU, 0x10EFU, 0xFE3DU, 0x546CU,
+		0x3195U, 0x9BC4U, 0x7516U, 0xDF47U, 0xB893U, 0x12C2U, 0xFC10U, 0x5641U,
+		0x37E2U, 0x9DB3U, 0x7361U, 0xD930U, 0xBEE4U, 0x14B5U, 0xFA67U, 0x5036U,
+		0x35CFU, 0x9F9EU, 0x714CU, 0xDB1DU, 0xBCC9U, 0x1698U, 0xF84AU, 0x521BU,
+		0x3B0CU, 0x915DU, 0x7F8FU, 0xD5DEU, 0xB20AU, 0x185BU, 0xF689U, 0x5CD8U,
+		0x3921U, 0x9370U, 0x7DA2U, 0xD7F3U, 0xB027U, 0x1A76U, 0xF4A4U, 0x5EF5U,
+		0x3F56U, 0x9507U, 0x7BD5U, 0xD184U, 0xB650U, 0x1C01U, 0xF2D3U, 0x5882U,
+		0x3D7BU, 0x972AU, 0x79F8U, 0xD3A9U, 0xB47DU, 0x1E2CU, 0xF0FEU, 0x5AAFU
+	},
+	{
+		0x0000U, 0x45A0U, 0x8B40U, 0xCEE0U, 0x06A1U, 0x4301U, 0x8DE1U, 0xC841U,
+		0x0D42U, 0x48E2U, 0x8602U, 0xC3A2U, 0x0BE3U, 0x4E43U, 0x80A3U, 0xC503U,
+		0x1A84U, 0x5F24U, 0x91C4U, 0xD464U, 0x1C25U, 0x5985U, 0x9765U, 0xD2C5U,
+		0x17C6U, 0x5266U, 0x9C86U, 0xD926U, 0x1167U, 0x54C7U, 0x9A27U, 0xDF87U,
+		0x3508U, 0x70A8U, 0xBE48U, 0xFBE8U, 0x33A9U, 0x7609U, 0xB8E9U, 0xFD49U,
+		0x384AU, 0x7DEAU, 0xB30AU, 0xF6AAU, 0x3EEBU, 0x7B4BU, 0xB5ABU, 0xF00BU,
+		0x2F8CU, 0x6A2CU, 0xA4CCU, 0xE16CU, 0x292DU, 0x6C8DU, 0xA26DU, 0xE7CDU,
+		0x22CEU, 0x676EU, 0xA98EU, 0xEC2EU, 0x246FU, 0x61CFU, 0xAF2FU, 0xEA8FU,
+		0x6A10U, 0x2FB0U, 0xE150U, 0xA4F0U, 0x6CB1U, 0x2911U, 0xE7F1U, 0xA251U,
+		0x6752U, 0x22F2U, 0xEC12U, 0xA9B2U, 0x61F3U, 0x2453U, 0xEAB3U, 0xAF13U,
+		0x7094U, 0x3534U, 0xFBD4U, 0xBE74U, 0x7635U, 0x3395U, 0xFD75U, 0xB8D5U,
+		0x7DD6U, 0x3876U, 0xF696U, 0xB336U, 0x7B77U, 0x3ED7U, 0xF037U, 0xB597U,
+		0x5F18U, 0x1AB8U, 0xD458U, 0x91F8U, 0x59B9U, 0x1C19U, 0xD2F9U, 0x9759U,
+		0x525AU, 0x17FAU, 0xD91AU, 0x9CBAU, 0x54FBU, 0x115BU, 0xDFBBU, 0x9A1BU,
+		0x459CU, 0x003CU, 0xCEDCU, 0x8B7CU, 0x433DU, 0x069DU, 0xC87DU, 0x8DDDU,
+		0x48DEU, 0x0D7EU, 0xC39EU, 0x863EU, 0x4E7FU, 0x0BDFU, 0xC53FU, 0x809FU,
+		0xD420U, 0x9180U, 0x5F60U, 0x1AC0U, 0xD281U, 0x9721U, 0x59C1U, 0x1C61U,
+		0xD962U, 0x9CC2U, 0x5222U, 0x1782U, 0xDFC3U, 0x9A63U, 0x5483U, 0x1123U,
+		0xCEA4U, 0x8B04U, 0x45E4U, 0x0044U, 0xC805U, 0x8DA5U, 0x4345U, 0x06E5U,
+		0xC3E6U, 0x8646U, 0x48A6U, 0x0D06U, 0xC547U, 0x80E7U, 0x4E07U, 0x0BA7U,
+		0xE128U, 0xA488U, 0x6A68U, 0x2FC8U, 0xE789U, 0xA229U, 0x6CC9U, 0x2969U,
+		0xEC6AU, 0xA9CAU, 0x672AU, 0x228AU, 0xEACBU, 0xAF6BU, 0x618BU, 0x242BU,
+		0xFBACU, 0xBE0CU, 0x70ECU, 0x354CU, 0xFD0DU, 0xB8ADU, 0x764DU, 0x33EDU,
+		0xF6EEU, 0xB34EU, 0x7DAEU, 0x380EU, 0xF04FU, 0xB5EFU, 0x7B0FU, 0x3EAFU,
+		0xBE30U, 0xFB90U, 0x3570U, 0x70D0U, 0xB891U, 0xFD31U, 0x33D1U, 0x7671U,
+		0xB372U, 0xF6D2U, 0x3832U, 0x7D92U, 0xB5D3U, 0xF073U, 0x3E93U, 0x7B33U,
+		0xA4B4U, 0xE114U, 0x2FF4U, 0x6A54U, 0xA215U, 0xE7B5U, 0x2955U, 0x6CF5U,
+		0xA9F6U, 0xEC56U, 0x22B6U, 0x6716U, 0xAF57U, 0xEAF7U, 0x2417U, 0x61B7U,
+		0x8B38U, 0xCE98U, 0x0078U, 0x45D8U, 0x8D99U, 0xC839U, 0x06D9U, 0x4379U,
+		0x867AU, 0xC3DAU, 0x0D3AU, 0x489AU, 0x80DBU, 0xC57BU, 0x0B9BU, 0x4E3BU,
+		0x91BCU, 0xD41CU, 0x1AFCU, 0x5F5CU, 0x971DU, 0xD2BDU, 0x1C5DU, 0x59FDU,
+		0x9CFEU, 0xD95EU, 0x17BEU, 0x521EU, 0x9A5FU, 0xDFFFU, 0x111FU, 0x54BFU
+	},
+	{
+		0x0000U, 0xB861U, 0x60E3U, 0xD882U, 0xC1C6U, 0x79A7U, 0xA125U, 0x1944U,
+		0x93ADU, 0x2BCCU, 0xF34EU, 0x4B2FU, 0x526BU, 0xEA0AU, 0x3288U, 0x8AE9U,
+		0x377BU, 0x8F1AU, 0x5798U, 0xEFF9U, 0xF6BDU, 0x4EDCU, 0x965EU, 0x2E3FU,
+		0xA4D6U, 0x1CB7U, 0xC435U, 0x7C54U, 0x6510U, 0xDD71U, 0x05F3U, 0xBD92U,
+		0x6EF6U, 0xD697U, 0x0E15U, 0xB674U, 0xAF30U, 0x1751U, 0xCFD3U, 0x77B2U,
+		0xFD5BU, 0x453AU, 0x9DB8U, 0x25D9U, 0x3C9DU, 0x84FCU, 0x5C7EU, 0xE41FU,
+		0x598DU, 0xE1ECU, 0x396EU, 0x810FU, 0x984BU, 0x202AU, 0xF8A8U, 0x40C9U,
+		0xCA20U, 0x7241U, 0xAAC3U, 0x12A2U, 0x0BE6U, 0xB387U, 0x6B05U, 0xD364U,
+		0xDDECU, 0x658DU, 0xBD0FU, 0x056EU, 0x1C2AU, 0xA44BU, 0x7CC9U, 0xC4A8U,
+		0x4E41U, 0xF620U, 0x2EA2U, 0x96C3U, 0x8F87U, 0x37E6U, 0xEF64U, 0x5705U,
+		0xEA97U, 0x52F6U, 0x8A74U, 0x3215U, 0x2B51U, 0x9330U, 0x4BB2U, 0xF3D3U,
+		0x793AU, 0xC15BU, 0x19D9U, 0xA1B8U, 0xB8FCU, 0x009DU, 0xD81FU, 0x607EU,
+		0xB31AU, 0x0B7BU, 0xD3F9U, 0x6B98U, 0x72DCU, 0xCABDU, 0x123FU, 0xAA5EU,
+		0x20B7U, 0x98D6U, 0x4054U, 0xF835U, 0xE171U, 0x5910U, 0x8192U, 0x39F3U,
+		0x8461U, 0x3C00U, 0xE482U, 0x5CE3U, 0x45A7U, 0xFDC6U, 0x2544U, 0x9D25U,
+		0x17CCU, 0xAFADU, 0x772FU, 0xCF4EU, 0xD60AU, 0x6E6BU, 0xB6E9U, 0x0E88U,
+		0xABF9U, 0x1398U, 0xCB1AU, 0x737BU, 0x6A3FU, 0xD25EU, 0x0ADCU, 0xB2BDU,
+		0x3854U, 0x8035U, 0x58B7U, 0xE0D6U, 0xF992U, 0x41F3U, 0x9971U, 0x2110U,
+		0x9C82U, 0x24E3U, 0xFC61U, 0x4400U, 0x5D44U, 0xE525U, 0x3DA7U, 0x85C6U,
+		0x0F2FU, 0xB74EU, 0x6FCCU, 0xD7ADU, 0xCEE9U, 0x7688U, 0xAE0AU, 0x166BU,
+		0xC50FU, 0x7D6EU, 0xA5ECU, 0x1D8DU, 0x04C9U, 0xBCA8U, 0x642AU, 0xDC4BU,
+		0x56A2U, 0xEEC3U, 0x3641U, 0x8E20U, 0x9764U, 0x2F05U, 0xF787U, 0x4FE6U,
+		0xF274U, 0x4A15U, 0x9297U, 0x2AF6U, 0x33B2U, 0x8BD3U, 0x5351U, 0xEB30U,
+		0x61D9U, 0xD9B8U, 0x013AU, 0xB95BU, 0xA01FU, 0x187EU, 0xC0FCU, 0x789DU,
+		0x7615U, 0xCE74U, 0x16F6U, 0xAE97U, 0xB7D3U, 0x0FB2U, 0xD730U, 0x6F51U,
+		0xE5B8U, 0x5DD9U, 0x855BU, 0x3D3AU, 0x247EU, 0x9C1FU, 0x449DU, 0xFCFCU,
+		0x416EU, 0xF90FU, 0x218DU, 0x99ECU, 0x80A8U, 0x38C9U, 0xE04BU, 0x582AU,
+		0xD2C3U, 0x6AA2U, 0xB220U, 0x0A41U, 0x1305U, 0xAB64U, 0x73E6U, 0xCB87U,
+		0x18E3U, 0xA082U, 0x7800U, 0xC061U, 0xD925U, 0x6144U, 0xB9C6U, 0x01A7U,
+		0x8B4EU, 0x332FU, 0xEBADU, 0x53CCU, 0x4A88U, 0xF2E9U, 0x2A6BU, 0x920AU,
+		0x2F98U, 0x97F9U, 0x4F7BU, 0xF71AU, 0xEE5EU, 0x563FU, 0x8EBDU, 0x36DCU,
+		0xBC35U, 0x0454U, 0xDCD6U, 0x64B7U, 0x7DF3U, 0xC592U, 0x1D10U, 0xA571U
+	},
+	{
+		0x0000U, 0x47D3U, 0x8FA6U, 0xC875U, 0x0F6DU, 0x48BEU, 0x80CBU, 0xC718U,
+		0x1EDAU, 0x5909U, 0x917CU, 0xD6AFU, 0x11B7U, 0x5664U, 0x9E11U, 0xD9C2U,
+		0x3DB4U, 0x7A67U, 0xB212U, 0xF5C1U, 0x32D9U, 0x750AU, 0xBD7FU, 0xFAACU,
+		0x236EU, 0x64BDU, 0xACC8U, 0xEB1BU, 0x2C03U, 0x6BD0U, 0xA3A5U, 0xE476U,
+		0x7B68U, 0x3CBBU, 0xF4CEU, 0xB31DU, 0x7405U, 0x33D6U, 0xFBA3U, 0xBC70U,
+		0x65B2U, 0x2261U, 0xEA14U, 0xADC7U, 0x6ADFU, 0x2D0CU, 0xE579U, 0xA2AAU,
+		0x46DCU, 0x010FU, 0xC97AU, 0x8EA9U, 0x49B1U, 0x0E62U, 0xC617U, 0x81C4U,
+		0x5806U, 0x1FD5U, 0xD7A0U, 0x9073U, 0x576BU, 0x10B8U, 0xD8CDU, 0x9F1EU,
+		0xF6D0U, 0xB103U, 0x7976U, 0x3EA5U, 0xF9BDU, 0xBE6EU, 0x761BU, 0x31C8U,
+		0xE80AU, 0xAFD9U, 0x67ACU, 0x207FU, 0xE767U, 0xA0B4U, 0x68C1U, 0x2F12U,
+		0xCB64U, 0x8CB7U, 0x44C2U, 0x0311U, 0xC409U, 0x83DAU, 0x4BAFU, 0x0C7CU,
+		0xD5BEU, 0x926DU, 0x5A18U, 0x1DCBU, 0xDAD3U, 0x9D00U, 0x5575U, 0x12A6U,
+		0x8DB8U, 0xCA6BU, 0x021EU, 0x45CDU, 0x82D5U, 0xC506U, 0x0D73U, 0x4AA0U,
+		0x9362U, 0xD4B1U, 0x1CC4U, 0x5B17U, 0x9C0FU, 0xDBDCU, 0x13A9U, 0x547AU,
+		0xB00CU, 0xF7DFU, 0x3FAAU, 0x7879U, 0xBF61U, 0xF8B2U, 0x30C7U, 0x7714U,
+		0xAED6U, 0xE905U, 0x2170U, 0x66A3U, 0xA1BBU, 0xE668U, 0x2E1DU, 0x69CEU,
+		0xFD81U, 0xBA52U, 0x7227U, 0x35F4U, 0xF2ECU, 0xB53FU, 0x7D4AU, 0x3A99U,
+		0xE35BU, 0xA488U, 0x6CFDU, 0x2B2EU, 0xEC36U, 0xABE5U, 0x6390U, 0x2443U,
+		0xC035U, 0x87E6U, 0x4F93U, 0x0840U, 0xCF58U, 0x888BU, 0x40FEU, 0x072DU,
+		0xDEEFU, 0x993CU, 0x5149U, 0x169AU, 0xD182U, 0x9651U, 0x5E24U, 0x19F7U,
+		0x86E9U, 0xC13AU, 0x094FU, 0x4E9CU, 0x8984U, 0xCE57U, 0x0622U, 0x41F1U,
+		0x9833U, 0xDFE0U, 0x1795U, 0x5046U, 0x975EU, 0xD08DU, 0x18F8U, 0x5F2BU,
+		0xBB5DU, 0xFC8EU, 0x34FBU, 0x7328U, 0xB430U, 0xF3E3U, 0x3B96U, 0x7C45U,
+		0xA587U, 0xE254U, 0x2A21U, 0x6DF2U, 0xAAEAU, 0xED39U, 0x254CU, 0x629FU,
+		0x0B51U, 0x4C82U, 0x84F7U, 0xC324U, 0x043CU, 0x43EFU, 0x8B9AU, 0xCC49U,
+		0x158BU, 0x5258U, 0x9A2DU, 0xDDFEU, 0x1AE6U, 0x5D35U, 0x9540U, 0xD293U,
+		0x36E5U, 0x7136U, 0xB943U, 0xFE90U, 0x3988U, 0x7E5BU, 0xB62EU, 0xF1FDU,
+		0x283FU, 0x6FECU, 0xA799U, 0xE04AU, 0x2752U, 0x6081U, 0xA8F4U, 0xEF27U,
+		0x7039U, 0x37EAU, 0xFF9FU, 0xB84CU, 0x7F54U, 0x3887U, 0xF0F2U, 0xB721U,
+		0x6EE3U, 0x2930U, 0xE145U, 0xA696U, 0x618EU, 0x265DU, 0xEE28U, 0xA9FBU,
+		0x4D8DU, 0x0A5EU, 0xC22BU, 0x85F8U, 0x42E0U, 0x0533U, 0xCD46U, 0x8A95U,
+		0x5357U, 0x1484U, 0xDCF1U, 0x9B22U, 0x5C3AU, 0x1BE9U, 0xD39CU, 0x944FU
+	}
+};
+
+static uint16_t crc16_ccitt_slice8(uint16_t crc, const uint8_t *src, size_t len)
+{
+	for (; len >= 8; len -= 8, src += 8) {
+		uint32_t lo = crc ^ sys_get_le32(src);
+		uint32_t hi = sys_get_le32(src + 4);
+
+		crc = crc16_ccitt_table[7][lo & 0xff] ^
+		      crc16_ccitt_table[6][(lo >> 8) & 0xff] ^
+		      crc16_ccitt_table[5][(lo >> 16) & 0xff] ^
+		      crc16_ccitt_table[4][lo >> 24] ^
+		      crc16_ccitt_table[3][hi & 0xff] ^
+		      crc16_ccitt_table[2][(hi >> 8) & 0xff] ^
+		      crc16_ccitt_table[1][(hi >> 16) & 0xff] ^
+		      crc16_ccitt_table[0][hi >> 24];
+	}
+
+	for (; len > 0; len--) {
+		crc = crc16_ccitt_table[0][(crc ^ *src++) & 0xff] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+
+/* Not reflected: the CRC register lines up with the most significant
+ * bits of the data, hence the big endian loads
+ */
+static uint16_t crc16_itu_t_slice8(uint16_t crc, const uint8_t *src, size_t len)
+{
+	for (; len >= 8; len -= 8, src += 8) {
+		uint32_t hi = ((uint32_t)crc << 16) ^ sys_get_be32(src);
+		uint32_t lo = sys_get_be32(src + 4);
+
+		crc = crc16_itu_t_table[7][hi >> 24] ^
+		      crc16_itu_t_table[6][(hi >> 16) & 0xff] ^
+		      crc16_itu_t_table[5][(hi >> 8) & 0xff] ^
+		      crc16_itu_t_table[4][hi & 0xff] ^
+		      crc16_itu_t_table[3][lo >> 24] ^
+		      crc16_itu_t_table[2][(lo >> 16) & 0xff] ^
+		      crc16_itu_t_table[1][(lo >> 8) & 0xff] ^
+		      crc16_itu_t_table[0][lo & 0xff];
+	}
+
+	for (; len > 0; len--) {
+		crc = crc16_itu_t_table[0][(crc >> 8) ^ *src++] ^ (uint16_t)(crc << 8);
+	}
+
+	return crc;
+}
+#endif /* CONFIG_CRC_SLICING_BY_8 */
+
 uint16_t crc16(uint16_t poly, uint16_t seed, const uint8_t *src, size_t len)
 {
 	uint16_t crc = seed;
 	size_t i, j;
 
+#ifdef CONFIG_CRC_SLICING_BY_8
+	if (poly == 0x1021U) {
+		return crc16_itu_t_slice8(seed, src, len);
+	}
+#endif
+
 	for (i = 0; i < len; i++) {
 		crc ^= (uint16_t)(src[i] << 8U);
 
@@ -32,6 +643,12 @@ uint16_t crc16_reflect(uint16_t poly, uint16_t seed, const uint8_t *src, size_t
 	uint16_t crc = seed;
 	size_t i, j;
 
+#ifdef CONFIG_CRC_SLICING_BY_8
+	if (poly == 0x8408U) {
+		return crc16_ccitt_slice8(seed, src, len);
+	}
+#endif
+
 	for (i = 0; i < len; i++) {
 		crc ^= (uint16_t)src[i];
 
@@ -51,6 +668,9 @@ uint16_t crc16_reflect(uint16_t poly, uint16_t seed, const uint8_t *src, size_t
 
 uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 {
+#ifdef CONFIG_CRC_SLICING_BY_8
+	return crc16_ccitt_slice8(seed, src, len);
+#else
 	for (; len > 0; len--) {
 		uint8_t e, f;
 
@@ -60,10 +680,14 @@ uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 	}
 
 	return seed;
+#endif
 }
 
 uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 {
+#ifdef CONFIG_CRC_SLICING_BY_8
+	return crc16_itu_t_slice8(seed, src, len);
+#else
 	for (; len > 0; len--) {
 		seed = (seed >> 8U) | (seed << 8U);
 		seed ^= *src++;
@@ -73,4 +697,5 @@ uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 	}
 
 	return seed;
+#endif
 }
@@ -0,0 +1,57 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <arm_acle.h>
+
+#include "crc_internal.h"
+
+/* The CRC32 instructions are optional in ARMv8.0, so they may have to
+ * be enabled for these functions only
+ */
+#ifdef __ARM_FEATURE_CRC32
+#define CRC_TARGET
+#else
+#define CRC_TARGET __attribute__((target("+crc")))
+#endif
+
+CRC_TARGET
+uint32_t z_crc32_ieee_arm64(uint32_t crc, const uint8_t *data, size_t len)
+{
+	for (; (len > 0) && (((uintptr_t)data & 7) != 0); len--) {
+		crc = __crc32b(crc, *data++);
+	}
+
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = __crc32d(crc, *(const uint64_t *)data);
+	}
+
+	for (; len > 0; len--) {
+		crc = __crc32b(crc, *data++);
+	}
+
+	return crc;
+}
+
+CRC_TARGET
+uint32_t z_crc32c_arm64(uint32_t crc, const uint8_t *data, size_t len)
+{
+	for (; (len > 0) && (((uintptr_t)data & 7) != 0); len--) {
+		crc = __crc32cb(crc, *data++);
+	}
+
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = __crc32cd(crc, *(const uint64_t *)data);
+	}
+
+	for (; len > 0; len--) {
+		crc = __crc32cb(crc, *data++);
+	}
+
+	return crc;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_OS_CRC_INTERNAL_H_
+#define ZEPHYR_LIB_OS_CRC_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/byteorder.h>
+
+/* All of these work on the raw CRC register: any inversion on the way
+ * in or out is up to the caller.
+ */
+
+#ifdef CONFIG_CRC_SLICING_BY_8
+/* Slicing-by-8 for bit-reflected 32-bit CRCs.  table[k][b] is the CRC
+ * of byte b followed by k zero bytes, so that eight independent
+ * lookups consume eight bytes at once.
+ */
+static inline uint32_t crc32_slice8(const uint32_t table[8][256], uint32_t crc,
+				    const uint8_t *data, size_t len)
+{
+	for (; len >= 8; len -= 8, data += 8) {
+		uint32_t lo = crc ^ sys_get_le32(data);
+		uint32_t hi = sys_get_le32(data + 4);
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+	}
+
+	for (; len > 0; len--) {
+		crc = table[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+#endif /* CONFIG_CRC_SLICING_BY_8 */
+
+#ifdef CONFIG_CRC_X86_SSE42
+/* CRC-32C with the SSE4.2 crc32 instruction */
+uint32_t z_crc32c_sse42(uint32_t crc, const uint8_t *data, size_t len);
+#endif
+
+#ifdef CONFIG_CRC_X86_PCLMUL
+/* CRC-32/IEEE by folding with carry-less multiplication.  len must be a
+ * multiple of 16, and at least 64.
+ */
+uint32_t z_crc32_ieee_pclmul(uint32_t crc, const uint8_t *data, size_t len);
+#endif
+
+#ifdef CONFIG_CRC_ARM64_CRC32
+/* CRC-32/IEEE and CRC-32C with the ARMv8 CRC32 instructions */
+uint32_t z_crc32_ieee_arm64(uint32_t crc, const uint8_t *data, size_t len);
+uint32_t z_crc32c_arm64(uint32_t crc, const uint8_t *data, size_t len);
+#endif
+
+#endif /* ZEPHYR_LIB_OS_CRC_INTERNAL_H_ */
@@ -0,0 +1,142 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <immintrin.h>
+
+#include "crc_internal.h"
+
+#ifdef CONFIG_CRC_X86_SSE42
+__attribute__((target("sse4.2")))
+uint32_t z_crc32c_sse42(uint32_t crc, const uint8_t *data, size_t len)
+{
+	for (; (len > 0) && (((uintptr_t)data & (sizeof(long) - 1)) != 0); len--) {
+		crc = _mm_crc32_u8(crc, *data++);
+	}
+
+#ifdef CONFIG_64BIT
+	uint64_t crc64 = crc;
+
+	for (; len >= 8; len -= 8, data += 8) {
+		crc64 = _mm_crc32_u64(crc64, *(const uint64_t *)data);
+	}
+
+	crc = (uint32_t)crc64;
+#else
+	for (; len >= 4; len -= 4, data += 4) {
+		crc = _mm_crc32_u32(crc, *(const uint32_t *)data);
+	}
+#endif
+
+	for (; len > 0; len--) {
+		crc = _mm_crc32_u8(crc, *data++);
+	}
+
+	return crc;
+}
+#endif /* CONFIG_CRC_X86_SSE42 */
+
+#ifdef CONFIG_CRC_X86_PCLMUL
+/*
+ * Folding as described in "Fast CRC Computation for Generic Polynomials
+ * Using PCLMULQDQ Instruction" (Intel, 2009), with the bit-reflected
+ * constants for polynomial 0x04c11db7: four 128-bit lanes are folded
+ * 64 bytes at a time, then into one lane, which is finally reduced to
+ * 32 bits with a Barrett reduction.
+ */
+__attribute__((target("sse4.1,pclmul")))
+uint32_t z_crc32_ieee_pclmul(uint32_t crc, const uint8_t *data, size_t len)
+{
+	/* x^(4*128+32) mod P, x^(4*128-32) mod P */
+	static const uint64_t __aligned(16) k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+	/* x^(128+32) mod P, x^(128-32) mod P */
+	static const uint64_t __aligned(16) k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+	/* x^64 mod P */
+	static const uint64_t __aligned(16) k5k0[] = { 0x0163cd6124, 0x0000000000 };
+	/* P, and mu = x^64 / P */
+	static const uint64_t __aligned(16) poly[] = { 0x01db710641, 0x01f7011641 };
+	__m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+	x1 = _mm_loadu_si128((const __m128i *)(data + 0x00));
+	x2 = _mm_loadu_si128((const __m128i *)(data + 0x10));
+	x3 = _mm_loadu_si128((const __m128i *)(data + 0x20));
+	x4 = _mm_loadu_si128((const __m128i *)(data + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+	data += 64;
+	len -= 64;
+
+	x0 = _mm_load_si128((const __m128i *)k1k2);
+
+	for (; len >= 64; len -= 64, data += 64) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+				   _mm_loadu_si128((const __m128i *)(data + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6),
+				   _mm_loadu_si128((const __m128i *)(data + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7),
+				   _mm_loadu_si128((const __m128i *)(data + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8),
+				   _mm_loadu_si128((const __m128i *)(data + 0x30)));
+	}
+
+	/* Fold the four lanes into one */
+	x0 = _mm_load_si128((const __m128i *)k3k4);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+	x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	/* Remaining 16 byte blocks */
+	for (; len >= 16; len -= 16, data += 16) {
+		x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5),
+				   _mm_loadu_si128((const __m128i *)data));
+	}
+
+	/* 128 to 64 bits */
+	x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+	x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+	x0 = _mm_loadl_epi64((const __m128i *)k5k0);
+
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, x3);
+	x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	/* Barrett reduction to 32 bits */
+	x0 = _mm_load_si128((const __m128i *)poly);
+
+	x2 = _mm_and_si128(x1, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+	x2 = _mm_and_si128(x2, x3);
+	x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+#endif /* CONFIG_CRC_X86_PCLMUL */
@@ -17,13 +17,16 @@
 #include <zephyr/posix/fcntl.h>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/fdtable.h>
+#include <zephyr/sys/bitarray.h>
 #include <zephyr/sys/speculation.h>
 #include <zephyr/syscall_handler.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
 
 struct fd_entry {
 	void *obj;
-	const struct fd_op_vtable *vtable;
+	/* const struct fd_op_vtable *, published last, see fd_vtable() */
+	atomic_ptr_t vtable;
 	atomic_t refcount;
 	struct k_mutex lock;
 	struct k_condvar cond;
@@ -33,24 +36,33 @@ struct fd_entry {
 static const struct fd_op_vtable stdinout_fd_op_vtable;
 #endif
 
-static struct fd_entry fdtable[CONFIG_POSIX_MAX_FDS] = {
+#ifdef CONFIG_POSIX_FDTABLE_DYNAMIC
+#define FD_CHUNK_SIZE CONFIG_POSIX_FDTABLE_CHUNK_SIZE
+#else
+#define FD_CHUNK_SIZE CONFIG_POSIX_MAX_FDS
+#endif
+
+#define FD_CHUNKS DIV_ROUND_UP(CONFIG_POSIX_MAX_FDS, FD_CHUNK_SIZE)
+
+/* The first chunk of entries, the whole table unless it grows dynamically */
+static struct fd_entry fdtable[MIN(FD_CHUNK_SIZE, CONFIG_POSIX_MAX_FDS)] = {
 #ifdef CONFIG_POSIX_API
 	/*
 	 * Predefine entries for stdin/stdout/stderr.
 	 */
 	{
 		/* STDIN */
-		.vtable = &stdinout_fd_op_vtable,
+		.vtable = ATOMIC_PTR_INIT((void *)&stdinout_fd_op_vtable),
 		.refcount = ATOMIC_INIT(1)
 	},
 	{
 		/* STDOUT */
-		.vtable = &stdinout_fd_op_vtable,
+		.vtable = ATOMIC_PTR_INIT((void *)&stdinout_fd_op_vtable),
 		.refcount = ATOMIC_INIT(1)
 	},
 	{
 		/* STDERR */
-		.vtable = &stdinout_fd_op_vtable,
+		.vtable = ATOMIC_PTR_INIT((void *)&stdinout_fd_op_vtable),
 		.refcount = ATOMIC_INIT(1)
 	},
 #else
@@ -60,15 +72,111 @@ static struct fd_entry fdtable[CONFIG_POSIX_MAX_FDS] = {
 #endif
 };
 
-static K_MUTEX_DEFINE(fdtable_lock);
+#ifdef CONFIG_POSIX_API
+BUILD_ASSERT(ARRAY_SIZE(fdtable) >= 3, "No room for stdin, stdout and stderr");
+#endif
+
+#ifdef CONFIG_POSIX_FDTABLE_DYNAMIC
+/* Further chunks are allocated on first use and never freed, so that
+ * lookups need no lock.
+ */
+static atomic_ptr_t fd_chunks[FD_CHUNKS] = {
+	ATOMIC_PTR_INIT(fdtable),
+};
+#endif
+
+/* Allocated descriptors, so that finding a free one scans words rather
+ * than entries, and does not need a global lock.
+ */
+static uint32_t fd_bundles[DIV_ROUND_UP(CONFIG_POSIX_MAX_FDS, 32)] = {
+#ifdef CONFIG_POSIX_API
+	/* stdin, stdout and stderr */
+	BIT_MASK(3),
+#endif
+};
+
+static sys_bitarray_t fd_bitarray = {
+	.num_bits = CONFIG_POSIX_MAX_FDS,
+	.num_bundles = ARRAY_SIZE(fd_bundles),
+	.bundles = fd_bundles,
+};
+
+static struct fd_entry *fd_entry(int fd)
+{
+	if (fd < 0 || fd >= CONFIG_POSIX_MAX_FDS) {
+		return NULL;
+	}
+
+	fd = k_array_index_sanitize(fd, CONFIG_POSIX_MAX_FDS);
+
+#ifdef CONFIG_POSIX_FDTABLE_DYNAMIC
+	struct fd_entry *chunk = atomic_ptr_get(&fd_chunks[fd / FD_CHUNK_SIZE]);
+
+	if (chunk == NULL) {
+		return NULL;
+	}
+
+	return &chunk[fd % FD_CHUNK_SIZE];
+#else
+	return &fdtable[fd];
+#endif
+}
+
+/* Lookups take no lock: z_finalize_fd() fills the entry in before it
+ * publishes the vtable, so whoever sees the vtable sees the rest too.
+ */
+static const struct fd_op_vtable *fd_vtable(struct fd_entry *entry)
+{
+	const struct fd_op_vtable *vtable = atomic_ptr_get(&entry->vtable);
+
+	barrier_dmem_fence_full();
 
-static int z_fd_ref(int fd)
+	return vtable;
+}
+
+/* Returns the entry of an allocated descriptor, allocating its chunk if needed */
+static struct fd_entry *fd_entry_alloc(int fd)
 {
-	return atomic_inc(&fdtable[fd].refcount) + 1;
+#ifdef CONFIG_POSIX_FDTABLE_DYNAMIC
+	atomic_ptr_t *slot = &fd_chunks[fd / FD_CHUNK_SIZE];
+	struct fd_entry *chunk;
+
+	if (atomic_ptr_get(slot) == NULL) {
+		chunk = k_calloc(FD_CHUNK_SIZE, sizeof(*chunk));
+		if (chunk == NULL) {
+			return NULL;
+		}
+
+		/* another thread may have allocated it meanwhile */
+		if (!atomic_ptr_cas(slot, NULL, chunk)) {
+			k_free(chunk);
+		}
+	}
+#endif
+
+	return fd_entry(fd);
+}
+
+static int z_fd_ref(struct fd_entry *entry)
+{
+	atomic_val_t old_rc;
+
+	/* Only take a reference while the descriptor is in use, so that a
+	 * lookup racing with the last z_fd_unref() cannot revive it.
+	 */
+	do {
+		old_rc = atomic_get(&entry->refcount);
+		if (!old_rc) {
+			return 0;
+		}
+	} while (!atomic_cas(&entry->refcount, old_rc, old_rc + 1));
+
+	return old_rc + 1;
 }
 
 static int z_fd_unref(int fd)
 {
+	struct fd_entry *entry = fd_entry(fd);
 	atomic_val_t old_rc;
 
 	/* Reference counter must be checked to avoid decrement refcount below
@@ -77,64 +185,47 @@ static int z_fd_unref(int fd)
 	 * refcount is not going to be written.
 	 */
 	do {
-		old_rc = atomic_get(&fdtable[fd].refcount);
+		old_rc = atomic_get(&entry->refcount);
 		if (!old_rc) {
 			return 0;
 		}
-	} while (!atomic_cas(&fdtable[fd].refcount, old_rc, old_rc - 1));
+	} while (!atomic_cas(&entry->refcount, old_rc, old_rc - 1));
 
 	if (old_rc != 1) {
 		return old_rc - 1;
 	}
 
-	fdtable[fd].obj = NULL;
-	fdtable[fd].vtable = NULL;
+	atomic_ptr_clear(&entry->vtable);
+	entry->obj = NULL;
 
-	return 0;
-}
-
-static int _find_fd_entry(void)
-{
-	int fd;
-
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (!atomic_get(&fdtable[fd].refcount)) {
-			return fd;
-		}
-	}
+	/* Only now may the descriptor be reserved again */
+	(void)sys_bitarray_free(&fd_bitarray, 1, fd);
 
-	errno = ENFILE;
-	return -1;
+	return 0;
 }
 
-static int _check_fd(int fd)
+static struct fd_entry *_check_fd(int fd)
 {
-	if (fd < 0 || fd >= ARRAY_SIZE(fdtable)) {
-		errno = EBADF;
-		return -1;
-	}
+	struct fd_entry *entry = fd_entry(fd);
 
-	fd = k_array_index_sanitize(fd, ARRAY_SIZE(fdtable));
-
-	if (!atomic_get(&fdtable[fd].refcount)) {
+	if (entry == NULL || !atomic_get(&entry->refcount)) {
 		errno = EBADF;
-		return -1;
+		return NULL;
 	}
 
-	return 0;
+	return entry;
 }
 
 void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err)
 {
 	struct fd_entry *entry;
 
-	if (_check_fd(fd) < 0) {
+	entry = _check_fd(fd);
+	if (entry == NULL) {
 		return NULL;
 	}
 
-	entry = &fdtable[fd];
-
-	if (vtable != NULL && entry->vtable != vtable) {
+	if (vtable != NULL && fd_vtable(entry) != vtable) {
 		errno = err;
 		return NULL;
 	}
@@ -142,33 +233,32 @@ void *z_get_fd_obj(int fd, const struct fd_op_vtable *vtable, int err)
 	return entry->obj;
 }
 
-static int z_get_fd_by_obj_and_vtable(void *obj, const struct fd_op_vtable *vtable)
+static struct fd_entry *z_get_fd_by_obj_and_vtable(void *obj, const struct fd_op_vtable *vtable)
 {
-	int fd;
+	struct fd_entry *entry;
 
-	for (fd = 0; fd < ARRAY_SIZE(fdtable); fd++) {
-		if (fdtable[fd].obj == obj && fdtable[fd].vtable == vtable) {
-			return fd;
+	for (int fd = 0; fd < CONFIG_POSIX_MAX_FDS; fd++) {
+		entry = fd_entry(fd);
+		if (entry != NULL && atomic_get(&entry->refcount) && entry->obj == obj &&
+		    fd_vtable(entry) == vtable) {
+			return entry;
 		}
 	}
 
 	errno = ENFILE;
-	return -1;
+	return NULL;
 }
 
 bool z_get_obj_lock_and_cond(void *obj, const struct fd_op_vtable *vtable, struct k_mutex **lock,
 			     struct k_condvar **cond)
 {
-	int fd;
 	struct fd_entry *entry;
 
-	fd = z_get_fd_by_obj_and_vtable(obj, vtable);
-	if (_check_fd(fd) < 0) {
+	entry = z_get_fd_by_obj_and_vtable(obj, vtable);
+	if (entry == NULL) {
 		return false;
 	}
 
-	entry = &fdtable[fd];
-
 	if (lock) {
 		*lock = &entry->lock;
 	}
@@ -185,12 +275,12 @@ void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 {
 	struct fd_entry *entry;
 
-	if (_check_fd(fd) < 0) {
+	entry = _check_fd(fd);
+	if (entry == NULL) {
 		return NULL;
 	}
 
-	entry = &fdtable[fd];
-	*vtable = entry->vtable;
+	*vtable = fd_vtable(entry);
 
 	if (lock) {
 		*lock = &entry->lock;
@@ -199,23 +289,63 @@ void *z_get_fd_obj_and_vtable(int fd, const struct fd_op_vtable **vtable,
 	return entry->obj;
 }
 
+int z_fd_get(int fd, void **obj, const struct fd_op_vtable **vtable, struct k_mutex **lock)
+{
+	struct fd_entry *entry = fd_entry(fd);
+
+	if (entry == NULL || !z_fd_ref(entry)) {
+		errno = EBADF;
+		return -1;
+	}
+
+	/* Reserved, but not finalized yet */
+	*vtable = fd_vtable(entry);
+	if (*vtable == NULL) {
+		(void)z_fd_unref(fd);
+		errno = EBADF;
+		return -1;
+	}
+
+	*obj = entry->obj;
+
+	if (lock) {
+		*lock = &entry->lock;
+	}
+
+	return 0;
+}
+
+void z_fd_put(int fd)
+{
+	(void)z_fd_unref(fd);
+}
+
 int z_reserve_fd(void)
 {
-	int fd;
+	struct fd_entry *entry;
+	size_t fd;
 
-	(void)k_mutex_lock(&fdtable_lock, K_FOREVER);
+	/* The lowest free descriptor, as POSIX requires */
+	if (sys_bitarray_alloc(&fd_bitarray, 1, &fd) < 0) {
+		errno = ENFILE;
+		return -1;
+	}
 
-	fd = _find_fd_entry();
-	if (fd >= 0) {
-		/* Mark entry as used, z_finalize_fd() will fill it in. */
-		(void)z_fd_ref(fd);
-		fdtable[fd].obj = NULL;
-		fdtable[fd].vtable = NULL;
-		k_mutex_init(&fdtable[fd].lock);
-		k_condvar_init(&fdtable[fd].cond);
+	entry = fd_entry_alloc(fd);
+	if (entry == NULL) {
+		(void)sys_bitarray_free(&fd_bitarray, 1, fd);
+		errno = ENFILE;
+		return -1;
 	}
 
-	k_mutex_unlock(&fdtable_lock);
+	/* The descriptor is ours until the reference is published, z_finalize_fd()
+	 * will fill it in.
+	 */
+	entry->obj = NULL;
+	atomic_ptr_clear(&entry->vtable);
+	k_mutex_init(&entry->lock);
+	k_condvar_init(&entry->cond);
+	atomic_set(&entry->refcount, 1);
 
 	return fd;
 }
@@ -223,6 +353,8 @@ int z_reserve_fd(void)
 void z_finalize_fd(int fd, void *obj, const struct fd_op_vtable *vtable)
 {
 	/* Assumes fd was already bounds-checked. */
+	struct fd_entry *entry = fd_entry(fd);
+
 #ifdef CONFIG_USERSPACE
 	/* descriptor context objects are inserted into the table when they
 	 * are ready for use. Mark the object as initialized and grant the
@@ -233,8 +365,7 @@ void z_finalize_fd(int fd, void *obj, const struct fd_op_vtable *vtable)
 	 */
 	z_object_recycle(obj);
 #endif
-	fdtable[fd].obj = obj;
-	fdtable[fd].vtable = vtable;
+	entry->obj = obj;
 
 	/* Let the object know about the lock just in case it needs it
 	 * for something. For BSD sockets, the lock is used with condition
@@ -242,8 +373,14 @@ void z_finalize_fd(int fd, void *obj, const struct fd_op_vtable *vtable)
 	 */
 	if (vtable && vtable->ioctl) {
 		(void)z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_SET_LOCK,
-					   &fdtable[fd].lock);
+					   &entry->lock);
 	}
+
+	/* Publish the descriptor last, once the object and its lock are
+	 * set up, for z_fd_get() and the other lookups.
+	 */
+	barrier_dmem_fence_full();
+	atomic_ptr_set(&entry->vtable, (void *)vtable);
 }
 
 void z_free_fd(int fd)
@@ -268,17 +405,22 @@ int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
 
 ssize_t read(int fd, void *buf, size_t sz)
 {
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
 	ssize_t res;
+	void *obj;
 
-	if (_check_fd(fd) < 0) {
+	if (z_fd_get(fd, &obj, &vtable, &lock) < 0) {
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+	(void)k_mutex_lock(lock, K_FOREVER);
 
-	res = fdtable[fd].vtable->read(fdtable[fd].obj, buf, sz);
+	res = vtable->read(obj, buf, sz);
 
-	k_mutex_unlock(&fdtable[fd].lock);
+	k_mutex_unlock(lock);
+
+	z_fd_put(fd);
 
 	return res;
 }
@@ -286,17 +428,22 @@ FUNC_ALIAS(read, _read, ssize_t);
 
 ssize_t write(int fd, const void *buf, size_t sz)
 {
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
 	ssize_t res;
+	void *obj;
 
-	if (_check_fd(fd) < 0) {
+	if (z_fd_get(fd, &obj, &vtable, &lock) < 0) {
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	res = vtable->write(obj, buf, sz);
 
-	res = fdtable[fd].vtable->write(fdtable[fd].obj, buf, sz);
+	k_mutex_unlock(lock);
 
-	k_mutex_unlock(&fdtable[fd].lock);
+	z_fd_put(fd);
 
 	return res;
 }
@@ -304,19 +451,24 @@ FUNC_ALIAS(write, _write, ssize_t);
 
 int close(int fd)
 {
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (z_fd_get(fd, &obj, &vtable, &lock) < 0) {
 		return -1;
 	}
 
-	(void)k_mutex_lock(&fdtable[fd].lock, K_FOREVER);
+	(void)k_mutex_lock(lock, K_FOREVER);
 
-	res = fdtable[fd].vtable->close(fdtable[fd].obj);
+	res = vtable->close(obj);
 
-	k_mutex_unlock(&fdtable[fd].lock);
+	k_mutex_unlock(lock);
 
+	/* The entry is released with the last reference */
 	z_free_fd(fd);
+	z_fd_put(fd);
 
 	return res;
 }
@@ -324,46 +476,67 @@ FUNC_ALIAS(close, _close, int);
 
 int fsync(int fd)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj;
+	int res;
+
+	if (z_fd_get(fd, &obj, &vtable, NULL) < 0) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_FSYNC);
+	res = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_FSYNC);
+
+	z_fd_put(fd);
+
+	return res;
 }
 
 off_t lseek(int fd, off_t offset, int whence)
 {
-	if (_check_fd(fd) < 0) {
+	const struct fd_op_vtable *vtable;
+	void *obj;
+	off_t res;
+
+	if (z_fd_get(fd, &obj, &vtable, NULL) < 0) {
 		return -1;
 	}
 
-	return z_fdtable_call_ioctl(fdtable[fd].vtable, fdtable[fd].obj, ZFD_IOCTL_LSEEK,
-			  offset, whence);
+	res = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_LSEEK, offset, whence);
+
+	z_fd_put(fd);
+
+	return res;
 }
 FUNC_ALIAS(lseek, _lseek, off_t);
 
 int ioctl(int fd, unsigned long request, ...)
 {
+	const struct fd_op_vtable *vtable;
 	va_list args;
+	void *obj;
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (z_fd_get(fd, &obj, &vtable, NULL) < 0) {
 		return -1;
 	}
 
 	va_start(args, request);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, request, args);
+	res = vtable->ioctl(obj, request, args);
 	va_end(args);
 
+	z_fd_put(fd);
+
 	return res;
 }
 
 int fcntl(int fd, int cmd, ...)
 {
+	const struct fd_op_vtable *vtable;
 	va_list args;
+	void *obj;
 	int res;
 
-	if (_check_fd(fd) < 0) {
+	if (_check_fd(fd) == NULL) {
 		return -1;
 	}
 
@@ -374,11 +547,17 @@ int fcntl(int fd, int cmd, ...)
 		return -1;
 	}
 
+	if (z_fd_get(fd, &obj, &vtable, NULL) < 0) {
+		return -1;
+	}
+
 	/* The rest of commands are per-fd, handled by ioctl vmethod. */
 	va_start(args, cmd);
-	res = fdtable[fd].vtable->ioctl(fdtable[fd].obj, cmd, args);
+	res = vtable->ioctl(obj, cmd, args);
 	va_end(args);
 
+	z_fd_put(fd);
+
 	return res;
 }
 
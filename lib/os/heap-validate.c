@@ -56,7 +56,7 @@ static inline void check_nexts(struct z_heap *h, int bidx)
 {
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
-	bool emptybit = (h->avail_buckets & BIT(bidx)) == 0;
+	bool emptybit = !bucket_avail(h, bidx);
 	bool emptylist = b->next == 0;
 	bool empties_match = emptybit == emptylist;
 
@@ -138,7 +138,7 @@ bool sys_heap_validate(struct sys_heap *heap)
 			set_chunk_used(h, c, true);
 		}
 
-		bool empty = (h->avail_buckets & BIT(b)) == 0;
+		bool empty = !bucket_avail(h, b);
 		bool zero = n == 0;
 
 		if (empty != zero) {
@@ -374,7 +374,7 @@ void heap_print_info(struct z_heap *h, bool dump_chunks)
 		}
 		if (count) {
 			printk("%9d %12d %12d %12d %12zd\n",
-			       i, (1 << i) - 1 + min_chunk_size(h), count,
+			       i, bucket_min_usable(i) - 1 + min_chunk_size(h), count,
 			       largest, chunksz_to_bytes(h, largest));
 		}
 	}
@@ -423,6 +423,9 @@ int sys_heap_runtime_stats_get(struct sys_heap *heap,
 	stats->free_bytes = heap->heap->free_bytes;
 	stats->allocated_bytes = heap->heap->allocated_bytes;
 	stats->max_allocated_bytes = heap->heap->max_allocated_bytes;
+#ifdef CONFIG_SYS_HEAP_TCACHE
+	z_heap_tcache_stats_get(heap, stats);
+#endif
 
 	return 0;
 }
@@ -37,11 +37,11 @@ static void free_list_remove_bidx(struct z_heap *h, chunkid_t c, int bidx)
 
 	CHECK(!chunk_used(h, c));
 	CHECK(b->next != 0);
-	CHECK(h->avail_buckets & BIT(bidx));
+	CHECK(bucket_avail(h, bidx));
 
 	if (next_free_chunk(h, c) == c) {
 		/* this is the last chunk */
-		h->avail_buckets &= ~BIT(bidx);
+		set_bucket_avail(h, bidx, false);
 		b->next = 0;
 	} else {
 		chunkid_t first = prev_free_chunk(h, c),
@@ -70,15 +70,15 @@ static void free_list_add_bidx(struct z_heap *h, chunkid_t c, int bidx)
 	struct z_heap_bucket *b = &h->buckets[bidx];
 
 	if (b->next == 0U) {
-		CHECK((h->avail_buckets & BIT(bidx)) == 0);
+		CHECK(!bucket_avail(h, bidx));
 
 		/* Empty list, first item */
-		h->avail_buckets |= BIT(bidx);
+		set_bucket_avail(h, bidx, true);
 		b->next = c;
 		set_prev_free_chunk(h, c, c);
 		set_next_free_chunk(h, c, c);
 	} else {
-		CHECK(h->avail_buckets & BIT(bidx));
+		CHECK(bucket_avail(h, bidx));
 
 		/* Insert before (!) the "next" pointer */
 		chunkid_t second = b->next;
@@ -208,6 +208,61 @@ size_t sys_heap_usable_size(struct sys_heap *heap, void *mem)
 	return chunk_sz - (addr - chunk_base);
 }
 
+#ifdef CONFIG_SYS_HEAP_BUCKETS_TLSF
+
+/* Two-level segregated fit.  Round the request up to the first
+ * bucket whose chunks are all large enough and take the head of the
+ * first non-empty bucket from there, located with one scan of the
+ * row bitmap and one of the row-level bitmap.  No loops, so constant
+ * time regardless of the state of the free lists.
+ */
+static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
+{
+	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
+	int fl = 31 - __builtin_clz(usable_sz);
+	int bi, row;
+	uint32_t slmap;
+	chunkid_t c;
+
+	if (fl > TLSF_SL_BITS) {
+		usable_sz += BIT(fl - TLSF_SL_BITS) - 1U;
+	}
+
+	bi = tlsf_bucket_idx(usable_sz);
+	row = bi >> TLSF_SL_BITS;
+	slmap = (row < TLSF_ROWS) ?
+		h->avail_sl[row] & ~BIT_MASK(bi & (TLSF_SL_COUNT - 1U)) : 0U;
+
+	if (slmap == 0U) {
+		uint32_t flmap = (row + 1 < TLSF_ROWS) ?
+				 h->avail_buckets & ~BIT_MASK(row + 1) : 0U;
+
+		if (flmap == 0U) {
+			/* Nothing guaranteed to fit: as a last resort,
+			 * the head of the request's own bucket might.
+			 */
+			bi = bucket_idx(h, sz);
+			c = h->buckets[bi].next;
+			if (c != 0U && chunk_size(h, c) >= sz) {
+				free_list_remove_bidx(h, c, bi);
+				return c;
+			}
+			return 0;
+		}
+
+		row = __builtin_ctz(flmap);
+		slmap = h->avail_sl[row];
+	}
+
+	bi = (row << TLSF_SL_BITS) | __builtin_ctz(slmap);
+	c = h->buckets[bi].next;
+	free_list_remove_bidx(h, c, bi);
+	CHECK(chunk_size(h, c) >= sz);
+	return c;
+}
+
+#else /* CONFIG_SYS_HEAP_BUCKETS_TLSF */
+
 static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 {
 	int bi = bucket_idx(h, sz);
@@ -260,6 +315,8 @@ static chunkid_t alloc_chunk(struct z_heap *h, chunksz_t sz)
 	return 0;
 }
 
+#endif /* CONFIG_SYS_HEAP_BUCKETS_TLSF */
+
 void *sys_heap_alloc(struct sys_heap *heap, size_t bytes)
 {
 	struct z_heap *h = heap->heap;
@@ -482,6 +539,12 @@ void *sys_heap_aligned_realloc(struct sys_heap *heap, void *ptr,
 	return ptr2;
 }
 
+/* Z_HEAP_MIN_SIZE must be the smallest heap sys_heap_init() below
+ * accepts with room for a 1 byte allocation
+ */
+BUILD_ASSERT(Z_HEAP_MIN_NEXT(Z_HEAP_MIN_CHUNKS) == Z_HEAP_MIN_CHUNKS,
+	     "Z_HEAP_MIN_SIZE does not fit the heap metadata");
+
 void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 {
 	IF_ENABLED(CONFIG_MSAN, (__sanitizer_dtor_callback(mem, bytes)));
@@ -509,7 +572,11 @@ void sys_heap_init(struct sys_heap *heap, void *mem, size_t bytes)
 	struct z_heap *h = (struct z_heap *)addr;
 	heap->heap = h;
 	h->end_chunk = heap_sz;
+	IF_ENABLED(CONFIG_SYS_HEAP_TCACHE, (z_heap_tcache_init(heap)));
 	h->avail_buckets = 0;
+#ifdef CONFIG_SYS_HEAP_BUCKETS_TLSF
+	memset(h->avail_sl, 0, sizeof(h->avail_sl));
+#endif
 
 #ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
 	h->free_bytes = 0;
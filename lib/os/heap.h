@@ -6,6 +6,8 @@
 #ifndef ZEPHYR_INCLUDE_LIB_OS_HEAP_H_
 #define ZEPHYR_INCLUDE_LIB_OS_HEAP_H_
 
+#include <zephyr/sys/sys_heap_internal.h>
+
 /*
  * Internal heap APIs
  */
@@ -53,7 +55,7 @@
 
 enum chunk_fields { LEFT_SIZE, SIZE_AND_USED, FREE_PREV, FREE_NEXT };
 
-#define CHUNK_UNIT 8U
+#define CHUNK_UNIT Z_HEAP_CHUNK_UNIT
 
 typedef struct { char bytes[CHUNK_UNIT]; } chunk_unit_t;
 
@@ -61,30 +63,31 @@ typedef struct { char bytes[CHUNK_UNIT]; } chunk_unit_t;
 typedef uint32_t chunkid_t;
 typedef uint32_t chunksz_t;
 
-struct z_heap_bucket {
-	chunkid_t next;
-};
-
-struct z_heap {
-	chunkid_t chunk0_hdr[2];
-	chunkid_t end_chunk;
-	uint32_t avail_buckets;
-#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
-	size_t free_bytes;
-	size_t allocated_bytes;
-	size_t max_allocated_bytes;
+/* struct z_heap, the header of chunk 0, and its struct z_heap_bucket
+ * free lists are in <zephyr/sys/sys_heap_internal.h>, along with the
+ * bucket index computation, as Z_HEAP_MIN_SIZE depends on them.
+ */
+
+#ifdef CONFIG_SYS_HEAP_BUCKETS_TLSF
+/* With the TLSF layout, each power-of-two range of chunk sizes is
+ * split into 2^TLSF_SL_BITS equally sized free lists ("second level"),
+ * and each such row of lists has its own availability bitmap.  The
+ * smallest sizes, where rows would have fewer chunk sizes than lists,
+ * get one list per chunk size instead.
+ */
+#define TLSF_SL_BITS  Z_HEAP_TLSF_SL_BITS
+#define TLSF_SL_COUNT BIT(TLSF_SL_BITS)
+#define TLSF_ROWS     Z_HEAP_TLSF_ROWS
 #endif
-	struct z_heap_bucket buckets[0];
-};
 
 static inline bool big_heap_chunks(chunksz_t chunks)
 {
+	if (Z_HEAP_SMALL_IS_BIG) {
+		return true;
+	}
 	if (IS_ENABLED(CONFIG_SYS_HEAP_SMALL_ONLY)) {
 		return false;
 	}
-	if (IS_ENABLED(CONFIG_SYS_HEAP_BIG_ONLY) || sizeof(void *) > 4U) {
-		return true;
-	}
 	return chunks > 0x7fffU;
 }
 
@@ -247,12 +250,82 @@ static inline size_t chunksz_to_bytes(struct z_heap *h, chunksz_t chunksz_in)
 	return chunksz_in * CHUNK_UNIT - chunk_header_bytes(h);
 }
 
+#ifdef CONFIG_SYS_HEAP_BUCKETS_TLSF
+
+static inline int tlsf_bucket_idx(unsigned int usable_sz)
+{
+	return Z_HEAP_BUCKET_IDX(usable_sz);
+}
+
+static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
+{
+	return tlsf_bucket_idx(sz - min_chunk_size(h) + 1);
+}
+
+/* Smallest "usable size" (as computed by bucket_idx()) in a bucket */
+static inline unsigned int bucket_min_usable(int bidx)
+{
+	if (bidx < 2 * TLSF_SL_COUNT) {
+		return bidx;
+	}
+
+	int fl = (bidx >> TLSF_SL_BITS) + TLSF_SL_BITS - 1;
+	unsigned int sl = bidx & (TLSF_SL_COUNT - 1U);
+
+	return BIT(fl) | (sl << (fl - TLSF_SL_BITS));
+}
+
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (h->avail_sl[bidx >> TLSF_SL_BITS] &
+		BIT(bidx & (TLSF_SL_COUNT - 1U))) != 0U;
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+	int row = bidx >> TLSF_SL_BITS;
+
+	if (avail) {
+		h->avail_sl[row] |= BIT(bidx & (TLSF_SL_COUNT - 1U));
+		h->avail_buckets |= BIT(row);
+	} else {
+		h->avail_sl[row] &= ~BIT(bidx & (TLSF_SL_COUNT - 1U));
+		if (h->avail_sl[row] == 0U) {
+			h->avail_buckets &= ~BIT(row);
+		}
+	}
+}
+
+#else /* CONFIG_SYS_HEAP_BUCKETS_TLSF */
+
 static inline int bucket_idx(struct z_heap *h, chunksz_t sz)
 {
 	unsigned int usable_sz = sz - min_chunk_size(h) + 1;
-	return 31 - __builtin_clz(usable_sz);
+	return Z_HEAP_BUCKET_IDX(usable_sz);
+}
+
+/* Smallest "usable size" (as computed by bucket_idx()) in a bucket */
+static inline unsigned int bucket_min_usable(int bidx)
+{
+	return BIT(bidx);
 }
 
+static inline bool bucket_avail(struct z_heap *h, int bidx)
+{
+	return (h->avail_buckets & BIT(bidx)) != 0U;
+}
+
+static inline void set_bucket_avail(struct z_heap *h, int bidx, bool avail)
+{
+	if (avail) {
+		h->avail_buckets |= BIT(bidx);
+	} else {
+		h->avail_buckets &= ~BIT(bidx);
+	}
+}
+
+#endif /* CONFIG_SYS_HEAP_BUCKETS_TLSF */
+
 static inline bool size_too_big(struct z_heap *h, size_t bytes)
 {
 	/*
@@ -265,4 +338,10 @@ static inline bool size_too_big(struct z_heap *h, size_t bytes)
 /* For debugging */
 void heap_print_info(struct z_heap *h, bool dump_chunks);
 
+#ifdef CONFIG_SYS_HEAP_TCACHE
+void z_heap_tcache_init(struct sys_heap *heap);
+void z_heap_tcache_stats_get(struct sys_heap *heap,
+			     struct sys_memory_stats *stats);
+#endif
+
 #endif /* ZEPHYR_INCLUDE_LIB_OS_HEAP_H_ */
@@ -0,0 +1,244 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/kernel.h>
+#include <string.h>
+#include "heap.h"
+#ifdef CONFIG_MSAN
+#include <sanitizer/msan_interface.h>
+#endif
+
+/*
+ * Per-CPU caches of small blocks.  Cached blocks remain allocated
+ * chunks as far as the heap is concerned, so the heap proper never
+ * sees them and needs no change.  There is one size class per chunk
+ * size, from min_chunk_size() up, so every block of a class has
+ * exactly the same size and any of them can serve any request of that
+ * class.  A CPU's cache is only ever touched by that CPU, with local
+ * interrupts locked, which is what makes the fast paths safe without
+ * the heap lock.
+ */
+#define TCACHE_CLASSES CONFIG_SYS_HEAP_TCACHE_CLASSES
+#define TCACHE_DEPTH   CONFIG_SYS_HEAP_TCACHE_DEPTH
+
+/* Refills and flushes run with interrupts locked (the heap lock, or
+ * arch_irq_lock() for the malloc arena), so bound the number of heap
+ * calls each of them makes.
+ */
+#define TCACHE_BATCH_MAX 8
+#define TCACHE_BATCH   MIN(TCACHE_DEPTH / 2, TCACHE_BATCH_MAX)
+
+static inline struct z_heap_tcache *local_tcache(struct sys_heap *heap)
+{
+#ifdef CONFIG_SMP
+	return &heap->tcache[arch_curr_cpu()->id];
+#else
+	return &heap->tcache[0];
+#endif
+}
+
+/* Only plain power-of-two alignments are cacheable, not the
+ * align/rewind combinations accepted by sys_heap_aligned_alloc()
+ */
+static inline bool cacheable_align(size_t align)
+{
+	return (align & (align - 1)) == 0U;
+}
+
+/* Returns the class serving requests of @bytes, or -1 */
+static int request_class(struct z_heap *h, size_t bytes)
+{
+	chunksz_t max_sz = min_chunk_size(h) + TCACHE_CLASSES - 1;
+
+	if (bytes == 0U || bytes > chunksz_to_bytes(h, max_sz)) {
+		return -1;
+	}
+
+	return bytes_to_chunksz(h, bytes) - min_chunk_size(h);
+}
+
+/* Returns the class of allocated block @mem, or -1 */
+static int block_class(struct z_heap *h, void *mem)
+{
+	uint8_t *base = (uint8_t *)chunk_buf(h);
+	chunkid_t c = ((uint8_t *)mem - chunk_header_bytes(h) - base) / CHUNK_UNIT;
+	chunksz_t sz;
+
+	/* Blocks from an alignment rewind don't start at their chunk */
+	if ((uint8_t *)&chunk_buf(h)[c] + chunk_header_bytes(h) != mem) {
+		return -1;
+	}
+
+	__ASSERT(chunk_used(h, c),
+		 "unexpected heap state (double-free?) for memory at %p", mem);
+
+	sz = chunk_size(h, c) - min_chunk_size(h);
+
+	return sz < TCACHE_CLASSES ? (int)sz : -1;
+}
+
+static inline void tcache_push(struct z_heap_tcache *tc, int cls, void *mem)
+{
+	*(void **)mem = tc->bins[cls];
+	tc->bins[cls] = mem;
+	tc->count[cls]++;
+}
+
+static inline void *tcache_pop(struct z_heap_tcache *tc, int cls)
+{
+	void *mem = tc->bins[cls];
+
+	tc->bins[cls] = *(void **)mem;
+	tc->count[cls]--;
+
+	return mem;
+}
+
+/* Returns @n blocks of class @cls to the heap.  must be locked */
+static void tcache_release(struct sys_heap *heap, struct z_heap_tcache *tc,
+			   int cls, int n)
+{
+	while (n-- > 0 && tc->count[cls] > 0U) {
+		sys_heap_free(heap, tcache_pop(tc, cls));
+	}
+}
+
+void *sys_heap_tcache_alloc(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct z_heap_tcache *tc = local_tcache(heap);
+	int cls = request_class(heap->heap, bytes);
+	void *mem;
+
+	if (cls < 0 || !cacheable_align(align)) {
+		return NULL;
+	}
+
+	mem = tc->bins[cls];
+	if (mem == NULL || ((uintptr_t)mem & (MAX(align, 1U) - 1U)) != 0U) {
+		return NULL;
+	}
+
+	(void)tcache_pop(tc, cls);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	tc->hits++;
+#endif
+
+	IF_ENABLED(CONFIG_MSAN, (__msan_allocated_memory(mem, bytes)));
+	return mem;
+}
+
+bool sys_heap_tcache_free(struct sys_heap *heap, void *mem)
+{
+	struct z_heap_tcache *tc = local_tcache(heap);
+	int cls;
+
+	if (mem == NULL) {
+		return false;
+	}
+
+	cls = block_class(heap->heap, mem);
+	if (cls < 0 || tc->count[cls] >= TCACHE_DEPTH) {
+		return false;
+	}
+
+	tcache_push(tc, cls, mem);
+	return true;
+}
+
+void *sys_heap_tcache_refill(struct sys_heap *heap, size_t align, size_t bytes)
+{
+	struct z_heap_tcache *tc = local_tcache(heap);
+	int cls = request_class(heap->heap, bytes);
+	void *mem = sys_heap_aligned_alloc(heap, align, bytes);
+
+	if (cls < 0 || mem == NULL || !cacheable_align(align)) {
+		return mem;
+	}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	tc->misses++;
+#endif
+
+	/* The block returned counts as the first of the batch: allocate
+	 * up to TCACHE_BATCH - 1 more with the same request and cache
+	 * them, stopping early if the heap runs out or the cache of the
+	 * class is full.  The heap splits off whatever a chunk has in
+	 * excess of the request, so these blocks all have the chunk size
+	 * of the class the next sys_heap_tcache_alloc() looks at.
+	 */
+	for (int i = 1; i < TCACHE_BATCH && tc->count[cls] < TCACHE_DEPTH; i++) {
+		void *blk = sys_heap_aligned_alloc(heap, align, bytes);
+
+		if (blk == NULL) {
+			break;
+		}
+		tcache_push(tc, cls, blk);
+	}
+
+	return mem;
+}
+
+void sys_heap_tcache_flush(struct sys_heap *heap, void *mem)
+{
+	struct z_heap_tcache *tc = local_tcache(heap);
+	int cls = (mem == NULL) ? -1 : block_class(heap->heap, mem);
+
+	if (cls < 0) {
+		sys_heap_free(heap, mem);
+		return;
+	}
+
+	/* Keep the block being freed, it is the most likely to be hot */
+	if (tc->count[cls] >= TCACHE_DEPTH) {
+		tcache_release(heap, tc, cls, TCACHE_BATCH);
+	}
+	tcache_push(tc, cls, mem);
+}
+
+bool sys_heap_tcache_drain(struct sys_heap *heap)
+{
+	struct z_heap_tcache *tc = local_tcache(heap);
+	bool drained = false;
+
+	for (int cls = 0; cls < TCACHE_CLASSES; cls++) {
+		if (tc->count[cls] > 0U) {
+			tcache_release(heap, tc, cls, tc->count[cls]);
+			drained = true;
+		}
+	}
+
+	return drained;
+}
+
+void z_heap_tcache_init(struct sys_heap *heap)
+{
+	memset(heap->tcache, 0, sizeof(heap->tcache));
+}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+void z_heap_tcache_stats_get(struct sys_heap *heap,
+			     struct sys_memory_stats *stats)
+{
+	struct z_heap *h = heap->heap;
+
+	stats->cached_bytes = 0;
+	stats->cache_hits = 0;
+	stats->cache_misses = 0;
+
+	for (int cpu = 0; cpu < ARRAY_SIZE(heap->tcache); cpu++) {
+		struct z_heap_tcache *tc = &heap->tcache[cpu];
+
+		for (int cls = 0; cls < TCACHE_CLASSES; cls++) {
+			stats->cached_bytes += tc->count[cls] *
+				chunksz_to_bytes(h, min_chunk_size(h) + cls);
+		}
+		stats->cache_hits += tc->hits;
+		stats->cache_misses += tc->misses;
+	}
+}
+#endif
@@ -9,6 +9,66 @@
 #include <errno.h>
 #include <zephyr/sys/util.h>
 
+#include "hex_internal.h"
+
+/* Bytes of a word with each of the four bytes set to one */
+#define ONES 0x01010101U
+
+/* Per byte flags, in bit 7, for bytes of x above m or below n, which hold
+ * for bytes and bounds below 0x80.
+ */
+#define BYTES_ABOVE(x, m) (((x) + (0x7fU - (m)) * ONES) & (0x80U * ONES))
+#define BYTES_BELOW(x, n) (~((x) + (0x80U - (n)) * ONES) & (0x80U * ONES))
+
+/* Convert two bytes into four lowercase hex digits, a word at a time */
+static inline void bin2hex_2(const uint8_t *buf, char *hex)
+{
+	uint32_t v = ((uint32_t)buf[0] << 8) | buf[1];
+	uint32_t alpha;
+
+	/* One nibble per byte, most significant first */
+	v = ((v & 0xf000U) << 12) | ((v & 0x0f00U) << 8) |
+	    ((v & 0x00f0U) << 4) | (v & 0x000fU);
+
+	/* Nibbles above 9 are offset from 'a' - 10 instead of '0' */
+	alpha = ((v + 6U * ONES) >> 4) & ONES;
+	v += '0' * ONES + alpha * ('a' - 10 - '0');
+
+	hex[0] = v >> 24;
+	hex[1] = v >> 16;
+	hex[2] = v >> 8;
+	hex[3] = v;
+}
+
+/* Convert four hex digits into two bytes, a word at a time */
+static inline int hex2bin_2(const char *hex, uint8_t *buf)
+{
+	uint32_t x = ((uint32_t)(uint8_t)hex[0] << 24) | ((uint32_t)(uint8_t)hex[1] << 16) |
+		     ((uint32_t)(uint8_t)hex[2] << 8) | (uint8_t)hex[3];
+	uint32_t digit, alpha;
+
+	if ((x & (0x80U * ONES)) != 0U) {
+		return -EINVAL;
+	}
+
+	digit = BYTES_ABOVE(x, '0' - 1) & BYTES_BELOW(x, '9' + 1);
+	/* Lowercase letters, and no other character becomes one */
+	alpha = BYTES_ABOVE(x | (0x20U * ONES), 'a' - 1) &
+		BYTES_BELOW(x | (0x20U * ONES), 'f' + 1);
+
+	if ((digit | alpha) != 0x80U * ONES) {
+		return -EINVAL;
+	}
+
+	x = (x & (0x0fU * ONES)) + (alpha >> 7) * 9U;
+	x |= x >> 4;
+
+	buf[0] = x >> 16;
+	buf[1] = x;
+
+	return 0;
+}
+
 int char2hex(char c, uint8_t *x)
 {
 	if (c >= '0' && c <= '9') {
@@ -39,11 +99,20 @@ int hex2char(uint8_t x, char *c)
 
 size_t bin2hex(const uint8_t *buf, size_t buflen, char *hex, size_t hexlen)
 {
+	size_t done;
+
 	if (hexlen < (buflen * 2 + 1)) {
 		return 0;
 	}
 
-	for (size_t i = 0; i < buflen; i++) {
+	/* Whole vectors first, the count is even */
+	done = z_bin2hex_simd(buf, buflen, hex);
+
+	for (size_t i = done; i < buflen / 2 * 2; i += 2) {
+		bin2hex_2(&buf[i], &hex[2 * i]);
+	}
+
+	for (size_t i = buflen / 2 * 2; i < buflen; i++) {
 		if (hex2char(buf[i] >> 4, &hex[2 * i]) < 0) {
 			return 0;
 		}
@@ -59,6 +128,7 @@ size_t bin2hex(const uint8_t *buf, size_t buflen, char *hex, size_t hexlen)
 size_t hex2bin(const char *hex, size_t hexlen, uint8_t *buf, size_t buflen)
 {
 	uint8_t dec;
+	size_t done;
 
 	if (buflen < hexlen / 2 + hexlen % 2) {
 		return 0;
@@ -74,8 +144,19 @@ size_t hex2bin(const char *hex, size_t hexlen, uint8_t *buf, size_t buflen)
 		buf++;
 	}
 
-	/* regular hex conversion */
-	for (size_t i = 0; i < hexlen / 2; i++) {
+	/* whole vectors first, up to the first invalid digit, which the
+	 * regular conversion then reports
+	 */
+	done = z_hex2bin_simd(hex, hexlen / 2, buf);
+
+	/* regular hex conversion, two bytes at a time */
+	for (size_t i = done; i < hexlen / 4 * 2; i += 2) {
+		if (hex2bin_2(&hex[2 * i], &buf[i]) < 0) {
+			return 0;
+		}
+	}
+
+	for (size_t i = hexlen / 4 * 2; i < hexlen / 2; i++) {
 		if (char2hex(hex[2 * i], &dec) < 0) {
 			return 0;
 		}
@@ -0,0 +1,72 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <arm_neon.h>
+
+#include "hex_internal.h"
+
+/* 16 bytes to 32 digits and back per step, the structure loads and
+ * stores interleave the high and low nibble digits
+ */
+
+static const uint8_t digits[] = "0123456789abcdef";
+
+size_t z_bin2hex_simd(const uint8_t *buf, size_t len, char *hex)
+{
+	const uint8x16_t map = vld1q_u8(digits);
+	size_t done;
+
+	for (done = 0; len - done >= 16; done += 16, hex += 32) {
+		uint8x16_t in = vld1q_u8(&buf[done]);
+		uint8x16x2_t out;
+
+		out.val[0] = vqtbl1q_u8(map, vshrq_n_u8(in, 4));
+		out.val[1] = vqtbl1q_u8(map, vandq_u8(in, vdupq_n_u8(0x0f)));
+
+		vst2q_u8((uint8_t *)hex, out);
+	}
+
+	return done;
+}
+
+/* Nibbles of 16 hex digits, upper or lowercase, with all ones in *valid
+ * for the digits and zero for any other character
+ */
+static inline uint8x16_t hex_nibbles(uint8x16_t in, uint8x16_t *valid)
+{
+	uint8x16_t digit = vsubq_u8(in, vdupq_n_u8('0'));
+	uint8x16_t alpha = vsubq_u8(vorrq_u8(in, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+	uint8x16_t is_digit = vcltq_u8(digit, vdupq_n_u8(10));
+	uint8x16_t is_alpha = vcltq_u8(alpha, vdupq_n_u8(6));
+
+	*valid = vorrq_u8(is_digit, is_alpha);
+
+	return vbslq_u8(is_digit, digit, vaddq_u8(alpha, vdupq_n_u8(10)));
+}
+
+size_t z_hex2bin_simd(const char *hex, size_t len, uint8_t *buf)
+{
+	size_t done;
+
+	for (done = 0; len - done >= 16; done += 16, hex += 32) {
+		uint8x16x2_t in = vld2q_u8((const uint8_t *)hex);
+		uint8x16_t valid_hi, valid_lo;
+		uint8x16_t hi = hex_nibbles(in.val[0], &valid_hi);
+		uint8x16_t lo = hex_nibbles(in.val[1], &valid_lo);
+
+		if (vminvq_u8(vandq_u8(valid_hi, valid_lo)) == 0U) {
+			break;
+		}
+
+		vst1q_u8(&buf[done], vorrq_u8(vshlq_n_u8(hi, 4), lo));
+	}
+
+	return done;
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_LIB_OS_HEX_INTERNAL_H_
+#define ZEPHYR_LIB_OS_HEX_INTERNAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(CONFIG_HEX_X86_SSSE3) || defined(CONFIG_HEX_ARM64_NEON)
+/* Converts the leading blocks of len bytes into lowercase hex digits,
+ * returns the number of bytes converted
+ */
+size_t z_bin2hex_simd(const uint8_t *buf, size_t len, char *hex);
+
+/* Converts the leading blocks of 2 * len hex digits into bytes, up to the
+ * first block with an invalid digit, returns the number of bytes written
+ */
+size_t z_hex2bin_simd(const char *hex, size_t len, uint8_t *buf);
+#else
+static inline size_t z_bin2hex_simd(const uint8_t *buf, size_t len, char *hex)
+{
+	return 0;
+}
+
+static inline size_t z_hex2bin_simd(const char *hex, size_t len, uint8_t *buf)
+{
+	return 0;
+}
+#endif
+
+#endif /* ZEPHYR_LIB_OS_HEX_INTERNAL_H_ */
@@ -0,0 +1,82 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/toolchain.h>
+#include <immintrin.h>
+
+#include "hex_internal.h"
+
+/* 16 bytes to 32 digits and back per step */
+
+__attribute__((target("ssse3")))
+size_t z_bin2hex_simd(const uint8_t *buf, size_t len, char *hex)
+{
+	const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+					     '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+	const __m128i mask = _mm_set1_epi8(0x0f);
+	size_t done;
+
+	for (done = 0; len - done >= 16; done += 16, hex += 32) {
+		__m128i in = _mm_loadu_si128((const __m128i *)&buf[done]);
+		__m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(in, 4), mask));
+		__m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(in, mask));
+
+		_mm_storeu_si128((__m128i *)hex, _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i *)&hex[16], _mm_unpackhi_epi8(hi, lo));
+	}
+
+	return done;
+}
+
+/* Nibbles of 16 hex digits, upper or lowercase, returns false on any
+ * other character
+ */
+__attribute__((target("ssse3")))
+static inline bool hex_nibbles(__m128i in, __m128i *nibbles)
+{
+	/* Unsigned x < n as min(x, n - 1) == x */
+	__m128i digit = _mm_sub_epi8(in, _mm_set1_epi8('0'));
+	__m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+	__m128i alpha = _mm_sub_epi8(_mm_or_si128(in, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	__m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+	if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xffff) {
+		return false;
+	}
+
+	*nibbles = _mm_or_si128(_mm_and_si128(is_digit, digit),
+				_mm_and_si128(is_alpha, _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+
+	return true;
+}
+
+__attribute__((target("ssse3")))
+size_t z_hex2bin_simd(const char *hex, size_t len, uint8_t *buf)
+{
+	/* Weights of the high and low nibble digits of each byte */
+	const __m128i weights = _mm_set1_epi16(0x0110);
+	size_t done;
+
+	for (done = 0; len - done >= 16; done += 16, hex += 32) {
+		__m128i in0 = _mm_loadu_si128((const __m128i *)hex);
+		__m128i in1 = _mm_loadu_si128((const __m128i *)&hex[16]);
+		__m128i lo, hi;
+
+		if (!hex_nibbles(in0, &lo) || !hex_nibbles(in1, &hi)) {
+			break;
+		}
+
+		lo = _mm_maddubs_epi16(lo, weights);
+		hi = _mm_maddubs_epi16(hi, weights);
+
+		_mm_storeu_si128((__m128i *)&buf[done], _mm_packus_epi16(lo, hi));
+	}
+
+	return done;
+}
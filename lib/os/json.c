@@ -8,6 +8,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>
+#include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/printk.h>
 #include <zephyr/sys/util.h>
 #include <stdbool.h>
@@ -730,6 +731,704 @@ int json_arr_separate_parse_object(struct json_obj *json, const struct json_obj_
 	return obj_parse(json, descr, descr_len, val);
 }
 
+/*
+ * The streaming parser is a push-driven version of the above: the
+ * lexer keeps its state between chunks, and the recursion of
+ * obj_parse()/arr_parse() is replaced by a stack of frames.  It accepts
+ * the same input, including the optional commas.
+ */
+
+enum stream_lex {
+	STREAM_LEX_VALUE,
+	STREAM_LEX_STRING,
+	STREAM_LEX_ESCAPE,
+	STREAM_LEX_UNICODE,
+	STREAM_LEX_SIGN,
+	STREAM_LEX_NUMBER,
+	STREAM_LEX_LITERAL,
+	/* Copying a JSON_TOK_OBJ_ARRAY value verbatim */
+	STREAM_LEX_RAW,
+	STREAM_LEX_RAW_STRING,
+	STREAM_LEX_RAW_ESCAPE,
+	STREAM_LEX_DONE,
+};
+
+enum stream_state {
+	STREAM_OBJ_START,
+	/* Key, comma or end of object */
+	STREAM_OBJ_KEY,
+	/* Key after a comma */
+	STREAM_OBJ_KEY_ONLY,
+	STREAM_OBJ_COLON,
+	STREAM_OBJ_VALUE,
+	STREAM_ARR_START,
+	/* Element, comma or end of array */
+	STREAM_ARR_VALUE,
+	/* Element after a comma */
+	STREAM_ARR_VALUE_ONLY,
+};
+
+/* Where the characters of the current token go */
+enum stream_sink {
+	STREAM_SINK_NONE,
+	STREAM_SINK_KEY,
+	STREAM_SINK_NUM,
+	STREAM_SINK_BUF,
+};
+
+static struct json_stream_frame *stream_top(struct json_stream_parser *parser)
+{
+	return &parser->stack[parser->depth - 1];
+}
+
+static int stream_push(struct json_stream_parser *parser,
+		       const struct json_obj_descr *descr, size_t len,
+		       void *val, size_t *count, enum stream_state state)
+{
+	struct json_stream_frame *frame;
+
+	if (parser->depth == ARRAY_SIZE(parser->stack)) {
+		return -E2BIG;
+	}
+
+	frame = &parser->stack[parser->depth++];
+	frame->descr = descr;
+	frame->len = len;
+	frame->val = val;
+	frame->count = count;
+	frame->decoded = 0;
+	frame->elem_size = 0;
+	frame->field = -1;
+	frame->state = state;
+
+	if (state >= STREAM_ARR_START && descr != NULL) {
+		frame->elem_size = get_elem_size(descr);
+		__ASSERT_NO_MSG(frame->elem_size > 0);
+	}
+
+	if (count != NULL) {
+		*count = 0;
+	}
+
+	return 0;
+}
+
+static void stream_value_done(struct json_stream_parser *parser)
+{
+	struct json_stream_frame *frame = stream_top(parser);
+
+	if (frame->state == STREAM_OBJ_VALUE) {
+		if (frame->field >= 0) {
+			frame->decoded |= (int64_t)1 << frame->field;
+		}
+
+		frame->state = STREAM_OBJ_KEY;
+	} else {
+		frame->decoded++;
+		if (frame->count != NULL) {
+			*frame->count = (size_t)frame->decoded;
+		}
+
+		frame->state = STREAM_ARR_VALUE;
+	}
+}
+
+static void stream_pop(struct json_stream_parser *parser, int64_t result)
+{
+	parser->depth--;
+
+	if (parser->depth == 0) {
+		parser->result = result;
+		parser->lex = STREAM_LEX_DONE;
+		return;
+	}
+
+	stream_value_done(parser);
+}
+
+static int stream_buf_append(struct json_stream_parser *parser,
+			     const char *bytes, size_t len)
+{
+	if (len > parser->buf_size - parser->buf_used) {
+		return -ENOMEM;
+	}
+
+	memcpy(parser->buf + parser->buf_used, bytes, len);
+	parser->buf_used += len;
+
+	return 0;
+}
+
+static void stream_key_append(struct json_stream_parser *parser,
+			      const char *bytes, size_t len)
+{
+	const struct json_obj_descr *descr = stream_top(parser)->descr;
+	uint64_t match = parser->key_match;
+
+	while (match != 0) {
+		int i = u64_count_trailing_zeros(match);
+
+		if (parser->count + len > descr[i].field_name_len ||
+		    memcmp(descr[i].field_name + parser->count, bytes, len)) {
+			parser->key_match &= ~BIT64(i);
+		}
+
+		match &= match - 1;
+	}
+
+	if (parser->key_match != 0) {
+		parser->count += len;
+	}
+}
+
+static void stream_key_done(struct json_stream_parser *parser)
+{
+	struct json_stream_frame *frame = stream_top(parser);
+	uint64_t match = parser->key_match;
+
+	frame->field = -1;
+
+	while (match != 0) {
+		int i = u64_count_trailing_zeros(match);
+
+		/* Fields decoded already are skipped */
+		if (frame->descr[i].field_name_len == parser->count &&
+		    !(frame->decoded & ((int64_t)1 << i))) {
+			frame->field = i;
+			break;
+		}
+
+		match &= match - 1;
+	}
+}
+
+static int stream_sink(struct json_stream_parser *parser, const char *bytes,
+		       size_t len)
+{
+	switch (parser->sink) {
+	case STREAM_SINK_KEY:
+		stream_key_append(parser, bytes, len);
+		return 0;
+	case STREAM_SINK_NUM:
+		if (len >= sizeof(parser->num) - parser->count) {
+			return -ERANGE;
+		}
+
+		memcpy(parser->num + parser->count, bytes, len);
+		parser->count += len;
+		return 0;
+	case STREAM_SINK_BUF:
+		return stream_buf_append(parser, bytes, len);
+	default:
+		return 0;
+	}
+}
+
+static int stream_decode_num(struct json_stream_parser *parser, int32_t *num)
+{
+	struct json_token token = {
+		.start = parser->num,
+		.end = parser->num + parser->count,
+	};
+
+	return decode_num(&token, num);
+}
+
+/* Stores a complete scalar, or JSON_TOK_OBJ_ARRAY, value */
+static int stream_scalar_done(struct json_stream_parser *parser)
+{
+	const struct json_obj_descr *descr = parser->descr;
+	int ret;
+
+	if (descr == NULL) {
+		stream_value_done(parser);
+		return 0;
+	}
+
+	switch (descr->type) {
+	case JSON_TOK_FALSE:
+	case JSON_TOK_TRUE: {
+		bool *v = parser->field;
+
+		*v = parser->type == JSON_TOK_TRUE;
+		break;
+	}
+	case JSON_TOK_NUMBER:
+		ret = stream_decode_num(parser, parser->field);
+		if (ret < 0) {
+			return ret;
+		}
+		break;
+	case JSON_TOK_OPAQUE:
+	case JSON_TOK_FLOAT:
+	case JSON_TOK_OBJ_ARRAY: {
+		struct json_obj_token *obj_token = parser->field;
+
+		obj_token->start = parser->buf + parser->tok_start;
+		obj_token->length = parser->buf_used - parser->tok_start;
+		break;
+	}
+	case JSON_TOK_STRING: {
+		char **str = parser->field;
+
+		ret = stream_buf_append(parser, "", 1);
+		if (ret < 0) {
+			return ret;
+		}
+
+		*str = parser->buf + parser->tok_start;
+		break;
+	}
+	default:
+		return -EINVAL;
+	}
+
+	stream_value_done(parser);
+
+	return 0;
+}
+
+/* Starts decoding a value according to descr, or skipping it if NULL */
+static int stream_value(struct json_stream_parser *parser,
+			enum json_tokens type,
+			const struct json_obj_descr *descr, void *field,
+			void *val)
+{
+	const struct json_obj_descr *elem_descr;
+
+	if (element_token(type) < 0) {
+		return -EINVAL;
+	}
+
+	if (descr != NULL && !equivalent_types(type, descr->type)) {
+		return -EINVAL;
+	}
+
+	parser->descr = descr;
+	parser->field = field;
+	parser->type = type;
+	parser->sink = STREAM_SINK_NONE;
+	parser->tok_start = parser->buf_used;
+
+	switch (type) {
+	case JSON_TOK_OBJECT_START:
+		if (descr == NULL) {
+			return stream_push(parser, NULL, 0, NULL, NULL,
+					   STREAM_OBJ_KEY);
+		}
+
+		return stream_push(parser, descr->object.sub_descr,
+				   descr->object.sub_descr_len, field, NULL,
+				   STREAM_OBJ_KEY);
+	case JSON_TOK_ARRAY_START:
+		if (descr == NULL) {
+			return stream_push(parser, NULL, 0, NULL, NULL,
+					   STREAM_ARR_VALUE);
+		}
+
+		if (descr->type == JSON_TOK_OBJ_ARRAY) {
+			parser->lex = STREAM_LEX_RAW;
+			parser->raw_depth = 1;
+			return stream_buf_append(parser, "[", 1);
+		}
+
+		elem_descr = descr->array.element_descr;
+
+		return stream_push(parser, elem_descr, descr->array.n_elements,
+				   field,
+				   val != NULL ?
+				   (size_t *)((char *)val + elem_descr->offset) : NULL,
+				   STREAM_ARR_VALUE);
+	case JSON_TOK_STRING:
+		if (descr != NULL) {
+			parser->sink = STREAM_SINK_BUF;
+		}
+
+		return 0;
+	case JSON_TOK_NUMBER:
+		if (descr != NULL) {
+			parser->sink = descr->type == JSON_TOK_FLOAT ?
+				       STREAM_SINK_BUF : STREAM_SINK_NUM;
+		}
+
+		parser->count = 0;
+		return 0;
+	default:
+		return 0;
+	}
+}
+
+/* Handles the start of a token, as far as the grammar is concerned */
+static int stream_token(struct json_stream_parser *parser,
+			enum json_tokens type)
+{
+	struct json_stream_frame *frame = stream_top(parser);
+	const struct json_obj_descr *descr;
+
+	switch (frame->state) {
+	case STREAM_OBJ_START:
+		if (type != JSON_TOK_OBJECT_START) {
+			return -EINVAL;
+		}
+
+		frame->state = STREAM_OBJ_KEY;
+		return 0;
+	case STREAM_OBJ_KEY:
+		if (type == JSON_TOK_OBJECT_END) {
+			stream_pop(parser, frame->decoded);
+			return 0;
+		}
+
+		if (type == JSON_TOK_COMMA) {
+			frame->state = STREAM_OBJ_KEY_ONLY;
+			return 0;
+		}
+
+		__fallthrough;
+	case STREAM_OBJ_KEY_ONLY:
+		if (type != JSON_TOK_STRING) {
+			return -EINVAL;
+		}
+
+		parser->sink = STREAM_SINK_KEY;
+		parser->key_match = frame->len < 64 ? BIT64_MASK(frame->len) : 0;
+		parser->count = 0;
+		frame->state = STREAM_OBJ_COLON;
+		return 0;
+	case STREAM_OBJ_COLON:
+		if (type != JSON_TOK_COLON) {
+			return -EINVAL;
+		}
+
+		frame->state = STREAM_OBJ_VALUE;
+		return 0;
+	case STREAM_OBJ_VALUE:
+		if (frame->field < 0) {
+			return stream_value(parser, type, NULL, NULL, NULL);
+		}
+
+		descr = &frame->descr[frame->field];
+
+		return stream_value(parser, type, descr,
+				    (char *)frame->val + descr->offset,
+				    frame->val);
+	case STREAM_ARR_START:
+		if (type != JSON_TOK_ARRAY_START) {
+			return -EINVAL;
+		}
+
+		frame->state = STREAM_ARR_VALUE;
+		return 0;
+	case STREAM_ARR_VALUE:
+		if (type == JSON_TOK_ARRAY_END) {
+			stream_pop(parser, 0);
+			return 0;
+		}
+
+		if (type == JSON_TOK_COMMA) {
+			frame->state = STREAM_ARR_VALUE_ONLY;
+			return 0;
+		}
+
+		__fallthrough;
+	case STREAM_ARR_VALUE_ONLY:
+		if (frame->descr == NULL) {
+			return stream_value(parser, type, NULL, NULL, NULL);
+		}
+
+		if ((size_t)frame->decoded == frame->len) {
+			return -ENOSPC;
+		}
+
+		return stream_value(parser, type, frame->descr,
+				    (char *)frame->val +
+				    frame->elem_size * frame->decoded,
+				    NULL);
+	default:
+		return -EINVAL;
+	}
+}
+
+static int stream_lex_value(struct json_stream_parser *parser, char chr)
+{
+	int ret;
+
+	switch (chr) {
+	case '}':
+	case '{':
+	case '[':
+	case ']':
+	case ',':
+	case ':':
+		return stream_token(parser, (enum json_tokens)chr);
+	case '"':
+		parser->lex = STREAM_LEX_STRING;
+		return stream_token(parser, JSON_TOK_STRING);
+	case 't':
+		parser->lex = STREAM_LEX_LITERAL;
+		parser->literal = "rue";
+		return stream_token(parser, JSON_TOK_TRUE);
+	case 'f':
+		parser->lex = STREAM_LEX_LITERAL;
+		parser->literal = "alse";
+		return stream_token(parser, JSON_TOK_FALSE);
+	case 'n':
+		/* Recognized, but never decoded, as by json_obj_parse() */
+		return stream_token(parser, JSON_TOK_NULL);
+	case '-':
+		parser->lex = STREAM_LEX_SIGN;
+		break;
+	default:
+		if (isspace((unsigned char)chr) != 0) {
+			return 0;
+		}
+
+		if (isdigit((unsigned char)chr) == 0) {
+			return -EINVAL;
+		}
+
+		parser->lex = STREAM_LEX_NUMBER;
+		break;
+	}
+
+	ret = stream_token(parser, JSON_TOK_NUMBER);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return stream_sink(parser, &chr, 1);
+}
+
+static bool is_number_char(char chr)
+{
+	return isdigit((unsigned char)chr) != 0 || chr == '.';
+}
+
+int json_stream_parse_feed(struct json_stream_parser *parser, const char *data,
+			   size_t len)
+{
+	const char *end = data + len;
+	const char *run;
+	int ret = 0;
+	char chr;
+
+	if (parser->result < 0) {
+		return parser->result;
+	}
+
+	while (data != end && ret == 0) {
+		chr = *data;
+
+		switch (parser->lex) {
+		case STREAM_LEX_VALUE:
+			data++;
+			ret = stream_lex_value(parser, chr);
+			break;
+		case STREAM_LEX_STRING:
+			for (run = data; data != end; data++) {
+				if (*data == '"' || *data == '\\' || *data == '\0') {
+					break;
+				}
+			}
+
+			ret = stream_sink(parser, run, data - run);
+			if (ret < 0 || data == end) {
+				break;
+			}
+
+			chr = *data++;
+			if (chr == '"') {
+				parser->lex = STREAM_LEX_VALUE;
+				if (parser->sink == STREAM_SINK_KEY) {
+					stream_key_done(parser);
+				} else {
+					ret = stream_scalar_done(parser);
+				}
+			} else if (chr == '\\') {
+				parser->lex = STREAM_LEX_ESCAPE;
+				ret = stream_sink(parser, &chr, 1);
+			} else {
+				ret = -EINVAL;
+			}
+			break;
+		case STREAM_LEX_ESCAPE:
+			data++;
+			switch (chr) {
+			case '"':
+			case '\\':
+			case '/':
+			case 'b':
+			case 'f':
+			case 'n':
+			case 'r':
+			case 't':
+				parser->lex = STREAM_LEX_STRING;
+				break;
+			case 'u':
+				parser->lex = STREAM_LEX_UNICODE;
+				parser->hex = 4;
+				break;
+			default:
+				ret = -EINVAL;
+				break;
+			}
+
+			if (ret == 0) {
+				ret = stream_sink(parser, &chr, 1);
+			}
+			break;
+		case STREAM_LEX_UNICODE:
+			data++;
+			if (isxdigit((unsigned char)chr) == 0) {
+				ret = -EINVAL;
+				break;
+			}
+
+			if (--parser->hex == 0) {
+				parser->lex = STREAM_LEX_STRING;
+			}
+
+			ret = stream_sink(parser, &chr, 1);
+			break;
+		case STREAM_LEX_SIGN:
+			if (isdigit((unsigned char)chr) == 0) {
+				ret = -EINVAL;
+				break;
+			}
+
+			parser->lex = STREAM_LEX_NUMBER;
+			__fallthrough;
+		case STREAM_LEX_NUMBER:
+			for (run = data; data != end && is_number_char(*data); data++) {
+			}
+
+			ret = stream_sink(parser, run, data - run);
+			if (ret < 0 || data == end) {
+				break;
+			}
+
+			/* The delimiter is handled as the next token */
+			parser->lex = STREAM_LEX_VALUE;
+			ret = stream_scalar_done(parser);
+			break;
+		case STREAM_LEX_LITERAL:
+			data++;
+			if (chr != *parser->literal) {
+				ret = -EINVAL;
+				break;
+			}
+
+			if (*++parser->literal == '\0') {
+				parser->lex = STREAM_LEX_VALUE;
+				ret = stream_scalar_done(parser);
+			}
+			break;
+		case STREAM_LEX_RAW:
+			for (run = data; data != end;) {
+				chr = *data++;
+
+				if (chr == '"') {
+					parser->lex = STREAM_LEX_RAW_STRING;
+					break;
+				}
+
+				if (chr == '[') {
+					parser->raw_depth++;
+				} else if (chr == ']' && --parser->raw_depth == 0) {
+					parser->lex = STREAM_LEX_VALUE;
+					break;
+				}
+			}
+
+			ret = stream_buf_append(parser, run, data - run);
+			if (ret == 0 && parser->lex == STREAM_LEX_VALUE) {
+				ret = stream_scalar_done(parser);
+			}
+			break;
+		case STREAM_LEX_RAW_STRING:
+			for (run = data; data != end;) {
+				chr = *data++;
+
+				if (chr == '\\') {
+					parser->lex = STREAM_LEX_RAW_ESCAPE;
+					break;
+				}
+
+				if (chr == '"') {
+					parser->lex = STREAM_LEX_RAW;
+					break;
+				}
+			}
+
+			ret = stream_buf_append(parser, run, data - run);
+			break;
+		case STREAM_LEX_RAW_ESCAPE:
+			data++;
+			parser->lex = STREAM_LEX_RAW_STRING;
+			ret = stream_buf_append(parser, &chr, 1);
+			break;
+		default:
+			/* Data after the end is ignored, as by json_obj_parse() */
+			return 0;
+		}
+	}
+
+	if (ret < 0) {
+		parser->result = ret;
+	}
+
+	return ret;
+}
+
+static void stream_init(struct json_stream_parser *parser, char *buf,
+			size_t buf_size)
+{
+	parser->depth = 0;
+	parser->lex = STREAM_LEX_VALUE;
+	parser->sink = STREAM_SINK_NONE;
+	parser->descr = NULL;
+	parser->buf = buf;
+	parser->buf_size = buf != NULL ? buf_size : 0;
+	parser->buf_used = 0;
+	parser->result = 0;
+}
+
+void json_stream_obj_parse_init(struct json_stream_parser *parser,
+				const struct json_obj_descr *descr, size_t descr_len,
+				void *val, char *buf, size_t buf_size)
+{
+	__ASSERT_NO_MSG(descr_len < (sizeof(parser->result) * CHAR_BIT - 1));
+
+	stream_init(parser, buf, buf_size);
+	(void)stream_push(parser, descr, descr_len, val, NULL, STREAM_OBJ_START);
+}
+
+void json_stream_arr_parse_init(struct json_stream_parser *parser,
+				const struct json_obj_descr *descr, void *val,
+				char *buf, size_t buf_size)
+{
+	const struct json_obj_descr *elem_descr = descr->array.element_descr;
+
+	stream_init(parser, buf, buf_size);
+	(void)stream_push(parser, elem_descr, descr->array.n_elements,
+			  (char *)val + descr->offset,
+			  (size_t *)((char *)val + elem_descr->offset),
+			  STREAM_ARR_START);
+}
+
+int64_t json_stream_parse_finish(struct json_stream_parser *parser)
+{
+	if (parser->result < 0) {
+		return parser->result;
+	}
+
+	if (parser->lex != STREAM_LEX_DONE) {
+		return -EINVAL;
+	}
+
+	return parser->result;
+}
+
 static char escape_as(char chr)
 {
 	switch (chr) {
@@ -756,22 +1455,40 @@ static int json_escape_internal(const char *str,
 				json_append_bytes_t append_bytes,
 				void *data)
 {
+	const char *run = str;
 	const char *cur;
-	int ret = 0;
+	int ret;
 
-	for (cur = str; ret == 0 && *cur; cur++) {
+	/* Runs of characters that need no escaping are appended at once */
+	for (cur = str; *cur; cur++) {
 		char escaped = escape_as(*cur);
 
-		if (escaped) {
-			char bytes[2] = { '\\', escaped };
+		if (!escaped) {
+			continue;
+		}
 
-			ret = append_bytes(bytes, 2, data);
-		} else {
-			ret = append_bytes(cur, 1, data);
+		char bytes[2] = { '\\', escaped };
+
+		if (cur != run) {
+			ret = append_bytes(run, cur - run, data);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+
+		ret = append_bytes(bytes, 2, data);
+		if (ret < 0) {
+			return ret;
 		}
+
+		run = cur + 1;
 	}
 
-	return ret;
+	if (cur == run) {
+		return 0;
+	}
+
+	return append_bytes(run, cur - run, data);
 }
 
 size_t json_calc_escaped_len(const char *str, size_t len)
@@ -1072,6 +1789,92 @@ int json_arr_encode_buf(const struct json_obj_descr *descr, const void *val,
 	return json_arr_encode(descr, val, append_bytes_to_buf, &appender);
 }
 
+struct buffered_appender {
+	json_append_bytes_t append_bytes;
+	void *data;
+	char *buffer;
+	size_t used;
+	size_t size;
+};
+
+static int buffered_flush(struct buffered_appender *appender)
+{
+	size_t used = appender->used;
+
+	if (used == 0) {
+		return 0;
+	}
+
+	appender->used = 0;
+
+	return appender->append_bytes(appender->buffer, used, appender->data);
+}
+
+static int append_bytes_buffered(const char *bytes, size_t len, void *data)
+{
+	struct buffered_appender *appender = data;
+	int ret;
+
+	if (len > appender->size - appender->used) {
+		ret = buffered_flush(appender);
+		if (ret < 0) {
+			return ret;
+		}
+
+		/* Not worth copying when it does not fit anyway */
+		if (len >= appender->size) {
+			return appender->append_bytes(bytes, len,
+						      appender->data);
+		}
+	}
+
+	memcpy(appender->buffer + appender->used, bytes, len);
+	appender->used += len;
+
+	return 0;
+}
+
+int json_obj_encode_buffered(const struct json_obj_descr *descr, size_t descr_len,
+			     const void *val, json_append_bytes_t append_bytes,
+			     void *data, char *buffer, size_t buf_size)
+{
+	struct buffered_appender appender = {
+		.append_bytes = append_bytes,
+		.data = data,
+		.buffer = buffer,
+		.size = buf_size,
+	};
+	int ret;
+
+	ret = json_obj_encode(descr, descr_len, val, append_bytes_buffered,
+			      &appender);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return buffered_flush(&appender);
+}
+
+int json_arr_encode_buffered(const struct json_obj_descr *descr, const void *val,
+			     json_append_bytes_t append_bytes, void *data,
+			     char *buffer, size_t buf_size)
+{
+	struct buffered_appender appender = {
+		.append_bytes = append_bytes,
+		.data = data,
+		.buffer = buffer,
+		.size = buf_size,
+	};
+	int ret;
+
+	ret = json_arr_encode(descr, val, append_bytes_buffered, &appender);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return buffered_flush(&appender);
+}
+
 static int measure_bytes(const char *bytes, size_t len, void *data)
 {
 	ssize_t *total = data;
@@ -121,6 +121,7 @@ out:
 int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 			 void **out_blocks)
 {
+	size_t *offsets;
 	int ret = 0;
 	int i;
 
@@ -140,12 +141,37 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 		goto out;
 	}
 
-	for (i = 0; i < count; i++) {
-		void *ptr = alloc_blocks(mem_block, 1);
+	/* Allocate all blocks in a single search of the bitmap, storing the
+	 * offsets in the output array and converting them in place.
+	 */
+	BUILD_ASSERT(sizeof(size_t) == sizeof(void *));
+	offsets = (size_t *)out_blocks;
 
-		if (ptr == NULL) {
-			break;
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+	k_spinlock_key_t  key = k_spin_lock(&mem_block->lock);
+#endif
+
+	ret = sys_bitarray_alloc_multi(mem_block->bitmap, 1, count, offsets);
+
+#ifdef CONFIG_SYS_MEM_BLOCKS_RUNTIME_STATS
+	if (ret == 0) {
+		mem_block->used_blocks += (uint32_t)count;
+
+		if (mem_block->max_used_blocks < mem_block->used_blocks) {
+			mem_block->max_used_blocks = mem_block->used_blocks;
 		}
+	}
+
+	k_spin_unlock(&mem_block->lock, key);
+#endif
+
+	if (ret != 0) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	for (i = 0; i < count; i++) {
+		void *ptr = mem_block->buffer + (offsets[i] << mem_block->blk_sz_shift);
 
 		out_blocks[i] = ptr;
 
@@ -155,12 +181,6 @@ int sys_mem_blocks_alloc(sys_mem_blocks_t *mem_block, size_t count,
 #endif
 	}
 
-	/* If error, free already allocated blocks. */
-	if (i < count) {
-		(void)sys_mem_blocks_free(mem_block, i, out_blocks);
-		ret = -ENOMEM;
-	}
-
 out:
 	return ret;
 }
@@ -36,6 +36,7 @@ void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 	buffer->buf = cfg->buf;
 	buffer->size = cfg->size;
 	buffer->max_usage = 0;
+	buffer->drops = 0;
 	buffer->flags = cfg->flags;
 
 	if (is_power_of_two(buffer->size)) {
@@ -159,6 +160,25 @@ static void rd_idx_inc(struct mpsc_pbuf_buffer *buffer, int32_t wlen)
 	buffer->flags &= ~MPSC_PBUF_FULL;
 }
 
+/* Move the read index past the packets which were freed out of order, up
+ * to the first packet still claimed.
+ */
+static void rd_idx_release(struct mpsc_pbuf_buffer *buffer)
+{
+	union mpsc_pbuf_generic *item;
+	uint32_t skip;
+
+	while (buffer->rd_idx != buffer->tmp_rd_idx) {
+		item = (union mpsc_pbuf_generic *)&buffer->buf[buffer->rd_idx];
+		skip = get_skip(item);
+		if (!skip) {
+			break;
+		}
+
+		rd_idx_inc(buffer, skip);
+	}
+}
+
 static void add_skip_item(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 {
 	union mpsc_pbuf_generic skip = {
@@ -192,8 +212,11 @@ static bool drop_item_locked(struct mpsc_pbuf_buffer *buffer,
 		return true;
 	}
 
-	/* Other options for dropping available only in overwrite mode. */
+	/* Other options for dropping available only in overwrite mode. The
+	 * new packet is dropped instead.
+	 */
 	if (!(buffer->flags & MPSC_PBUF_MODE_OVERWRITE)) {
+		buffer->drops++;
 		return false;
 	}
 
@@ -201,6 +224,18 @@ static bool drop_item_locked(struct mpsc_pbuf_buffer *buffer,
 
 	/* If packet is busy need to be ommited. */
 	if (!is_valid(item)) {
+		buffer->drops++;
+		return false;
+	} else if (item->hdr.busy &&
+		   (buffer->rd_idx != buffer->tmp_rd_idx) &&
+		   (idx_inc(buffer, buffer->rd_idx, rd_wlen) != buffer->tmp_rd_idx)) {
+		/* Packets after the busy one were claimed as well, or freed
+		 * out of order but not released yet. Skipping them all would
+		 * leave claimed packets in the space handed to writers, so
+		 * drop the new packet instead, as without overwrite.
+		 */
+		MPSC_PBUF_DBG(buffer, "no space: several packets claimed");
+		buffer->drops++;
 		return false;
 	} else if (item->hdr.busy) {
 		MPSC_PBUF_DBG(buffer, "no space: Found busy packet %p (len:%d)", item, rd_wlen);
@@ -249,6 +284,7 @@ static bool drop_item_locked(struct mpsc_pbuf_buffer *buffer,
 		buffer->flags |= MPSC_PBUF_FULL;
 		item->hdr.valid = 0;
 		*item_to_drop = item;
+		buffer->drops++;
 		MPSC_PBUF_DBG(buffer, "no space: dropping packet %p (len: %d)",
 			       item, rd_wlen);
 	}
@@ -377,6 +413,9 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 			err = k_sem_take(&buffer->sem, timeout);
 			key = k_spin_lock(&buffer->lock);
 			cont = (err == 0) ? true : false;
+			if (!cont) {
+				buffer->drops++;
+			}
 		} else if (cont) {
 			tmp_wr_idx_val = buffer->tmp_wr_idx;
 			cont = drop_item_locked(buffer, free_wlen,
@@ -550,9 +589,25 @@ const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
 				uint32_t inc =
 					skip ? skip : buffer->get_wlen(item);
 
+				/* If packets before are still claimed, the read
+				 * index is moved past this one when they are
+				 * freed.
+				 */
+				if (buffer->rd_idx == buffer->tmp_rd_idx) {
+					rd_idx_inc(buffer, inc);
+				}
 				buffer->tmp_rd_idx =
 				      idx_inc(buffer, buffer->tmp_rd_idx, inc);
-				rd_idx_inc(buffer, inc);
+				cont = true;
+			} else if (item->hdr.busy) {
+				/* Still claimed from before a writer skipped
+				 * it and wrapped around: it is not claimed
+				 * again, and the read index stays on it until
+				 * it is freed.
+				 */
+				buffer->tmp_rd_idx =
+					idx_inc(buffer, buffer->tmp_rd_idx,
+						buffer->get_wlen(item));
 				cont = true;
 			} else {
 				item->hdr.busy = 1;
@@ -579,8 +634,7 @@ void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
 	union mpsc_pbuf_generic *witem = (union mpsc_pbuf_generic *)item;
 
 	witem->hdr.valid = 0;
-	if (!(buffer->flags & MPSC_PBUF_MODE_OVERWRITE) ||
-		 ((uint32_t *)item == &buffer->buf[buffer->rd_idx])) {
+	if ((uint32_t *)item == &buffer->buf[buffer->rd_idx]) {
 		witem->hdr.busy = 0;
 		if (buffer->rd_idx == buffer->tmp_rd_idx) {
 			/* There is a chance that there are so many new packets
@@ -593,8 +647,12 @@ void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
 			buffer->tmp_rd_idx = idx_inc(buffer, buffer->tmp_rd_idx, wlen);
 		}
 		rd_idx_inc(buffer, wlen);
+		rd_idx_release(buffer);
 	} else {
-		MPSC_PBUF_DBG(buffer, "Allocation occurred during claim");
+		/* Freed out of order, or allocation occurred during claim.
+		 * Mark as skip packet, it is released with the packets before.
+		 */
+		MPSC_PBUF_DBG(buffer, "Packet freed before the read index");
 		witem->skip.len = wlen;
 	}
 	MPSC_PBUF_DBG(buffer, "<<freed: %p", item);
@@ -630,3 +688,8 @@ int mpsc_pbuf_get_max_utilization(struct mpsc_pbuf_buffer *buffer, uint32_t *max
 	*max = buffer->max_usage * sizeof(int);
 	return 0;
 }
+
+uint32_t mpsc_pbuf_get_drops(struct mpsc_pbuf_buffer *buffer)
+{
+	return buffer->drops;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/sys/mpsc_pbuf.h>
+
+/*
+ * Each lane is a complete packet buffer, with its own lock, in an equal part
+ * of the memory. Producers use the lane of the CPU they run on, so the lock
+ * is only contended by the consumers, or by a thread which migrated to
+ * another CPU in the meantime, which is harmless. The packet locates its
+ * lane when committed or freed.
+ */
+
+static inline struct mpsc_pbuf_buffer *local_lane(struct mpsc_pbuf_lanes *lanes)
+{
+#ifdef CONFIG_SMP
+	return &lanes->lanes[arch_curr_cpu()->id % lanes->num_lanes];
+#else
+	return &lanes->lanes[0];
+#endif
+}
+
+static inline uint32_t packet_lane(struct mpsc_pbuf_lanes *lanes,
+				   const union mpsc_pbuf_generic *packet)
+{
+	uint32_t idx = (const uint32_t *)packet - lanes->lanes[0].buf;
+
+	return idx / lanes->lanes[0].size;
+}
+
+void mpsc_pbuf_lanes_init(struct mpsc_pbuf_lanes *lanes,
+			  const struct mpsc_pbuf_lanes_config *config)
+{
+	struct mpsc_pbuf_buffer_config cfg = config->buffer;
+	uint32_t num_lanes = config->num_lanes;
+
+	if (num_lanes == 0) {
+		num_lanes = arch_num_cpus();
+	}
+
+	__ASSERT_NO_MSG(num_lanes <= CONFIG_MP_MAX_NUM_CPUS);
+
+	memset(lanes, 0, sizeof(*lanes));
+	lanes->num_lanes = num_lanes;
+	lanes->get_timestamp = config->get_timestamp;
+
+	cfg.size = config->buffer.size / num_lanes;
+	for (uint32_t i = 0; i < num_lanes; i++) {
+		cfg.buf = &config->buffer.buf[i * cfg.size];
+		mpsc_pbuf_init(&lanes->lanes[i], &cfg);
+	}
+}
+
+union mpsc_pbuf_generic *mpsc_pbuf_lanes_alloc(struct mpsc_pbuf_lanes *lanes,
+					       size_t wlen, k_timeout_t timeout)
+{
+	return mpsc_pbuf_alloc(local_lane(lanes), wlen, timeout);
+}
+
+void mpsc_pbuf_lanes_commit(struct mpsc_pbuf_lanes *lanes,
+			    union mpsc_pbuf_generic *packet)
+{
+	mpsc_pbuf_commit(&lanes->lanes[packet_lane(lanes, packet)], packet);
+}
+
+void mpsc_pbuf_lanes_put_data(struct mpsc_pbuf_lanes *lanes,
+			      const uint32_t *data, size_t wlen)
+{
+	mpsc_pbuf_put_data(local_lane(lanes), data, wlen);
+}
+
+const union mpsc_pbuf_generic *mpsc_pbuf_lanes_claim(struct mpsc_pbuf_lanes *lanes)
+{
+	const union mpsc_pbuf_generic *packet = NULL;
+	k_spinlock_key_t key;
+	uint64_t min_ts = 0;
+	uint32_t min = 0;
+	uint64_t ts;
+
+	key = k_spin_lock(&lanes->lock);
+
+	/* The first pending packet of each lane remains claimed until it is
+	 * the oldest one, so that it is only timestamped once.
+	 */
+	for (uint32_t i = 0; i < lanes->num_lanes; i++) {
+		if (lanes->heads[i] == NULL) {
+			lanes->heads[i] = mpsc_pbuf_claim(&lanes->lanes[i]);
+			if (lanes->heads[i] == NULL) {
+				continue;
+			}
+		}
+
+		ts = lanes->get_timestamp(lanes->heads[i]);
+		if ((packet == NULL) || (ts < min_ts)) {
+			packet = lanes->heads[i];
+			min_ts = ts;
+			min = i;
+		}
+	}
+
+	if (packet != NULL) {
+		lanes->heads[min] = NULL;
+	}
+
+	k_spin_unlock(&lanes->lock, key);
+
+	return packet;
+}
+
+void mpsc_pbuf_lanes_free(struct mpsc_pbuf_lanes *lanes,
+			  const union mpsc_pbuf_generic *packet)
+{
+	mpsc_pbuf_free(&lanes->lanes[packet_lane(lanes, packet)], packet);
+}
+
+bool mpsc_pbuf_lanes_is_pending(struct mpsc_pbuf_lanes *lanes)
+{
+	for (uint32_t i = 0; i < lanes->num_lanes; i++) {
+		if ((lanes->heads[i] != NULL) || mpsc_pbuf_is_pending(&lanes->lanes[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int mpsc_pbuf_lanes_get_stats(struct mpsc_pbuf_lanes *lanes, uint32_t lane,
+			      struct mpsc_pbuf_lane_stats *stats)
+{
+	if (lane >= lanes->num_lanes) {
+		return -EINVAL;
+	}
+
+	mpsc_pbuf_get_utilization(&lanes->lanes[lane], &stats->size, &stats->now);
+	if (mpsc_pbuf_get_max_utilization(&lanes->lanes[lane], &stats->max) != 0) {
+		stats->max = 0;
+	}
+
+	stats->drops = mpsc_pbuf_get_drops(&lanes->lanes[lane]);
+
+	return 0;
+}
@@ -0,0 +1,307 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/work_pool.h>
+#include <zephyr/sys/util.h>
+
+#define DEQUE_SIZE CONFIG_WORK_POOL_DEQUE_SIZE
+#define DEQUE_MASK (DEQUE_SIZE - 1U)
+
+BUILD_ASSERT((DEQUE_SIZE & DEQUE_MASK) == 0U,
+	     "CONFIG_WORK_POOL_DEQUE_SIZE must be a power of two");
+
+/* Deques are short critical sections on a per-worker lock, so a
+ * worker pushing and popping its own deque only ever contends with
+ * the occasional thief.  head and tail are free-running counters.
+ */
+static bool deque_push(struct k_work_pool_worker *w, struct k_work *work)
+{
+	k_spinlock_key_t key = k_spin_lock(&w->lock);
+	bool ok = (w->tail - w->head) < DEQUE_SIZE;
+
+	if (ok) {
+		w->items[w->tail++ & DEQUE_MASK] = work;
+	}
+
+	k_spin_unlock(&w->lock, key);
+	return ok;
+}
+
+/* Owner side: newest first */
+static struct k_work *deque_pop(struct k_work_pool_worker *w)
+{
+	k_spinlock_key_t key = k_spin_lock(&w->lock);
+	struct k_work *work = NULL;
+
+	if (w->tail != w->head) {
+		work = w->items[--w->tail & DEQUE_MASK];
+	}
+
+	k_spin_unlock(&w->lock, key);
+	return work;
+}
+
+/* Thief side: oldest first, which tends to be the largest piece of
+ * work in a recursive fan-out, and stays clear of the data the owner
+ * is working on
+ */
+static struct k_work *deque_steal(struct k_work_pool_worker *w)
+{
+	k_spinlock_key_t key = k_spin_lock(&w->lock);
+	struct k_work *work = NULL;
+
+	if (w->tail != w->head) {
+		work = w->items[w->head++ & DEQUE_MASK];
+	}
+
+	k_spin_unlock(&w->lock, key);
+	return work;
+}
+
+/* Returns the worker the current thread is, or NULL.  Pools have a
+ * handful of workers, so looking the thread up beats reserving a
+ * per-thread field for it.
+ */
+static struct k_work_pool_worker *current_worker(struct k_work_pool *pool)
+{
+	k_tid_t current;
+
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	current = k_current_get();
+	for (uint32_t i = 0; i < pool->num_workers; i++) {
+		if (&pool->workers[i].thread == current) {
+			return &pool->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct k_work *pool_next(struct k_work_pool *pool,
+				struct k_work_pool_worker *self, bool *stolen)
+{
+	uint32_t id = self - pool->workers;
+	struct k_work *work = deque_pop(self);
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	*stolen = false;
+	if (work != NULL) {
+		return work;
+	}
+
+	key = k_spin_lock(&pool->lock);
+	node = sys_slist_get(&pool->injected);
+	k_spin_unlock(&pool->lock, key);
+
+	if (node != NULL) {
+		return CONTAINER_OF(node, struct k_work, node);
+	}
+
+	/* Start with the next worker so that thieves spread out */
+	for (uint32_t i = 1; i < pool->num_workers; i++) {
+		work = deque_steal(&pool->workers[(id + i) % pool->num_workers]);
+		if (work != NULL) {
+			*stolen = true;
+			return work;
+		}
+	}
+
+	return NULL;
+}
+
+static void pool_run(struct k_work_pool_worker *self, struct k_work *work,
+		     bool stolen)
+{
+	self->executed++;
+	self->stolen += stolen ? 1U : 0U;
+
+	work->handler(work);
+}
+
+static void worker_main(void *p1, void *p2, void *p3)
+{
+	struct k_work_pool *pool = p1;
+	struct k_work_pool_worker *self = p2;
+	struct k_work *work;
+	bool stolen;
+
+	ARG_UNUSED(p3);
+
+	while (true) {
+		work = pool_next(pool, self, &stolen);
+		if (work == NULL) {
+			/* Announce ourselves idle before the last look,
+			 * so that a submitter either sees us idle and
+			 * wakes us, or its item is found here.
+			 */
+			(void)atomic_inc(&pool->idle);
+			work = pool_next(pool, self, &stolen);
+			if (work == NULL) {
+				(void)k_sem_take(&pool->wake, K_FOREVER);
+			}
+			(void)atomic_dec(&pool->idle);
+
+			if (work == NULL) {
+				continue;
+			}
+		}
+
+		pool_run(self, work, stolen);
+	}
+}
+
+void k_work_pool_start(struct k_work_pool *pool, int prio)
+{
+	size_t stride = K_THREAD_STACK_LEN(pool->stack_size);
+
+	sys_slist_init(&pool->injected);
+	k_sem_init(&pool->wake, 0, pool->num_workers);
+	atomic_set(&pool->idle, 0);
+
+	/* All deques must be ready before the first worker goes stealing */
+	for (uint32_t i = 0; i < pool->num_workers; i++) {
+		struct k_work_pool_worker *w = &pool->workers[i];
+
+		w->head = 0U;
+		w->tail = 0U;
+		w->executed = 0U;
+		w->stolen = 0U;
+	}
+
+	for (uint32_t i = 0; i < pool->num_workers; i++) {
+		k_thread_create(&pool->workers[i].thread, &pool->stacks[stride * i],
+				pool->stack_size, worker_main, pool,
+				&pool->workers[i], NULL, prio, 0, K_NO_WAIT);
+	}
+}
+
+void k_work_pool_submit(struct k_work_pool *pool, struct k_work *work)
+{
+	struct k_work_pool_worker *self = current_worker(pool);
+
+	__ASSERT_NO_MSG(work->handler != NULL);
+
+	if (self == NULL || !deque_push(self, work)) {
+		k_spinlock_key_t key = k_spin_lock(&pool->lock);
+
+		sys_slist_append(&pool->injected, &work->node);
+		k_spin_unlock(&pool->lock, key);
+	}
+
+	/* Releasing the lock above is a full barrier on SMP, so the
+	 * item is visible before idle is read.  Extra gives only cause
+	 * spurious wakeups.
+	 */
+	if (atomic_get(&pool->idle) > 0) {
+		k_sem_give(&pool->wake);
+	}
+}
+
+struct pool_job {
+	k_work_pool_range_fn_t fn;
+	void *arg;
+	size_t n;
+	size_t grain;
+	size_t chunks;
+	atomic_t next;
+	struct k_sem done;
+};
+
+struct pool_helper {
+	struct k_work work;
+	struct pool_job *job;
+};
+
+static void job_run(struct pool_job *job)
+{
+	size_t c;
+
+	while ((c = (size_t)atomic_inc(&job->next)) < job->chunks) {
+		size_t begin = c * job->grain;
+
+		job->fn(begin, MIN(begin + job->grain, job->n), job->arg);
+	}
+}
+
+static void helper_handler(struct k_work *work)
+{
+	struct pool_helper *helper = CONTAINER_OF(work, struct pool_helper, work);
+	struct pool_job *job = helper->job;
+
+	job_run(job);
+
+	/* The job lives on the caller's stack: no access past this */
+	k_sem_give(&job->done);
+}
+
+int k_work_pool_parallel_for(struct k_work_pool *pool, size_t n, size_t grain,
+			     k_work_pool_range_fn_t fn, void *arg)
+{
+	struct k_work_pool_worker *self = current_worker(pool);
+	struct pool_helper helpers[CONFIG_WORK_POOL_MAX_HELPERS];
+	struct pool_job job = {
+		.fn = fn,
+		.arg = arg,
+		.n = n,
+		.grain = grain,
+	};
+	size_t n_helpers;
+
+	if (grain == 0U) {
+		return -EINVAL;
+	}
+
+	job.chunks = DIV_ROUND_UP(n, grain);
+	atomic_set(&job.next, 0);
+
+	/* The caller takes a share itself, so a worker calling in
+	 * leaves one fewer worker to enlist
+	 */
+	n_helpers = pool->num_workers - ((self != NULL) ? 1U : 0U);
+	n_helpers = MIN(n_helpers, ARRAY_SIZE(helpers));
+	n_helpers = MIN(n_helpers, job.chunks > 0U ? job.chunks - 1U : 0U);
+
+	k_sem_init(&job.done, 0, K_SEM_MAX_LIMIT);
+
+	for (size_t i = 0; i < n_helpers; i++) {
+		helpers[i].job = &job;
+		k_work_init(&helpers[i].work, helper_handler);
+		k_work_pool_submit(pool, &helpers[i].work);
+	}
+
+	job_run(&job);
+
+	/* Join.  A worker keeps running pool items meanwhile: helpers
+	 * not started yet may be sitting in its own deque, and nested
+	 * loops would otherwise run out of workers.  Once there is
+	 * nothing left to pick up, all remaining helpers are running
+	 * and it is safe to block.
+	 */
+	for (size_t joined = 0; joined < n_helpers; joined++) {
+		while (self != NULL && k_sem_take(&job.done, K_NO_WAIT) != 0) {
+			struct k_work *work;
+			bool stolen;
+
+			work = pool_next(pool, self, &stolen);
+			if (work == NULL) {
+				(void)k_sem_take(&job.done, K_FOREVER);
+				break;
+			}
+
+			pool_run(self, work, stolen);
+		}
+
+		if (self == NULL) {
+			(void)k_sem_take(&job.done, K_FOREVER);
+		}
+	}
+
+	return 0;
+}
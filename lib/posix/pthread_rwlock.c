@@ -11,11 +11,9 @@
 #define INITIALIZED 1
 #define NOT_INITIALIZED 0
 
-#define CONCURRENT_READER_LIMIT  (CONFIG_MAX_PTHREAD_COUNT + 1)
-
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
-static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
-static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
+static int read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
+static int write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 
 /**
  * @brief Initialize read-write lock object.
@@ -25,10 +23,7 @@ static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout);
 int pthread_rwlock_init(pthread_rwlock_t *rwlock,
 			const pthread_rwlockattr_t *attr)
 {
-	k_sem_init(&rwlock->rd_sem, CONCURRENT_READER_LIMIT,
-		   CONCURRENT_READER_LIMIT);
-	k_sem_init(&rwlock->wr_sem, 1, 1);
-	k_sem_init(&rwlock->reader_active, 1, 1);
+	(void)k_rwlock_init(&rwlock->rwlock, 0);
 	rwlock->wr_owner = NULL;
 	rwlock->status = INITIALIZED;
 	return 0;
@@ -60,9 +55,6 @@ int pthread_rwlock_destroy(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
@@ -77,16 +69,13 @@ int pthread_rwlock_rdlock(pthread_rwlock_t *rwlock)
 /**
  * @brief Lock a read-write lock object for reading within specific time.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
 	int32_t timeout;
-	uint32_t ret = 0U;
+	int ret;
 
 	if (rwlock->status == NOT_INITIALIZED || abstime->tv_nsec < 0 ||
 	    abstime->tv_nsec > NSEC_PER_SEC) {
@@ -95,19 +84,14 @@ int pthread_rwlock_timedrdlock(pthread_rwlock_t *rwlock,
 
 	timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	if (read_lock_acquire(rwlock, timeout) != 0U) {
-		ret = ETIMEDOUT;
-	}
+	ret = read_lock_acquire(rwlock, timeout);
 
-	return ret;
+	return (ret == EBUSY) ? ETIMEDOUT : ret;
 }
 
 /**
  * @brief Lock a read-write lock object for reading immediately.
  *
- * API behaviour is unpredictable if number of concurrent reader
- * lock held is greater than CONCURRENT_READER_LIMIT.
- *
  * See IEEE 1003.1
  */
 int pthread_rwlock_tryrdlock(pthread_rwlock_t *rwlock)
@@ -148,7 +132,7 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 			       const struct timespec *abstime)
 {
 	int32_t timeout;
-	uint32_t ret = 0U;
+	int ret;
 
 	if (rwlock->status == NOT_INITIALIZED || abstime->tv_nsec < 0 ||
 	    abstime->tv_nsec > NSEC_PER_SEC) {
@@ -157,11 +141,9 @@ int pthread_rwlock_timedwrlock(pthread_rwlock_t *rwlock,
 
 	timeout = (int32_t) timespec_to_timeoutms(abstime);
 
-	if (write_lock_acquire(rwlock, timeout) != 0U) {
-		ret = ETIMEDOUT;
-	}
+	ret = write_lock_acquire(rwlock, timeout);
 
-	return ret;
+	return (ret == EBUSY) ? ETIMEDOUT : ret;
 }
 
 /**
@@ -196,66 +178,42 @@ int pthread_rwlock_unlock(pthread_rwlock_t *rwlock)
 	if (k_current_get() == rwlock->wr_owner) {
 		/* Write unlock */
 		rwlock->wr_owner = NULL;
-		k_sem_give(&rwlock->reader_active);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		/* Read unlock */
-		if (k_sem_count_get(&rwlock->rd_sem) ==
-				    (CONCURRENT_READER_LIMIT - 1)) {
-			/* Last read lock, unlock writer */
-			k_sem_give(&rwlock->reader_active);
-		}
-
-		k_sem_give(&rwlock->rd_sem);
+		(void)k_rwlock_write_unlock(&rwlock->rwlock);
+	} else if (k_rwlock_read_unlock(&rwlock->rwlock) != 0) {
+		return EPERM;
 	}
+
 	return 0;
 }
 
-
-static uint32_t read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
+/* Convert the error of a k_rwlock lock call to the POSIX one. */
+static int lock_error(int ret)
 {
-	uint32_t ret = 0U;
-
-	if (k_sem_take(&rwlock->wr_sem, SYS_TIMEOUT_MS(timeout)) == 0) {
-		k_sem_take(&rwlock->reader_active, K_NO_WAIT);
-		k_sem_take(&rwlock->rd_sem, K_NO_WAIT);
-		k_sem_give(&rwlock->wr_sem);
-	} else {
-		ret = EBUSY;
+	switch (ret) {
+	case 0:
+		return 0;
+	case -EAGAIN:
+		return ETIMEDOUT;
+	case -EDEADLK:
+		return EDEADLK;
+	default:
+		return EBUSY;
 	}
+}
 
-	return ret;
+static int read_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
+{
+	return lock_error(k_rwlock_read_lock(&rwlock->rwlock,
+					     SYS_TIMEOUT_MS(timeout)));
 }
 
-static uint32_t write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
+static int write_lock_acquire(pthread_rwlock_t *rwlock, int32_t timeout)
 {
-	uint32_t ret = 0U;
-	int64_t elapsed_time, st_time = k_uptime_get();
-	k_timeout_t k_timeout;
-
-	k_timeout = SYS_TIMEOUT_MS(timeout);
-
-	/* waiting for release of write lock */
-	if (k_sem_take(&rwlock->wr_sem, k_timeout) == 0) {
-		/* update remaining timeout time for 2nd sem */
-		if (timeout != SYS_FOREVER_MS) {
-			elapsed_time = k_uptime_get() - st_time;
-			timeout = timeout <= elapsed_time ? 0 :
-				  timeout - elapsed_time;
-		}
-
-		k_timeout = SYS_TIMEOUT_MS(timeout);
-
-		/* waiting for reader to complete operation */
-		if (k_sem_take(&rwlock->reader_active, k_timeout) == 0) {
-			rwlock->wr_owner = k_current_get();
-		} else {
-			k_sem_give(&rwlock->wr_sem);
-			ret = EBUSY;
-		}
-
-	} else {
-		ret = EBUSY;
+	int ret = k_rwlock_write_lock(&rwlock->rwlock, SYS_TIMEOUT_MS(timeout));
+
+	if (ret == 0) {
+		rwlock->wr_owner = k_current_get();
 	}
-	return ret;
+
+	return lock_error(ret);
 }
@@ -18,6 +18,7 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #include <errno.h>
 #include <zephyr/sys/util.h>
+#include <zephyr/random/rand32.h>
 
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
@@ -59,11 +60,29 @@ LOG_MODULE_REGISTER(net_conn, CONFIG_NET_CONN_LOG_LEVEL);
 
 #define NET_CONN_RANK(_flags)		(_flags & 0x78)
 
+/** Both end points fully specified */
+#define NET_CONN_EXACT			0x78
+
+/** Number of buckets of the TCP/UDP lookup tables */
+#define CONN_HASH_SIZE			((size_t)NHPOT(CONFIG_NET_MAX_CONN))
+
 static struct net_conn conns[CONFIG_NET_MAX_CONN];
 
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+/* TCP/UDP connections are also linked into one of the lookup lists below,
+ * so that a unicast packet is only matched against the connections it can
+ * belong to: connected sockets, bound to both end points, are hashed on
+ * their addresses and ports, listeners on their protocol and local port,
+ * and the few connections bound to no local port are always checked.
+ */
+static sys_slist_t conn_exact[CONN_HASH_SIZE];
+static sys_slist_t conn_listen[CONN_HASH_SIZE];
+static sys_slist_t conn_wild;
+
+static uint32_t conn_hash_seed;
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -116,6 +135,93 @@ void conn_register_debug(struct net_conn *conn,
 
 static K_MUTEX_DEFINE(conn_lock);
 
+static inline uint32_t conn_hash_word(uint32_t h, uint32_t k)
+{
+	k *= 0xcc9e2d51U;
+	k = (k << 15) | (k >> 17);
+	k *= 0x1b873593U;
+
+	h ^= k;
+	h = (h << 13) | (h >> 19);
+
+	return h * 5U + 0xe6546b64U;
+}
+
+static inline uint32_t conn_hash_final(uint32_t h)
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6bU;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35U;
+	h ^= h >> 16;
+
+	return h;
+}
+
+uint32_t net_conn_hash(sa_family_t family,
+		       const uint8_t *remote_addr, uint16_t remote_port,
+		       const uint8_t *local_addr, uint16_t local_port)
+{
+	size_t len = family == AF_INET6 ? sizeof(struct in6_addr) :
+					  sizeof(struct in_addr);
+	uint32_t h = conn_hash_seed;
+
+	for (size_t i = 0; i < len; i += sizeof(uint32_t)) {
+		h = conn_hash_word(h, UNALIGNED_GET((uint32_t *)&remote_addr[i]));
+		h = conn_hash_word(h, UNALIGNED_GET((uint32_t *)&local_addr[i]));
+	}
+
+	h = conn_hash_word(h, ((uint32_t)remote_port << 16) | local_port);
+
+	return conn_hash_final(h);
+}
+
+static inline sys_slist_t *conn_listen_list(uint16_t proto, uint16_t local_port)
+{
+	uint32_t h = conn_hash_word(conn_hash_seed, ((uint32_t)proto << 16) | local_port);
+
+	return &conn_listen[conn_hash_final(h) & (CONN_HASH_SIZE - 1)];
+}
+
+static inline const uint8_t *conn_addr_raw(const struct sockaddr *addr)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV6) && addr->sa_family == AF_INET6) {
+		return (const uint8_t *)&net_sin6(addr)->sin6_addr;
+	}
+
+	return (const uint8_t *)&net_sin(addr)->sin_addr;
+}
+
+/* Lookup list of a connection, or NULL if it is not a TCP/UDP one, in which
+ * case it is only found by walking all the connections.
+ */
+static sys_slist_t *conn_lookup_list(struct net_conn *conn)
+{
+	uint32_t h;
+
+	if ((conn->proto != IPPROTO_UDP && conn->proto != IPPROTO_TCP) ||
+	    (conn->family != AF_INET && conn->family != AF_INET6 &&
+	     conn->family != AF_UNSPEC)) {
+		return NULL;
+	}
+
+	if ((conn->flags & NET_CONN_EXACT) == NET_CONN_EXACT) {
+		h = net_conn_hash(conn->local_addr.sa_family,
+				  conn_addr_raw(&conn->remote_addr),
+				  net_sin(&conn->remote_addr)->sin_port,
+				  conn_addr_raw(&conn->local_addr),
+				  net_sin(&conn->local_addr)->sin_port);
+
+		return &conn_exact[h & (CONN_HASH_SIZE - 1)];
+	}
+
+	if (conn->flags & NET_CONN_LOCAL_PORT_SPEC) {
+		return conn_listen_list(conn->proto, net_sin(&conn->local_addr)->sin_port);
+	}
+
+	return &conn_wild;
+}
+
 static struct net_conn *conn_get_unused(void)
 {
 	sys_snode_t *node;
@@ -137,10 +243,15 @@ static struct net_conn *conn_get_unused(void)
 
 static void conn_set_used(struct net_conn *conn)
 {
+	sys_slist_t *list = conn_lookup_list(conn);
+
 	conn->flags |= NET_CONN_IN_USE;
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+	if (list != NULL) {
+		sys_slist_prepend(list, &conn->hash_node);
+	}
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -384,6 +495,7 @@ error:
 int net_conn_unregister(struct net_conn_handle *handle)
 {
 	struct net_conn *conn = (struct net_conn *)handle;
+	sys_slist_t *list;
 
 	if (conn < &conns[0] || conn > &conns[CONFIG_NET_MAX_CONN]) {
 		return -EINVAL;
@@ -395,8 +507,13 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	NET_DBG("Connection handler %p removed", conn);
 
+	list = conn_lookup_list(conn);
+
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+	if (list != NULL) {
+		sys_slist_find_and_remove(list, &conn->hash_node);
+	}
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -477,6 +594,119 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+static bool conn_endpoints_match(struct net_conn *conn, struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 uint16_t src_port, uint16_t dst_port)
+{
+	if (net_sin(&conn->remote_addr)->sin_port &&
+	    net_sin(&conn->remote_addr)->sin_port != src_port) {
+		return false; /* wrong remote port */
+	}
+
+	if (net_sin(&conn->local_addr)->sin_port &&
+	    net_sin(&conn->local_addr)->sin_port != dst_port) {
+		return false; /* wrong local port */
+	}
+
+	if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+		return false; /* wrong remote address */
+	}
+
+	if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+	    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+		return false; /* wrong local address */
+	}
+
+	return true;
+}
+
+static bool conn_ip_match(struct net_conn *conn, struct net_pkt *pkt,
+			  union net_ip_header *ip_hdr, uint8_t proto,
+			  uint16_t src_port, uint16_t dst_port)
+{
+	if (conn->context != NULL &&
+	    net_context_is_bound_to_iface(conn->context) &&
+	    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+		return false; /* wrong interface */
+	}
+
+	if (conn->family != AF_UNSPEC && conn->family != net_pkt_family(pkt)) {
+		return false; /* wrong protocol family */
+	}
+
+	if (conn->proto != proto) {
+		return false; /* wrong protocol */
+	}
+
+	return conn_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port);
+}
+
+/* Rank the connections of a lookup list as the walk of all connections
+ * in net_conn_input() does for unicast packets.
+ */
+static void conn_rank_list(sys_slist_t *list, struct net_pkt *pkt,
+			   union net_ip_header *ip_hdr, uint8_t proto,
+			   uint16_t src_port, uint16_t dst_port,
+			   struct net_conn **best_match, int16_t *best_rank)
+{
+	struct net_conn *conn;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(list, conn, hash_node) {
+		if (!conn_ip_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+			continue;
+		}
+
+		if (*best_match != NULL && (*best_match)->flags & NET_CONN_REMOTE_PORT_SPEC) {
+			return; /* do not override listening connection */
+		}
+
+		if (*best_rank < NET_CONN_RANK(conn->flags)) {
+			*best_rank = NET_CONN_RANK(conn->flags);
+			*best_match = conn;
+		}
+	}
+}
+
+/* Find the connection of a unicast or broadcast TCP/UDP packet: the
+ * connected socket bound to its end points if any, or else the best
+ * ranked listener or wildcard connection.
+ */
+static struct net_conn *conn_lookup(struct net_pkt *pkt,
+				    union net_ip_header *ip_hdr, uint8_t proto,
+				    uint16_t src_port, uint16_t dst_port)
+{
+	struct net_conn *best_match = NULL;
+	int16_t best_rank = -1;
+	struct net_conn *conn;
+	const uint8_t *src;
+	const uint8_t *dst;
+	uint32_t h;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		src = ip_hdr->ipv6->src;
+		dst = ip_hdr->ipv6->dst;
+	} else {
+		src = ip_hdr->ipv4->src;
+		dst = ip_hdr->ipv4->dst;
+	}
+
+	h = net_conn_hash(net_pkt_family(pkt), src, src_port, dst, dst_port);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&conn_exact[h & (CONN_HASH_SIZE - 1)], conn, hash_node) {
+		if (conn_ip_match(conn, pkt, ip_hdr, proto, src_port, dst_port)) {
+			return conn;
+		}
+	}
+
+	conn_rank_list(conn_listen_list(proto, dst_port), pkt, ip_hdr, proto,
+		       src_port, dst_port, &best_match, &best_rank);
+	conn_rank_list(&conn_wild, pkt, ip_hdr, proto,
+		       src_port, dst_port, &best_match, &best_rank);
+
+	return best_match;
+}
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_DISABLE_ICMP_DESTINATION_UNREACHABLE)) {
@@ -634,6 +864,13 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+	if (IS_ENABLED(CONFIG_NET_IP) && (pkt_family == AF_INET || pkt_family == AF_INET6) &&
+	    (proto == IPPROTO_UDP || proto == IPPROTO_TCP) && !is_mcast_pkt) {
+		/* Only multicast packets need to visit all connections */
+		best_match = conn_lookup(pkt, ip_hdr, proto, src_port, dst_port);
+		goto deliver;
+	}
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
@@ -711,24 +948,8 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 			/* Is the candidate connection matching the packet's TCP/UDP
 			 * address and port?
 			 */
-			if (net_sin(&conn->remote_addr)->sin_port &&
-			    net_sin(&conn->remote_addr)->sin_port != src_port) {
-				continue; /* wrong remote port */
-			}
-
-			if (net_sin(&conn->local_addr)->sin_port &&
-			    net_sin(&conn->local_addr)->sin_port != dst_port) {
-				continue; /* wrong local port */
-			}
-
-			if ((conn->flags & NET_CONN_REMOTE_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
-				continue; /* wrong remote address */
-			}
-
-			if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
-			    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
-				continue; /* wrong local address */
+			if (!conn_endpoints_match(conn, pkt, ip_hdr, src_port, dst_port)) {
+				continue; /* wrong address or port */
 			}
 
 			/* If we have an existing best_match, and that one
@@ -806,6 +1027,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		return NET_OK;
 	}
 
+deliver:
 	if (best_match) {
 		NET_DBG("[%p] match found cb %p ud %p rank 0x%02x", best_match, best_match->cb,
 			best_match->user_data, best_match->flags);
@@ -856,6 +1078,14 @@ void net_conn_init(void)
 
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
+	sys_slist_init(&conn_wild);
+
+	for (i = 0; i < CONN_HASH_SIZE; i++) {
+		sys_slist_init(&conn_exact[i]);
+		sys_slist_init(&conn_listen[i]);
+	}
+
+	conn_hash_seed = sys_rand32_get();
 
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
@@ -54,6 +54,9 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+	/** Internal slist node of the TCP/UDP lookup tables */
+	sys_snode_t hash_node;
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
@@ -192,6 +195,24 @@ static inline enum net_verdict net_conn_input(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IP || CONFIG_NET_CONNECTION_SOCKETS */
 
+/**
+ * @brief Hash the addresses and ports of a TCP/UDP connection.
+ *
+ * The hash is seeded at boot, so that remote peers cannot choose
+ * addresses and ports that collide.
+ *
+ * @param family Address family, AF_INET or AF_INET6
+ * @param remote_addr Remote IPv4 or IPv6 address
+ * @param remote_port Remote port, in network byte order
+ * @param local_addr Local IPv4 or IPv6 address
+ * @param local_port Local port, in network byte order
+ *
+ * @return Hash of the connection end points.
+ */
+uint32_t net_conn_hash(sa_family_t family,
+		       const uint8_t *remote_addr, uint16_t remote_port,
+		       const uint8_t *local_addr, uint16_t local_port);
+
 /**
  * @typedef net_conn_foreach_cb_t
  * @brief Callback used while iterating over network connection
@@ -23,6 +23,7 @@ LOG_MODULE_REGISTER(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
 #include "icmpv4.h"
 #include "udp_internal.h"
 #include "tcp_internal.h"
+#include "net_gro.h"
 #include "ipv4.h"
 
 BUILD_ASSERT(sizeof(struct in_addr) == NET_IPV4_ADDR_SIZE);
@@ -395,6 +396,11 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 
 	ip.ipv4 = hdr;
 
+	if (IS_ENABLED(CONFIG_NET_GRO) && hdr->proto == IPPROTO_TCP &&
+	    net_gro_receive(pkt, &ip, proto_hdr.tcp) == NET_OK) {
+		return NET_OK;
+	}
+
 	verdict = net_conn_input(pkt, &ip, hdr->proto, &proto_hdr);
 	if (verdict != NET_DROP) {
 		return verdict;
@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(net_ipv6, CONFIG_NET_IPV6_LOG_LEVEL);
 #include "icmpv6.h"
 #include "udp_internal.h"
 #include "tcp_internal.h"
+#include "net_gro.h"
 #include "ipv6.h"
 #include "nbr.h"
 #include "6lo.h"
@@ -723,6 +724,11 @@ enum net_verdict net_ipv6_input(struct net_pkt *pkt, bool is_loopback)
 
 	ip.ipv6 = hdr;
 
+	if (IS_ENABLED(CONFIG_NET_GRO) && current_hdr == IPPROTO_TCP &&
+	    net_gro_receive(pkt, &ip, proto_hdr.tcp) == NET_OK) {
+		return NET_OK;
+	}
+
 	verdict = net_conn_input(pkt, &ip, current_hdr, &proto_hdr);
 	if (verdict != NET_DROP) {
 		return verdict;
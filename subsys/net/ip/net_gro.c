@@ -0,0 +1,362 @@
+/** @file
+ * @brief Generic receive offload for TCP
+ *
+ * In-order TCP segments of a flow that are received back to back are
+ * merged into a single packet before they reach TCP, so that TCP runs,
+ * and acknowledges, once per burst instead of once per segment. The
+ * segments are held until the RX queue they came from is empty.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_gro, CONFIG_NET_GRO_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "connection.h"
+#include "net_gro.h"
+#include "net_private.h"
+#include "net_stats.h"
+
+#define TCP_PSH BIT(3)
+#define TCP_ACK BIT(4)
+
+/* Merged packets must still fit the length field of the IP header */
+#define GRO_MAX_LEN UINT16_MAX
+
+struct gro_flow {
+	struct net_pkt *pkt; /* first segment, NULL if the slot is free */
+	uint32_t next_seq;
+	uint32_t ack;
+	uint32_t len; /* length of the merged packet, headers included */
+	uint16_t seg_len; /* payload length of the first segment */
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint8_t src[NET_IPV6_ADDR_SIZE];
+	uint8_t dst[NET_IPV6_ADDR_SIZE];
+	uint8_t wnd[2]; /* window advertised by the last segment */
+	uint8_t flags;
+	uint8_t segs;
+};
+
+struct gro_table {
+	k_tid_t owner;
+	struct gro_flow flows[CONFIG_NET_GRO_FLOWS];
+	uint8_t next_evict;
+	bool delivering;
+};
+
+static struct gro_table gro_tables[NET_TC_RX_COUNT];
+
+static inline size_t gro_addr_len(struct net_pkt *pkt)
+{
+	return net_pkt_family(pkt) == AF_INET ? NET_IPV4_ADDR_SIZE :
+						NET_IPV6_ADDR_SIZE;
+}
+
+/* The TCP header of the packet has been written back with a zero checksum */
+static int gro_update_chksum(struct net_pkt *pkt, struct net_tcp_hdr *tcp_hdr)
+{
+	struct net_pkt_cursor backup;
+	int ret;
+
+	tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+
+	ret = net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) +
+			   net_pkt_ip_opts_len(pkt) +
+			   offsetof(struct net_tcp_hdr, chksum));
+	if (ret == 0) {
+		ret = net_pkt_write(pkt, &tcp_hdr->chksum,
+				    sizeof(tcp_hdr->chksum));
+	}
+
+	net_pkt_cursor_restore(pkt, &backup);
+
+	return ret;
+}
+
+static enum net_verdict gro_deliver(struct net_pkt *pkt, bool merged,
+				    uint8_t flags, const uint8_t *wnd)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(ipv6_access, struct net_ipv6_hdr);
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct net_tcp_hdr);
+	union net_proto_header proto_hdr;
+	union net_ip_header ip_hdr;
+	size_t len = net_pkt_get_len(pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		ip_hdr.ipv4 = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+		if (!ip_hdr.ipv4) {
+			return NET_DROP;
+		}
+
+#if defined(CONFIG_NET_IPV4)
+		if (merged) {
+			ip_hdr.ipv4->len = htons(len);
+			ip_hdr.ipv4->chksum = 0U;
+			ip_hdr.ipv4->chksum = net_calc_chksum_ipv4(pkt);
+		}
+#endif
+
+		if (net_pkt_set_data(pkt, &ipv4_access)) {
+			return NET_DROP;
+		}
+	} else {
+		ip_hdr.ipv6 = (struct net_ipv6_hdr *)net_pkt_get_data(pkt, &ipv6_access);
+		if (!ip_hdr.ipv6) {
+			return NET_DROP;
+		}
+
+		if (merged) {
+			ip_hdr.ipv6->len = htons(len - sizeof(struct net_ipv6_hdr));
+		}
+
+		if (net_pkt_set_data(pkt, &ipv6_access)) {
+			return NET_DROP;
+		}
+	}
+
+	proto_hdr.tcp = (struct net_tcp_hdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!proto_hdr.tcp) {
+		return NET_DROP;
+	}
+
+	if (merged) {
+		proto_hdr.tcp->flags = flags;
+		memcpy(proto_hdr.tcp->wnd, wnd, sizeof(proto_hdr.tcp->wnd));
+		proto_hdr.tcp->chksum = 0U;
+	}
+
+	if (net_pkt_set_data(pkt, &tcp_access)) {
+		return NET_DROP;
+	}
+
+	/* The checksum of each segment was verified by net_tcp_input(),
+	 * the merged segment gets a checksum of its own, so that it is
+	 * valid for anyone looking at the packet later on.
+	 */
+	if (merged && gro_update_chksum(pkt, proto_hdr.tcp) < 0) {
+		return NET_DROP;
+	}
+
+	return net_conn_input(pkt, &ip_hdr, IPPROTO_TCP, &proto_hdr);
+}
+
+static void gro_flow_flush(struct gro_table *table, struct gro_flow *flow)
+{
+	struct net_pkt *pkt = flow->pkt;
+
+	flow->pkt = NULL;
+
+	NET_DBG("Flush pkt %p, %u segments, len %u", pkt, flow->segs,
+		flow->len);
+
+	/* Packets held by a flush are not to be merged, they would be
+	 * delivered ahead of the ones being flushed.
+	 */
+	table->delivering = true;
+
+	if (gro_deliver(pkt, flow->segs > 1, flow->flags, flow->wnd) == NET_DROP) {
+		if (net_pkt_family(pkt) == AF_INET) {
+			net_stats_update_ipv4_drop(net_pkt_iface(pkt));
+		} else {
+			net_stats_update_ipv6_drop(net_pkt_iface(pkt));
+		}
+
+		net_pkt_unref(pkt);
+	}
+
+	table->delivering = false;
+}
+
+static struct gro_flow *gro_flow_lookup(struct gro_table *table,
+					struct net_pkt *pkt,
+					const uint8_t *src, const uint8_t *dst,
+					struct net_tcp_hdr *tcp_hdr)
+{
+	size_t addr_len = gro_addr_len(pkt);
+
+	for (int i = 0; i < CONFIG_NET_GRO_FLOWS; i++) {
+		struct gro_flow *flow = &table->flows[i];
+
+		if (flow->pkt == NULL ||
+		    flow->src_port != tcp_hdr->src_port ||
+		    flow->dst_port != tcp_hdr->dst_port ||
+		    net_pkt_iface(flow->pkt) != net_pkt_iface(pkt) ||
+		    net_pkt_family(flow->pkt) != net_pkt_family(pkt)) {
+			continue;
+		}
+
+		if (memcmp(flow->src, src, addr_len) == 0 &&
+		    memcmp(flow->dst, dst, addr_len) == 0) {
+			return flow;
+		}
+	}
+
+	return NULL;
+}
+
+static struct gro_flow *gro_flow_alloc(struct gro_table *table)
+{
+	struct gro_flow *flow;
+
+	for (int i = 0; i < CONFIG_NET_GRO_FLOWS; i++) {
+		if (table->flows[i].pkt == NULL) {
+			return &table->flows[i];
+		}
+	}
+
+	flow = &table->flows[table->next_evict];
+	table->next_evict = (table->next_evict + 1) % CONFIG_NET_GRO_FLOWS;
+
+	gro_flow_flush(table, flow);
+
+	return flow;
+}
+
+/* Keep the payload of the segment only, and chain it to the held one */
+static void gro_flow_merge(struct gro_flow *flow, struct net_pkt *pkt,
+			   size_t hdr_len, size_t seg_len)
+{
+	struct net_buf *buf;
+
+	while (hdr_len > 0 && pkt->buffer != NULL) {
+		buf = pkt->buffer;
+
+		if (buf->len > hdr_len) {
+			net_buf_pull(buf, hdr_len);
+			break;
+		}
+
+		hdr_len -= buf->len;
+		pkt->buffer = buf->frags;
+		buf->frags = NULL;
+		net_buf_unref(buf);
+	}
+
+	net_pkt_append_buffer(flow->pkt, pkt->buffer);
+	pkt->buffer = NULL;
+	net_pkt_unref(pkt);
+
+	flow->next_seq += seg_len;
+	flow->len += seg_len;
+	flow->segs++;
+}
+
+enum net_verdict net_gro_receive(struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 struct net_tcp_hdr *tcp_hdr)
+{
+	struct gro_table *table =
+		&gro_tables[net_rx_priority2tc(net_pkt_priority(pkt))];
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt) +
+			 (tcp_hdr->offset >> 4) * 4U;
+	size_t pkt_len = net_pkt_get_len(pkt);
+	size_t seg_len = pkt_len > hdr_len ? pkt_len - hdr_len : 0;
+	uint32_t seq = sys_get_be32(tcp_hdr->seq);
+	uint32_t ack = sys_get_be32(tcp_hdr->ack);
+	const uint8_t *src, *dst;
+	struct gro_flow *flow;
+	bool mergeable;
+
+	/* Packets looped back by the TX path are processed by other
+	 * threads, leave them alone.
+	 */
+	if (table->owner != k_current_get() || table->delivering) {
+		return NET_CONTINUE;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		src = ip_hdr->ipv4->src;
+		dst = ip_hdr->ipv4->dst;
+	} else {
+		src = ip_hdr->ipv6->src;
+		dst = ip_hdr->ipv6->dst;
+	}
+
+	/* Only data segments without any TCP or IP options are merged.
+	 * PSH does not end a burst, as some stacks set it on every
+	 * segment.
+	 */
+	mergeable = seg_len > 0 && net_pkt_ip_opts_len(pkt) == 0 &&
+		    (tcp_hdr->offset >> 4) == 5 &&
+		    (tcp_hdr->flags & ~TCP_PSH) == TCP_ACK;
+
+	flow = gro_flow_lookup(table, pkt, src, dst, tcp_hdr);
+	if (flow != NULL) {
+		if (mergeable && seq == flow->next_seq && ack == flow->ack &&
+		    seg_len <= flow->seg_len &&
+		    flow->len + seg_len <= GRO_MAX_LEN) {
+			flow->flags |= tcp_hdr->flags;
+			memcpy(flow->wnd, tcp_hdr->wnd, sizeof(flow->wnd));
+
+			gro_flow_merge(flow, pkt, hdr_len, seg_len);
+
+			/* A short segment ends the burst */
+			if (seg_len < flow->seg_len ||
+			    flow->segs >= CONFIG_NET_GRO_MAX_SEGMENTS) {
+				gro_flow_flush(table, flow);
+			}
+
+			return NET_OK;
+		}
+
+		/* Keep the segments of the flow in order */
+		gro_flow_flush(table, flow);
+	}
+
+	if (!mergeable) {
+		return NET_CONTINUE;
+	}
+
+	flow = gro_flow_alloc(table);
+
+	flow->pkt = pkt;
+	flow->next_seq = seq + seg_len;
+	flow->ack = ack;
+	flow->len = pkt_len;
+	flow->seg_len = seg_len;
+	flow->src_port = tcp_hdr->src_port;
+	flow->dst_port = tcp_hdr->dst_port;
+	memcpy(flow->src, src, gro_addr_len(pkt));
+	memcpy(flow->dst, dst, gro_addr_len(pkt));
+	memcpy(flow->wnd, tcp_hdr->wnd, sizeof(flow->wnd));
+	flow->flags = tcp_hdr->flags;
+	flow->segs = 1U;
+
+	return NET_OK;
+}
+
+void net_gro_flush(uint8_t tc)
+{
+	struct gro_table *table = &gro_tables[tc];
+
+	for (int i = 0; i < CONFIG_NET_GRO_FLOWS; i++) {
+		if (table->flows[i].pkt != NULL) {
+			gro_flow_flush(table, &table->flows[i]);
+		}
+	}
+}
+
+void net_gro_init(uint8_t tc)
+{
+	gro_tables[tc].owner = k_current_get();
+}
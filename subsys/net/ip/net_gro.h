@@ -0,0 +1,91 @@
+/** @file
+ @brief Generic receive offload for TCP.
+
+ This is not to be included by the application.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_GRO_H
+#define __NET_GRO_H
+
+#include <zephyr/types.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_NET_GRO)
+/**
+ * @brief Start receive offload for a RX traffic class.
+ *
+ * Must be called by the thread processing the packets of the traffic
+ * class. Only packets processed by that thread are merged.
+ *
+ * @param tc RX traffic class
+ */
+void net_gro_init(uint8_t tc);
+
+/**
+ * @brief Try to merge a received TCP segment with the previous segments
+ * of the same flow.
+ *
+ * Called by the IPv4 and IPv6 input functions, once the TCP header of the
+ * packet has been checked.
+ *
+ * @param pkt Network packet holding a TCP segment
+ * @param ip_hdr IP header of the packet
+ * @param tcp_hdr TCP header of the packet
+ *
+ * @return NET_OK if the packet was held, or merged into a held packet,
+ * and must not be touched by the caller anymore. NET_CONTINUE if the
+ * caller should pass the packet on as usual.
+ */
+enum net_verdict net_gro_receive(struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 struct net_tcp_hdr *tcp_hdr);
+
+/**
+ * @brief Pass all the held packets of a RX traffic class on to TCP.
+ *
+ * Called once the RX queue of the traffic class has been emptied.
+ *
+ * @param tc RX traffic class
+ */
+void net_gro_flush(uint8_t tc);
+#else
+static inline void net_gro_init(uint8_t tc)
+{
+	ARG_UNUSED(tc);
+}
+
+static inline enum net_verdict net_gro_receive(struct net_pkt *pkt,
+					       union net_ip_header *ip_hdr,
+					       struct net_tcp_hdr *tcp_hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(tcp_hdr);
+
+	return NET_CONTINUE;
+}
+
+static inline void net_gro_flush(uint8_t tc)
+{
+	ARG_UNUSED(tc);
+}
+#endif /* CONFIG_NET_GRO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_GRO_H */
@@ -0,0 +1,257 @@
+/** @file
+ * @brief Generic segmentation offload for TCP
+ *
+ * TCP hands packets carrying several MSS worth of data down the stack as
+ * a single packet. Unless the network device segments them itself, they
+ * are cut into MSS sized segments here, just before they are given to
+ * the L2. The headers of all the segments are built from the ones of the
+ * large packet, and the payload buffers are moved, not copied.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(net_gso, CONFIG_NET_TCP_GSO_LOG_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <zephyr/sys/byteorder.h>
+
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "net_gso.h"
+#include "net_private.h"
+
+#define TCP_FIN BIT(0)
+#define TCP_PSH BIT(3)
+
+/* Offsets of the fields rewritten in the TCP header */
+#define TCP_SEQ_OFFSET   4
+#define TCP_OFF_OFFSET   12
+#define TCP_FLAGS_OFFSET 13
+
+/* Options of IPv4 and TCP headers, and IPv6 extension headers, are kept
+ * in one buffer: up to 40 bytes each, longer IPv6 extension headers are
+ * rejected with -EMSGSIZE.
+ */
+#define GSO_MAX_OPTS_LEN 40
+#define GSO_MAX_HDR_LEN							\
+	(MAX(NET_IPV4H_LEN, NET_IPV6H_LEN) + GSO_MAX_OPTS_LEN +		\
+	 NET_TCPH_LEN + GSO_MAX_OPTS_LEN)
+
+#define GSO_ALLOC_TIMEOUT K_MSEC(100)
+
+static void gso_copy_attributes(struct net_pkt *seg, struct net_pkt *pkt)
+{
+	net_pkt_set_ip_hdr_len(seg, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ip_dscp(seg, net_pkt_ip_dscp(pkt));
+	net_pkt_set_ip_ecn(seg, net_pkt_ip_ecn(pkt));
+	net_pkt_set_vlan_tag(seg, net_pkt_vlan_tag(pkt));
+	net_pkt_set_priority(seg, net_pkt_priority(pkt));
+	net_pkt_set_orig_iface(seg, net_pkt_orig_iface(pkt));
+	net_pkt_set_ll_proto_type(seg, net_pkt_ll_proto_type(pkt));
+
+	memcpy(net_pkt_lladdr_src(seg), net_pkt_lladdr_src(pkt),
+	       sizeof(struct net_linkaddr));
+	memcpy(net_pkt_lladdr_dst(seg), net_pkt_lladdr_dst(pkt),
+	       sizeof(struct net_linkaddr));
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		net_pkt_set_ipv4_ttl(seg, net_pkt_ipv4_ttl(pkt));
+		net_pkt_set_ipv4_opts_len(seg, net_pkt_ipv4_opts_len(pkt));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		   net_pkt_family(pkt) == AF_INET6) {
+		net_pkt_set_ipv6_hop_limit(seg, net_pkt_ipv6_hop_limit(pkt));
+		net_pkt_set_ipv6_ext_len(seg, net_pkt_ipv6_ext_len(pkt));
+		net_pkt_set_ipv6_next_hdr(seg, net_pkt_ipv6_next_hdr(pkt));
+	}
+}
+
+/* Drop len bytes from the head of the packet, without moving the rest */
+static void gso_pull(struct net_pkt *pkt, size_t len)
+{
+	struct net_buf *buf;
+
+	while (len > 0 && pkt->buffer != NULL) {
+		buf = pkt->buffer;
+
+		if (buf->len > len) {
+			net_buf_pull(buf, len);
+			break;
+		}
+
+		len -= buf->len;
+		pkt->buffer = buf->frags;
+		buf->frags = NULL;
+		net_buf_unref(buf);
+	}
+}
+
+/* Move len bytes from the head of the packet to the tail of the segment.
+ * Only a buffer straddling the end of the segment is copied.
+ */
+static int gso_move(struct net_pkt *seg, struct net_pkt *pkt, size_t len)
+{
+	struct net_buf *buf;
+	struct net_buf *frag;
+
+	while (len > 0 && pkt->buffer != NULL) {
+		buf = pkt->buffer;
+
+		if (buf->len > len) {
+			frag = net_pkt_get_frag(seg, len, GSO_ALLOC_TIMEOUT);
+			if (!frag) {
+				return -ENOBUFS;
+			}
+
+			net_buf_add_mem(frag, buf->data, len);
+			net_buf_pull(buf, len);
+			net_pkt_append_buffer(seg, frag);
+
+			return 0;
+		}
+
+		len -= buf->len;
+		pkt->buffer = buf->frags;
+		buf->frags = NULL;
+		net_pkt_append_buffer(seg, buf);
+	}
+
+	return len > 0 ? -EINVAL : 0;
+}
+
+static int gso_finalize(struct net_pkt *seg)
+{
+	net_pkt_cursor_init(seg);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(seg) == AF_INET) {
+		return net_ipv4_finalize(seg, IPPROTO_TCP);
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(seg) == AF_INET6) {
+		return net_ipv6_finalize(seg, IPPROTO_TCP);
+	}
+
+	return -EINVAL;
+}
+
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t gso_size = net_pkt_gso_size(pkt);
+	uint8_t hdr[GSO_MAX_HDR_LEN];
+	size_t payload_len;
+	size_t offset = 0;
+	size_t hdr_len;
+	struct net_pkt *seg;
+	uint32_t seq;
+	uint8_t flags;
+	int sent = 0;
+	int ret;
+
+	if (net_pkt_ip_opts_len(pkt) > GSO_MAX_OPTS_LEN) {
+		return -EMSGSIZE;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_read(pkt, hdr, ip_len + NET_TCPH_LEN)) {
+		return -ENOBUFS;
+	}
+
+	hdr_len = ip_len + (hdr[ip_len + TCP_OFF_OFFSET] >> 4) * 4U;
+	if (hdr_len < ip_len + NET_TCPH_LEN || hdr_len > sizeof(hdr) ||
+	    hdr_len > net_pkt_get_len(pkt)) {
+		return -EINVAL;
+	}
+
+	if (net_pkt_read(pkt, &hdr[ip_len + NET_TCPH_LEN],
+			 hdr_len - ip_len - NET_TCPH_LEN)) {
+		return -ENOBUFS;
+	}
+
+	payload_len = net_pkt_get_len(pkt) - hdr_len;
+	seq = sys_get_be32(&hdr[ip_len + TCP_SEQ_OFFSET]);
+	flags = hdr[ip_len + TCP_FLAGS_OFFSET];
+
+	/* The IPv4 checksum is computed over the header as it is, the TCP
+	 * one is cleared by net_tcp_finalize().
+	 */
+	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
+		memset(&hdr[offsetof(struct net_ipv4_hdr, chksum)], 0,
+		       sizeof(uint16_t));
+	}
+
+	gso_pull(pkt, hdr_len);
+
+	NET_DBG("pkt %p, %zu bytes in segments of %u", pkt, payload_len,
+		gso_size);
+
+	while (offset < payload_len) {
+		size_t len = MIN(payload_len - offset, gso_size);
+
+		seg = net_pkt_alloc_with_buffer(iface, hdr_len,
+						net_pkt_family(pkt),
+						IPPROTO_TCP, GSO_ALLOC_TIMEOUT);
+		if (!seg) {
+			ret = -ENOBUFS;
+			goto fail;
+		}
+
+		gso_copy_attributes(seg, pkt);
+
+		/* PSH and FIN belong to the last byte of data */
+		sys_put_be32(seq + offset, &hdr[ip_len + TCP_SEQ_OFFSET]);
+		hdr[ip_len + TCP_FLAGS_OFFSET] =
+			offset + len == payload_len ?
+			flags : flags & ~(TCP_PSH | TCP_FIN);
+
+		ret = net_pkt_write(seg, hdr, hdr_len);
+		if (ret == 0) {
+			ret = gso_move(seg, pkt, len);
+		}
+
+		if (ret == 0) {
+			ret = gso_finalize(seg);
+		}
+
+		if (ret == 0) {
+			ret = net_if_l2(iface)->send(iface, seg);
+		}
+
+		if (ret < 0) {
+			net_pkt_unref(seg);
+			goto fail;
+		}
+
+		sent += ret;
+		offset += len;
+	}
+
+	net_pkt_unref(pkt);
+
+	return sent;
+
+fail:
+	NET_DBG("pkt %p, segment at %zu not sent (%d)", pkt, offset, ret);
+
+	/* The segments already sent cannot be taken back, report them and
+	 * leave the rest to TCP retransmissions.
+	 */
+	if (sent > 0) {
+		net_pkt_unref(pkt);
+		return sent;
+	}
+
+	return ret;
+}
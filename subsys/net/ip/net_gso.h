@@ -0,0 +1,60 @@
+/** @file
+ @brief Generic segmentation offload for TCP.
+
+ This is not to be included by the application.
+ */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NET_GSO_H
+#define __NET_GSO_H
+
+#include <errno.h>
+#include <zephyr/types.h>
+
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_pkt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(CONFIG_NET_TCP_GSO)
+/**
+ * @brief Cut a TCP packet larger than the MSS into segments, and send
+ * them to the network device one by one.
+ *
+ * Called by the TX path for packets with a non zero net_pkt_gso_size(),
+ * when the network device cannot segment them on its own.
+ *
+ * @param iface Network interface the packet is sent to
+ * @param pkt Network packet holding the IP and TCP headers, followed by
+ * the payload of all the segments
+ *
+ * @return Number of bytes sent if at least one segment was sent, in which
+ * case the packet has been consumed. When a later segment fails, the
+ * remaining payload is dropped and left to TCP retransmissions. Negative
+ * errno if no segment was sent, the caller then still owns the packet:
+ * -EMSGSIZE for IPv4 options or IPv6 extension headers of more than 40
+ * bytes.
+ */
+int net_gso_send(struct net_if *iface, struct net_pkt *pkt);
+#else
+static inline int net_gso_send(struct net_if *iface, struct net_pkt *pkt)
+{
+	ARG_UNUSED(iface);
+	ARG_UNUSED(pkt);
+
+	return -ENOTSUP;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_GSO_H */
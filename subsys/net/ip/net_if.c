@@ -29,6 +29,7 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include "ipv4_autoconf_internal.h"
 
 #include "net_stats.h"
+#include "net_gso.h"
 
 #define REACHABLE_TIME (MSEC_PER_SEC * 30) /* in ms */
 /*
@@ -262,7 +263,12 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 			}
 		}
 
-		status = net_if_l2(iface)->send(iface, pkt);
+		if (net_pkt_gso_size(pkt) != 0U &&
+		    net_if_need_tx_segmentation(iface)) {
+			status = net_gso_send(iface, pkt);
+		} else {
+			status = net_if_l2(iface)->send(iface, pkt);
+		}
 
 		if (IS_ENABLED(CONFIG_NET_PKT_TXTIME_STATS)) {
 			uint32_t end_tick = k_cycle_get_32();
@@ -4076,7 +4082,7 @@ void net_if_call_link_cb(struct net_if *iface, struct net_linkaddr *lladdr,
 	k_mutex_unlock(&lock);
 }
 
-static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
+static bool need_sw_fallback(struct net_if *iface, enum ethernet_hw_caps caps)
 {
 #if defined(CONFIG_NET_L2_ETHERNET)
 	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
@@ -4094,12 +4100,17 @@ static bool need_calc_checksum(struct net_if *iface, enum ethernet_hw_caps caps)
 
 bool net_if_need_calc_tx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
+	return need_sw_fallback(iface, ETHERNET_HW_TX_CHKSUM_OFFLOAD);
 }
 
 bool net_if_need_calc_rx_checksum(struct net_if *iface)
 {
-	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+	return need_sw_fallback(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
+}
+
+bool net_if_need_tx_segmentation(struct net_if *iface)
+{
+	return need_sw_fallback(iface, ETHERNET_HW_TX_TCP_SEG_OFFLOAD);
 }
 
 int net_if_get_by_iface(struct net_if *iface)
@@ -269,6 +269,7 @@ static struct ethernet_capabilities eth_hw_caps[] = {
 	EC(ETHERNET_HW_FILTERING,         "MAC address filtering"),
 	EC(ETHERNET_DSA_SLAVE_PORT,       "DSA slave port"),
 	EC(ETHERNET_DSA_MASTER_PORT,      "DSA master port"),
+	EC(ETHERNET_HW_TX_TCP_SEG_OFFLOAD, "TCP segmentation offload"),
 };
 
 static void print_supported_ethernet_capabilities(
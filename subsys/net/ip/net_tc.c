@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
 
+#include "net_gro.h"
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
@@ -239,8 +240,11 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #if NET_TC_RX_COUNT > 0
 static void tc_rx_handler(struct k_fifo *fifo)
 {
+	uint8_t tc = CONTAINER_OF(fifo, struct net_traffic_class, fifo) - rx_classes;
 	struct net_pkt *pkt;
 
+	net_gro_init(tc);
+
 	while (1) {
 		pkt = k_fifo_get(fifo, K_FOREVER);
 		if (pkt == NULL) {
@@ -248,6 +252,13 @@ static void tc_rx_handler(struct k_fifo *fifo)
 		}
 
 		net_process_rx_packet(pkt);
+
+		/* Segments merged so far are passed on once the queue is
+		 * drained, there is nothing left to merge them with.
+		 */
+		if (IS_ENABLED(CONFIG_NET_GRO) && k_fifo_is_empty(fifo)) {
+			net_gro_flush(tc);
+		}
 	}
 }
 #endif
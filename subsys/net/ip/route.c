@@ -15,6 +15,7 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 #include <zephyr/kernel.h>
 #include <limits.h>
 #include <zephyr/types.h>
+#include <zephyr/sys/dlist.h>
 #include <zephyr/sys/slist.h>
 
 #include <zephyr/net/net_pkt.h>
@@ -36,7 +37,41 @@ LOG_MODULE_REGISTER(net_route, CONFIG_NET_ROUTE_LOG_LEVEL);
 /* We keep track of the routes in a separate list so that we can remove
  * the oldest routes (at tail) if needed.
  */
-static sys_slist_t routes;
+static sys_dlist_t routes = SYS_DLIST_STATIC_INIT(&routes);
+
+/* Routes are also indexed by prefix in a path compressed binary trie,
+ * so that a lookup only visits the prefixes on the way to the destination
+ * instead of checking every route. A trie node holds a prefix, the routes
+ * to it, and the subtries of the longer prefixes continuing with a 0 or a
+ * 1 bit. Nodes without routes are only there to branch and always have
+ * two children, so N routes need less than 2 * N nodes.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+	sys_slist_t routes;
+	struct in6_addr prefix;
+	uint8_t len;
+};
+
+static struct route_trie_node trie_nodes[2 * CONFIG_NET_MAX_ROUTES];
+static struct route_trie_node *trie_free_list;
+static struct route_trie_node *trie_root;
+static size_t trie_nodes_used;
+
+/* Bumped whenever the trie changes, which invalidates the route cache */
+static uint32_t route_gen = 1U;
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+/* Route found for recently used destinations */
+struct route_cache_entry {
+	struct in6_addr dst;
+	struct net_if *iface;
+	struct net_route_entry *route;
+	uint32_t gen;
+};
+
+static struct route_cache_entry route_cache[CONFIG_NET_ROUTE_CACHE_SIZE];
+#endif
 
 /* Track currently active route lifetime timers */
 static sys_slist_t active_route_lifetime_timers;
@@ -272,41 +307,261 @@ static int nbr_nexthop_put(struct net_nbr *nbr)
 /* Route was accessed, so place it in front of the routes list */
 static inline void update_route_access(struct net_route_entry *route)
 {
-	sys_slist_find_and_remove(&routes, &route->node);
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_remove(&route->node);
+	sys_dlist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+static inline uint8_t prefix_bit(const struct in6_addr *addr, uint8_t bit)
 {
-	struct net_route_entry *route, *found = NULL;
-	uint8_t longest_match = 0U;
+	return (addr->s6_addr[bit / 8U] >> (7U - bit % 8U)) & 1U;
+}
+
+/* Number of leading bits, up to max, that two addresses have in common */
+static uint8_t prefix_common_len(const struct in6_addr *a,
+				 const struct in6_addr *b, uint8_t max)
+{
+	uint8_t len = 0U;
+	uint8_t diff;
 	int i;
 
-	k_mutex_lock(&lock, K_FOREVER);
+	for (i = 0; i < sizeof(a->s6_addr) && len < max; i++) {
+		diff = a->s6_addr[i] ^ b->s6_addr[i];
+		if (diff != 0U) {
+			len += __builtin_clz(diff) - 24;
+			break;
+		}
 
-	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
-		struct net_nbr *nbr = get_nbr(i);
+		len += 8U;
+	}
 
-		if (!nbr->ref) {
-			continue;
+	return MIN(len, max);
+}
+
+static struct route_trie_node *trie_node_alloc(const struct in6_addr *prefix,
+					       uint8_t len)
+{
+	struct route_trie_node *node = trie_free_list;
+
+	if (node != NULL) {
+		trie_free_list = node->child[0];
+	} else if (trie_nodes_used < ARRAY_SIZE(trie_nodes)) {
+		node = &trie_nodes[trie_nodes_used++];
+	} else {
+		return NULL;
+	}
+
+	node->child[0] = NULL;
+	node->child[1] = NULL;
+	sys_slist_init(&node->routes);
+
+	/* Keep only the prefix bits, the others may be set in route->addr */
+	memset(&node->prefix, 0, sizeof(node->prefix));
+	memcpy(&node->prefix, prefix, len / 8U);
+	if (len % 8U) {
+		node->prefix.s6_addr[len / 8U] =
+			prefix->s6_addr[len / 8U] & (0xff << (8U - len % 8U));
+	}
+
+	node->len = len;
+
+	return node;
+}
+
+static void trie_node_free(struct route_trie_node *node)
+{
+	node->child[0] = trie_free_list;
+	trie_free_list = node;
+}
+
+static int route_trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &trie_root;
+	struct route_trie_node *node, *new, *branch;
+	uint8_t len = route->prefix_len;
+	uint8_t common = 0U;
+
+	while ((node = *link) != NULL) {
+		common = prefix_common_len(&node->prefix, &route->addr,
+					   MIN(node->len, len));
+		if (common < node->len) {
+			break;
 		}
 
-		if (iface && nbr->iface != iface) {
-			continue;
+		if (node->len == len) {
+			sys_slist_append(&node->routes, &route->prefix_node);
+			route_gen++;
+			return 0;
 		}
 
-		route = net_route_data(nbr);
+		link = &node->child[prefix_bit(&route->addr, node->len)];
+	}
+
+	new = trie_node_alloc(&route->addr, len);
+	if (new == NULL) {
+		return -ENOMEM;
+	}
+
+	sys_slist_append(&new->routes, &route->prefix_node);
+
+	if (node == NULL) {
+		*link = new;
+	} else if (common == len) {
+		/* The new prefix is the start of the node prefix */
+		new->child[prefix_bit(&node->prefix, len)] = node;
+		*link = new;
+	} else {
+		/* The prefixes differ after common bits, branch there */
+		branch = trie_node_alloc(&route->addr, common);
+		if (branch == NULL) {
+			trie_node_free(new);
+			return -ENOMEM;
+		}
+
+		branch->child[prefix_bit(&route->addr, common)] = new;
+		branch->child[prefix_bit(&node->prefix, common)] = node;
+		*link = branch;
+	}
+
+	route_gen++;
+
+	return 0;
+}
+
+static void route_trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node **link = &trie_root, **parent_link = NULL;
+	struct route_trie_node *node, *parent = NULL, *child;
+
+	while ((node = *link) != NULL && node->len < route->prefix_len) {
+		if (prefix_common_len(&node->prefix, &route->addr,
+				      node->len) < node->len) {
+			return;
+		}
+
+		parent_link = link;
+		parent = node;
+		link = &node->child[prefix_bit(&route->addr, node->len)];
+	}
+
+	if (node == NULL ||
+	    !sys_slist_find_and_remove(&node->routes, &route->prefix_node)) {
+		return;
+	}
 
-		if (route->prefix_len >= longest_match &&
-		    net_ipv6_is_prefix(dst->s6_addr,
-				       route->addr.s6_addr,
-				       route->prefix_len)) {
-			found = route;
-			longest_match = route->prefix_len;
+	route_gen++;
+
+	if (!sys_slist_is_empty(&node->routes) ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		return;
+	}
+
+	child = node->child[0] != NULL ? node->child[0] : node->child[1];
+	*link = child;
+	trie_node_free(node);
+
+	/* A parent without routes was only branching to this node */
+	if (child == NULL && parent != NULL &&
+	    sys_slist_is_empty(&parent->routes)) {
+		*parent_link = parent->child[0] != NULL ? parent->child[0] :
+							  parent->child[1];
+		trie_node_free(parent);
+	}
+}
+
+static struct net_route_entry *route_trie_lookup(struct net_if *iface,
+						 struct in6_addr *dst)
+{
+	struct route_trie_node *node = trie_root;
+	struct net_route_entry *route, *found = NULL;
+
+	/* Prefixes only get longer on the way down, so the last one
+	 * matching is the longest.
+	 */
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->len)) {
+		SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, prefix_node) {
+			if (iface == NULL || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->len == 128U) {
+			break;
+		}
+
+		node = node->child[prefix_bit(dst, node->len)];
+	}
+
+	return found;
+}
+
+/* Route to exactly this prefix, not to a longer or shorter one */
+static struct net_route_entry *route_trie_find(struct net_if *iface,
+					       struct in6_addr *prefix,
+					       uint8_t len)
+{
+	struct route_trie_node *node = trie_root;
+	struct net_route_entry *route;
+
+	while (node != NULL && node->len < len) {
+		node = node->child[prefix_bit(prefix, node->len)];
+	}
+
+	if (node == NULL || node->len != len ||
+	    !net_ipv6_is_prefix(prefix->s6_addr, node->prefix.s6_addr, len)) {
+		return NULL;
+	}
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&node->routes, route, prefix_node) {
+		if (route->iface == iface) {
+			return route;
 		}
 	}
 
+	return NULL;
+}
+
+#if CONFIG_NET_ROUTE_CACHE_SIZE > 0
+static struct net_route_entry *route_cache_lookup(struct net_if *iface,
+						  struct in6_addr *dst)
+{
+	struct route_cache_entry *entry;
+	uint32_t hash;
+
+	hash = (UNALIGNED_GET(&dst->s6_addr32[0]) ^
+		UNALIGNED_GET(&dst->s6_addr32[1]) ^
+		UNALIGNED_GET(&dst->s6_addr32[2]) ^
+		UNALIGNED_GET(&dst->s6_addr32[3])) * 0x9e3779b1U;
+	entry = &route_cache[(hash >> 16) % CONFIG_NET_ROUTE_CACHE_SIZE];
+
+	if (entry->gen != route_gen || entry->iface != iface ||
+	    !net_ipv6_addr_cmp(&entry->dst, dst)) {
+		entry->route = route_trie_lookup(iface, dst);
+		entry->iface = iface;
+		entry->gen = route_gen;
+		net_ipaddr_copy(&entry->dst, dst);
+	}
+
+	return entry->route;
+}
+#else
+static inline struct net_route_entry *route_cache_lookup(struct net_if *iface,
+							 struct in6_addr *dst)
+{
+	return route_trie_lookup(iface, dst);
+}
+#endif
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	found = route_cache_lookup(iface, dst);
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -370,11 +625,13 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 			net_sprint_ll_addr(nexthop_lladdr->addr, nexthop_lladdr->len));
 	}
 
-	route = net_route_lookup(iface, addr);
+	route = route_trie_find(iface, addr, prefix_len);
 	if (route) {
 		/* Update nexthop if not the same */
 		struct in6_addr *nexthop_addr;
 
+		update_route_access(route);
+
 		nexthop_addr = net_route_get_nexthop(route);
 		if (nexthop_addr && net_ipv6_addr_cmp(nexthop, nexthop_addr)) {
 			NET_DBG("No changes, return old route %p", route);
@@ -402,9 +659,9 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	nbr = nbr_new(iface, addr, prefix_len);
 	if (!nbr) {
 		/* Remove the oldest route and try again */
-		sys_snode_t *last = sys_slist_peek_tail(&routes);
+		sys_dnode_t *last = sys_dlist_peek_tail(&routes);
 
-		sys_slist_find_and_remove(&routes, last);
+		sys_dlist_remove(last);
 
 		route = CONTAINER_OF(last,
 				     struct net_route_entry,
@@ -453,7 +710,7 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 
 	net_route_update_lifetime(route, lifetime);
 
-	sys_slist_prepend(&routes, &route->node);
+	sys_dlist_prepend(&routes, &route->node);
 
 	tmp = nbr_nexthop_get(iface, nexthop);
 
@@ -464,6 +721,13 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	sys_slist_init(&route->nexthop);
 	sys_slist_prepend(&route->nexthop, &nexthop_route->node);
 
+	if (route_trie_insert(route) < 0) {
+		NET_ERR("No room for route in lookup trie!");
+		net_route_del(route);
+		route = NULL;
+		goto exit;
+	}
+
 	net_route_info("Added", route, addr);
 
 #if defined(CONFIG_NET_MGMT_EVENT_INFO)
@@ -595,7 +859,9 @@ int net_route_del(struct net_route_entry *route)
 		}
 	}
 
-	sys_slist_find_and_remove(&routes, &route->node);
+	if (sys_dnode_is_linked(&route->node)) {
+		sys_dlist_remove(&route->node);
+	}
 
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
@@ -603,6 +869,8 @@ int net_route_del(struct net_route_entry *route)
 		return -ENOENT;
 	}
 
+	route_trie_remove(route);
+
 	net_route_info("Deleted", route, &route->addr);
 
 	SYS_SLIST_FOR_EACH_CONTAINER(&route->nexthop, nexthop_route, node) {
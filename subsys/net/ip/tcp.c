@@ -30,6 +30,10 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define ACK_TIMEOUT K_MSEC(ACK_TIMEOUT_MS)
 #define FIN_TIMEOUT K_MSEC(tcp_fin_timeout_ms)
 #define ACK_DELAY K_MSEC(100)
+/* Data segments acknowledged at once on a new connection, so that the
+ * slow start of the peer is not held back by the delayed ACK timer.
+ */
+#define ACK_QUICK_SEGMENTS 16
 #define ZWP_MAX_DELAY_MS 120000
 #define DUPLICATE_ACK_RETRANSMIT_TRHESHOLD 3
 
@@ -64,6 +68,11 @@ static int tcp_tx_window =
 
 static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
+/* Connections whose end points are set, hashed on their addresses and
+ * ports, so that received segments do not search all of tcp_conns.
+ */
+static sys_slist_t tcp_conn_hash[NHPOT(CONFIG_NET_MAX_CONTEXTS)];
+
 static K_MUTEX_DEFINE(tcp_lock);
 
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
@@ -233,6 +242,54 @@ static int tcp_endpoint_set(union tcp_endpoint *ep, struct net_pkt *pkt,
 	return ret;
 }
 
+static sys_slist_t *tcp_conn_hash_list(union tcp_endpoint *src,
+				       union tcp_endpoint *dst)
+{
+	uint32_t h;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && src->sa.sa_family == AF_INET6) {
+		h = net_conn_hash(AF_INET6, (uint8_t *)&dst->sin6.sin6_addr,
+				  dst->sin6.sin6_port,
+				  (uint8_t *)&src->sin6.sin6_addr,
+				  src->sin6.sin6_port);
+	} else {
+		h = net_conn_hash(AF_INET, (uint8_t *)&dst->sin.sin_addr,
+				  dst->sin.sin_port,
+				  (uint8_t *)&src->sin.sin_addr,
+				  src->sin.sin_port);
+	}
+
+	return &tcp_conn_hash[h & (ARRAY_SIZE(tcp_conn_hash) - 1)];
+}
+
+static void tcp_conn_hash_remove(struct tcp *conn)
+{
+	k_mutex_lock(&tcp_lock, K_FOREVER);
+
+	/* The end points may have changed since the connection was added */
+	if (conn->hash_list != NULL) {
+		sys_slist_find_and_remove(conn->hash_list, &conn->hash_node);
+		conn->hash_list = NULL;
+	}
+
+	k_mutex_unlock(&tcp_lock);
+}
+
+/* Make a connection found by tcp_conn_search() once its end points are set.
+ * Connections are appended, so that the oldest one with given end points
+ * is found first, as when searching tcp_conns.
+ */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	k_mutex_lock(&tcp_lock, K_FOREVER);
+
+	tcp_conn_hash_remove(conn);
+	conn->hash_list = tcp_conn_hash_list(&conn->src, &conn->dst);
+	sys_slist_append(conn->hash_list, &conn->hash_node);
+
+	k_mutex_unlock(&tcp_lock);
+}
+
 static const char *tcp_flags(uint8_t flags)
 {
 #define BUF_SIZE 25 /* 6 * 4 + 1 */
@@ -465,8 +522,12 @@ static int tcp_conn_unref(struct tcp *conn)
 	(void)k_work_cancel_delayable(&conn->fin_timer);
 	(void)k_work_cancel_delayable(&conn->persist_timer);
 	(void)k_work_cancel_delayable(&conn->ack_timer);
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+	(void)k_work_cancel_delayable(&conn->delayed_ack_timer);
+#endif
 
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
+	tcp_conn_hash_remove(conn);
 
 	memset(conn, 0, sizeof(*conn));
 
@@ -673,7 +734,7 @@ static uint8_t *tcp_options_get(struct net_pkt *pkt, int tcp_options_len,
 }
 
 static bool tcp_options_check(struct tcp_options *recv_options,
-			      struct net_pkt *pkt, ssize_t len)
+			      struct net_pkt *pkt, ssize_t len, bool syn)
 {
 	uint8_t options_buf[40]; /* TCP header max options size is 40 */
 	bool result = len > 0 && ((len % 4) == 0) ? true : false;
@@ -683,8 +744,14 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 
 	NET_DBG("len=%zd", len);
 
-	recv_options->mss_found = false;
-	recv_options->wnd_found = false;
+	/* The options negotiated in the handshake are only valid in SYN
+	 * segments, later segments do not change them.
+	 */
+	if (syn) {
+		recv_options->mss_found = false;
+		recv_options->wnd_found = false;
+		recv_options->sack_perm_found = false;
+	}
 
 	for ( ; options && len >= 1; options += opt_len, len -= opt_len) {
 		opt = options[0];
@@ -719,6 +786,10 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
+			if (!syn) {
+				break;
+			}
+
 			recv_options->mss =
 				ntohs(UNALIGNED_GET((uint16_t *)(options + 2)));
 			recv_options->mss_found = true;
@@ -730,9 +801,43 @@ static bool tcp_options_check(struct tcp_options *recv_options,
 				goto end;
 			}
 
-			recv_options->window = opt;
+			if (!syn) {
+				break;
+			}
+
+			recv_options->window = MIN(options[2],
+						   NET_TCP_MAX_WINDOW_SCALE);
 			recv_options->wnd_found = true;
+			NET_DBG("Window scale=%hu", recv_options->window);
 			break;
+		case NET_TCP_SACK_PERM_OPT:
+			if (opt_len != NET_TCP_SACK_PERM_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			if (syn) {
+				recv_options->sack_perm_found = true;
+			}
+			break;
+#ifdef CONFIG_NET_TCP_SACK
+		case NET_TCP_SACK_OPT:
+			if ((opt_len - 2) % NET_TCP_SACK_BLOCK_SIZE) {
+				result = false;
+				goto end;
+			}
+
+			for (int i = 2; i < opt_len &&
+			     recv_options->sack_cnt < NET_TCP_SACK_BLOCKS;
+			     i += NET_TCP_SACK_BLOCK_SIZE) {
+				struct tcp_sack_block *block =
+					&recv_options->sack[recv_options->sack_cnt++];
+
+				block->start = ntohl(UNALIGNED_GET((uint32_t *)(options + i)));
+				block->end = ntohl(UNALIGNED_GET((uint32_t *)(options + i + 4)));
+			}
+			break;
+#endif
 		default:
 			continue;
 		}
@@ -907,10 +1012,11 @@ static int tcp_finalize_pkt(struct net_pkt *pkt)
 }
 
 static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
-			  uint32_t seq)
+			  uint32_t seq, size_t options_len)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
 	struct tcphdr *th;
+	uint32_t win = conn->recv_win;
 
 	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
 	if (!th) {
@@ -921,14 +1027,15 @@ static int tcp_header_add(struct tcp *conn, struct net_pkt *pkt, uint8_t flags,
 
 	UNALIGNED_PUT(conn->src.sin.sin_port, &th->th_sport);
 	UNALIGNED_PUT(conn->dst.sin.sin_port, &th->th_dport);
-	th->th_off = 5;
+	th->th_off = 5 + options_len / 4;
 
-	if (conn->send_options.mss_found) {
-		th->th_off++;
+	/* The window of a SYN is never scaled, RFC 7323 ch 2.2 */
+	if (!(flags & SYN) && conn->wscale_ok) {
+		win >>= conn->rcv_wscale;
 	}
 
 	UNALIGNED_PUT(flags, &th->th_flags);
-	UNALIGNED_PUT(htons(conn->recv_win), &th->th_win);
+	UNALIGNED_PUT(htons(MIN(win, UINT16_MAX)), &th->th_win);
 	UNALIGNED_PUT(htonl(seq), &th->th_seq);
 
 	if (ACK & flags) {
@@ -986,23 +1093,68 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
-static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
+/* Write the options of a segment with the given flags into opts, which
+ * must hold the 40 bytes of the largest option list, and return their
+ * length, a multiple of 4.
+ */
+static size_t tcp_options_build(struct tcp *conn, uint8_t flags, bool data,
+				uint8_t *opts)
 {
-	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
-	struct tcp_mss_option *mss;
-	uint32_t recv_mss;
+	size_t len = 0;
 
-	mss = net_pkt_get_data(pkt, &mss_opt_access);
-	if (!mss) {
-		return -ENOBUFS;
+	if (conn->send_options.mss_found) {
+		uint32_t recv_mss = net_tcp_get_supported_mss(conn);
+
+		recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+		UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)opts);
+		len += sizeof(uint32_t);
 	}
 
-	recv_mss = net_tcp_get_supported_mss(conn);
-	recv_mss |= (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16);
+	if (flags & SYN) {
+		/* A SYN-ACK only answers the options offered in the SYN */
+		if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+		    (!(flags & ACK) || conn->wscale_ok)) {
+			opts[len++] = NET_TCP_NOP_OPT;
+			opts[len++] = NET_TCP_WINDOW_SCALE_OPT;
+			opts[len++] = NET_TCP_WINDOW_SCALE_SIZE;
+			opts[len++] = conn->rcv_wscale;
+		}
 
-	UNALIGNED_PUT(htonl(recv_mss), (uint32_t *)mss);
+		if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+		    (!(flags & ACK) || conn->sack_ok)) {
+			opts[len++] = NET_TCP_NOP_OPT;
+			opts[len++] = NET_TCP_NOP_OPT;
+			opts[len++] = NET_TCP_SACK_PERM_OPT;
+			opts[len++] = NET_TCP_SACK_PERM_SIZE;
+		}
+
+		return len;
+	}
+
+#ifdef CONFIG_NET_TCP_SACK
+	/* Report the queued out of order data in the ACKs, so that the peer
+	 * only resends what is missing. Data segments are not given the
+	 * option, it would not fit in a full sized segment.
+	 */
+	if (conn->sack_ok && !data && CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
+	    conn->queue_recv_data != NULL &&
+	    !net_pkt_is_empty(conn->queue_recv_data)) {
+		uint32_t start = tcp_get_seq(conn->queue_recv_data->buffer);
+		uint32_t end = start + net_pkt_get_len(conn->queue_recv_data);
+
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_NOP_OPT;
+		opts[len++] = NET_TCP_SACK_OPT;
+		opts[len++] = 2 + NET_TCP_SACK_BLOCK_SIZE;
+		UNALIGNED_PUT(htonl(start), (uint32_t *)(opts + len));
+		UNALIGNED_PUT(htonl(end), (uint32_t *)(opts + len + 4));
+		len += NET_TCP_SACK_BLOCK_SIZE;
+	}
+#else
+	ARG_UNUSED(data);
+#endif
 
-	return net_pkt_set_data(pkt, &mss_opt_access);
+	return len;
 }
 
 static bool is_destination_local(struct net_pkt *pkt)
@@ -1031,14 +1183,14 @@ static bool is_destination_local(struct net_pkt *pkt)
 static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		       uint32_t seq)
 {
-	size_t alloc_len = sizeof(struct tcphdr);
+	uint8_t options[40];
+	size_t options_len = tcp_options_build(conn, flags, data != NULL,
+					       options);
+	size_t alloc_len = sizeof(struct tcphdr) + options_len;
+	size_t data_len = data ? net_pkt_get_len(data) : 0;
 	struct net_pkt *pkt;
 	int ret = 0;
 
-	if (conn->send_options.mss_found) {
-		alloc_len += sizeof(uint32_t);
-	}
-
 	pkt = tcp_pkt_alloc(conn, alloc_len);
 	if (!pkt) {
 		ret = -ENOBUFS;
@@ -1057,26 +1209,39 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		goto out;
 	}
 
-	ret = tcp_header_add(conn, pkt, flags, seq);
+	ret = tcp_header_add(conn, pkt, flags, seq, options_len);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
-	if (conn->send_options.mss_found) {
-		ret = net_tcp_set_mss_opt(conn, pkt);
+	if (options_len > 0) {
+		ret = net_pkt_write(pkt, options, options_len);
 		if (ret < 0) {
 			tcp_pkt_unref(pkt);
 			goto out;
 		}
 	}
 
+	/* Data larger than the MSS is cut into segments on its way out */
+	if (data_len > conn_mss(conn)) {
+		net_pkt_set_gso_size(pkt, conn_mss(conn));
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
 		goto out;
 	}
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+	if ((flags & ACK) && conn->ack_pending_len > 0) {
+		/* This segment acknowledges all the data received so far */
+		conn->ack_pending_len = 0;
+		k_work_cancel_delayable(&conn->delayed_ack_timer);
+	}
+#endif
+
 	NET_DBG("%s", tcp_th(pkt));
 
 	if (tcp_send_cb) {
@@ -1146,8 +1311,21 @@ static bool tcp_window_full(struct tcp *conn)
 	return window_full;
 }
 
+/* Data which can be in flight, limited by the peer receive window and
+ * by the congestion window.
+ */
+static uint32_t tcp_send_window(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	return MIN(conn->send_win, conn->ca.cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
 static int tcp_unsent_len(struct tcp *conn)
 {
+	uint32_t window = tcp_send_window(conn);
 	int unsent_len;
 
 	if (conn->unacked_len > conn->send_data_total) {
@@ -1158,10 +1336,10 @@ static int tcp_unsent_len(struct tcp *conn)
 	}
 
 	unsent_len = conn->send_data_total - conn->unacked_len;
-	if (conn->unacked_len >= conn->send_win) {
+	if (conn->unacked_len >= window) {
 		unsent_len = 0;
 	} else {
-		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
+		unsent_len = MIN(unsent_len, window - conn->unacked_len);
 	}
  out:
 	NET_DBG("unsent_len=%d", unsent_len);
@@ -1169,53 +1347,153 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
-static int tcp_send_data(struct tcp *conn)
+#ifdef CONFIG_NET_TCP_GSO
+/* Leave room for the largest IP and TCP headers in the IP length field */
+#define TCP_GSO_MAX_LEN (UINT16_MAX - 2 * NET_IPV4H_LEN - 2 * NET_TCPH_LEN)
+
+/* Largest amount of data sent in a single packet. Packets larger than
+ * the MSS are segmented by net_if_tx(). Without a loopback driver, packets
+ * to our own address do not go through it, and 6lo technologies compress
+ * the headers of each packet, so these get one segment per packet.
+ */
+static uint32_t tcp_send_max(struct tcp *conn)
 {
-	int ret = 0;
-	int len;
-	struct net_pkt *pkt;
+	uint32_t mss = conn_mss(conn);
+	enum net_link_type type = net_if_get_link_addr(conn->iface)->type;
 
-	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
-	if (len == 0) {
-		NET_DBG("conn: %p no data to send", conn);
-		ret = -ENODATA;
-		goto out;
+	if ((IS_ENABLED(CONFIG_NET_L2_BT) && type == NET_LINK_BLUETOOTH) ||
+	    (IS_ENABLED(CONFIG_NET_L2_IEEE802154) &&
+	     type == NET_LINK_IEEE802154)) {
+		return mss;
 	}
 
-	pkt = tcp_pkt_alloc(conn, len);
-	if (!pkt) {
-		NET_ERR("conn: %p packet allocation failed, len=%d", conn, len);
-		ret = -ENOBUFS;
-		goto out;
+	if (!IS_ENABLED(CONFIG_NET_LOOPBACK)) {
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    conn->dst.sa.sa_family == AF_INET &&
+		    (net_ipv4_is_addr_loopback(&conn->dst.sin.sin_addr) ||
+		     net_ipv4_is_my_addr(&conn->dst.sin.sin_addr))) {
+			return mss;
+		}
+
+		if (IS_ENABLED(CONFIG_NET_IPV6) &&
+		    conn->dst.sa.sa_family == AF_INET6 &&
+		    (net_ipv6_is_addr_loopback(&conn->dst.sin6.sin6_addr) ||
+		     net_ipv6_is_my_addr(&conn->dst.sin6.sin6_addr))) {
+			return mss;
+		}
 	}
 
-	ret = tcp_pkt_peek(pkt, conn->send_data, conn->unacked_len, len);
-	if (ret < 0) {
-		tcp_pkt_unref(pkt);
-		ret = -ENOBUFS;
-		goto out;
+	return MIN(mss * CONFIG_NET_TCP_GSO_MAX_SEGMENTS,
+		   TCP_GSO_MAX_LEN / mss * mss);
+}
+#else
+#define tcp_send_max(_conn) conn_mss(_conn)
+#endif /* CONFIG_NET_TCP_GSO */
+
+/* Send len bytes of send_data from offset, the sequence number of their
+ * first byte being seq + offset. The data is gathered MSS by MSS, as the
+ * buffer of a packet does not grow beyond the MTU.
+ */
+static int tcp_send_segment(struct tcp *conn, uint32_t offset, uint32_t len,
+			    bool resend)
+{
+	uint16_t mss = conn_mss(conn);
+	struct net_pkt *pkt = NULL;
+	struct net_pkt *part;
+	uint32_t done = 0;
+	int segs = 0;
+	int ret;
+
+	while (done < len) {
+		uint32_t part_len = MIN(len - done, mss);
+
+		part = tcp_pkt_alloc(conn, part_len);
+		if (!part) {
+			NET_ERR("conn: %p packet allocation failed, len=%u",
+				conn, part_len);
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		ret = tcp_pkt_peek(part, conn->send_data, offset + done,
+				   part_len);
+		if (ret < 0) {
+			tcp_pkt_unref(part);
+			ret = -ENOBUFS;
+			goto out;
+		}
+
+		if (pkt == NULL) {
+			pkt = part;
+		} else {
+			net_pkt_append_buffer(pkt, part->buffer);
+			part->buffer = NULL;
+			tcp_pkt_unref(part);
+		}
+
+		done += part_len;
+		segs++;
 	}
 
-	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
+	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + offset);
 	if (ret == 0) {
-		conn->unacked_len += len;
-
-		if (conn->data_mode == TCP_DATA_MODE_RESEND) {
+		if (resend) {
 			net_stats_update_tcp_resent(conn->iface, len);
-			net_stats_update_tcp_seg_rexmit(conn->iface);
 		} else {
 			net_stats_update_tcp_sent(conn->iface, len);
-			net_stats_update_tcp_seg_sent(conn->iface);
+		}
+
+		while (segs-- > 0) {
+			if (resend) {
+				net_stats_update_tcp_seg_rexmit(conn->iface);
+			} else {
+				net_stats_update_tcp_seg_sent(conn->iface);
+			}
 		}
 	}
 
+out:
 	/* The data we want to send, has been moved to the send queue so we
 	 * can unref the head net_pkt. If there was an error, we need to remove
 	 * the packet anyway.
 	 */
-	tcp_pkt_unref(pkt);
+	if (pkt) {
+		tcp_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+static int tcp_send_data(struct tcp *conn)
+{
+	uint32_t window = tcp_send_window(conn);
+	int ret = 0;
+	int len = 0;
+
+	if (conn->unacked_len < window) {
+		len = MIN3(conn->send_data_total - conn->unacked_len,
+			   window - conn->unacked_len,
+			   tcp_send_max(conn));
+	}
+
+	if (len == 0) {
+		NET_DBG("conn: %p no data to send", conn);
+		ret = -ENODATA;
+		goto out;
+	}
+
+	ret = tcp_send_segment(conn, conn->unacked_len, len,
+			       conn->data_mode == TCP_DATA_MODE_RESEND);
+	if (ret == -ENOBUFS && len > conn_mss(conn)) {
+		/* Not enough buffers for a large packet, try a single segment */
+		len = conn_mss(conn);
+		ret = tcp_send_segment(conn, conn->unacked_len, len,
+				       conn->data_mode == TCP_DATA_MODE_RESEND);
+	}
+
+	if (ret == 0) {
+		conn->unacked_len += len;
+	}
 
 	conn_send_data_dump(conn);
 
@@ -1223,6 +1501,366 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_SACK
+/* Add a block of selectively acknowledged data to the scoreboard, merging
+ * it with the blocks it overlaps or touches. When the scoreboard is full,
+ * the highest block is forgotten, holes are resent from the lowest one.
+ */
+static void tcp_sack_insert(struct tcp *conn, uint32_t start, uint32_t end)
+{
+	struct tcp_sack_block *sacked = conn->sacked;
+	int i = 0;
+	int j;
+
+	while (i < conn->sacked_cnt &&
+	       net_tcp_seq_cmp(sacked[i].end, start) < 0) {
+		i++;
+	}
+
+	for (j = i; j < conn->sacked_cnt &&
+	     net_tcp_seq_cmp(sacked[j].start, end) <= 0; j++) {
+		if (net_tcp_seq_cmp(sacked[j].start, start) < 0) {
+			start = sacked[j].start;
+		}
+
+		if (net_tcp_seq_cmp(sacked[j].end, end) > 0) {
+			end = sacked[j].end;
+		}
+	}
+
+	if (j == i) {
+		if (conn->sacked_cnt == NET_TCP_SACK_BLOCKS) {
+			if (i == NET_TCP_SACK_BLOCKS) {
+				return;
+			}
+
+			conn->sacked_cnt--;
+		}
+
+		memmove(&sacked[i + 1], &sacked[i],
+			(conn->sacked_cnt - i) * sizeof(sacked[0]));
+		conn->sacked_cnt++;
+	} else if (j > i + 1) {
+		memmove(&sacked[i + 1], &sacked[j],
+			(conn->sacked_cnt - j) * sizeof(sacked[0]));
+		conn->sacked_cnt -= j - i - 1;
+	}
+
+	sacked[i].start = start;
+	sacked[i].end = end;
+}
+
+/* Forget the blocks acknowledged cumulatively, and add the blocks of the
+ * SACK option of the received segment.
+ */
+static void tcp_sack_update(struct tcp *conn)
+{
+	uint32_t snd_nxt = conn->seq + conn->unacked_len;
+	uint8_t n = 0;
+
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		struct tcp_sack_block block = conn->sacked[i];
+
+		if (net_tcp_seq_cmp(block.end, conn->seq) <= 0) {
+			continue;
+		}
+
+		if (net_tcp_seq_cmp(block.start, conn->seq) < 0) {
+			block.start = conn->seq;
+		}
+
+		conn->sacked[n++] = block;
+	}
+
+	conn->sacked_cnt = n;
+
+	for (int i = 0; i < conn->recv_options.sack_cnt; i++) {
+		uint32_t start = conn->recv_options.sack[i].start;
+		uint32_t end = conn->recv_options.sack[i].end;
+
+		/* Keep the part of the block within the data in flight,
+		 * duplicate SACK blocks (RFC 2883) fall outside of it.
+		 */
+		if (net_tcp_seq_cmp(start, conn->seq) < 0) {
+			start = conn->seq;
+		}
+
+		if (net_tcp_seq_cmp(end, snd_nxt) > 0) {
+			end = snd_nxt;
+		}
+
+		if (net_tcp_seq_cmp(start, end) < 0) {
+			tcp_sack_insert(conn, start, end);
+		}
+	}
+}
+
+/* Find the first data not acknowledged by the peer from rexmit_next, below
+ * the highest acknowledged block, and return its offset from seq.
+ */
+static bool tcp_sack_next_hole(struct tcp *conn, uint32_t *offset,
+			       uint32_t *len)
+{
+	uint32_t from = conn->rexmit_next;
+
+	if (net_tcp_seq_cmp(from, conn->seq) < 0) {
+		from = conn->seq;
+	}
+
+	for (int i = 0; i < conn->sacked_cnt; i++) {
+		if (net_tcp_seq_cmp(from, conn->sacked[i].start) < 0) {
+			*offset = from - conn->seq;
+			*len = conn->sacked[i].start - from;
+			return true;
+		}
+
+		if (net_tcp_seq_cmp(from, conn->sacked[i].end) < 0) {
+			from = conn->sacked[i].end;
+		}
+	}
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_SACK */
+
+#if defined(CONFIG_NET_TCP_FAST_RETRANSMIT) || \
+	defined(CONFIG_NET_TCP_CONGESTION_AVOIDANCE)
+/* Resend the first segment the peer is missing, without changing the data
+ * in flight. Without SACK information, this is the segment at seq.
+ */
+static void tcp_retransmit_lost(struct tcp *conn)
+{
+	uint32_t offset = 0;
+	uint32_t len = conn->unacked_len;
+
+#ifdef CONFIG_NET_TCP_SACK
+	if (conn->sacked_cnt > 0 && !tcp_sack_next_hole(conn, &offset, &len)) {
+		return;
+	}
+#endif
+
+	len = MIN(len, conn_mss(conn));
+	if (len == 0) {
+		return;
+	}
+
+	if (tcp_send_segment(conn, offset, len, true) < 0) {
+		return;
+	}
+
+#ifdef CONFIG_NET_TCP_SACK
+	conn->rexmit_next = conn->seq + offset + len;
+#endif
+}
+#endif
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+/* Largest congestion window, the largest scaled window */
+#define TCP_CWND_MAX (UINT16_MAX << NET_TCP_MAX_WINDOW_SCALE)
+
+/* Congestion control algorithm, the operations are called with the
+ * connection locked.
+ */
+struct tcp_cc {
+	/* Return the slow start threshold after a loss */
+	uint32_t (*ssthresh)(struct tcp *conn);
+	/* Grow cwnd past the slow start threshold, for acked new bytes */
+	void (*cong_avoid)(struct tcp *conn, uint32_t acked);
+};
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+static uint32_t newreno_ssthresh(struct tcp *conn)
+{
+	/* Half the data in flight, RFC 5681 ch 3.1 eq. 4 */
+	return MAX(conn->unacked_len / 2, 2 * conn_mss(conn));
+}
+
+static void newreno_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	/* One segment per window of acknowledged data, RFC 5681 ch 3.1 */
+	conn->ca.acked += acked;
+	if (conn->ca.acked >= conn->ca.cwnd) {
+		conn->ca.acked -= conn->ca.cwnd;
+		conn->ca.cwnd += conn_mss(conn);
+	}
+}
+
+static const struct tcp_cc tcp_cc = {
+	.ssthresh = newreno_ssthresh,
+	.cong_avoid = newreno_cong_avoid,
+};
+#endif /* CONFIG_NET_TCP_CC_NEWRENO */
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* Integer cube root */
+static uint32_t cubic_cbrt(uint64_t x)
+{
+	uint64_t y = 0;
+	uint64_t b;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static uint32_t cubic_ssthresh(struct tcp *conn)
+{
+	uint32_t cwnd = conn->ca.cwnd;
+
+	/* Release some bandwidth to new flows when the window did not
+	 * grow back to where the previous loss occurred, RFC 8312 ch 4.6.
+	 */
+	if (cwnd < conn->ca.w_max) {
+		conn->ca.w_max = (uint64_t)cwnd * 17 / 20;
+	} else {
+		conn->ca.w_max = cwnd;
+	}
+
+	conn->ca.epoch_start = 0;
+
+	/* Multiplicative decrease by beta = 0.7, RFC 8312 ch 4.5 */
+	return MAX((uint64_t)cwnd * 7 / 10, 2 * conn_mss(conn));
+}
+
+static void cubic_cong_avoid(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+	uint32_t cwnd = conn->ca.cwnd;
+	uint32_t now = k_uptime_get_32();
+	uint32_t inc;
+	int64_t t;
+	int64_t target;
+
+	if (conn->ca.epoch_start == 0) {
+		conn->ca.epoch_start = now ? now : 1;
+
+		/* Time for W_cubic to be back at w_max, RFC 8312 ch 4.1 eq. 2,
+		 * K = cbrt((w_max - cwnd) / C) seconds with C = 0.4.
+		 */
+		if (cwnd < conn->ca.w_max) {
+			conn->ca.k = cubic_cbrt(2500000000ULL *
+						(conn->ca.w_max - cwnd) / mss);
+		} else {
+			conn->ca.w_max = cwnd;
+			conn->ca.k = 0;
+		}
+	}
+
+	/* W_cubic(t) = C * (t - K)^3 + w_max, RFC 8312 ch 4.1 eq. 1, with t
+	 * in ms and the window in bytes. The time is bounded so that the
+	 * cube does not overflow.
+	 */
+	t = (int64_t)(now - conn->ca.epoch_start) - conn->ca.k;
+	t = CLAMP(t, -(1 << 18), 1 << 18);
+	target = conn->ca.w_max + t * t * t * 4 / 10000 * mss / 1000000;
+
+	/* At most 1.5 times the window per round trip, RFC 8312 ch 4.3 */
+	target = CLAMP(target, cwnd, cwnd + cwnd / 2);
+
+	inc = (uint64_t)(target - cwnd) * acked / cwnd;
+
+	/* Never slower than NewReno, a simplification of the TCP friendly
+	 * region of RFC 8312 ch 4.2.
+	 */
+	inc = MAX(inc, (uint64_t)mss * acked / cwnd);
+
+	conn->ca.cwnd += inc;
+}
+
+static const struct tcp_cc tcp_cc = {
+	.ssthresh = cubic_ssthresh,
+	.cong_avoid = cubic_cong_avoid,
+};
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
+
+/* Start a connection with the initial window of RFC 6928 */
+static void tcp_ca_init(struct tcp *conn)
+{
+	uint32_t mss = conn_mss(conn);
+
+	conn->ca.cwnd = MIN(10 * mss, MAX(2 * mss, 14600));
+	conn->ca.ssthresh = UINT32_MAX;
+	conn->ca.acked = 0;
+	conn->ca.in_recovery = false;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+	conn->ca.w_max = 0;
+	conn->ca.epoch_start = 0;
+#endif
+}
+
+/* A loss was detected with duplicate acknowledgments, RFC 6582 ch 3.2 */
+static void tcp_ca_recovery_enter(struct tcp *conn)
+{
+	conn->ca.ssthresh = tcp_cc.ssthresh(conn);
+	conn->ca.cwnd = conn->ca.ssthresh + 3 * conn_mss(conn);
+	conn->ca.recover = conn->seq + conn->unacked_len;
+	conn->ca.in_recovery = true;
+	conn->ca.acked = 0;
+}
+
+/* The retransmission timer expired, restart from a single segment */
+static void tcp_ca_timeout(struct tcp *conn)
+{
+	/* Back to back timeouts do not lower the threshold further,
+	 * RFC 5681 ch 3.1.
+	 */
+	if (conn->data_mode != TCP_DATA_MODE_RESEND) {
+		conn->ca.ssthresh = tcp_cc.ssthresh(conn);
+	}
+
+	conn->ca.cwnd = conn_mss(conn);
+	conn->ca.in_recovery = false;
+	conn->ca.acked = 0;
+}
+
+/* New data was acknowledged, seq has already been moved past it */
+static void tcp_ca_acked(struct tcp *conn, uint32_t acked)
+{
+	uint32_t mss = conn_mss(conn);
+
+	if (conn->ca.in_recovery) {
+		if (net_tcp_seq_cmp(conn->seq, conn->ca.recover) >= 0) {
+			/* Full acknowledgment, deflate the window */
+			conn->ca.cwnd = MIN(conn->ca.ssthresh,
+					    MAX(conn->unacked_len, mss) + mss);
+			conn->ca.in_recovery = false;
+		} else {
+			/* Partial acknowledgment, the segment at seq was lost
+			 * too. Deflate the window by the acknowledged data,
+			 * add back one segment, and resend it.
+			 */
+			conn->ca.cwnd -= MIN(acked, conn->ca.cwnd - mss);
+			if (acked >= mss) {
+				conn->ca.cwnd += mss;
+			}
+
+			tcp_retransmit_lost(conn);
+		}
+
+		return;
+	}
+
+	if (conn->ca.cwnd < conn->ca.ssthresh) {
+		/* Slow start with appropriate byte counting, RFC 3465 with
+		 * L = 2, so that ACKs covering two segments, as delayed or
+		 * coalesced ones do, do not slow it down.
+		 */
+		conn->ca.cwnd += MIN(acked, 2 * mss);
+	} else {
+		tcp_cc.cong_avoid(conn, acked);
+	}
+
+	conn->ca.cwnd = MIN(conn->ca.cwnd, TCP_CWND_MAX);
+}
+#endif /* CONFIG_NET_TCP_CONGESTION_AVOIDANCE */
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1271,6 +1909,48 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+/* A duplicate acknowledgment was received while sending new data */
+static void tcp_dup_ack(struct tcp *conn)
+{
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	bool recovering = conn->ca.in_recovery;
+#else
+	bool recovering = conn->dup_ack_cnt > DUPLICATE_ACK_RETRANSMIT_TRHESHOLD;
+#endif
+
+	if (recovering) {
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		/* Each duplicate acknowledgment is a segment which left the
+		 * network, RFC 5681 ch 3.2 step 4.
+		 */
+		conn->ca.cwnd = MIN(conn->ca.cwnd + conn_mss(conn), TCP_CWND_MAX);
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+		if (conn->sacked_cnt > 0) {
+			tcp_retransmit_lost(conn);
+		}
+#endif
+	} else if (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD) {
+		/* Apply a fast retransmit */
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+		tcp_ca_recovery_enter(conn);
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+		conn->rexmit_next = conn->seq;
+#endif
+		tcp_retransmit_lost(conn);
+	} else {
+		return;
+	}
+
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	/* The inflated window may let new data out */
+	(void)tcp_send_queued_data(conn);
+#endif
+}
+#endif /* CONFIG_NET_TCP_FAST_RETRANSMIT */
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1306,6 +1986,16 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	if (conn->unacked_len > 0) {
+		tcp_ca_timeout(conn);
+	}
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	/* The peer may drop data it reported, RFC 2018 ch 8 */
+	conn->sacked_cnt = 0;
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1435,6 +2125,22 @@ static void tcp_send_ack(struct k_work *work)
 	k_mutex_unlock(&conn->lock);
 }
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+static void tcp_send_delayed_ack(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct tcp *conn = CONTAINER_OF(dwork, struct tcp, delayed_ack_timer);
+
+	k_mutex_lock(&conn->lock, K_FOREVER);
+
+	if (conn->ack_pending_len > 0) {
+		tcp_out(conn, ACK);
+	}
+
+	k_mutex_unlock(&conn->lock);
+}
+#endif
+
 static void tcp_conn_ref(struct tcp *conn)
 {
 	int ref_count = atomic_inc(&conn->ref_count) + 1;
@@ -1501,6 +2207,11 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->persist_timer, tcp_send_zwp);
 	k_work_init_delayable(&conn->ack_timer, tcp_send_ack);
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+	k_work_init_delayable(&conn->delayed_ack_timer, tcp_send_delayed_ack);
+	conn->ack_quick = ACK_QUICK_SEGMENTS;
+#endif
+
 	tcp_conn_ref(conn);
 
 	sys_slist_append(&tcp_conns, &conn->next);
@@ -1541,38 +2252,27 @@ out:
 	return ret;
 }
 
-static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
-			     enum pkt_addr which)
+static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
-	union tcp_endpoint ep_tmp;
+	union tcp_endpoint src;
+	union tcp_endpoint dst;
+	struct tcp *conn;
+	size_t len;
 
-	if (tcp_endpoint_set(&ep_tmp, pkt, which) < 0) {
-		return false;
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
 	}
 
-	return !memcmp(ep, &ep_tmp, tcp_endpoint_len(ep->sa.sa_family));
-}
+	len = tcp_endpoint_len(src.sa.sa_family);
 
-static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
-{
-	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
-		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
-}
-
-static struct tcp *tcp_conn_search(struct net_pkt *pkt)
-{
-	bool found = false;
-	struct tcp *conn;
-	struct tcp *tmp;
-
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&tcp_conns, conn, tmp, next) {
-		found = tcp_conn_cmp(conn, pkt);
-		if (found) {
-			break;
+	SYS_SLIST_FOR_EACH_CONTAINER(tcp_conn_hash_list(&src, &dst), conn, hash_node) {
+		if (!memcmp(&conn->src, &src, len) && !memcmp(&conn->dst, &dst, len)) {
+			return conn;
 		}
 	}
 
-	return found ? conn : NULL;
+	return NULL;
 }
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
@@ -1751,6 +2451,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr),
@@ -1981,9 +2683,53 @@ static void tcp_queue_recv_data(struct tcp *conn, struct net_pkt *pkt,
 	}
 }
 
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+/* Account len newly received bytes and tell whether their acknowledgement
+ * may wait for the ACK timer, as described in RFC 5681 chapter 4.2. At least
+ * every Nth full sized segment is acknowledged, as is data filling a hole or
+ * arriving while out-of-order data is queued, so that the peer can recover.
+ */
+static bool tcp_ack_delayed(struct tcp *conn, size_t len, bool hole_filled)
+{
+	conn->ack_pending_len += len;
+
+	if (conn->ack_quick > 0) {
+		conn->ack_quick--;
+		return false;
+	}
+
+	if (hole_filled || (CONFIG_NET_TCP_RECV_QUEUE_TIMEOUT &&
+			    !net_pkt_is_empty(conn->queue_recv_data))) {
+		return false;
+	}
+
+	if (conn->ack_pending_len >=
+	    CONFIG_NET_TCP_DELAYED_ACK_SEGMENTS * conn_mss(conn)) {
+		return false;
+	}
+
+	/* Keeps the deadline set by the oldest unacknowledged segment */
+	k_work_schedule_for_queue(&tcp_work_q, &conn->delayed_ack_timer,
+				  K_MSEC(CONFIG_NET_TCP_DELAYED_ACK_TIMEOUT));
+
+	return true;
+}
+#else
+static inline bool tcp_ack_delayed(struct tcp *conn, size_t len,
+				   bool hole_filled)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(len);
+	ARG_UNUSED(hole_filled);
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_DELAYED_ACK */
+
 static enum net_verdict tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
 					  size_t *len)
 {
+	size_t data_len = *len;
 	enum net_verdict ret;
 
 	if (*len == 0) {
@@ -2001,6 +2747,8 @@ static enum net_verdict tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
 	if (tcp_short_window(conn)) {
 		k_work_schedule_for_queue(&tcp_work_q, &conn->ack_timer,
 					  ACK_DELAY);
+	} else if (tcp_ack_delayed(conn, *len, *len != data_len)) {
+		NET_DBG("conn: %p, delaying ACK", conn);
 	} else {
 		k_work_cancel_delayable(&conn->ack_timer);
 		tcp_out(conn, ACK);
@@ -2069,6 +2817,42 @@ static void tcp_check_sock_options(struct tcp *conn)
 	}
 }
 
+/* Pick the window scale we advertise, the smallest one fitting our largest
+ * receive window in the 16 bits of the window field.
+ */
+static void tcp_wscale_init(struct tcp *conn)
+{
+	uint8_t shift = 0;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE)) {
+		return;
+	}
+
+	while (shift < NET_TCP_MAX_WINDOW_SCALE &&
+	       (conn->recv_win_max >> shift) > UINT16_MAX) {
+		shift++;
+	}
+
+	conn->rcv_wscale = shift;
+}
+
+/* Enable the options of the handshake both ends support, from the options
+ * of the received SYN or SYN-ACK.
+ */
+static void tcp_syn_options_apply(struct tcp *conn)
+{
+	if (IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) &&
+	    conn->recv_options.wnd_found) {
+		conn->wscale_ok = true;
+		conn->snd_wscale = conn->recv_options.window;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_TCP_SACK) &&
+	    conn->recv_options.sack_perm_found) {
+		conn->sack_ok = true;
+	}
+}
+
 /* TCP state machine, everything happens here */
 static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 {
@@ -2122,8 +2906,13 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 		goto next_state;
 	}
 
+#ifdef CONFIG_NET_TCP_SACK
+	conn->recv_options.sack_cnt = 0;
+#endif
+
 	if (tcp_options_len && !tcp_options_check(&conn->recv_options, pkt,
-						  tcp_options_len)) {
+						  tcp_options_len,
+						  th_flags(th) & SYN)) {
 		NET_DBG("DROP: Invalid TCP option list");
 		tcp_out(conn, RST);
 		do_close = true;
@@ -2148,6 +2937,10 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 
 	if (th) {
 		conn->send_win = ntohs(th_win(th));
+		if (conn->wscale_ok && !(th_flags(th) & SYN)) {
+			conn->send_win <<= conn->snd_wscale;
+		}
+
 		if (conn->send_win > conn->send_win_max) {
 			NET_DBG("Lowering send window from %u to %u",
 				conn->send_win, conn->send_win_max);
@@ -2178,7 +2971,11 @@ next_state:
 
 	switch (conn->state) {
 	case TCP_LISTEN:
+		tcp_wscale_init(conn);
+
 		if (FL(&fl, ==, SYN)) {
+			tcp_syn_options_apply(conn);
+
 			/* Make sure our MSS is also sent in the ACK */
 			conn->send_options.mss_found = true;
 			conn_ack(conn, th_seq(th) + 1); /* capture peer's isn */
@@ -2207,6 +3004,9 @@ next_state:
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
 			next = TCP_ESTABLISHED;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+			tcp_ca_init(conn);
+#endif
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -2246,6 +3046,10 @@ next_state:
 		 */
 		if (FL(&fl, &, SYN | ACK, th && th_ack(th) == conn->seq)) {
 			tcp_send_timer_cancel(conn);
+			tcp_syn_options_apply(conn);
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+			tcp_ca_init(conn);
+#endif
 			conn_ack(conn, th_seq(th) + 1);
 			if (len) {
 				verdict = tcp_data_get(conn, pkt, &len);
@@ -2328,18 +3132,15 @@ next_state:
 				conn->dup_ack_cnt = 0;
 			}
 
-			/* Only do fast retransmit when not already in a resend state */
-			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
-			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
-
-				conn->unacked_len = 0;
-
-				(void)tcp_send_data(conn);
+#ifdef CONFIG_NET_TCP_SACK
+			if (conn->sack_ok) {
+				tcp_sack_update(conn);
+			}
+#endif
 
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+			/* Only do fast retransmit when not already in a resend state */
+			if ((conn->data_mode == TCP_DATA_MODE_SEND) && (len == 0)) {
+				tcp_dup_ack(conn);
 			}
 		}
 #endif
@@ -2381,6 +3182,15 @@ next_state:
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#ifdef CONFIG_NET_TCP_SACK
+			if (conn->sack_ok) {
+				tcp_sack_update(conn);
+			}
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+			tcp_ca_acked(conn, len_acked);
+#endif
+
 			conn_send_data_dump(conn);
 
 			if (!k_work_delayable_remaining_get(
@@ -2964,6 +3774,10 @@ int net_tcp_connect(struct net_context *context,
 		ret = -EPROTONOSUPPORT;
 	}
 
+	if (ret == 0) {
+		tcp_conn_hash_add(conn);
+	}
+
 	if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 	      IS_ENABLED(CONFIG_NET_TEST))) {
 		conn->seq = tcp_init_isn(&conn->src.sa, &conn->dst.sa);
@@ -3130,7 +3944,9 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* The checksum of each segment is computed once it is cut */
+	if (net_pkt_gso_size(pkt) == 0U &&
+	    net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -3180,6 +3996,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -3302,6 +4119,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_add(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
@@ -129,7 +129,7 @@
 #define conn_send_data_dump(_conn)                                             \
 	({                                                                     \
 		NET_DBG("conn: %p total=%zd, unacked_len=%d, "                 \
-			"send_win=%hu, mss=%hu",                               \
+			"send_win=%u, mss=%hu",                                \
 			(_conn), net_pkt_get_len((_conn)->send_data),          \
 			_conn->unacked_len, _conn->send_win,                   \
 			(uint16_t)conn_mss((_conn)));                          \
@@ -209,22 +209,44 @@ union tcp_endpoint {
 #define NET_TCP_NOP_OPT          1
 #define NET_TCP_MSS_OPT          2
 #define NET_TCP_WINDOW_SCALE_OPT 3
+#define NET_TCP_SACK_PERM_OPT    4
+#define NET_TCP_SACK_OPT         5
 
 /* TCP Option sizes */
 #define NET_TCP_END_SIZE          1
 #define NET_TCP_NOP_SIZE          1
 #define NET_TCP_MSS_SIZE          4
 #define NET_TCP_WINDOW_SCALE_SIZE 3
+#define NET_TCP_SACK_PERM_SIZE    2
+#define NET_TCP_SACK_BLOCK_SIZE   8
+
+/* Largest window scale shift, RFC 7323 ch 2.3 */
+#define NET_TCP_MAX_WINDOW_SCALE 14
+
+/* SACK blocks fitting in the option space, and kept in the scoreboard */
+#define NET_TCP_SACK_BLOCKS 4
+
+struct tcp_sack_block {
+	uint32_t start;
+	uint32_t end;
+};
 
 struct tcp_options {
 	uint16_t mss;
 	uint16_t window;
+#ifdef CONFIG_NET_TCP_SACK
+	struct tcp_sack_block sack[NET_TCP_SACK_BLOCKS];
+	uint8_t sack_cnt;
+#endif
 	bool mss_found : 1;
 	bool wnd_found : 1;
+	bool sack_perm_found : 1;
 };
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+	sys_snode_t hash_node; /* node in the table of connected end points */
+	sys_slist_t *hash_list; /* bucket of hash_node, NULL if not hashed */
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_pkt *queue_recv_data;
@@ -267,10 +289,35 @@ struct tcp { /* TCP connection */
 	enum tcp_data_mode data_mode;
 	uint32_t seq;
 	uint32_t ack;
-	uint16_t recv_win_max;
-	uint16_t recv_win;
-	uint16_t send_win_max;
-	uint16_t send_win;
+	uint32_t recv_win_max;
+	uint32_t recv_win;
+	uint32_t send_win_max;
+	uint32_t send_win;
+#ifdef CONFIG_NET_TCP_CONGESTION_AVOIDANCE
+	struct {
+		uint32_t cwnd;
+		uint32_t ssthresh;
+		uint32_t recover; /* last byte sent when the loss was detected */
+		uint32_t acked; /* bytes acked since the last window increase */
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+		uint32_t w_max; /* window before the last reduction */
+		uint32_t epoch_start; /* uptime in ms, 0 until the first ack */
+		uint32_t k; /* ms from epoch_start until cwnd is back to w_max */
+#endif
+		bool in_recovery : 1;
+	} ca;
+#endif
+#ifdef CONFIG_NET_TCP_SACK
+	/* Data above seq the peer has selectively acknowledged, sorted */
+	struct tcp_sack_block sacked[NET_TCP_SACK_BLOCKS];
+	uint32_t rexmit_next; /* where to look for the next hole to resend */
+	uint8_t sacked_cnt;
+#endif
+#ifdef CONFIG_NET_TCP_DELAYED_ACK
+	struct k_work_delayable delayed_ack_timer;
+	uint32_t ack_pending_len; /* received bytes not acknowledged yet */
+	uint8_t ack_quick; /* segments still to be acknowledged at once */
+#endif
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
 #endif
@@ -279,10 +326,14 @@ struct tcp { /* TCP connection */
 	uint8_t dup_ack_cnt;
 #endif
 	uint8_t zwp_retries;
+	uint8_t snd_wscale : 4; /* shift of the windows the peer advertises */
+	uint8_t rcv_wscale : 4; /* shift of the windows we advertise */
 	bool in_retransmission : 1;
 	bool in_connect : 1;
 	bool in_close : 1;
 	bool tcp_nodelay : 1;
+	bool wscale_ok : 1;
+	bool sack_ok : 1;
 };
 
 #define _flags(_fl, _op, _mask, _cond)					\
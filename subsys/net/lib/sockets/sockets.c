@@ -43,13 +43,14 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 		void *obj;				     \
 		int ret;				     \
 							     \
-		obj = get_sock_vtable(sock, &vtable, &lock); \
+		obj = get_sock_ref(sock, &vtable, &lock);    \
 		if (obj == NULL) {			     \
 			errno = EBADF;			     \
 			return -1;			     \
 		}					     \
 							     \
 		if (vtable->fn == NULL) {		     \
+			z_fd_put(sock);			     \
 			errno = EOPNOTSUPP;		     \
 			return -1;			     \
 		}					     \
@@ -60,21 +61,15 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 							     \
 		k_mutex_unlock(lock);                        \
 							     \
+		z_fd_put(sock);				     \
+							     \
 		return ret;				     \
 	} while (0)
 
 const struct socket_op_vtable sock_fd_op_vtable;
 
-static inline void *get_sock_vtable(int sock,
-				    const struct socket_op_vtable **vtable,
-				    struct k_mutex **lock)
+static inline void *check_sock_ctx(int sock, void *ctx)
 {
-	void *ctx;
-
-	ctx = z_get_fd_obj_and_vtable(sock,
-				      (const struct fd_op_vtable **)vtable,
-				      lock);
-
 #ifdef CONFIG_USERSPACE
 	if (ctx != NULL && z_is_in_user_syscall()) {
 		struct z_object *zo;
@@ -102,6 +97,45 @@ static inline void *get_sock_vtable(int sock,
 	return ctx;
 }
 
+static inline void *get_sock_vtable(int sock,
+				    const struct socket_op_vtable **vtable,
+				    struct k_mutex **lock)
+{
+	void *ctx;
+
+	ctx = z_get_fd_obj_and_vtable(sock,
+				      (const struct fd_op_vtable **)vtable,
+				      lock);
+
+	return check_sock_ctx(sock, ctx);
+}
+
+/* Like get_sock_vtable(), but holds a reference to the descriptor, which
+ * must be dropped with z_fd_put(), so that it cannot be closed and reused
+ * while the call is in progress.
+ */
+static inline void *get_sock_ref(int sock,
+				 const struct socket_op_vtable **vtable,
+				 struct k_mutex **lock)
+{
+	void *ctx;
+
+	if (z_fd_get(sock, &ctx, (const struct fd_op_vtable **)vtable,
+		     lock) < 0) {
+		ctx = NULL;
+	}
+
+	if (check_sock_ctx(sock, ctx) == NULL) {
+		if (ctx != NULL) {
+			z_fd_put(sock);
+		}
+
+		return NULL;
+	}
+
+	return ctx;
+}
+
 void *z_impl_zsock_get_context_object(int sock)
 {
 	const struct socket_op_vtable *ignored;
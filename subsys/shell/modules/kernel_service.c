@@ -66,6 +66,18 @@ static int cmd_kernel_cycles(const struct shell *sh,
 
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 	defined(CONFIG_THREAD_MONITOR)
+static int64_t thread_timeout_ticks(const struct k_thread *thread)
+{
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	/* The timing wheel keeps the absolute expiry tick in dticks,
+	 * print the ticks left like the delta list does.
+	 */
+	return (int64_t)k_thread_timeout_remaining_ticks(thread);
+#else
+	return (int64_t)thread->base.timeout.dticks;
+#endif
+}
+
 static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 {
 	struct k_thread *thread = (struct k_thread *)cthread;
@@ -92,7 +104,7 @@ static void shell_tdata_dump(const struct k_thread *cthread, void *user_data)
 	shell_print(sh, "\toptions: 0x%x, priority: %d timeout: %" PRId64,
 		      thread->base.user_options,
 		      thread->base.prio,
-		      (int64_t)thread->base.timeout.dticks);
+		      thread_timeout_ticks(thread));
 	shell_print(sh, "\tstate: %s, entry: %p",
 		    k_thread_state_str(thread, state_str, sizeof(state_str)),
 		    thread->entry.pEntry);
@@ -141,6 +141,19 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_work_submit_exit(work, ret)                                               \
 	SEGGER_SYSVIEW_RecordEndCallU32(TID_WORK_SUBMIT, (uint32_t)ret)
 
+#define sys_port_trace_k_work_submit_batch_to_queue_enter(queue, works, n)                         \
+	SEGGER_SYSVIEW_RecordU32x3(TID_WORK_SUBMIT_BATCH_TO_QUEUE, (uint32_t)(uintptr_t)queue,     \
+				   (uint32_t)(uintptr_t)works, (uint32_t)n)
+
+#define sys_port_trace_k_work_submit_batch_to_queue_exit(queue, works, n, ret)                     \
+	SEGGER_SYSVIEW_RecordEndCallU32(TID_WORK_SUBMIT_BATCH_TO_QUEUE, (uint32_t)ret)
+
+#define sys_port_trace_k_work_submit_batch_enter(works, n)                                         \
+	SEGGER_SYSVIEW_RecordU32x2(TID_WORK_SUBMIT_BATCH, (uint32_t)(uintptr_t)works, (uint32_t)n)
+
+#define sys_port_trace_k_work_submit_batch_exit(works, n, ret)                                     \
+	SEGGER_SYSVIEW_RecordEndCallU32(TID_WORK_SUBMIT_BATCH, (uint32_t)ret)
+
 #define sys_port_trace_k_work_flush_enter(work)                                                    \
 	SEGGER_SYSVIEW_RecordU32(TID_WORK_FLUSH, (uint32_t)(uintptr_t)work)
 
@@ -309,6 +322,39 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_mutex_unlock_exit(mutex, ret)                                             \
 	SEGGER_SYSVIEW_RecordEndCallU32(TID_MUTEX_UNLOCK, (uint32_t)ret)
 
+#define sys_port_trace_k_rwlock_init(rwlock, ret)                                                  \
+	SEGGER_SYSVIEW_RecordU32x2(TID_RWLOCK_INIT, (uint32_t)(uintptr_t)rwlock, (int32_t)ret)
+
+#define sys_port_trace_k_rwlock_read_lock_enter(rwlock, timeout)                                   \
+	SEGGER_SYSVIEW_RecordU32x2(TID_RWLOCK_READ_LOCK, (uint32_t)(uintptr_t)rwlock,              \
+				   (uint32_t)timeout.ticks)
+
+#define sys_port_trace_k_rwlock_read_lock_blocking(rwlock, timeout)
+
+#define sys_port_trace_k_rwlock_read_lock_exit(rwlock, timeout, ret)                               \
+	SEGGER_SYSVIEW_RecordEndCallU32(TID_RWLOCK_READ_LOCK, (int32_t)ret)
+
+#define sys_port_trace_k_rwlock_read_unlock_enter(rwlock)                                          \
+	SEGGER_SYSVIEW_RecordU32(TID_RWLOCK_READ_UNLOCK, (uint32_t)(uintptr_t)rwlock)
+
+#define sys_port_trace_k_rwlock_read_unlock_exit(rwlock, ret)                                      \
+	SEGGER_SYSVIEW_RecordEndCallU32(TID_RWLOCK_READ_UNLOCK, (uint32_t)ret)
+
+#define sys_port_trace_k_rwlock_write_lock_enter(rwlock, timeout)                                  \
+	SEGGER_SYSVIEW_RecordU32x2(TID_RWLOCK_WRITE_LOCK, (uint32_t)(uintptr_t)rwlock,             \
+				   (uint32_t)timeout.ticks)
+
+#define sys_port_trace_k_rwlock_write_lock_blocking(rwlock, timeout)
+
+#define sys_port_trace_k_rwlock_write_lock_exit(rwlock, timeout, ret)                              \
+	SEGGER_SYSVIEW_RecordEndCallU32(TID_RWLOCK_WRITE_LOCK, (int32_t)ret)
+
+#define sys_port_trace_k_rwlock_write_unlock_enter(rwlock)                                         \
+	SEGGER_SYSVIEW_RecordU32(TID_RWLOCK_WRITE_UNLOCK, (uint32_t)(uintptr_t)rwlock)
+
+#define sys_port_trace_k_rwlock_write_unlock_exit(rwlock, ret)                                     \
+	SEGGER_SYSVIEW_RecordEndCallU32(TID_RWLOCK_WRITE_UNLOCK, (uint32_t)ret)
+
 #define sys_port_trace_k_condvar_init(condvar, ret)                                                \
 	SEGGER_SYSVIEW_RecordU32(TID_CONDVAR_INIT, (uint32_t)(uintptr_t)condvar)
 
@@ -499,6 +545,12 @@ void sys_trace_thread_info(struct k_thread *thread);
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)
 #define sys_port_trace_k_msgq_get_blocking(msgq, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_put_n_enter(msgq, n, timeout)
+#define sys_port_trace_k_msgq_put_n_blocking(msgq, n, timeout)
+#define sys_port_trace_k_msgq_put_n_exit(msgq, n, timeout, ret)
+#define sys_port_trace_k_msgq_get_n_enter(msgq, n, timeout)
+#define sys_port_trace_k_msgq_get_n_blocking(msgq, n, timeout)
+#define sys_port_trace_k_msgq_get_n_exit(msgq, n, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)
 
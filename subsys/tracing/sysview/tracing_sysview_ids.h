@@ -128,6 +128,14 @@ extern "C" {
 #define TID_WORK_SUBMIT_TO_QUEUE (100u + TID_OFFSET)
 #define TID_WORK_QUEUE_UNPLUG (101u + TID_OFFSET)
 #define TID_WORK_QUEUE_INIT (102u + TID_OFFSET)
+#define TID_WORK_SUBMIT_BATCH (103u + TID_OFFSET)
+#define TID_WORK_SUBMIT_BATCH_TO_QUEUE (104u + TID_OFFSET)
+
+#define TID_RWLOCK_INIT (105u + TID_OFFSET)
+#define TID_RWLOCK_READ_LOCK (106u + TID_OFFSET)
+#define TID_RWLOCK_READ_UNLOCK (107u + TID_OFFSET)
+#define TID_RWLOCK_WRITE_LOCK (108u + TID_OFFSET)
+#define TID_RWLOCK_WRITE_UNLOCK (109u + TID_OFFSET)
 
 #define TID_FIFO_INIT (110u + TID_OFFSET)
 #define TID_FIFO_CANCEL_WAIT (111u + TID_OFFSET)
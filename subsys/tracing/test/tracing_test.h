@@ -69,6 +69,10 @@
 #define sys_port_trace_k_work_submit_to_queue_exit(queue, work, ret)
 #define sys_port_trace_k_work_submit_enter(work)
 #define sys_port_trace_k_work_submit_exit(work, ret)
+#define sys_port_trace_k_work_submit_batch_to_queue_enter(queue, works, n)
+#define sys_port_trace_k_work_submit_batch_to_queue_exit(queue, works, n, ret)
+#define sys_port_trace_k_work_submit_batch_enter(works, n)
+#define sys_port_trace_k_work_submit_batch_exit(works, n, ret)
 #define sys_port_trace_k_work_flush_enter(work)
 #define sys_port_trace_k_work_flush_blocking(work, timeout)
 #define sys_port_trace_k_work_flush_exit(work, ret)
@@ -139,6 +143,18 @@
 #define sys_port_trace_k_mutex_unlock_enter(mutex) sys_trace_k_mutex_unlock_enter(mutex)
 #define sys_port_trace_k_mutex_unlock_exit(mutex, ret) sys_trace_k_mutex_unlock_exit(mutex, ret)
 
+#define sys_port_trace_k_rwlock_init(rwlock, ret)
+#define sys_port_trace_k_rwlock_read_lock_enter(rwlock, timeout)
+#define sys_port_trace_k_rwlock_read_lock_blocking(rwlock, timeout)
+#define sys_port_trace_k_rwlock_read_lock_exit(rwlock, timeout, ret)
+#define sys_port_trace_k_rwlock_read_unlock_enter(rwlock)
+#define sys_port_trace_k_rwlock_read_unlock_exit(rwlock, ret)
+#define sys_port_trace_k_rwlock_write_lock_enter(rwlock, timeout)
+#define sys_port_trace_k_rwlock_write_lock_blocking(rwlock, timeout)
+#define sys_port_trace_k_rwlock_write_lock_exit(rwlock, timeout, ret)
+#define sys_port_trace_k_rwlock_write_unlock_enter(rwlock)
+#define sys_port_trace_k_rwlock_write_unlock_exit(rwlock, ret)
+
 #define sys_port_trace_k_condvar_init(condvar, ret) sys_trace_k_condvar_init(condvar, ret)
 #define sys_port_trace_k_condvar_signal_enter(condvar) sys_trace_k_condvar_signal_enter(condvar)
 #define sys_port_trace_k_condvar_signal_blocking(condvar, timeout)                                 \
@@ -315,6 +331,18 @@
 	sys_trace_k_msgq_get_blocking(msgq, data, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)                                         \
 	sys_trace_k_msgq_get_exit(msgq, data, timeout, ret)
+#define sys_port_trace_k_msgq_put_n_enter(msgq, n, timeout)                                        \
+	sys_trace_k_msgq_put_n_enter(msgq, data, n, timeout)
+#define sys_port_trace_k_msgq_put_n_blocking(msgq, n, timeout)                                     \
+	sys_trace_k_msgq_put_n_blocking(msgq, data, n, timeout)
+#define sys_port_trace_k_msgq_put_n_exit(msgq, n, timeout, ret)                                    \
+	sys_trace_k_msgq_put_n_exit(msgq, data, n, timeout, ret)
+#define sys_port_trace_k_msgq_get_n_enter(msgq, n, timeout)                                        \
+	sys_trace_k_msgq_get_n_enter(msgq, data, n, timeout)
+#define sys_port_trace_k_msgq_get_n_blocking(msgq, n, timeout)                                     \
+	sys_trace_k_msgq_get_n_blocking(msgq, data, n, timeout)
+#define sys_port_trace_k_msgq_get_n_exit(msgq, n, timeout, ret)                                    \
+	sys_trace_k_msgq_get_n_exit(msgq, data, n, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret) sys_trace_k_msgq_peek(msgq, data, ret)
 #define sys_port_trace_k_msgq_purge(msgq) sys_trace_k_msgq_purge(msgq)
 
@@ -651,6 +679,18 @@ void sys_trace_k_msgq_put_exit(struct k_msgq *msgq, const void *data, k_timeout_
 void sys_trace_k_msgq_get_enter(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 void sys_trace_k_msgq_get_blocking(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 void sys_trace_k_msgq_get_exit(struct k_msgq *msgq, const void *data, k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_put_n_enter(struct k_msgq *msgq, const void *data, uint32_t n,
+				  k_timeout_t timeout);
+void sys_trace_k_msgq_put_n_blocking(struct k_msgq *msgq, const void *data, uint32_t n,
+				     k_timeout_t timeout);
+void sys_trace_k_msgq_put_n_exit(struct k_msgq *msgq, const void *data, uint32_t n,
+				 k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_get_n_enter(struct k_msgq *msgq, const void *data, uint32_t n,
+				  k_timeout_t timeout);
+void sys_trace_k_msgq_get_n_blocking(struct k_msgq *msgq, const void *data, uint32_t n,
+				     k_timeout_t timeout);
+void sys_trace_k_msgq_get_n_exit(struct k_msgq *msgq, const void *data, uint32_t n,
+				 k_timeout_t timeout, int ret);
 void sys_trace_k_msgq_peek(struct k_msgq *msgq, void *data, int ret);
 void sys_trace_k_msgq_purge(struct k_msgq *msgq);
 
@@ -91,6 +91,10 @@ void sys_trace_idle(void);
 #define sys_port_trace_k_work_submit_to_queue_exit(queue, work, ret)
 #define sys_port_trace_k_work_submit_enter(work)
 #define sys_port_trace_k_work_submit_exit(work, ret)
+#define sys_port_trace_k_work_submit_batch_to_queue_enter(queue, works, n)
+#define sys_port_trace_k_work_submit_batch_to_queue_exit(queue, works, n, ret)
+#define sys_port_trace_k_work_submit_batch_enter(works, n)
+#define sys_port_trace_k_work_submit_batch_exit(works, n, ret)
 #define sys_port_trace_k_work_flush_enter(work)
 #define sys_port_trace_k_work_flush_blocking(work, timeout)
 #define sys_port_trace_k_work_flush_exit(work, ret)
@@ -162,6 +166,18 @@ void sys_trace_idle(void);
 #define sys_port_trace_k_mutex_unlock_enter(mutex)
 #define sys_port_trace_k_mutex_unlock_exit(mutex, ret)
 
+#define sys_port_trace_k_rwlock_init(rwlock, ret)
+#define sys_port_trace_k_rwlock_read_lock_enter(rwlock, timeout)
+#define sys_port_trace_k_rwlock_read_lock_blocking(rwlock, timeout)
+#define sys_port_trace_k_rwlock_read_lock_exit(rwlock, timeout, ret)
+#define sys_port_trace_k_rwlock_read_unlock_enter(rwlock)
+#define sys_port_trace_k_rwlock_read_unlock_exit(rwlock, ret)
+#define sys_port_trace_k_rwlock_write_lock_enter(rwlock, timeout)
+#define sys_port_trace_k_rwlock_write_lock_blocking(rwlock, timeout)
+#define sys_port_trace_k_rwlock_write_lock_exit(rwlock, timeout, ret)
+#define sys_port_trace_k_rwlock_write_unlock_enter(rwlock)
+#define sys_port_trace_k_rwlock_write_unlock_exit(rwlock, ret)
+
 #define sys_port_trace_k_condvar_init(condvar, ret)
 #define sys_port_trace_k_condvar_signal_enter(condvar)
 #define sys_port_trace_k_condvar_signal_blocking(condvar, timeout)
@@ -251,6 +267,12 @@ void sys_trace_idle(void);
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)
 #define sys_port_trace_k_msgq_get_blocking(msgq, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_put_n_enter(msgq, n, timeout)
+#define sys_port_trace_k_msgq_put_n_blocking(msgq, n, timeout)
+#define sys_port_trace_k_msgq_put_n_exit(msgq, n, timeout, ret)
+#define sys_port_trace_k_msgq_get_n_enter(msgq, n, timeout)
+#define sys_port_trace_k_msgq_get_n_blocking(msgq, n, timeout)
+#define sys_port_trace_k_msgq_get_n_exit(msgq, n, timeout, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)
 
@@ -0,0 +1,368 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/base64.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+/* Cycles needed to convert a buffer to and from base64 and hex digits,
+ * with the word at a time conversions and with the byte at a time loops
+ * they replaced, then with the streaming base64 encoder and decoder.
+ * The output of every run is checked against the one of the byte at a
+ * time loops.
+ */
+
+#define DATA_SIZE  1024
+#define CHUNK_SIZE 64
+#define REPS	   20
+
+static uint8_t data[DATA_SIZE];
+static uint8_t b64[DATA_SIZE / 3 * 4 + 5];
+static uint8_t b64_out[sizeof(b64)];
+/* Room for a whole last group, as required by the streaming decoder */
+static uint8_t out[DIV_ROUND_UP(DATA_SIZE, 3) * 3];
+static char hex[2 * DATA_SIZE + 1];
+static size_t b64_len;
+
+/* Reference outputs, the legacy encoder only handles whole groups */
+#define B64_REF_LEN (DATA_SIZE / 3 * 4)
+static uint8_t b64_ref[B64_REF_LEN];
+static char hex_ref[sizeof(hex)];
+
+static int error_count;
+
+static const uint8_t legacy_enc_map[64] =
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static uint8_t legacy_dec_map[128];
+
+static inline uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+/* The encoding loop of the previous implementation, without the checks */
+static void legacy_encode(uint8_t *p, const uint8_t *src, size_t slen)
+{
+	int C1, C2, C3;
+
+	for (size_t i = 0; i < slen / 3 * 3; i += 3) {
+		C1 = *src++;
+		C2 = *src++;
+		C3 = *src++;
+
+		*p++ = legacy_enc_map[(C1 >> 2) & 0x3F];
+		*p++ = legacy_enc_map[(((C1 & 3) << 4) + (C2 >> 4)) & 0x3F];
+		*p++ = legacy_enc_map[(((C2 & 15) << 2) + (C3 >> 6)) & 0x3F];
+		*p++ = legacy_enc_map[C3 & 0x3F];
+	}
+}
+
+/* The two passes of the previous implementation, checking and decoding
+ * one character at a time.
+ */
+static int legacy_decode(uint8_t *dst, const uint8_t *src, size_t slen)
+{
+	size_t i, n;
+	uint32_t j, x;
+	uint8_t *p;
+
+	for (i = n = j = 0U; i < slen; i++) {
+		x = 0U;
+		while (i < slen && src[i] == ' ') {
+			++i;
+			++x;
+		}
+
+		if (i == slen) {
+			break;
+		}
+
+		if ((slen - i) >= 2 && src[i] == '\r' && src[i + 1] == '\n') {
+			continue;
+		}
+
+		if (src[i] == '\n') {
+			continue;
+		}
+
+		if (x != 0U) {
+			return -EINVAL;
+		}
+
+		if (src[i] == '=' && ++j > 2) {
+			return -EINVAL;
+		}
+
+		if (src[i] > 127 || legacy_dec_map[src[i]] == 127U) {
+			return -EINVAL;
+		}
+
+		if (legacy_dec_map[src[i]] < 64 && j != 0U) {
+			return -EINVAL;
+		}
+
+		n++;
+	}
+
+	for (j = 3U, n = x = 0U, p = dst; i > 0; i--, src++) {
+		if (*src == '\r' || *src == '\n' || *src == ' ') {
+			continue;
+		}
+
+		j -= (legacy_dec_map[*src] == 64U);
+		x = (x << 6) | (legacy_dec_map[*src] & 0x3F);
+
+		if (++n == 4) {
+			n = 0;
+			if (j > 0) {
+				*p++ = (uint8_t)(x >> 16);
+			}
+			if (j > 1) {
+				*p++ = (uint8_t)(x >> 8);
+			}
+			if (j > 2) {
+				*p++ = (uint8_t)(x);
+			}
+		}
+	}
+
+	return p - dst;
+}
+
+static int legacy_char2hex(char c, uint8_t *x)
+{
+	if (c >= '0' && c <= '9') {
+		*x = c - '0';
+	} else if (c >= 'a' && c <= 'f') {
+		*x = c - 'a' + 10;
+	} else if (c >= 'A' && c <= 'F') {
+		*x = c - 'A' + 10;
+	} else {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int legacy_hex2char(uint8_t x, char *c)
+{
+	if (x <= 9) {
+		*c = x + '0';
+	} else if (x <= 15) {
+		*c = x - 10 + 'a';
+	} else {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void legacy_bin2hex(const uint8_t *buf, size_t buflen, char *hex)
+{
+	for (size_t i = 0; i < buflen; i++) {
+		(void)legacy_hex2char(buf[i] >> 4, &hex[2 * i]);
+		(void)legacy_hex2char(buf[i] & 0xf, &hex[2 * i + 1]);
+	}
+
+	hex[2 * buflen] = '\0';
+}
+
+static void legacy_hex2bin(const char *hex, size_t hexlen, uint8_t *buf)
+{
+	uint8_t dec;
+
+	for (size_t i = 0; i < hexlen / 2; i++) {
+		if (legacy_char2hex(hex[2 * i], &dec) < 0) {
+			return;
+		}
+		buf[i] = dec << 4;
+
+		if (legacy_char2hex(hex[2 * i + 1], &dec) < 0) {
+			return;
+		}
+		buf[i] += dec;
+	}
+}
+
+static void b64_encode_new(void)
+{
+	size_t len;
+
+	(void)base64_encode(b64_out, sizeof(b64_out), &len, data, DATA_SIZE);
+}
+
+static void b64_encode_legacy(void)
+{
+	legacy_encode(b64_out, data, DATA_SIZE);
+}
+
+static void b64_decode_new(void)
+{
+	size_t len;
+
+	(void)base64_decode(out, sizeof(out), &len, b64, b64_len);
+}
+
+static void b64_decode_legacy(void)
+{
+	(void)legacy_decode(out, b64, b64_len);
+}
+
+static void hex_encode_new(void)
+{
+	(void)bin2hex(data, DATA_SIZE, hex, sizeof(hex));
+}
+
+static void hex_encode_legacy(void)
+{
+	legacy_bin2hex(data, DATA_SIZE, hex);
+}
+
+static void hex_decode_new(void)
+{
+	(void)hex2bin(hex, 2 * DATA_SIZE, out, sizeof(out));
+}
+
+static void hex_decode_legacy(void)
+{
+	legacy_hex2bin(hex, 2 * DATA_SIZE, out);
+}
+
+static void b64_encode_stream(void)
+{
+	struct base64_encoder enc;
+	uint8_t *p = b64_out;
+	size_t len;
+
+	base64_encoder_init(&enc);
+
+	for (size_t off = 0; off < DATA_SIZE; off += CHUNK_SIZE) {
+		(void)base64_encoder_update(&enc, p, b64_out + sizeof(b64_out) - p, &len,
+					    &data[off], MIN(CHUNK_SIZE, DATA_SIZE - off));
+		p += len;
+	}
+
+	(void)base64_encoder_finish(&enc, p, b64_out + sizeof(b64_out) - p, &len);
+}
+
+static void b64_decode_stream(void)
+{
+	struct base64_decoder dec;
+	uint8_t *p = out;
+	size_t len;
+
+	base64_decoder_init(&dec);
+
+	for (size_t off = 0; off < b64_len; off += CHUNK_SIZE) {
+		(void)base64_decoder_update(&dec, p, out + sizeof(out) - p, &len, &b64[off],
+					    MIN(CHUNK_SIZE, b64_len - off));
+		p += len;
+	}
+
+	(void)base64_decoder_finish(&dec);
+}
+
+struct codec {
+	const char *name;
+	const char *first;
+	const char *second;
+	void (*run_first)(void);
+	void (*run_second)(void);
+	void *result;
+	const void *expected;
+	size_t len;
+};
+
+static const struct codec codecs[] = {
+	{ "base64 encode", "new", "legacy", b64_encode_new, b64_encode_legacy,
+	  b64_out, b64_ref, B64_REF_LEN },
+	{ "base64 decode", "new", "legacy", b64_decode_new, b64_decode_legacy,
+	  out, data, DATA_SIZE },
+	{ "hex encode", "new", "legacy", hex_encode_new, hex_encode_legacy,
+	  hex, hex_ref, 2 * DATA_SIZE },
+	{ "hex decode", "new", "legacy", hex_decode_new, hex_decode_legacy,
+	  out, data, DATA_SIZE },
+	{ "base64 encode", "stream", "oneshot", b64_encode_stream, b64_encode_new,
+	  b64_out, b64_ref, B64_REF_LEN },
+	{ "base64 decode", "stream", "oneshot", b64_decode_stream, b64_decode_new,
+	  out, data, DATA_SIZE },
+};
+
+static uint32_t run(const struct codec *codec, void (*fn)(void), const char *variant)
+{
+	uint64_t cycles = 0;
+	timing_t start, end;
+
+	for (int i = 0; i < REPS; i++) {
+		memset(codec->result, 0, codec->len);
+
+		start = timing_counter_get();
+		fn();
+		end = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	if (memcmp(codec->result, codec->expected, codec->len) != 0) {
+		TC_PRINT("%s %s: wrong output\n", codec->name, variant);
+		error_count++;
+	}
+
+	return (uint32_t)(cycles / REPS);
+}
+
+int main(void)
+{
+	uint32_t seed = 42;
+	uint32_t cycles, ref_cycles;
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		data[i] = xorshift32(&seed);
+	}
+
+	memset(legacy_dec_map, 127, sizeof(legacy_dec_map));
+	for (int i = 0; i < ARRAY_SIZE(legacy_enc_map); i++) {
+		legacy_dec_map[legacy_enc_map[i]] = i;
+	}
+	legacy_dec_map['='] = 64;
+
+	(void)base64_encode(b64, sizeof(b64), &b64_len, data, DATA_SIZE);
+	(void)bin2hex(data, DATA_SIZE, hex, sizeof(hex));
+
+	legacy_encode(b64_ref, data, DATA_SIZE);
+	legacy_bin2hex(data, DATA_SIZE, hex_ref);
+
+	timing_init();
+	timing_start();
+
+	printk("Codecs, %d bytes, cycles per buffer\n", DATA_SIZE);
+
+	for (int i = 0; i < ARRAY_SIZE(codecs); i++) {
+		cycles = run(&codecs[i], codecs[i].run_first, codecs[i].first);
+		ref_cycles = run(&codecs[i], codecs[i].run_second, codecs[i].second);
+
+		printk("%-14s %s %6u  %s %6u cycles\n", codecs[i].name, codecs[i].first, cycles,
+		       codecs[i].second, ref_cycles);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
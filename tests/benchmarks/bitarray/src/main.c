@@ -0,0 +1,230 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/bitarray.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+/* Cycles needed to allocate a region in a partially allocated bit array,
+ * with the word-at-a-time search of sys_bitarray_alloc() and with the
+ * per-offset region matching it replaced, then to allocate several bits
+ * at once with sys_bitarray_alloc_multi(). Both searches return the
+ * first fit, so they must agree on the region allocated.
+ */
+
+#define ARRAY_BITS 4096
+#define REPS	 100
+#define BULK	 16
+
+SYS_BITARRAY_DEFINE_STATIC(ba, ARRAY_BITS);
+
+static int error_count;
+
+struct pattern {
+	const char *name;
+	void (*fill)(unsigned int percent);
+};
+
+static inline uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+static void fill_sequential(unsigned int percent)
+{
+	(void)sys_bitarray_clear_region(&ba, ARRAY_BITS, 0);
+	(void)sys_bitarray_set_region(&ba, ARRAY_BITS * percent / 100, 0);
+}
+
+static void fill_fragmented(unsigned int percent)
+{
+	uint32_t seed = 42;
+	size_t n = 0;
+	int prev;
+
+	(void)sys_bitarray_clear_region(&ba, ARRAY_BITS, 0);
+
+	while (n < ARRAY_BITS * percent / 100) {
+		(void)sys_bitarray_test_and_set_bit(&ba, xorshift32(&seed) % ARRAY_BITS, &prev);
+		n += prev == 0 ? 1 : 0;
+	}
+}
+
+/* The search of the previous implementation: match the region at each
+ * candidate offset, from the first bundle with a clear bit, and skip
+ * past the first set bit found in the region.
+ */
+static int legacy_alloc(sys_bitarray_t *bitarray, size_t num_bits, size_t *offset)
+{
+	size_t off = 0;
+	size_t idx, end;
+	uint32_t mask, set;
+
+	for (idx = 0; idx < bitarray->num_bundles; idx++) {
+		if (~bitarray->bundles[idx] != 0U) {
+			off = idx * 32 + find_lsb_set(~bitarray->bundles[idx]) - 1;
+			break;
+		}
+	}
+
+	while (off + num_bits <= bitarray->num_bits) {
+		end = off + num_bits;
+		set = 0U;
+
+		for (idx = off / 32; idx <= (end - 1) / 32; idx++) {
+			mask = ~0U;
+			if (idx == off / 32) {
+				mask &= ~BIT_MASK(off % 32);
+			}
+
+			if ((idx == (end - 1) / 32) && (end % 32 != 0)) {
+				mask &= BIT_MASK(end % 32);
+			}
+
+			set = bitarray->bundles[idx] & mask;
+			if (set != 0U) {
+				break;
+			}
+		}
+
+		if (set == 0U) {
+			*offset = off;
+			return sys_bitarray_set_region(bitarray, num_bits, off);
+		}
+
+		off = idx * 32 + find_lsb_set(set);
+	}
+
+	return -ENOSPC;
+}
+
+/* Offset of the region allocated, SIZE_MAX if the allocation failed */
+static uint32_t run(int (*alloc)(sys_bitarray_t *, size_t, size_t *), size_t num_bits,
+		    size_t *result)
+{
+	uint64_t cycles = 0;
+	timing_t start, end;
+	size_t offset;
+	int ret;
+
+	for (int i = 0; i < REPS; i++) {
+		start = timing_counter_get();
+		ret = alloc(&ba, num_bits, &offset);
+		end = timing_counter_get();
+
+		cycles += timing_cycles_get(&start, &end);
+
+		*result = ret == 0 ? offset : SIZE_MAX;
+
+		if (ret == 0) {
+			(void)sys_bitarray_free(&ba, num_bits, offset);
+		}
+	}
+
+	return (uint32_t)(cycles / REPS);
+}
+
+static uint32_t run_bulk(bool multi, size_t *offsets)
+{
+	uint64_t cycles = 0;
+	timing_t start, end;
+	int ret = 0;
+
+	for (int i = 0; i < REPS; i++) {
+		start = timing_counter_get();
+		if (multi) {
+			ret = sys_bitarray_alloc_multi(&ba, 1, BULK, offsets);
+		} else {
+			for (int j = 0; j < BULK; j++) {
+				ret |= sys_bitarray_alloc(&ba, 1, &offsets[j]);
+			}
+		}
+		end = timing_counter_get();
+
+		if (ret != 0) {
+			TC_PRINT("bulk allocation failed (%d)\n", ret);
+			error_count++;
+			break;
+		}
+
+		cycles += timing_cycles_get(&start, &end);
+
+		for (int j = 0; j < BULK; j++) {
+			(void)sys_bitarray_free(&ba, 1, offsets[j]);
+		}
+	}
+
+	return (uint32_t)(cycles / REPS);
+}
+
+static const struct pattern patterns[] = {
+	{ "sequential", fill_sequential },
+	{ "fragmented", fill_fragmented },
+};
+
+static const unsigned int percents[] = { 50, 90, 99 };
+static const size_t sizes[] = { 1, 4, 32 };
+
+int main(void)
+{
+	size_t offsets[BULK], ref_offsets[BULK];
+	uint32_t cycles, ref_cycles;
+	size_t offset, ref_offset;
+
+	timing_init();
+	timing_start();
+
+	printk("Bit array, %d bits, cycles per allocation\n", ARRAY_BITS);
+
+	for (int i = 0; i < ARRAY_SIZE(patterns); i++) {
+		for (int j = 0; j < ARRAY_SIZE(percents); j++) {
+			patterns[i].fill(percents[j]);
+
+			for (int k = 0; k < ARRAY_SIZE(sizes); k++) {
+				cycles = run(sys_bitarray_alloc, sizes[k], &offset);
+				ref_cycles = run(legacy_alloc, sizes[k], &ref_offset);
+
+				if (offset != ref_offset) {
+					TC_PRINT("%s %u%% %zu bits: offset %zd, legacy %zd\n",
+						 patterns[i].name, percents[j], sizes[k],
+						 (ssize_t)offset, (ssize_t)ref_offset);
+					error_count++;
+				}
+
+				printk("%-10s %2u%% %2zu bits  new %6u  legacy %6u cycles\n",
+				       patterns[i].name, percents[j], sizes[k], cycles,
+				       ref_cycles);
+			}
+		}
+	}
+
+	fill_sequential(90);
+	cycles = run_bulk(true, offsets);
+	ref_cycles = run_bulk(false, ref_offsets);
+
+	if (memcmp(offsets, ref_offsets, sizeof(offsets)) != 0) {
+		TC_PRINT("bulk: multi and loop allocated different bits\n");
+		error_count++;
+	}
+
+	printk("%-10s %2u%% %dx1 bits  multi %6u  loop %6u cycles\n", "bulk", 90, BULK, cycles,
+	       ref_cycles);
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
@@ -0,0 +1,189 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Cycles needed to create a package the way logging does, calculating
+ * the length first and then storing the package, with the runtime,
+ * static and precompiled packaging, and to convert a package with
+ * string arguments to a self-contained one with and without the format
+ * string parsing done for CBPRINTF_PACKAGE_CONVERT_PTR_CHECK. Every
+ * package is then formatted and compared with the string formatted
+ * directly.
+ */
+
+#define REPS 1000
+
+#define PKG_FLAGS CBPRINTF_PACKAGE_ADD_RW_STR_POS
+
+static uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) pkg[128];
+static uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) out[256];
+static int pkg_len;
+
+/* Set at runtime, so that the arguments are not folded */
+static int i1, i2;
+static long l1;
+static long long ll1;
+static char name[16];
+static void *ptr;
+
+static char ints_str[64];
+static char strings_str[64];
+
+static int error_count;
+
+struct bench {
+	const char *fmt;
+	const char *method;
+	void (*fn)(void);
+	uint8_t *result;
+	const char *expected;
+};
+
+struct out_buffer {
+	char *buf;
+	size_t idx;
+	size_t size;
+};
+
+static int out_char(int c, void *dest)
+{
+	struct out_buffer *buf = (struct out_buffer *)dest;
+
+	if (buf->idx >= buf->size) {
+		return EOF;
+	}
+
+	buf->buf[buf->idx++] = (char)(unsigned char)c;
+
+	return (int)(unsigned char)c;
+}
+
+static void check(const struct bench *b)
+{
+	char str[64];
+	struct out_buffer buf = { .buf = str, .size = sizeof(str) - 1 };
+
+	(void)cbpprintf((cbprintf_cb)out_char, &buf, b->result);
+	str[buf.idx] = '\0';
+
+	if (strcmp(str, b->expected) != 0) {
+		TC_PRINT("%s %s: got \"%s\", expected \"%s\"\n", b->fmt,
+			 b->method, str, b->expected);
+		error_count++;
+	}
+}
+
+#define BENCH_FMT(_name, ...)								\
+static void _name##_runtime(void)							\
+{											\
+	pkg_len = cbprintf_package(NULL, 0, PKG_FLAGS, __VA_ARGS__);			\
+	(void)cbprintf_package(pkg, pkg_len, PKG_FLAGS, __VA_ARGS__);			\
+}											\
+											\
+static void _name##_static(void)							\
+{											\
+	CBPRINTF_STATIC_PACKAGE(NULL, 0, pkg_len, 0, PKG_FLAGS, __VA_ARGS__);		\
+	CBPRINTF_STATIC_PACKAGE(pkg, pkg_len, pkg_len, 0, PKG_FLAGS, __VA_ARGS__);	\
+}											\
+											\
+static void _name##_precompiled(void)							\
+{											\
+	CBPRINTF_PRECOMPILED_PACKAGE(NULL, 0, pkg_len, 0, PKG_FLAGS, __VA_ARGS__);	\
+	CBPRINTF_PRECOMPILED_PACKAGE(pkg, pkg_len, pkg_len, 0, PKG_FLAGS,		\
+				     __VA_ARGS__);					\
+}
+
+BENCH_FMT(ints, "%d %d %lx %llu", i1, i2, l1, ll1)
+BENCH_FMT(strings, "%s: %d %p %s", name, i1, ptr, name)
+
+static void convert(uint32_t flags)
+{
+	uint16_t strl[4];
+	int len;
+
+	len = cbprintf_package_copy(pkg, pkg_len, NULL, 0, flags,
+				    strl, ARRAY_SIZE(strl));
+	__ASSERT_NO_MSG(len > 0 && len <= sizeof(out));
+
+	len = cbprintf_package_copy(pkg, pkg_len, out, len, flags,
+				    strl, ARRAY_SIZE(strl));
+	__ASSERT_NO_MSG(len > 0);
+	ARG_UNUSED(len);
+}
+
+static void strings_convert(void)
+{
+	convert(CBPRINTF_PACKAGE_CONVERT_RW_STR);
+}
+
+static void strings_convert_ptr(void)
+{
+	convert(CBPRINTF_PACKAGE_CONVERT_RW_STR |
+		CBPRINTF_PACKAGE_CONVERT_PTR_CHECK);
+}
+
+static const struct bench benches[] = {
+	{ "ints", "runtime", ints_runtime, pkg, ints_str },
+	{ "ints", "static", ints_static, pkg, ints_str },
+	{ "ints", "precompiled", ints_precompiled, pkg, ints_str },
+	{ "strings", "runtime", strings_runtime, pkg, strings_str },
+	{ "strings", "static", strings_static, pkg, strings_str },
+	{ "strings", "precompiled", strings_precompiled, pkg, strings_str },
+	/* Converts the package stored by the previous case */
+	{ "strings", "convert", strings_convert, out, strings_str },
+	{ "strings", "convert_ptr", strings_convert_ptr, out, strings_str },
+};
+
+int main(void)
+{
+	timing_t start, end;
+	uint64_t cycles;
+
+	i1 = 21;
+	i2 = -5;
+	l1 = 0x1000L;
+	ll1 = 1ULL << 40;
+	ptr = &pkg_len;
+	strcpy(name, "sensor-007");
+
+	snprintk(ints_str, sizeof(ints_str), "%d %d %lx %llu", i1, i2, l1, ll1);
+	snprintk(strings_str, sizeof(strings_str), "%s: %d %p %s", name, i1, ptr,
+		 name);
+
+	timing_init();
+	timing_start();
+
+	printk("cbprintf packaging, cycles per package\n");
+
+	for (int i = 0; i < ARRAY_SIZE(benches); i++) {
+		const struct bench *b = &benches[i];
+
+		start = timing_counter_get();
+		for (int j = 0; j < REPS; j++) {
+			b->fn();
+		}
+		end = timing_counter_get();
+
+		cycles = timing_cycles_get(&start, &end);
+
+		printk("%-8s %-12s %6u cycles, %d B\n", b->fmt, b->method,
+		       (uint32_t)(cycles / REPS), pkg_len);
+
+		check(b);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
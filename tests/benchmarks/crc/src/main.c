@@ -0,0 +1,170 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+/* Throughput of the CRC routines on buffers from 16 bytes, typical of
+ * headers and flash records, up to 64 KB, typical of image checks.
+ * Every size gets the same total amount of data, so that small sizes
+ * show the per-call overhead.  Build with CONFIG_CRC_SLICING_BY_8=y
+ * and the instruction set options to compare implementations.  Every
+ * result is checked against a bit at a time computation.
+ */
+
+#define MAX_SIZE   (64 * 1024)
+#define TOTAL_SIZE (256 * 1024)
+
+static uint8_t data[MAX_SIZE];
+
+static int error_count;
+
+/* Reflected CRC-32, initial value and final XOR all ones */
+static uint32_t ref_crc32(uint32_t poly, const uint8_t *buf, size_t len)
+{
+	uint32_t crc = ~0U;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= buf[i];
+		for (int b = 0; b < 8; b++) {
+			crc = (crc >> 1) ^ ((crc & 1U) ? poly : 0U);
+		}
+	}
+
+	return ~crc;
+}
+
+static uint32_t ref_crc32_ieee(const uint8_t *buf, size_t len)
+{
+	return ref_crc32(0xEDB88320U, buf, len);
+}
+
+static uint32_t ref_crc32_c(const uint8_t *buf, size_t len)
+{
+	return ref_crc32(0x82F63B78U, buf, len);
+}
+
+static uint32_t ref_crc16_ccitt(const uint8_t *buf, size_t len)
+{
+	uint16_t crc = 0xffff;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= buf[i];
+		for (int b = 0; b < 8; b++) {
+			crc = (crc >> 1) ^ ((crc & 1U) ? 0x8408U : 0U);
+		}
+	}
+
+	return crc;
+}
+
+static uint32_t ref_crc16_itu_t(const uint8_t *buf, size_t len)
+{
+	uint16_t crc = 0xffff;
+
+	for (size_t i = 0; i < len; i++) {
+		crc ^= (uint16_t)buf[i] << 8;
+		for (int b = 0; b < 8; b++) {
+			crc = (crc << 1) ^ ((crc & 0x8000U) ? 0x1021U : 0U);
+		}
+	}
+
+	return crc;
+}
+
+static uint32_t run_crc32_ieee(const uint8_t *buf, size_t len)
+{
+	return crc32_ieee(buf, len);
+}
+
+static uint32_t run_crc32_c(const uint8_t *buf, size_t len)
+{
+	return crc32_c(0, buf, len, true, true);
+}
+
+static uint32_t run_crc16_ccitt(const uint8_t *buf, size_t len)
+{
+	return crc16_ccitt(0xffff, buf, len);
+}
+
+static uint32_t run_crc16_itu_t(const uint8_t *buf, size_t len)
+{
+	return crc16_itu_t(0xffff, buf, len);
+}
+
+static const struct {
+	const char *name;
+	uint32_t (*fn)(const uint8_t *buf, size_t len);
+	uint32_t (*ref)(const uint8_t *buf, size_t len);
+} crcs[] = {
+	{ "crc32_ieee", run_crc32_ieee, ref_crc32_ieee },
+	{ "crc32_c", run_crc32_c, ref_crc32_c },
+	{ "crc16_ccitt", run_crc16_ccitt, ref_crc16_ccitt },
+	{ "crc16_itu_t", run_crc16_itu_t, ref_crc16_itu_t },
+};
+
+static void bench(int c, size_t len)
+{
+	uint32_t reps = TOTAL_SIZE / len;
+	volatile uint32_t sink = 0U;
+	timing_t start, end;
+	uint64_t cycles, ns;
+	uint32_t crc, ref;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < reps; i++) {
+		sink ^= crcs[c].fn(data, len);
+	}
+	end = timing_counter_get();
+
+	/* Unaligned start and odd length, to cover the head and tail loops */
+	for (size_t off = 0; off < 2; off++) {
+		crc = crcs[c].fn(data + off, len - off);
+		ref = crcs[c].ref(data + off, len - off);
+		if (crc != ref) {
+			TC_PRINT("%s %zu B at %zu: 0x%08x, expected 0x%08x\n",
+				 crcs[c].name, len - off, off, crc, ref);
+			error_count++;
+		}
+	}
+
+	cycles = timing_cycles_get(&start, &end);
+	ns = timing_cycles_to_ns(cycles);
+
+	printk("%-12s %5zu B %8u cycles %5u MB/s\n", crcs[c].name, len,
+	       (uint32_t)(cycles / reps),
+	       ns == 0U ? 0U : (uint32_t)((uint64_t)TOTAL_SIZE * 1000U / ns));
+}
+
+int main(void)
+{
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 31U + (i >> 8));
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("CRC throughput, %s tables%s%s%s\n",
+	       IS_ENABLED(CONFIG_CRC_SLICING_BY_8) ? "slicing-by-8" : "nibble",
+	       IS_ENABLED(CONFIG_CRC_X86_SSE42) ? ", SSE4.2" : "",
+	       IS_ENABLED(CONFIG_CRC_X86_PCLMUL) ? ", PCLMULQDQ" : "",
+	       IS_ENABLED(CONFIG_CRC_ARM64_CRC32) ? ", ARMv8 CRC32" : "");
+
+	for (int c = 0; c < ARRAY_SIZE(crcs); c++) {
+		for (size_t len = 16; len <= MAX_SIZE; len *= 4) {
+			bench(c, len);
+		}
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
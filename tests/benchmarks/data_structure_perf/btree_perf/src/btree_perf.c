@@ -0,0 +1,278 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+#include <zephyr/sys/rb.h>
+#include <zephyr/timing/timing.h>
+
+/* Cycles per entry to insert, look up and iterate over growing sets of
+ * entries with a B+tree and with a red/black tree, and to bulk load the
+ * same entries into a B+tree.
+ */
+
+#ifdef CONFIG_ARCH_POSIX
+#define MAX_ENTRIES (1024 * 1024)
+#else
+#define MAX_ENTRIES 4096
+#endif
+
+/* Room for B+tree nodes about half full */
+#define POOL_SIZE (MAX_ENTRIES * 48)
+
+/* Multiplier spreading consecutive indexes over the whole key space */
+#define KEY_MUL 0x9E3779B97F4A7C15ULL
+
+struct rb_entry {
+	struct rbnode node;
+	uint64_t key;
+	uint64_t value;
+};
+
+static struct rb_entry entries[MAX_ENTRIES];
+static uint64_t sorted_keys[MAX_ENTRIES];
+
+static uint8_t __aligned(8) pool[POOL_SIZE];
+static size_t pool_used;
+static void *pool_free_list;
+
+static bool entry_lessthan(struct rbnode *a, struct rbnode *b)
+{
+	return CONTAINER_OF(a, struct rb_entry, node)->key <
+	       CONTAINER_OF(b, struct rb_entry, node)->key;
+}
+
+static struct rbtree rb = {
+	.lessthan_fn = entry_lessthan,
+};
+
+/* A bump allocator recycling freed nodes, so that the B+tree is not
+ * measured against the heap.
+ */
+static void *pool_alloc(void *ptr, size_t size)
+{
+	void *node;
+
+	if (size == 0) {
+		*(void **)ptr = pool_free_list;
+		pool_free_list = ptr;
+		return NULL;
+	}
+
+	if (pool_free_list != NULL) {
+		node = pool_free_list;
+		pool_free_list = *(void **)node;
+		return node;
+	}
+
+	size = ROUND_UP(size, 8);
+	if (pool_used + size > sizeof(pool)) {
+		return NULL;
+	}
+
+	node = &pool[pool_used];
+	pool_used += size;
+
+	return node;
+}
+
+static SYS_BTREE_DEFINE(bt, pool_alloc);
+
+static inline uint64_t key_of(size_t i)
+{
+	return i * KEY_MUL;
+}
+
+static struct rb_entry *rb_find(uint64_t key)
+{
+	struct rbnode *n = rb.root;
+	struct rb_entry *e;
+
+	while (n != NULL) {
+		e = CONTAINER_OF(n, struct rb_entry, node);
+		if (e->key == key) {
+			return e;
+		}
+		n = z_rb_child(n, key > e->key);
+	}
+
+	return NULL;
+}
+
+/* Worst case height of a B+tree, with a root of two children and all
+ * other nodes at their minimum fill.
+ */
+static uint8_t btree_max_height(size_t n)
+{
+	size_t min_keys = (CONFIG_BTREE_ORDER - 1) / 2;
+	size_t entries_min = 2 * min_keys;
+	uint8_t h;
+
+	if (n <= CONFIG_BTREE_ORDER) {
+		return 1;
+	}
+
+	for (h = 2; entries_min * (min_keys + 1) <= n; h++) {
+		entries_min *= min_keys + 1;
+	}
+
+	return h;
+}
+
+static int cmp_keys(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a;
+	uint64_t y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static uint32_t per_entry(timing_t *start, timing_t *end, size_t n)
+{
+	return (uint32_t)(timing_cycles_get(start, end) / n);
+}
+
+static void bench_btree(size_t n)
+{
+	struct sys_btree_iterator it;
+	timing_t start, end;
+	uint32_t insert, lookup, iterate, bulk;
+	uint64_t value, prev = 0;
+	size_t count = 0;
+	bool found = true;
+
+	start = timing_counter_get();
+	for (size_t i = 0; i < n; i++) {
+		(void)sys_btree_insert(&bt, key_of(i), i, NULL);
+	}
+	end = timing_counter_get();
+	insert = per_entry(&start, &end, n);
+
+	zassert_equal(sys_btree_size(&bt), n, "not all entries inserted");
+	zassert_true(bt.height <= btree_max_height(n), "B+tree too high");
+
+	/* Look up in an order unrelated to the insertion one */
+	start = timing_counter_get();
+	for (size_t i = 0; i < n; i++) {
+		found &= sys_btree_get(&bt, key_of((i * 7919) & (n - 1)), &value);
+	}
+	end = timing_counter_get();
+	lookup = per_entry(&start, &end, n);
+
+	zassert_true(found, "entry not found");
+
+	start = timing_counter_get();
+	SYS_BTREE_FOR_EACH(&bt, &it) {
+		found &= count == 0 || it.key > prev;
+		prev = it.key;
+		count++;
+	}
+	end = timing_counter_get();
+	iterate = per_entry(&start, &end, n);
+
+	zassert_true(found, "entries out of order");
+	zassert_equal(count, n, "wrong number of entries iterated");
+
+	sys_btree_clear(&bt, NULL, NULL);
+	pool_used = 0;
+	pool_free_list = NULL;
+
+	for (size_t i = 0; i < n; i++) {
+		sorted_keys[i] = key_of(i);
+	}
+	qsort(sorted_keys, n, sizeof(sorted_keys[0]), cmp_keys);
+
+	start = timing_counter_get();
+	zassert_ok(sys_btree_bulk_load(&bt, sorted_keys, sorted_keys, n), "bulk load failed");
+	end = timing_counter_get();
+	bulk = per_entry(&start, &end, n);
+
+	sys_btree_clear(&bt, NULL, NULL);
+	pool_used = 0;
+	pool_free_list = NULL;
+
+	TC_PRINT("btree  %8zu entries: insert %5u lookup %5u iterate %4u bulk load %4u cycles\n",
+		 n, insert, lookup, iterate, bulk);
+}
+
+static void bench_rbtree(size_t n)
+{
+	struct rbnode *node;
+	timing_t start, end;
+	uint32_t insert, lookup, iterate;
+	uint64_t prev = 0;
+	size_t count = 0;
+	bool found = true;
+
+	for (size_t i = 0; i < n; i++) {
+		entries[i].key = key_of(i);
+		entries[i].value = i;
+	}
+
+	start = timing_counter_get();
+	for (size_t i = 0; i < n; i++) {
+		rb_insert(&rb, &entries[i].node);
+	}
+	end = timing_counter_get();
+	insert = per_entry(&start, &end, n);
+
+	start = timing_counter_get();
+	for (size_t i = 0; i < n; i++) {
+		found &= rb_find(key_of((i * 7919) & (n - 1))) != NULL;
+	}
+	end = timing_counter_get();
+	lookup = per_entry(&start, &end, n);
+
+	zassert_true(found, "entry not found");
+
+	start = timing_counter_get();
+	RB_FOR_EACH(&rb, node) {
+		uint64_t key = CONTAINER_OF(node, struct rb_entry, node)->key;
+
+		found &= count == 0 || key > prev;
+		prev = key;
+		count++;
+	}
+	end = timing_counter_get();
+	iterate = per_entry(&start, &end, n);
+
+	zassert_true(found, "entries out of order");
+	zassert_equal(count, n, "wrong number of entries iterated");
+
+	rb.root = NULL;
+
+	TC_PRINT("rbtree %8zu entries: insert %5u lookup %5u iterate %4u cycles\n",
+		 n, insert, lookup, iterate);
+}
+
+/**
+ * @brief Compare the B+tree and the red/black tree
+ *
+ * @details
+ * Insert 1K entries up to the largest set the platform has room for,
+ * with keys in pseudo random order, look all of them up in another
+ * order, then iterate over them in key order, and print the average
+ * cycles per entry of each operation for both trees.
+ *
+ * @ingroup lib_btree_tests
+ *
+ * @see sys_btree_insert(), sys_btree_get(), SYS_BTREE_FOR_EACH(),
+ * rb_insert(), RB_FOR_EACH()
+ */
+ZTEST(btree_perf, test_btree_vs_rbtree)
+{
+	timing_init();
+	timing_start();
+
+	for (size_t n = 1024; n <= MAX_ENTRIES; n *= 4) {
+		bench_btree(n);
+		bench_rbtree(n);
+	}
+
+	timing_stop();
+}
+
+ZTEST_SUITE(btree_perf, NULL, NULL, NULL, NULL, NULL);
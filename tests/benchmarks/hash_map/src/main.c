@@ -0,0 +1,265 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/hash_map.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+/* Insertion latency, including the rehashing, and lookup throughput of
+ * the Hashmap backends at several load factors, then the lookup
+ * throughput of concurrent readers while a writer updates the Hashmap,
+ * for the lock-free Concurrent Robin Hood Hashmap and for an
+ * Open-Addressing Hashmap guarded by a mutex. Every lookup of a key
+ * present in the Hashmap must find it, including the ones made while
+ * the writer updates other keys, and no other lookup may.
+ */
+
+#define N_ENTRIES   1024
+#define N_READERS   4
+#define DURATION_MS 200
+#define STACK_SIZE  1024
+/* Operations between yields, as the threads may share a CPU */
+#define BATCH	    64
+
+#define BENCH_MAPS(_backend, _lf)                                                                  \
+	SYS_HASHMAP_##_backend##_DEFINE_STATIC_ADVANCED(_backend##_##_lf, sys_hash32,              \
+							SYS_HASHMAP_DEFAULT_ALLOCATOR,             \
+							SYS_HASHMAP_CONFIG(SIZE_MAX, _lf))
+
+BENCH_MAPS(SC, 50);
+BENCH_MAPS(SC, 75);
+BENCH_MAPS(SC, 90);
+BENCH_MAPS(OA_LP, 50);
+BENCH_MAPS(OA_LP, 75);
+BENCH_MAPS(OA_LP, 90);
+BENCH_MAPS(RH, 50);
+BENCH_MAPS(RH, 75);
+BENCH_MAPS(RH, 90);
+
+struct bench {
+	const char *name;
+	struct sys_hashmap *map;
+	/* Serializes all operations, for the backends that are not thread-safe */
+	struct k_mutex *mutex;
+};
+
+static K_MUTEX_DEFINE(oa_lp_mutex);
+
+static const struct bench benches[] = {
+	{ "sc", &SC_50 },
+	{ "sc", &SC_75 },
+	{ "sc", &SC_90 },
+	{ "oa_lp", &OA_LP_50 },
+	{ "oa_lp", &OA_LP_75 },
+	{ "oa_lp", &OA_LP_90 },
+	{ "rh", &RH_50 },
+	{ "rh", &RH_75 },
+	{ "rh", &RH_90 },
+};
+
+static const struct bench concurrent_benches[] = {
+	{ "oa_lp+mtx", &OA_LP_75, &oa_lp_mutex },
+	{ "rh", &RH_75 },
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, N_READERS + 1, STACK_SIZE);
+static struct k_thread threads[N_READERS + 1];
+static uint32_t ops[N_READERS + 1];
+static volatile bool stop;
+
+static atomic_t errors;
+static int error_count;
+
+static inline uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+static uint32_t kops(uint32_t n, uint64_t cycles)
+{
+	uint64_t ns = timing_cycles_to_ns(cycles);
+
+	return ns == 0U ? 0U : (uint32_t)((uint64_t)n * 1000000U / ns);
+}
+
+static void run(const struct bench *b)
+{
+	uint64_t cycles, total = 0, worst = 0;
+	uint32_t hits = 0, misses = 0;
+	int inserted = 0;
+	timing_t start, end;
+	uint32_t get_kops;
+	uint8_t load_factor;
+	uint64_t value;
+
+	for (uint64_t i = 0; i < N_ENTRIES; ++i) {
+		start = timing_counter_get();
+		inserted += sys_hashmap_insert(b->map, i, i, NULL) >= 0 ? 1 : 0;
+		end = timing_counter_get();
+
+		cycles = timing_cycles_get(&start, &end);
+		total += cycles;
+		worst = MAX(worst, cycles);
+	}
+
+	load_factor = sys_hashmap_load_factor(b->map);
+
+	start = timing_counter_get();
+	for (uint64_t i = 0; i < N_ENTRIES; ++i) {
+		hits += sys_hashmap_get(b->map, i, &value) && value == i ? 1 : 0;
+	}
+	end = timing_counter_get();
+	get_kops = kops(N_ENTRIES, timing_cycles_get(&start, &end));
+
+	start = timing_counter_get();
+	for (uint64_t i = N_ENTRIES; i < 2 * N_ENTRIES; ++i) {
+		misses += sys_hashmap_get(b->map, i, NULL) ? 0 : 1;
+	}
+	end = timing_counter_get();
+
+	if (inserted != N_ENTRIES || hits != N_ENTRIES || misses != N_ENTRIES ||
+	    sys_hashmap_size(b->map) != N_ENTRIES) {
+		TC_PRINT("%s lf %u%%: %d inserted, %u found, %u not found, size %zu\n", b->name,
+			 b->map->config->load_factor, inserted, hits, misses,
+			 sys_hashmap_size(b->map));
+		error_count++;
+	}
+
+	printk("%-9s lf %2u%%  insert %5u avg %7u max cycles  get %6u Kops/s  miss %6u Kops/s"
+	       "  (%u%% full)\n",
+	       b->name, b->map->config->load_factor, (uint32_t)(total / N_ENTRIES),
+	       (uint32_t)worst, get_kops, kops(N_ENTRIES, timing_cycles_get(&start, &end)),
+	       load_factor);
+
+	sys_hashmap_clear(b->map, NULL, NULL);
+}
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	const struct bench *b = p1;
+	uint32_t *count = p2;
+	uint32_t seed = POINTER_TO_UINT(p3);
+	uint64_t key, value;
+
+	while (!stop) {
+		if (b->mutex != NULL) {
+			(void)k_mutex_lock(b->mutex, K_FOREVER);
+		}
+
+		for (int i = 0; i < BATCH; ++i) {
+			key = xorshift32(&seed) % N_ENTRIES;
+			if (!sys_hashmap_get(b->map, key, &value) || value != key) {
+				atomic_inc(&errors);
+			}
+		}
+
+		if (b->mutex != NULL) {
+			(void)k_mutex_unlock(b->mutex);
+		}
+
+		*count += BATCH;
+		k_yield();
+	}
+}
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	const struct bench *b = p1;
+	uint32_t *count = p2;
+	uint64_t key = N_ENTRIES + N_ENTRIES / 4;
+
+	ARG_UNUSED(p3);
+
+	/* churn the keys above the ones the readers look up */
+	while (!stop) {
+		if (b->mutex != NULL) {
+			(void)k_mutex_lock(b->mutex, K_FOREVER);
+		}
+
+		for (int i = 0; i < BATCH / 2; ++i, ++key) {
+			if (sys_hashmap_insert(b->map, key, key, NULL) < 0 ||
+			    !sys_hashmap_remove(b->map, key - N_ENTRIES / 4, NULL)) {
+				atomic_inc(&errors);
+			}
+		}
+
+		if (b->mutex != NULL) {
+			(void)k_mutex_unlock(b->mutex);
+		}
+
+		*count += BATCH;
+		k_yield();
+	}
+}
+
+static void run_concurrent(const struct bench *b, int n_readers)
+{
+	uint32_t reads = 0;
+
+	for (uint64_t i = 0; i < N_ENTRIES + N_ENTRIES / 4; ++i) {
+		(void)sys_hashmap_insert(b->map, i, i, NULL);
+	}
+
+	atomic_clear(&errors);
+	stop = false;
+	for (int i = 0; i <= n_readers; ++i) {
+		ops[i] = 0;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, i == 0 ? writer : reader,
+				(void *)b, &ops[i], UINT_TO_POINTER(i * 7919 + 1), K_PRIO_PREEMPT(1),
+				0, K_NO_WAIT);
+	}
+
+	k_sleep(K_MSEC(DURATION_MS));
+	stop = true;
+
+	for (int i = 0; i <= n_readers; ++i) {
+		k_thread_join(&threads[i], K_FOREVER);
+		reads += i == 0 ? 0 : ops[i];
+	}
+
+	printk("%-9s %d readers %7u Kops/s read %6u Kops/s write\n", b->name, n_readers,
+	       reads / DURATION_MS, ops[0] / DURATION_MS);
+
+	if (atomic_get(&errors) != 0) {
+		TC_PRINT("%s %d readers: %ld failed operations\n", b->name, n_readers,
+			 (long)atomic_get(&errors));
+		error_count++;
+	}
+
+	sys_hashmap_clear(b->map, NULL, NULL);
+}
+
+int main(void)
+{
+	timing_init();
+	timing_start();
+
+	printk("Hashmap, %d entries\n", N_ENTRIES);
+
+	for (int i = 0; i < ARRAY_SIZE(benches); i++) {
+		run(&benches[i]);
+	}
+
+	timing_stop();
+
+	for (int i = 0; i < ARRAY_SIZE(concurrent_benches); i++) {
+		for (int n_readers = 1; n_readers <= N_READERS; n_readers *= 2) {
+			run_concurrent(&concurrent_benches[i], n_readers);
+		}
+	}
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
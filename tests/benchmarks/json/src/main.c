@@ -0,0 +1,357 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/data/json.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <string.h>
+
+/* Decoding and encoding throughput and peak RAM of the JSON library
+ * for a payload of the size device management servers send, comparing
+ * the contiguous-buffer APIs with the streaming parser fed in network
+ * sized chunks and the buffered encoder.  Each case runs in its own
+ * thread, so that the stack it used can be added to its buffers.  The
+ * decoded records and the encoded bytes are checked every time.
+ */
+
+#define N_RECORDS  256
+#define REPS       16
+#define STACK_SIZE 2048
+#define ENC_BUF    256
+
+struct record {
+	const char *name;
+	const char *unit;
+	struct json_obj_token reading;
+	int32_t id;
+};
+
+struct records {
+	struct record records[N_RECORDS];
+	size_t n_records;
+};
+
+static const struct json_obj_descr record_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct record, name, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct record, unit, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct record, reading, JSON_TOK_FLOAT),
+	JSON_OBJ_DESCR_PRIM(struct record, id, JSON_TOK_NUMBER),
+};
+
+static const struct json_obj_descr records_descr[] = {
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct records, records, N_RECORDS, n_records,
+				 record_descr, ARRAY_SIZE(record_descr)),
+};
+
+static struct records src, dst;
+static char names[N_RECORDS][12];
+
+/* The payload as it arrives, and the contiguous copy json_obj_parse()
+ * needs, which is also the output buffer of json_obj_encode_buf()
+ */
+static char payload[24 * 1024];
+static char contiguous[sizeof(payload)];
+static size_t payload_len;
+
+static struct json_stream_parser parser;
+/* Decoded strings: the names, units and readings */
+static char strings[N_RECORDS * 32];
+
+static K_THREAD_STACK_DEFINE(bench_stack, STACK_SIZE);
+static struct k_thread bench_thread;
+
+struct bench {
+	const char *name;
+	void (*fn)(size_t arg);
+	size_t arg;
+	/* Returns the buffer memory the case needed */
+	size_t (*ram)(size_t arg);
+	/* Checks the output of the last run */
+	void (*check)(const char *what);
+};
+
+static uint64_t cycles;
+static uint32_t writes;
+static size_t tx_len;
+static bool tx_mismatch;
+
+/* Failures of the last run, reported once it is over */
+static int64_t bad_ret;
+static bool ret_failed;
+static bool tx_failed;
+
+static int error_count;
+
+static void check_ret(int64_t ret, int64_t expected)
+{
+	if (ret != expected) {
+		bad_ret = ret;
+		ret_failed = true;
+	}
+}
+
+static void check_decoded(const char *what)
+{
+	const struct record *a, *b;
+
+	if (dst.n_records != src.n_records) {
+		TC_PRINT("%s: %zu records decoded\n", what, dst.n_records);
+		error_count++;
+		return;
+	}
+
+	for (size_t i = 0; i < src.n_records; i++) {
+		a = &src.records[i];
+		b = &dst.records[i];
+
+		if (strcmp(a->name, b->name) != 0 || strcmp(a->unit, b->unit) != 0 ||
+		    a->reading.length != b->reading.length ||
+		    memcmp(a->reading.start, b->reading.start, a->reading.length) != 0 ||
+		    a->id != b->id) {
+			TC_PRINT("%s: record %zu differs\n", what, i);
+			error_count++;
+			return;
+		}
+	}
+}
+
+static void tx_start(void)
+{
+	tx_len = 0;
+	tx_mismatch = false;
+}
+
+static void tx_check(void)
+{
+	if (tx_mismatch || tx_len != payload_len) {
+		tx_failed = true;
+	}
+}
+
+static void check_encoded(const char *what)
+{
+	if (tx_failed) {
+		TC_PRINT("%s: encoded payload differs\n", what);
+		error_count++;
+	}
+}
+
+static void obj_parse(size_t arg)
+{
+	int64_t ret;
+
+	ARG_UNUSED(arg);
+
+	memcpy(contiguous, payload, payload_len);
+	ret = json_obj_parse(contiguous, payload_len, records_descr,
+			     ARRAY_SIZE(records_descr), &dst);
+	check_ret(ret, 1);
+}
+
+static size_t obj_parse_ram(size_t arg)
+{
+	ARG_UNUSED(arg);
+
+	return payload_len;
+}
+
+static void stream_parse(size_t chunk_len)
+{
+	int64_t ret;
+
+	json_stream_obj_parse_init(&parser, records_descr,
+				   ARRAY_SIZE(records_descr), &dst,
+				   strings, sizeof(strings));
+
+	for (size_t pos = 0; pos < payload_len; pos += chunk_len) {
+		(void)json_stream_parse_feed(&parser, payload + pos,
+					     MIN(chunk_len, payload_len - pos));
+	}
+
+	ret = json_stream_parse_finish(&parser);
+	check_ret(ret, 1);
+}
+
+static size_t stream_parse_ram(size_t chunk_len)
+{
+	return chunk_len + sizeof(parser) + json_stream_parse_buf_used(&parser);
+}
+
+/* Stands in for a socket send(), which costs per call and reads all
+ * the bytes: they are compared with the payload.
+ */
+static int tx_bytes(const char *bytes, size_t len, void *data)
+{
+	ARG_UNUSED(data);
+
+	if (tx_len + len > payload_len || memcmp(bytes, &payload[tx_len], len) != 0) {
+		tx_mismatch = true;
+	}
+
+	tx_len += len;
+	writes++;
+
+	return 0;
+}
+
+static void encode_buf(size_t arg)
+{
+	int ret;
+
+	ARG_UNUSED(arg);
+
+	tx_start();
+	ret = json_obj_encode_buf(records_descr, ARRAY_SIZE(records_descr),
+				  &src, contiguous, sizeof(contiguous));
+	check_ret(ret, 0);
+
+	(void)tx_bytes(contiguous, strlen(contiguous), NULL);
+	tx_check();
+}
+
+static void encode(size_t arg)
+{
+	int ret;
+
+	ARG_UNUSED(arg);
+
+	tx_start();
+	ret = json_obj_encode(records_descr, ARRAY_SIZE(records_descr), &src,
+			      tx_bytes, NULL);
+	check_ret(ret, 0);
+	tx_check();
+}
+
+static void encode_buffered(size_t buf_size)
+{
+	char buf[ENC_BUF];
+	int ret;
+
+	tx_start();
+	ret = json_obj_encode_buffered(records_descr, ARRAY_SIZE(records_descr),
+				       &src, tx_bytes, NULL, buf, buf_size);
+	check_ret(ret, 0);
+	tx_check();
+}
+
+static size_t no_ram(size_t arg)
+{
+	ARG_UNUSED(arg);
+
+	return 0;
+}
+
+static size_t encode_buf_ram(size_t arg)
+{
+	ARG_UNUSED(arg);
+
+	return payload_len + 1;
+}
+
+static const struct bench benches[] = {
+	{ "json_obj_parse", obj_parse, 0, obj_parse_ram, check_decoded },
+	{ "stream_parse/128", stream_parse, 128, stream_parse_ram, check_decoded },
+	{ "stream_parse/512", stream_parse, 512, stream_parse_ram, check_decoded },
+	{ "stream_parse/1460", stream_parse, 1460, stream_parse_ram, check_decoded },
+	{ "encode_buf", encode_buf, 0, encode_buf_ram, check_encoded },
+	{ "encode", encode, 0, no_ram, check_encoded },
+	/* The buffer is on the stack */
+	{ "encode_buffered", encode_buffered, ENC_BUF, no_ram, check_encoded },
+};
+
+static void bench_entry(void *p1, void *p2, void *p3)
+{
+	const struct bench *b = p1;
+	timing_t start, end;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	writes = 0U;
+
+	start = timing_counter_get();
+	for (int i = 0; i < REPS; i++) {
+		b->fn(b->arg);
+	}
+	end = timing_counter_get();
+
+	cycles = timing_cycles_get(&start, &end);
+}
+
+static void run(const struct bench *b)
+{
+	size_t unused = 0;
+	uint64_t ns;
+
+	memset(&dst, 0, sizeof(dst));
+	ret_failed = false;
+	tx_failed = false;
+
+	k_thread_create(&bench_thread, bench_stack, STACK_SIZE, bench_entry,
+			(void *)b, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_thread_join(&bench_thread, K_FOREVER);
+	(void)k_thread_stack_space_get(&bench_thread, &unused);
+
+	ns = timing_cycles_to_ns(cycles);
+
+	printk("%-18s %5zu B %9u cycles %4u MB/s %6zu B RAM", b->name,
+	       payload_len, (uint32_t)(cycles / REPS),
+	       ns == 0U ? 0U : (uint32_t)((uint64_t)payload_len * REPS * 1000U / ns),
+	       b->ram(b->arg) + STACK_SIZE - unused);
+
+	if (writes != 0U) {
+		printk(", %u writes", writes / REPS);
+	}
+
+	printk("\n");
+
+	if (ret_failed) {
+		TC_PRINT("%s: returned %lld\n", b->name, (long long)bad_ret);
+		error_count++;
+	}
+
+	b->check(b->name);
+}
+
+int main(void)
+{
+	int ret;
+
+	for (int i = 0; i < N_RECORDS; i++) {
+		snprintk(names[i], sizeof(names[i]), "sensor-%03d", i);
+		src.records[i].name = names[i];
+		src.records[i].unit = (i % 2) != 0 ? "Cel" : "%RH";
+		src.records[i].reading.start = (i % 3) != 0 ? "21.375" : "-0.5";
+		src.records[i].reading.length = strlen(src.records[i].reading.start);
+		src.records[i].id = 3300 + i;
+	}
+	src.n_records = N_RECORDS;
+
+	ret = json_obj_encode_buf(records_descr, ARRAY_SIZE(records_descr),
+				  &src, payload, sizeof(payload));
+	if (ret < 0) {
+		TC_PRINT("encoding failed: %d\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+	payload_len = strlen(payload);
+
+	timing_init();
+	timing_start();
+
+	printk("JSON, %d records, %zu B\n", N_RECORDS, payload_len);
+
+	for (int i = 0; i < ARRAY_SIZE(benches); i++) {
+		run(&benches[i]);
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
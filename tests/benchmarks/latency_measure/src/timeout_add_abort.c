@@ -0,0 +1,93 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * @file
+ * Measure the cost of adding and cancelling a kernel timeout while
+ * many other timeouts are pending, to compare the timeout queue
+ * backends (CONFIG_TIMEOUT_QUEUE_DLIST vs. CONFIG_TIMEOUT_QUEUE_WHEEL).
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+#include "utils.h"
+
+/* the number of start/stop cycles measured at each load level */
+#define N_TEST_TIMEOUT 100
+
+/* the largest number of background timeouts kept pending */
+#define N_LOAD_TIMEOUT 256
+
+static struct k_timer load_timer[N_LOAD_TIMEOUT];
+static struct k_timer test_timer;
+
+static const int load_levels[] = { 0, 16, 64, N_LOAD_TIMEOUT };
+
+/**
+ *
+ * @brief Test for the timer start/stop time under timeout load
+ *
+ * Keeps an increasing number of timers pending, all expiring well
+ * after the measurement is over, and measures the time needed to
+ * start a timer expiring after all of them (worst case for a sorted
+ * list) and to stop it again.
+ *
+ * @return 0 on success
+ */
+int timeout_add_abort(void)
+{
+	timing_t timestamp_start;
+	timing_t timestamp_mid;
+	timing_t timestamp_end;
+	uint32_t sum_start;
+	uint32_t sum_stop;
+	char label[64];
+	int loaded = 0;
+
+	for (int i = 0; i < N_LOAD_TIMEOUT; i++) {
+		k_timer_init(&load_timer[i], NULL, NULL);
+	}
+	k_timer_init(&test_timer, NULL, NULL);
+
+	timing_start();
+
+	for (int l = 0; l < ARRAY_SIZE(load_levels); l++) {
+		for (; loaded < load_levels[l]; loaded++) {
+			k_timer_start(&load_timer[loaded],
+				      K_TICKS(1000000 + loaded * 37), K_NO_WAIT);
+		}
+
+		sum_start = 0U;
+		sum_stop = 0U;
+
+		for (int i = 0; i < N_TEST_TIMEOUT; i++) {
+			timestamp_start = timing_counter_get();
+			k_timer_start(&test_timer, K_TICKS(2000000), K_NO_WAIT);
+			timestamp_mid = timing_counter_get();
+			k_timer_stop(&test_timer);
+			timestamp_end = timing_counter_get();
+
+			sum_start += timing_cycles_get(&timestamp_start,
+						       &timestamp_mid);
+			sum_stop += timing_cycles_get(&timestamp_mid,
+						      &timestamp_end);
+		}
+
+		snprintk(label, sizeof(label),
+			 "Average time to start a timer (%d pending)", loaded);
+		PRINT_STATS_AVG(label, sum_start, N_TEST_TIMEOUT);
+		snprintk(label, sizeof(label),
+			 "Average time to stop a timer (%d pending)", loaded);
+		PRINT_STATS_AVG(label, sum_stop, N_TEST_TIMEOUT);
+	}
+
+	for (int i = 0; i < N_LOAD_TIMEOUT; i++) {
+		k_timer_stop(&load_timer[i]);
+	}
+
+	timing_stop();
+	return 0;
+}
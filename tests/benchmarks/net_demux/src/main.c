@@ -0,0 +1,211 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include "connection.h"
+
+/* Cycles needed by net_conn_input() to find the connection of a received
+ * UDP packet, with a growing number of connected sockets registered.
+ * Every packet must be handed to the connection it was sent to.
+ */
+
+#define REPS	    1000
+#define LOCAL_PORT  4242
+#define LISTEN_PORT 5000
+#define MISS_PORT   6000
+#define PEER_PORT   10000
+
+/* User data of the listener, the connections get their index plus one */
+#define LISTENER_ID 0xffff
+
+static const int conn_counts[] = { 1, 16, 64, 256, 512 };
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_ipv4_hdr ipv4_hdr;
+static struct net_udp_hdr udp_hdr;
+static union net_ip_header ip_hdr = { .ipv4 = &ipv4_hdr };
+static union net_proto_header proto_hdr = { .udp = &udp_hdr };
+
+static struct net_if *iface;
+static struct net_pkt *pkt;
+static int connected;
+
+/* User data of the connection the last packet was handed to */
+static uintptr_t matched;
+static int error_count;
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_demux, "net_demux", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static inline uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+/* Keep the packet, it is fed to net_conn_input() over and over */
+static enum net_verdict conn_cb(struct net_conn *conn, struct net_pkt *pkt,
+				union net_ip_header *ip_hdr,
+				union net_proto_header *proto_hdr,
+				void *user_data)
+{
+	matched = POINTER_TO_UINT(user_data);
+
+	return NET_OK;
+}
+
+static int register_conn(const struct in_addr *remote, uint16_t remote_port,
+			 uint16_t local_port, uintptr_t id)
+{
+	struct sockaddr_in remote_addr = {
+		.sin_family = AF_INET,
+	};
+	struct sockaddr_in local_addr = {
+		.sin_family = AF_INET,
+	};
+
+	local_addr.sin_addr = my_addr;
+	if (remote != NULL) {
+		remote_addr.sin_addr = *remote;
+	}
+
+	return net_conn_register(IPPROTO_UDP, AF_INET,
+				 remote != NULL ? (struct sockaddr *)&remote_addr : NULL,
+				 (struct sockaddr *)&local_addr,
+				 remote_port, local_port, NULL, conn_cb,
+				 UINT_TO_POINTER(id), NULL);
+}
+
+/* The packets are expected to reach the connection with user data id,
+ * or none if id is 0.
+ */
+static uint32_t run(uint16_t dst_port, bool random_peer, uintptr_t id)
+{
+	uint32_t seed = 42;
+	timing_t start, end;
+	uint16_t src_port = PEER_PORT;
+	enum net_verdict verdict;
+	int errors = 0;
+
+	udp_hdr.dst_port = htons(dst_port);
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < REPS; i++) {
+		if (random_peer) {
+			src_port = PEER_PORT + xorshift32(&seed) % connected;
+			id = src_port - PEER_PORT + 1;
+		}
+
+		matched = 0;
+		udp_hdr.src_port = htons(src_port);
+		verdict = net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+
+		if (matched != id || verdict != (id != 0 ? NET_OK : NET_DROP)) {
+			errors++;
+		}
+	}
+
+	end = timing_counter_get();
+
+	if (errors != 0) {
+		TC_PRINT("%d conns, port %u: %d packets misdelivered\n", connected,
+			 dst_port, errors);
+		error_count++;
+	}
+
+	return (uint32_t)(timing_cycles_get(&start, &end) / REPS);
+}
+
+int main(void)
+{
+	uint32_t conn_cycles, listen_cycles, miss_cycles;
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	(void)net_if_ipv4_addr_add(iface, &my_addr, NET_ADDR_MANUAL, 0);
+
+	pkt = net_pkt_alloc_on_iface(iface, K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET);
+
+	net_ipv4_addr_copy_raw(ipv4_hdr.src, (uint8_t *)&peer_addr);
+	net_ipv4_addr_copy_raw(ipv4_hdr.dst, (uint8_t *)&my_addr);
+	ipv4_hdr.proto = IPPROTO_UDP;
+
+	ret = register_conn(NULL, 0, LISTEN_PORT, LISTENER_ID);
+	if (ret < 0) {
+		TC_PRINT("Cannot register listener (%d)\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("Demux, cycles per packet\n");
+
+	for (int i = 0; i < ARRAY_SIZE(conn_counts); i++) {
+		while (connected < conn_counts[i]) {
+			ret = register_conn(&peer_addr, PEER_PORT + connected, LOCAL_PORT,
+					    connected + 1);
+			if (ret < 0) {
+				TC_PRINT("Cannot register connection %d (%d)\n", connected, ret);
+				TC_END_REPORT(TC_FAIL);
+				return 0;
+			}
+
+			connected++;
+		}
+
+		conn_cycles = run(LOCAL_PORT, true, 0);
+		listen_cycles = run(LISTEN_PORT, false, LISTENER_ID);
+		miss_cycles = run(MISS_PORT, false, 0);
+
+		printk("%4d conns  connected %5u  listener %5u  miss %5u cycles\n",
+		       connected, conn_cycles, listen_cycles, miss_cycles);
+	}
+
+	timing_stop();
+
+	net_pkt_unref(pkt);
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/dummy.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+
+#include "ipv6.h"
+#include "route.h"
+
+/* Cycles needed by net_route_lookup() to find the route to a destination,
+ * with a growing number of routes in the routing table. Every lookup
+ * must return the longest prefix covering the destination.
+ */
+
+#define REPS	      1000
+#define NEIGHBORS     16
+#define CACHED_DSTS   4
+
+static const int route_counts[] = { 16, 64, 256, 1024 };
+static const uint8_t prefix_lens[] = { 48, 56, 64 };
+
+static struct in6_addr base_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0 } } };
+
+static struct in6_addr nexthops[NEIGHBORS];
+static struct in6_addr prefixes[1024];
+static struct in6_addr dsts[REPS];
+/* Index of the route each destination was taken from */
+static uint16_t dst_routes[REPS];
+
+static struct net_if *iface;
+static int routes;
+static int error_count;
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_route_bench, "net_route_bench", NULL, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+static inline uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+static int add_neighbors(void)
+{
+	static uint8_t lladdrs[NEIGHBORS][6];
+	struct net_linkaddr lladdr = {
+		.len = 6,
+		.type = NET_LINK_DUMMY,
+	};
+
+	for (int i = 0; i < NEIGHBORS; i++) {
+		nexthops[i] = (struct in6_addr) { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+						      0, 0, 0, 0, 0, 0, 0, i + 1 } } };
+		lladdrs[i][0] = 0x02;
+		lladdrs[i][5] = i + 1;
+		lladdr.addr = lladdrs[i];
+
+		if (net_ipv6_nbr_add(iface, &nexthops[i], &lladdr, false,
+				     NET_IPV6_NBR_STATE_REACHABLE) == NULL) {
+			return -ENOMEM;
+		}
+	}
+
+	return 0;
+}
+
+/* Every route gets its own /48, some of them longer prefixes inside it */
+static int add_route(int i, uint32_t *seed)
+{
+	struct in6_addr *prefix = &prefixes[i];
+
+	*prefix = base_addr;
+	prefix->s6_addr[4] = i >> 8;
+	prefix->s6_addr[5] = i;
+	prefix->s6_addr[6] = xorshift32(seed);
+	prefix->s6_addr[7] = xorshift32(seed);
+
+	if (net_route_add(iface, prefix, prefix_lens[i % ARRAY_SIZE(prefix_lens)],
+			  &nexthops[i % NEIGHBORS], NET_IPV6_ND_INFINITE_LIFETIME,
+			  NET_ROUTE_PREFERENCE_MEDIUM) == NULL) {
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+static bool route_matches(struct net_route_entry *route, int i)
+{
+	uint8_t len = prefix_lens[i % ARRAY_SIZE(prefix_lens)];
+
+	return route != NULL && route->prefix_len == len &&
+	       net_ipv6_is_prefix(route->addr.s6_addr, prefixes[i].s6_addr, len);
+}
+
+static uint64_t run(int dst_count)
+{
+	timing_t start, end;
+	int found = 0;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < REPS; i++) {
+		found += route_matches(net_route_lookup(iface, &dsts[i % dst_count]),
+				       dst_routes[i % dst_count]) ? 1 : 0;
+	}
+
+	end = timing_counter_get();
+
+	if (found != REPS) {
+		TC_PRINT("%d routes: only %d of %d destinations routed right\n",
+			 routes + 1, found, REPS);
+		error_count++;
+	}
+
+	return timing_cycles_get(&start, &end);
+}
+
+int main(void)
+{
+	uint32_t seed = 42;
+	uint64_t cached, uncached, ns;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+
+	if (add_neighbors() < 0) {
+		TC_PRINT("Cannot add neighbors\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	/* Covers the destinations of all the other routes */
+	if (net_route_add(iface, &base_addr, 32, &nexthops[0],
+			  NET_IPV6_ND_INFINITE_LIFETIME,
+			  NET_ROUTE_PREFERENCE_MEDIUM) == NULL) {
+		TC_PRINT("Cannot add route\n");
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("Route lookup, cycles per lookup\n");
+
+	for (int i = 0; i < ARRAY_SIZE(route_counts); i++) {
+		while (routes < route_counts[i] - 1) {
+			if (add_route(routes, &seed) < 0) {
+				TC_PRINT("Cannot add route %d\n", routes);
+				TC_END_REPORT(TC_FAIL);
+				return 0;
+			}
+
+			routes++;
+		}
+
+		/* Destinations within random routes, with random host bits */
+		for (int j = 0; j < REPS; j++) {
+			dst_routes[j] = xorshift32(&seed) % routes;
+			dsts[j] = prefixes[dst_routes[j]];
+			UNALIGNED_PUT(xorshift32(&seed), &dsts[j].s6_addr32[2]);
+			UNALIGNED_PUT(xorshift32(&seed), &dsts[j].s6_addr32[3]);
+		}
+
+		cached = run(CACHED_DSTS);
+		uncached = run(REPS);
+		ns = timing_cycles_to_ns(uncached);
+
+		printk("%4d routes  cached %5u  uncached %5u cycles  %8u lookups/s\n",
+		       routes + 1, (uint32_t)(cached / REPS), (uint32_t)(uncached / REPS),
+		       (uint32_t)(ns > 0 ? REPS * 1000000000ULL / ns : 0));
+	}
+
+	timing_stop();
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
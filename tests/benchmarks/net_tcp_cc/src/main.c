@@ -0,0 +1,135 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/loopback.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/zperf.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/tc_util.h>
+
+/* TCP throughput over the loopback interface, which drops a share of the
+ * packets and delays all of them, to emulate lossy links with a long
+ * round trip time. Every session must finish, with the server having
+ * received the data.
+ */
+
+#define PORT	    5001
+#define DURATION_MS 5000
+#define PACKET_SIZE 1024
+
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+#define CC_NAME "CUBIC"
+#elif defined(CONFIG_NET_TCP_CC_NEWRENO)
+#define CC_NAME "NewReno"
+#else
+#define CC_NAME "none"
+#endif
+
+static const uint32_t delays_ms[] = { 0, 10, 50 };
+static const uint8_t drop_percents[] = { 0, 1, 5 };
+
+static struct zperf_results server_results;
+static K_SEM_DEFINE(session_done, 0, 1);
+static int error_count;
+
+static void server_cb(enum zperf_status status, struct zperf_results *result,
+		      void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_FINISHED) {
+		server_results = *result;
+		k_sem_give(&session_done);
+	} else if (status == ZPERF_SESSION_ERROR) {
+		memset(&server_results, 0, sizeof(server_results));
+		k_sem_give(&session_done);
+	}
+}
+
+static int run(uint32_t delay_ms, uint8_t drop_percent)
+{
+	static const struct in_addr loopback_addr = INADDR_LOOPBACK_INIT;
+	struct zperf_upload_params upload = {
+		.duration_ms = DURATION_MS,
+		.packet_size = PACKET_SIZE,
+	};
+	struct zperf_results results;
+	struct sockaddr_in *peer = net_sin(&upload.peer_addr);
+	uint64_t kbps = 0;
+	int ret;
+
+	peer->sin_family = AF_INET;
+	peer->sin_port = htons(PORT);
+	net_ipaddr_copy(&peer->sin_addr, &loopback_addr);
+
+	(void)loopback_set_packet_drop_ratio(drop_percent / 100.0f);
+	(void)loopback_set_packet_delay(delay_ms);
+
+	k_sem_reset(&session_done);
+
+	ret = zperf_tcp_upload(&upload, &results);
+	if (ret < 0) {
+		TC_PRINT("Upload failed (%d)\n", ret);
+		return ret;
+	}
+
+	if (k_sem_take(&session_done, K_SECONDS(30)) != 0) {
+		TC_PRINT("Session did not finish\n");
+		error_count++;
+	} else if (server_results.total_len == 0U ||
+		   server_results.total_len > results.nb_packets_sent * PACKET_SIZE) {
+		TC_PRINT("Received %u bytes, %u sent\n", server_results.total_len,
+			 results.nb_packets_sent * PACKET_SIZE);
+		error_count++;
+	} else if (server_results.time_in_us > 0) {
+		/* What the receiver got, not what was queued by the sender */
+		kbps = (uint64_t)server_results.total_len * 8000U /
+		       server_results.time_in_us;
+	}
+
+	printk("%4u ms delay %3u%% drop %8u kbit/s\n", delay_ms, drop_percent,
+	       (uint32_t)kbps);
+
+	return 0;
+}
+
+int main(void)
+{
+	struct zperf_download_params download = {
+		.port = PORT,
+	};
+	int ret;
+
+	ret = zperf_tcp_download(&download, server_cb, NULL);
+	if (ret < 0) {
+		TC_PRINT("Cannot start the server (%d)\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	/* Let the server start listening */
+	k_sleep(K_MSEC(100));
+
+	printk("TCP throughput, congestion control %s, SACK %s, window scale %s\n",
+	       CC_NAME, IS_ENABLED(CONFIG_NET_TCP_SACK) ? "on" : "off",
+	       IS_ENABLED(CONFIG_NET_TCP_WINDOW_SCALE) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(delays_ms); i++) {
+		for (int j = 0; j < ARRAY_SIZE(drop_percents); j++) {
+			if (run(delays_ms[i], drop_percents[j]) < 0) {
+				error_count++;
+			}
+		}
+	}
+
+	(void)loopback_set_packet_drop_ratio(0.0f);
+	(void)loopback_set_packet_delay(0);
+	(void)zperf_tcp_download_stop();
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
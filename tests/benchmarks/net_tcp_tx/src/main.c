@@ -0,0 +1,140 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/net_stats.h>
+#include <zephyr/net/zperf.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/tc_util.h>
+
+/* TCP transmit throughput of a zperf client sending to a zperf server over
+ * the loopback interface. Next to it, the data segments sent by the client
+ * and the IP packets TCP handed down on both ends, acknowledgments
+ * included. With segmentation offload, one packet carries several segments.
+ * Every session must finish, with the server having received the data.
+ */
+
+#define PORT	    5001
+#define DURATION_MS 5000
+
+static const uint16_t packet_sizes[] = { 1024, 8192 };
+
+static struct zperf_results server_results;
+static K_SEM_DEFINE(session_done, 0, 1);
+static int error_count;
+
+static void server_cb(enum zperf_status status, struct zperf_results *result,
+		      void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	if (status == ZPERF_SESSION_FINISHED) {
+		server_results = *result;
+		k_sem_give(&session_done);
+	} else if (status == ZPERF_SESSION_ERROR) {
+		memset(&server_results, 0, sizeof(server_results));
+		k_sem_give(&session_done);
+	}
+}
+
+static void tcp_stats_get(struct net_stats_tcp *stats)
+{
+	if (net_mgmt(NET_REQUEST_STATS_GET_TCP, NULL, stats, sizeof(*stats)) < 0) {
+		memset(stats, 0, sizeof(*stats));
+	}
+}
+
+static void ipv4_stats_get(struct net_stats_ip *stats)
+{
+	if (net_mgmt(NET_REQUEST_STATS_GET_IPV4, NULL, stats, sizeof(*stats)) < 0) {
+		memset(stats, 0, sizeof(*stats));
+	}
+}
+
+static int run(uint16_t packet_size)
+{
+	static const struct in_addr loopback_addr = INADDR_LOOPBACK_INIT;
+	struct zperf_upload_params upload = {
+		.duration_ms = DURATION_MS,
+		.packet_size = packet_size,
+	};
+	struct sockaddr_in *peer = net_sin(&upload.peer_addr);
+	struct net_stats_tcp before, after;
+	struct net_stats_ip ip_before, ip_after;
+	struct zperf_results results;
+	uint64_t kbps = 0;
+	int ret;
+
+	peer->sin_family = AF_INET;
+	peer->sin_port = htons(PORT);
+	net_ipaddr_copy(&peer->sin_addr, &loopback_addr);
+
+	k_sem_reset(&session_done);
+	tcp_stats_get(&before);
+	ipv4_stats_get(&ip_before);
+
+	ret = zperf_tcp_upload(&upload, &results);
+	if (ret < 0) {
+		TC_PRINT("Upload failed (%d)\n", ret);
+		return ret;
+	}
+
+	if (k_sem_take(&session_done, K_SECONDS(30)) != 0) {
+		TC_PRINT("Session did not finish\n");
+		error_count++;
+	} else if (server_results.total_len == 0U ||
+		   server_results.total_len > results.nb_packets_sent * packet_size) {
+		TC_PRINT("Received %u bytes, %u sent\n", server_results.total_len,
+			 results.nb_packets_sent * packet_size);
+		error_count++;
+	} else if (server_results.time_in_us > 0) {
+		kbps = (uint64_t)server_results.total_len * 8000U /
+		       server_results.time_in_us;
+	}
+
+	tcp_stats_get(&after);
+	ipv4_stats_get(&ip_after);
+
+	printk("%5u bytes %8u kbit/s %8u data segments %8u packets\n",
+	       packet_size, (uint32_t)kbps, after.sent - before.sent,
+	       ip_after.sent - ip_before.sent);
+
+	return 0;
+}
+
+int main(void)
+{
+	struct zperf_download_params download = {
+		.port = PORT,
+	};
+	int ret;
+
+	ret = zperf_tcp_download(&download, server_cb, NULL);
+	if (ret < 0) {
+		TC_PRINT("Cannot start the server (%d)\n", ret);
+		TC_END_REPORT(TC_FAIL);
+		return 0;
+	}
+
+	/* Let the server start listening */
+	k_sleep(K_MSEC(100));
+
+	printk("TCP transmit, GSO %s\n",
+	       IS_ENABLED(CONFIG_NET_TCP_GSO) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(packet_sizes); i++) {
+		if (run(packet_sizes[i]) < 0) {
+			error_count++;
+		}
+	}
+
+	(void)zperf_tcp_download_stop();
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
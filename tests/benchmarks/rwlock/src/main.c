@@ -0,0 +1,141 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/tc_util.h>
+
+/* Lock and unlock operations per millisecond of threads taking a lock in a
+ * loop, on as many CPUs as available. The writers increment a counter
+ * without atomic operations, so that a writer not excluding the others
+ * loses increments.
+ */
+
+#define DURATION_MS 1000
+#define STACK_SIZE  (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define MAX_THREADS CONFIG_MP_MAX_NUM_CPUS
+
+enum lock_type {
+	RWLOCK_READ,
+	RWLOCK_WRITE,
+	MUTEX,
+};
+
+static const char *const names[] = {
+	[RWLOCK_READ] = "rwlock read",
+	[RWLOCK_WRITE] = "rwlock write",
+	[MUTEX] = "mutex",
+};
+
+K_RWLOCK_DEFINE(rwlock, 0);
+K_MUTEX_DEFINE(mutex);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[MAX_THREADS];
+
+static volatile bool stop;
+static volatile uint32_t counter;
+static uint32_t ops[MAX_THREADS];
+
+static atomic_t lock_errors;
+static int error_count;
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	enum lock_type type = POINTER_TO_UINT(p1);
+	uint32_t *count = p2;
+	uint32_t n = 0;
+	uint32_t sink = 0;
+	int ret = 0;
+
+	ARG_UNUSED(p3);
+
+	while (!stop) {
+		switch (type) {
+		case RWLOCK_READ:
+			ret = k_rwlock_read_lock(&rwlock, K_FOREVER);
+			sink += counter;
+			ret |= k_rwlock_read_unlock(&rwlock);
+			break;
+		case RWLOCK_WRITE:
+			ret = k_rwlock_write_lock(&rwlock, K_FOREVER);
+			counter = counter + 1;
+			ret |= k_rwlock_write_unlock(&rwlock);
+			break;
+		case MUTEX:
+			ret = k_mutex_lock(&mutex, K_FOREVER);
+			sink += counter;
+			ret |= k_mutex_unlock(&mutex);
+			break;
+		}
+
+		if (ret != 0) {
+			atomic_inc(&lock_errors);
+		}
+
+		n++;
+	}
+
+	*count = n + (sink & 0U);
+}
+
+static uint32_t run(enum lock_type type, unsigned int num_threads)
+{
+	uint32_t start_count = counter;
+	uint32_t total = 0;
+
+	atomic_clear(&lock_errors);
+	stop = false;
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		ops[i] = 0;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				UINT_TO_POINTER(type), &ops[i], NULL,
+				K_PRIO_PREEMPT(1), 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		(void)k_thread_cpu_pin(&threads[i], i);
+#endif
+		k_thread_start(&threads[i]);
+	}
+
+	k_msleep(DURATION_MS);
+	stop = true;
+
+	for (unsigned int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += ops[i];
+	}
+
+	if (atomic_get(&lock_errors) != 0) {
+		TC_PRINT("%s: %ld lock operations failed\n", names[type],
+			 (long)atomic_get(&lock_errors));
+		error_count++;
+	}
+
+	if (type == RWLOCK_WRITE && counter - start_count != total) {
+		TC_PRINT("%s: %u increments for %u locks\n", names[type],
+			 counter - start_count, total);
+		error_count++;
+	}
+
+	return total / DURATION_MS;
+}
+
+int main(void)
+{
+	unsigned int num_cpus = MIN(arch_num_cpus(), MAX_THREADS);
+
+	printk("Locks taken and released per millisecond, %d ms per run\n", DURATION_MS);
+
+	for (unsigned int n = 1; n <= num_cpus; n++) {
+		for (int type = 0; type < ARRAY_SIZE(names); type++) {
+			printk("%-13s %u threads  %u ops/ms\n", names[type], n, run(type, n));
+		}
+	}
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
@@ -32,6 +32,10 @@
 #define N_RUNS 1000
 #define N_SETTLE 10
 
+#ifdef CONFIG_SMP
+extern void smp_throughput(void);
+#endif
+
 
 static K_THREAD_STACK_DEFINE(partner_stack, 1024);
 static struct k_thread partner_thread;
@@ -148,6 +152,11 @@ int main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+#ifdef CONFIG_SMP
+	smp_throughput();
+#endif
+
 	printk("fin\n");
 	return 0;
 }
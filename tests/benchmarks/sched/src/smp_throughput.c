@@ -0,0 +1,91 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+/* SMP scaling companion to the latency benchmark in main.c.  It runs
+ * 1..N pairs of threads (N being the number of CPUs), each pair
+ * ping-ponging through two semaphores so that every iteration is two
+ * wakeups and two context switches, and reports the aggregate
+ * iteration rate for each pair count.  Every wakeup and switch takes
+ * the global scheduler lock, so this shows how much that lock and the
+ * scheduler IPIs cost as more CPUs do independent work.
+ */
+
+#define N_PAIRS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define RUN_MS 1000
+
+static K_THREAD_STACK_ARRAY_DEFINE(pair_stacks, 2 * N_PAIRS, STACK_SIZE);
+static struct k_thread pair_threads[2 * N_PAIRS];
+static struct k_sem pair_sems[2 * N_PAIRS];
+static uint32_t pair_iterations[N_PAIRS];
+
+static void ping_fn(void *arg1, void *arg2, void *arg3)
+{
+	int pair = POINTER_TO_INT(arg1);
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_give(&pair_sems[2 * pair + 1]);
+		k_sem_take(&pair_sems[2 * pair], K_FOREVER);
+		pair_iterations[pair]++;
+	}
+}
+
+static void pong_fn(void *arg1, void *arg2, void *arg3)
+{
+	int pair = POINTER_TO_INT(arg1);
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(&pair_sems[2 * pair + 1], K_FOREVER);
+		k_sem_give(&pair_sems[2 * pair]);
+	}
+}
+
+void smp_throughput(void)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	/* Below main, so main always gets a CPU back to stop the run */
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	for (int pairs = 1; pairs <= num_cpus; pairs++) {
+		uint32_t total = 0U;
+
+		for (int i = 0; i < pairs; i++) {
+			pair_iterations[i] = 0U;
+			k_sem_init(&pair_sems[2 * i], 0, 1);
+			k_sem_init(&pair_sems[2 * i + 1], 0, 1);
+
+			k_thread_create(&pair_threads[2 * i], pair_stacks[2 * i],
+					STACK_SIZE, pong_fn, INT_TO_POINTER(i),
+					NULL, NULL, prio, 0, K_NO_WAIT);
+			k_thread_create(&pair_threads[2 * i + 1],
+					pair_stacks[2 * i + 1], STACK_SIZE,
+					ping_fn, INT_TO_POINTER(i), NULL, NULL,
+					prio, 0, K_NO_WAIT);
+		}
+
+		k_msleep(RUN_MS);
+
+		for (int i = 0; i < 2 * pairs; i++) {
+			k_thread_abort(&pair_threads[i]);
+		}
+
+		for (int i = 0; i < pairs; i++) {
+			total += pair_iterations[i];
+		}
+
+		printk("cpus %d pairs %d switches/s %u\n", num_cpus, pairs,
+		       (uint32_t)((uint64_t)total * 2U * MSEC_PER_SEC / RUN_MS));
+	}
+}
@@ -0,0 +1,214 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/tc_util.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Latency and fragmentation of sys_heap under a networking-like
+ * workload: many small objects of 32 to 256 bytes mixed with 1.5 KB
+ * packet buffers, all with random lifetimes, keeping the heap close
+ * to full.  Each allocation and free is timed individually so that
+ * percentiles and the worst case can be reported, not just averages.
+ * Build with CONFIG_SYS_HEAP_BUCKETS_TLSF=y to compare the free list
+ * organizations.  Every block is filled and checked before it is
+ * freed, and the heap must be valid and whole again at the end.
+ */
+
+#define HEAP_SIZE  (64 * 1024)
+#define N_SLOTS    384
+#define N_OPS      20000
+#define PKT_SIZE   1536
+
+static uint8_t heap_mem[HEAP_SIZE] __aligned(8);
+static struct sys_heap heap;
+static void *slots[N_SLOTS];
+static size_t slot_sizes[N_SLOTS];
+static int error_count;
+
+static uint32_t alloc_cycles[N_OPS];
+static uint32_t free_cycles[N_OPS];
+
+/* Same LCRNG as sys_heap_stress(), for repeatable runs */
+static uint32_t rand32(void)
+{
+	static uint64_t state = 123456789;
+
+	state = state * 2862933555777941757UL + 3037000493UL;
+
+	return (uint32_t)(state >> 32);
+}
+
+static size_t workload_size(void)
+{
+	/* One packet buffer for every eight small objects */
+	if (rand32() % 9 == 0) {
+		return PKT_SIZE;
+	}
+
+	return 32 + rand32() % 225;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void print_percentiles(const char *name, uint32_t *cycles, int n)
+{
+	if (n == 0) {
+		return;
+	}
+
+	qsort(cycles, n, sizeof(cycles[0]), cmp_u32);
+
+	printk("%-5s p50 %u p90 %u p99 %u max %u (cycles)\n", name,
+	       cycles[n / 2], cycles[n * 90 / 100], cycles[n * 99 / 100],
+	       cycles[n - 1]);
+}
+
+/* Size of the largest block that can still be allocated */
+static size_t largest_free_block(void)
+{
+	size_t lo = 0, hi = HEAP_SIZE;
+
+	while (lo < hi) {
+		size_t mid = (lo + hi + 1) / 2;
+		void *p = sys_heap_alloc(&heap, mid);
+
+		if (p != NULL) {
+			sys_heap_free(&heap, p);
+			lo = mid;
+		} else {
+			hi = mid - 1;
+		}
+	}
+
+	return lo;
+}
+
+static void check_block(int s)
+{
+	uint8_t *p = slots[s];
+
+	for (size_t i = 0; i < slot_sizes[s]; i++) {
+		if (p[i] != (uint8_t)s) {
+			TC_PRINT("block %p of %zu bytes overwritten at %zu\n",
+				 p, slot_sizes[s], i);
+			error_count++;
+			return;
+		}
+	}
+}
+
+static void check_heap(const char *when)
+{
+	if (!sys_heap_validate(&heap)) {
+		TC_PRINT("heap corrupted %s\n", when);
+		error_count++;
+	}
+}
+
+int main(void)
+{
+	struct sys_memory_stats stats;
+	timing_t start, end;
+	int n_alloc = 0, n_free = 0;
+	uint32_t failed = 0;
+	size_t largest, initial;
+	unsigned int key;
+
+	sys_heap_init(&heap, heap_mem, sizeof(heap_mem));
+	initial = largest_free_block();
+
+	timing_init();
+	timing_start();
+
+	printk("sys_heap %s, %d bytes, %d operations\n",
+	       IS_ENABLED(CONFIG_SYS_HEAP_BUCKETS_TLSF) ? "tlsf" : "pow2",
+	       HEAP_SIZE, N_OPS);
+
+	/* Each operation toggles a random slot, which settles at about
+	 * half the slots in use: a bit more than the heap can hold.
+	 */
+	for (int i = 0; i < N_OPS; i++) {
+		int s = rand32() % N_SLOTS;
+
+		if (slots[s] != NULL) {
+			check_block(s);
+
+			key = irq_lock();
+			start = timing_counter_get();
+			sys_heap_free(&heap, slots[s]);
+			end = timing_counter_get();
+			irq_unlock(key);
+
+			slots[s] = NULL;
+			free_cycles[n_free++] = timing_cycles_get(&start, &end);
+		} else {
+			size_t sz = workload_size();
+
+			key = irq_lock();
+			start = timing_counter_get();
+			slots[s] = sys_heap_alloc(&heap, sz);
+			end = timing_counter_get();
+			irq_unlock(key);
+
+			failed += (slots[s] == NULL) ? 1U : 0U;
+			alloc_cycles[n_alloc++] = timing_cycles_get(&start, &end);
+
+			if (slots[s] != NULL) {
+				slot_sizes[s] = sz;
+				memset(slots[s], s, sz);
+			}
+		}
+	}
+
+	timing_stop();
+
+	print_percentiles("alloc", alloc_cycles, n_alloc);
+	print_percentiles("free", free_cycles, n_free);
+
+	/* How much of the free memory is usable as one block */
+	sys_heap_runtime_stats_get(&heap, &stats);
+	largest = largest_free_block();
+
+	printk("free %zu bytes, largest block %zu bytes\n",
+	       stats.free_bytes, largest);
+	printk("fragmentation %u%% failed %u of %d allocations\n",
+	       stats.free_bytes == 0 ? 0U :
+	       (uint32_t)(100U - largest * 100U / stats.free_bytes),
+	       failed, n_alloc);
+
+	check_heap("after the workload");
+
+	/* Nothing may be lost once everything is freed */
+	for (int s = 0; s < N_SLOTS; s++) {
+		if (slots[s] != NULL) {
+			check_block(s);
+			sys_heap_free(&heap, slots[s]);
+			slots[s] = NULL;
+		}
+	}
+
+	check_heap("after freeing all blocks");
+
+	largest = largest_free_block();
+	if (largest != initial) {
+		TC_PRINT("largest block %zu bytes once empty, %zu initially\n",
+			 largest, initial);
+		error_count++;
+	}
+
+	TC_END_REPORT(error_count);
+	return 0;
+}
@@ -0,0 +1,166 @@
+/* handoff.c */
+
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "syskernel.h"
+
+#if defined(CONFIG_SMP) && (CONFIG_MP_MAX_NUM_CPUS > 1)
+
+static struct k_sem ping_sem;
+static struct k_sem pong_sem;
+static struct k_mutex handoff_mutex;
+
+/* Shared data the mutex protects, bounced between the CPUs */
+static volatile uint32_t handoff_data;
+
+static void print_contention(struct k_sem *sem, struct k_mutex *mutex)
+{
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+	struct k_obj_contention stats;
+
+	if (sem != NULL) {
+		k_sem_contention_get(sem, &stats);
+	} else {
+		k_mutex_contention_get(mutex, &stats);
+	}
+
+	fprintf(output_file,
+		"\nCONTENTION: %u contended, %u acquired spinning, %u blocked",
+		stats.contended, stats.spin_acquired, stats.blocked);
+#else
+	ARG_UNUSED(sem);
+	ARG_UNUSED(mutex);
+#endif
+}
+
+/**
+ *
+ * @brief Semaphore ping-pong partner, running on another CPU
+ *
+ * @param par1   Ignored parameter.
+ * @param par2   Number of test loops.
+ * @param par3   Unused
+ *
+ */
+static void handoff_sem_thread(void *par1, void *par2, void *par3)
+{
+	int num_loops = POINTER_TO_INT(par2);
+
+	ARG_UNUSED(par1);
+	ARG_UNUSED(par3);
+
+	for (int i = 0; i < num_loops; i++) {
+		k_sem_take(&ping_sem, K_FOREVER);
+		k_sem_give(&pong_sem);
+	}
+}
+
+/**
+ *
+ * @brief Mutex contender, running on another CPU
+ *
+ * @param par1   Ignored parameter.
+ * @param par2   Number of test loops.
+ * @param par3   Unused
+ *
+ */
+static void handoff_mutex_thread(void *par1, void *par2, void *par3)
+{
+	int num_loops = POINTER_TO_INT(par2);
+
+	ARG_UNUSED(par1);
+	ARG_UNUSED(par3);
+
+	for (int i = 0; i < num_loops; i++) {
+		k_mutex_lock(&handoff_mutex, K_FOREVER);
+		handoff_data++;
+		k_mutex_unlock(&handoff_mutex);
+	}
+}
+
+/**
+ *
+ * @brief The main test entry
+ *
+ * Both tests keep one thread on each of two CPUs, so that every
+ * handoff crosses CPUs.  Compare runs with and without
+ * CONFIG_KERNEL_ADAPTIVE_SPIN.
+ *
+ * @return 1 if success and 0 on failure
+ */
+int handoff_test(void)
+{
+	uint32_t t;
+	int i;
+	int return_value = 0;
+
+	fprintf(output_file, sz_test_case_fmt,
+			"Cross-CPU handoff #1");
+	fprintf(output_file, sz_description,
+			"\n\tk_sem_give"
+			"\n\tk_sem_take(K_FOREVER), given from another CPU");
+	printf(sz_test_start_fmt);
+
+	k_sem_init(&ping_sem, 0, 1);
+	k_sem_init(&pong_sem, 0, 1);
+
+	k_thread_create(&thread_data1, thread_stack1, STACK_SIZE,
+			handoff_sem_thread, NULL,
+			INT_TO_POINTER(number_of_loops), NULL,
+			K_PRIO_COOP(3), 0, K_NO_WAIT);
+
+	t = BENCH_START();
+
+	for (i = 0; i < number_of_loops; i++) {
+		k_sem_give(&ping_sem);
+		k_sem_take(&pong_sem, K_FOREVER);
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	k_thread_join(&thread_data1, K_FOREVER);
+	print_contention(&pong_sem, NULL);
+	return_value += check_result(i, t);
+
+	fprintf(output_file, sz_test_case_fmt,
+			"Cross-CPU handoff #2");
+	fprintf(output_file, sz_description,
+			"\n\tk_mutex_lock(K_FOREVER)"
+			"\n\tk_mutex_unlock"
+			"\n\t(contended from another CPU)");
+	printf(sz_test_start_fmt);
+
+	k_mutex_init(&handoff_mutex);
+	handoff_data = 0U;
+
+	t = BENCH_START();
+
+	k_thread_create(&thread_data1, thread_stack1, STACK_SIZE,
+			handoff_mutex_thread, NULL,
+			INT_TO_POINTER(number_of_loops), NULL,
+			K_PRIO_COOP(3), 0, K_NO_WAIT);
+
+	for (i = 0; i < number_of_loops; i++) {
+		k_mutex_lock(&handoff_mutex, K_FOREVER);
+		handoff_data++;
+		k_mutex_unlock(&handoff_mutex);
+	}
+
+	k_thread_join(&thread_data1, K_FOREVER);
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	print_contention(NULL, &handoff_mutex);
+	if (handoff_data != 2U * number_of_loops) {
+		i = -1;
+	}
+	return_value += check_result(i, t);
+
+	return return_value;
+}
+
+#endif /* CONFIG_SMP && CONFIG_MP_MAX_NUM_CPUS > 1 */
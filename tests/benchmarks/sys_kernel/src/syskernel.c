@@ -32,6 +32,15 @@ uint32_t tm_off;
 /* Holds the loop count that need to be carried out. */
 uint32_t number_of_loops;
 
+/* sema/lifo/fifo/stack/mem_slab account for 14 tests, plus two
+ * cross-CPU handoff tests with more than one CPU
+ */
+#if defined(CONFIG_SMP) && (CONFIG_MP_MAX_NUM_CPUS > 1)
+#define NUMBER_OF_TESTS 16
+#else
+#define NUMBER_OF_TESTS 14
+#endif
+
 /**
  *
  * @brief Get the time ticks before test starts
@@ -162,10 +171,12 @@ int main(void)
 		test_result += fifo_test();
 		test_result += stack_test();
 		test_result += mem_slab_test();
+#if defined(CONFIG_SMP) && (CONFIG_MP_MAX_NUM_CPUS > 1)
+		test_result += handoff_test();
+#endif
 
 		if (test_result) {
-			/* sema/lifo/fifo/stack/mem_slab account for 14 tests in total */
-			if (test_result == 14) {
+			if (test_result == NUMBER_OF_TESTS) {
 				fprintf(output_file, sz_module_result_fmt,
 					sz_success);
 			} else {
@@ -57,6 +57,7 @@ int lifo_test(void);
 int fifo_test(void);
 int stack_test(void);
 int mem_slab_test(void);
+int handoff_test(void);
 void begin_test(void);
 
 static inline uint32_t BENCH_START(void)
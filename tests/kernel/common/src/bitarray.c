@@ -519,6 +519,109 @@ ZTEST(bitarray, test_bitarray_alloc_free)
 	alloc_and_free_interval();
 }
 
+/**
+ * @brief Test allocating several regions at once
+ *
+ * @see sys_bitarray_alloc_multi()
+ */
+ZTEST(bitarray, test_bitarray_alloc_multi)
+{
+	size_t offsets[4];
+	int ret;
+
+	/* Bitarrays have embedded spinlocks and can't on the stack. */
+	if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
+		ztest_test_skip();
+	}
+
+	SYS_BITARRAY_DEFINE(ba, 64);
+
+	printk("Testing bit array multiple region allocation\n");
+
+	ba.bundles[0] = 0x0000F00F;
+	ba.bundles[1] = 0xFFFFFFFE;
+
+	/* Regions are allocated first-fit, as by consecutive allocations */
+	ret = sys_bitarray_alloc_multi(&ba, 4, 3, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_alloc_multi() failed: %d", ret);
+	zassert_equal(offsets[0], 4);
+	zassert_equal(offsets[1], 8);
+	zassert_equal(offsets[2], 16);
+	zassert_equal(ba.bundles[0], 0x000FFFFF);
+
+	/* Either all regions are allocated or none is */
+	ret = sys_bitarray_alloc_multi(&ba, 4, 4, offsets);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc_multi() did not fail: %d", ret);
+	zassert_equal(ba.bundles[0], 0x000FFFFF);
+	zassert_equal(ba.bundles[1], 0xFFFFFFFE);
+
+	ret = sys_bitarray_alloc_multi(&ba, 1, 4, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_alloc_multi() failed: %d", ret);
+	zassert_equal(offsets[0], 20);
+	zassert_equal(offsets[3], 23);
+
+	/* A region may span bundles */
+	ret = sys_bitarray_alloc_multi(&ba, 9, 1, offsets);
+	zassert_equal(ret, 0, "sys_bitarray_alloc_multi() failed: %d", ret);
+	zassert_equal(offsets[0], 24);
+	zassert_equal(ba.bundles[0], 0xFFFFFFFF);
+	zassert_equal(ba.bundles[1], 0xFFFFFFFF);
+
+	zassert_equal(sys_bitarray_alloc_multi(&ba, 1, 65, offsets), -EINVAL);
+	zassert_equal(sys_bitarray_alloc_multi(&ba, 0, 1, offsets), -EINVAL);
+}
+
+/**
+ * @brief Test allocating in a large bitarray, whose full bundles are
+ * skipped when searching
+ *
+ * @see sys_bitarray_alloc()
+ * @see sys_bitarray_free()
+ */
+ZTEST(bitarray, test_bitarray_alloc_large)
+{
+	size_t offset;
+	size_t i;
+	int ret;
+
+	/* Bitarrays have embedded spinlocks and can't on the stack. */
+	if (IS_ENABLED(CONFIG_KERNEL_COHERENCE)) {
+		ztest_test_skip();
+	}
+
+	SYS_BITARRAY_DEFINE(ba, 1100);
+
+	printk("Testing bit array allocation in a large bitarray\n");
+
+	zassert_not_null(ba.summary);
+
+	for (i = 0; i < ba.num_bits; i++) {
+		ret = sys_bitarray_alloc(&ba, 1, &offset);
+		zassert_equal(ret, 0, "sys_bitarray_alloc() failed: %d", ret);
+		zassert_equal(offset, i, "expected offset %zu, got %zu", i, offset);
+	}
+
+	ret = sys_bitarray_alloc(&ba, 1, &offset);
+	zassert_equal(ret, -ENOSPC, "sys_bitarray_alloc() did not fail: %d", ret);
+
+	/* Free bits in full bundles, they must be found again */
+	zassert_ok(sys_bitarray_free(&ba, 1, 1000));
+	zassert_ok(sys_bitarray_clear_bit(&ba, 40));
+	zassert_ok(sys_bitarray_free(&ba, 64, 512));
+
+	zassert_ok(sys_bitarray_alloc(&ba, 1, &offset));
+	zassert_equal(offset, 40);
+	zassert_ok(sys_bitarray_alloc(&ba, 33, &offset));
+	zassert_equal(offset, 512);
+	zassert_ok(sys_bitarray_alloc(&ba, 2, &offset));
+	zassert_equal(offset, 545);
+	zassert_equal(sys_bitarray_alloc(&ba, 30, &offset), -ENOSPC);
+	zassert_ok(sys_bitarray_alloc(&ba, 29, &offset));
+	zassert_equal(offset, 547);
+	zassert_ok(sys_bitarray_alloc(&ba, 1, &offset));
+	zassert_equal(offset, 1000);
+}
+
 ZTEST(bitarray, test_bitarray_region_set_clear)
 {
 	int ret;
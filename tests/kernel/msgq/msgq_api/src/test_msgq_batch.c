@@ -0,0 +1,254 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 8
+#define N_WORKERS 2
+#define N_STRESS_MSGS 1000
+
+K_THREAD_STACK_DECLARE(tstack, STACK_SIZE);
+extern struct k_thread tdata;
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, 2 * N_WORKERS, STACK_SIZE);
+static struct k_thread worker_threads[2 * N_WORKERS];
+
+static char __aligned(4) bbuffer[MSG_SIZE * BATCH_LEN];
+static struct k_msgq bmsgq;
+
+#ifdef CONFIG_MSGQ_LOCKLESS
+K_MSGQ_LOCKLESS_DEFINE(kmsgq_lockless, MSG_SIZE, BATCH_LEN, 4);
+static struct k_msgq lmsgq;
+static atomic_t lseq[BATCH_LEN];
+#endif
+
+static uint32_t stress_sum[N_WORKERS];
+
+static void batch_put_get(struct k_msgq *q)
+{
+	uint32_t tx[BATCH_LEN + 2], rx[BATCH_LEN + 2];
+	uint32_t next_rx = 0U;
+
+	for (int i = 0; i < ARRAY_SIZE(tx); i++) {
+		tx[i] = MSG0 + i;
+	}
+
+	zassert_equal(k_msgq_put_n(q, tx, 0, K_NO_WAIT), -EINVAL);
+
+	/**TESTPOINT: only as many messages as fit are sent */
+	zassert_equal(k_msgq_put_n(q, tx, ARRAY_SIZE(tx), K_NO_WAIT), BATCH_LEN);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN);
+	zassert_equal(k_msgq_put_n(q, tx, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_put_n(q, tx, 1, TIMEOUT), -EAGAIN);
+
+	zassert_equal(k_msgq_get_n(q, rx, 3, K_NO_WAIT), 3);
+	for (int i = 0; i < 3; i++) {
+		zassert_equal(rx[i], tx[next_rx++]);
+	}
+
+	/**TESTPOINT: batches wrap around the end of the ring */
+	zassert_equal(k_msgq_put_n(q, &tx[BATCH_LEN], 2, K_NO_WAIT), 2);
+	zassert_equal(k_msgq_num_free_get(q), 1);
+
+	/**TESTPOINT: only as many messages as queued are received */
+	zassert_equal(k_msgq_get_n(q, rx, ARRAY_SIZE(rx), K_NO_WAIT),
+		      BATCH_LEN - 1);
+	for (int i = 0; i < BATCH_LEN - 1; i++) {
+		zassert_equal(rx[i], tx[next_rx++]);
+	}
+
+	zassert_equal(k_msgq_num_used_get(q), 0);
+	zassert_equal(k_msgq_get_n(q, rx, 1, K_NO_WAIT), -ENOMSG);
+	zassert_equal(k_msgq_get_n(q, rx, 1, TIMEOUT), -EAGAIN);
+}
+
+static void pending_reader(void *p1, void *p2, void *p3)
+{
+	uint32_t rx[BATCH_LEN];
+
+	/* Blocks first, then takes what is left of the batch */
+	zassert_equal(k_msgq_get_n(p1, rx, 1, K_FOREVER), 1);
+	zassert_equal(rx[0], MSG0);
+	zassert_equal(k_msgq_get_n(p1, rx, BATCH_LEN, K_NO_WAIT), 2);
+	zassert_equal(rx[0], MSG0 + 1);
+	zassert_equal(rx[1], MSG0 + 2);
+}
+
+static void pending_writer(void *p1, void *p2, void *p3)
+{
+	uint32_t tx = MSG1;
+
+	zassert_equal(k_msgq_put_n(p1, &tx, 1, K_FOREVER), 1);
+}
+
+static void batch_pend(struct k_msgq *q)
+{
+	uint32_t msgs[BATCH_LEN];
+
+	for (int i = 0; i < BATCH_LEN; i++) {
+		msgs[i] = MSG0 + i;
+	}
+
+	/**TESTPOINT: a batch wakes up a blocked reader */
+	k_thread_create(&tdata, tstack, STACK_SIZE, pending_reader, q,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_put_n(q, msgs, 3, K_NO_WAIT), 3);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+
+	/**TESTPOINT: a batch receive wakes up a blocked writer */
+	zassert_equal(k_msgq_put_n(q, msgs, BATCH_LEN, K_NO_WAIT), BATCH_LEN);
+	k_thread_create(&tdata, tstack, STACK_SIZE, pending_writer, q,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+	zassert_equal(k_msgq_get_n(q, msgs, 2, K_NO_WAIT), 2);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN - 1);
+
+	k_msgq_purge(q);
+	zassert_equal(k_msgq_num_used_get(q), 0);
+}
+
+static void stress_writer(void *p1, void *p2, void *p3)
+{
+	uint32_t tx[3];
+	uint32_t sent = 0U;
+
+	while (sent < N_STRESS_MSGS) {
+		uint32_t n = MIN(ARRAY_SIZE(tx), N_STRESS_MSGS - sent);
+		int ret;
+
+		for (int i = 0; i < n; i++) {
+			tx[i] = sent + i + 1U;
+		}
+
+		ret = k_msgq_put_n(p1, tx, n, K_FOREVER);
+		zassert_true(ret > 0);
+		sent += ret;
+	}
+}
+
+static void stress_reader(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p2);
+	uint32_t rx[5];
+	int ret;
+
+	/* Writers are done once the queue stays empty */
+	while ((ret = k_msgq_get_n(p1, rx, ARRAY_SIZE(rx), TIMEOUT)) > 0) {
+		for (int i = 0; i < ret; i++) {
+			stress_sum[id] += rx[i];
+		}
+	}
+
+	zassert_equal(ret, -EAGAIN);
+}
+
+static void batch_stress(struct k_msgq *q)
+{
+	uint32_t total = 0U;
+
+	for (int i = 0; i < N_WORKERS; i++) {
+		stress_sum[i] = 0U;
+		k_thread_create(&worker_threads[i], worker_stacks[i], STACK_SIZE,
+				stress_reader, q, INT_TO_POINTER(i), NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		k_thread_create(&worker_threads[N_WORKERS + i],
+				worker_stacks[N_WORKERS + i], STACK_SIZE,
+				stress_writer, q, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < 2 * N_WORKERS; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < N_WORKERS; i++) {
+		total += stress_sum[i];
+	}
+
+	/**TESTPOINT: every message is received exactly once */
+	zassert_equal(total, N_WORKERS * (N_STRESS_MSGS * (N_STRESS_MSGS + 1) / 2));
+	zassert_equal(k_msgq_num_used_get(q), 0);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving batches of messages
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_batch)
+{
+	k_msgq_init(&bmsgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	batch_put_get(&bmsgq);
+	batch_pend(&bmsgq);
+}
+
+/**
+ * @brief Test concurrent batches from several writers and readers
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+ZTEST(msgq_api, test_msgq_batch_stress)
+{
+	k_msgq_init(&bmsgq, bbuffer, MSG_SIZE, BATCH_LEN);
+
+	batch_stress(&bmsgq);
+}
+
+/**
+ * @brief Test lock-free message queues
+ * @see k_msgq_lockless_init(), K_MSGQ_LOCKLESS_DEFINE()
+ */
+ZTEST(msgq_api_1cpu, test_msgq_lockless)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_MSGQ_LOCKLESS);
+
+#ifdef CONFIG_MSGQ_LOCKLESS
+	uint32_t tx = MSG0, rx;
+
+	zassert_equal(k_msgq_lockless_init(&lmsgq, bbuffer, lseq, MSG_SIZE,
+					   BATCH_LEN - 1), -EINVAL);
+	zassert_equal(k_msgq_lockless_init(&lmsgq, bbuffer, lseq, MSG_SIZE,
+					   BATCH_LEN), 0);
+
+	/**TESTPOINT: single messages, and peeking is refused */
+	zassert_equal(k_msgq_put(&lmsgq, &tx, K_NO_WAIT), 0);
+	zassert_equal(k_msgq_peek(&lmsgq, &rx), -ENOTSUP);
+	zassert_equal(k_msgq_get(&lmsgq, &rx, K_NO_WAIT), 0);
+	zassert_equal(rx, MSG0);
+	zassert_equal(k_msgq_get(&lmsgq, &rx, K_NO_WAIT), -ENOMSG);
+
+	batch_put_get(&lmsgq);
+	batch_pend(&lmsgq);
+	batch_put_get(&kmsgq_lockless);
+#endif
+}
+
+/**
+ * @brief Test concurrent batches on a lock-free message queue
+ * @see k_msgq_put_n(), k_msgq_get_n()
+ */
+ZTEST(msgq_api, test_msgq_lockless_stress)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_MSGQ_LOCKLESS);
+
+#ifdef CONFIG_MSGQ_LOCKLESS
+	zassert_equal(k_msgq_lockless_init(&lmsgq, bbuffer, lseq, MSG_SIZE,
+					   BATCH_LEN), 0);
+
+	batch_stress(&lmsgq);
+#endif
+}
+
+/**
+ * @}
+ */
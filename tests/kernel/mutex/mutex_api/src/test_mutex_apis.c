@@ -449,6 +449,50 @@ ZTEST(mutex_api_1cpu, test_mutex_timeout_race_during_priority_inversion)
 	k_mutex_unlock(&mutex);
 }
 
+/**
+ * @brief Test the contention counters of a mutex
+ *
+ * @see k_mutex_contention_get()
+ */
+ZTEST(mutex_api_1cpu, test_mutex_contention_stats)
+{
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+	struct k_obj_contention stats;
+
+	k_mutex_init(&mutex);
+	zassert_ok(k_mutex_lock(&mutex, K_FOREVER));
+
+	/**TESTPOINT: locking recursively is no contention */
+	zassert_ok(k_mutex_lock(&mutex, K_NO_WAIT));
+	k_mutex_unlock(&mutex);
+	k_mutex_contention_get(&mutex, &stats);
+	zassert_equal(stats.contended, 0);
+
+	/**TESTPOINT: a failed attempt does not block */
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			tThread_entry_lock_no_wait, &mutex, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_thread_join(&tdata, K_FOREVER);
+	k_mutex_contention_get(&mutex, &stats);
+	zassert_equal(stats.contended, 1);
+	zassert_equal(stats.blocked, 0);
+
+	/**TESTPOINT: a waiter blocks */
+	k_thread_create(&tdata, tstack, STACK_SIZE,
+			tThread_entry_lock_timeout_pass, &mutex, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(100);
+	k_mutex_unlock(&mutex);
+	k_thread_join(&tdata, K_FOREVER);
+	k_mutex_contention_get(&mutex, &stats);
+	zassert_equal(stats.contended, 2);
+	zassert_equal(stats.blocked, 1);
+	zassert_equal(stats.spin_acquired, 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void *mutex_api_tests_setup(void)
 {
 #ifdef CONFIG_USERSPACE
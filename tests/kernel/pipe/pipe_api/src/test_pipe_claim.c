@@ -0,0 +1,223 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for zero-copy and vectored pipe transfers
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <zephyr/ztest.h>
+
+#define PIPE_SIZE 8
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WAIT_MS 100
+
+static unsigned char __aligned(4) claim_buf[PIPE_SIZE];
+static struct k_pipe claim_pipe;
+
+static K_THREAD_STACK_DEFINE(claim_stack, STACK_SIZE);
+static struct k_thread claim_thread;
+
+static void put_claimed(const char *str, size_t len)
+{
+	unsigned char *data;
+	size_t claimed;
+	size_t done = 0;
+
+	while (done < len) {
+		claimed = k_pipe_put_claim(&claim_pipe, &data, len - done);
+		zassert_true(claimed > 0, "no space claimed");
+		memcpy(data, &str[done], claimed);
+		done += claimed;
+	}
+
+	zassert_ok(k_pipe_put_finish(&claim_pipe, len));
+}
+
+static void get_claimed(const char *expected, size_t len)
+{
+	unsigned char *data;
+	size_t claimed;
+	size_t done = 0;
+
+	while (done < len) {
+		claimed = k_pipe_get_claim(&claim_pipe, &data, len - done);
+		zassert_true(claimed > 0, "no data claimed");
+		zassert_mem_equal(data, &expected[done], claimed);
+		done += claimed;
+	}
+
+	zassert_ok(k_pipe_get_finish(&claim_pipe, len));
+}
+
+static void pending_reader(void *p1, void *p2, void *p3)
+{
+	unsigned char rx[4];
+	size_t bytes_read;
+
+	zassert_ok(k_pipe_get(&claim_pipe, rx, sizeof(rx), &bytes_read,
+			      sizeof(rx), K_FOREVER));
+	zassert_equal(bytes_read, sizeof(rx));
+	zassert_mem_equal(rx, "wxyz", sizeof(rx));
+}
+
+static void pending_writer(void *p1, void *p2, void *p3)
+{
+	size_t bytes_written;
+
+	zassert_ok(k_pipe_put(&claim_pipe, "WXYZ", 4, &bytes_written, 4,
+			      K_FOREVER));
+	zassert_equal(bytes_written, 4);
+}
+
+/**
+ * @brief Test claiming pipe buffer space and data
+ *
+ * @see k_pipe_put_claim(), k_pipe_put_finish(), k_pipe_get_claim(),
+ * k_pipe_get_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim)
+{
+	unsigned char *data;
+	unsigned char rx;
+	size_t bytes;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	put_claimed("abcde", 5);
+	get_claimed("abc", 3);
+
+	/**TESTPOINT: claims are contiguous, and stop at the buffer's end */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, PIPE_SIZE), 3);
+	zassert_equal(data, &claim_buf[5]);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, PIPE_SIZE), 3);
+	zassert_equal(data, &claim_buf[0]);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, PIPE_SIZE), 0);
+
+	/**TESTPOINT: claimed space is only visible once committed */
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 2);
+	memcpy(&claim_buf[5], "fgh", 3);
+	memcpy(&claim_buf[0], "ijk", 3);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 5));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 7);
+
+	/**TESTPOINT: only released data leaves the pipe */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 4), 4);
+	zassert_mem_equal(data, "defg", 4);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 1));
+	get_claimed("efghij", 6);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, PIPE_SIZE), 0);
+
+	/**TESTPOINT: finishing more than claimed is refused */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 2), 2);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 3), -EINVAL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 1), -EINVAL);
+
+	/**TESTPOINT: copying transfers are refused while claimed */
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+	put_claimed("lmno", 4);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 2), 2);
+	zassert_equal(k_pipe_get(&claim_pipe, &rx, 1, &bytes, 0, K_NO_WAIT),
+		      -EBUSY);
+	zassert_equal(bytes, 0);
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &data, 1), 1);
+	zassert_equal(k_pipe_put(&claim_pipe, "p", 1, &bytes, 0, K_NO_WAIT),
+		      -EBUSY);
+	zassert_equal(bytes, 0);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 0));
+
+	/**TESTPOINT: flushing drops the claimed data with the rest */
+	k_pipe_buffer_flush(&claim_pipe);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, 2), -EINVAL);
+	zassert_ok(k_pipe_put(&claim_pipe, "p", 1, &bytes, 1, K_NO_WAIT));
+	zassert_ok(k_pipe_get(&claim_pipe, &rx, 1, &bytes, 1, K_NO_WAIT));
+	zassert_equal(rx, 'p');
+}
+
+/**
+ * @brief Test claims against readers and writers blocked on the pipe
+ *
+ * @see k_pipe_put_finish(), k_pipe_get_finish()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_claim_pending)
+{
+	unsigned char *data;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	/**TESTPOINT: committed data goes to a blocked reader */
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, pending_reader,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(WAIT_MS);
+	put_claimed("wxyz", 4);
+	zassert_ok(k_thread_join(&claim_thread, K_MSEC(WAIT_MS)));
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0);
+
+	/**TESTPOINT: released space is refilled by a blocked writer */
+	put_claimed("abcdefgh", PIPE_SIZE);
+	k_thread_create(&claim_thread, claim_stack, STACK_SIZE, pending_writer,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(WAIT_MS);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &data, 4), 4);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 4));
+	zassert_ok(k_thread_join(&claim_thread, K_MSEC(WAIT_MS)));
+	get_claimed("efghWXYZ", PIPE_SIZE);
+}
+
+/**
+ * @brief Test vectored pipe transfers
+ *
+ * @see k_pipe_put_iov(), k_pipe_get_iov()
+ */
+ZTEST(pipe_api_1cpu, test_pipe_iov)
+{
+	char a[3] = "abc", b[4] = "defg", c[4] = "hijk";
+	char x[2], y[6];
+	struct k_pipe_iovec put_iov[] = {
+		{ .base = a, .len = sizeof(a) },
+		{ .base = NULL, .len = 0 },
+		{ .base = b, .len = sizeof(b) },
+		{ .base = c, .len = sizeof(c) },
+	};
+	struct k_pipe_iovec get_iov[] = {
+		{ .base = x, .len = sizeof(x) },
+		{ .base = y, .len = sizeof(y) },
+	};
+	size_t bytes;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	zassert_equal(k_pipe_put_iov(&claim_pipe, put_iov, ARRAY_SIZE(put_iov),
+				     &bytes, 12, K_NO_WAIT), -EINVAL);
+
+	/**TESTPOINT: segments are written in order, as far as they fit */
+	zassert_ok(k_pipe_put_iov(&claim_pipe, put_iov, 3, &bytes, 7,
+				  K_NO_WAIT));
+	zassert_equal(bytes, 7);
+	zassert_equal(k_pipe_put_iov(&claim_pipe, &put_iov[3], 1, &bytes, 2,
+				     K_NO_WAIT), -EIO);
+	zassert_equal(bytes, 1);
+
+	/**TESTPOINT: segments are filled in order */
+	zassert_ok(k_pipe_get_iov(&claim_pipe, get_iov, ARRAY_SIZE(get_iov),
+				  &bytes, 1, K_NO_WAIT));
+	zassert_equal(bytes, PIPE_SIZE);
+	zassert_mem_equal(x, "ab", 2);
+	zassert_mem_equal(y, "cdefgh", 6);
+
+	/**TESTPOINT: the minimum applies to the total, with timeouts */
+	zassert_equal(k_pipe_get_iov(&claim_pipe, get_iov, ARRAY_SIZE(get_iov),
+				     &bytes, 1, K_MSEC(WAIT_MS)), -EAGAIN);
+	zassert_equal(bytes, 0);
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,171 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define NUM_SEMS 16
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WAIT_MS 100
+
+static struct k_sem set_sems[NUM_SEMS];
+static struct k_poll_signal set_signal;
+static struct k_fifo set_fifo;
+static struct k_poll_event set_events[NUM_SEMS + 2];
+static K_POLL_SET_DEFINE(poll_set);
+
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+static struct k_thread set_thread;
+
+static struct fifo_item {
+	intptr_t reserved;
+} set_fifo_item;
+
+static void set_setup(void)
+{
+	for (int i = 0; i < NUM_SEMS; i++) {
+		k_sem_init(&set_sems[i], 0, 1);
+		k_poll_event_init(&set_events[i], K_POLL_TYPE_SEM_AVAILABLE,
+				  K_POLL_MODE_NOTIFY_ONLY, &set_sems[i]);
+	}
+
+	k_poll_signal_init(&set_signal);
+	k_poll_event_init(&set_events[NUM_SEMS], K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_signal);
+
+	k_fifo_init(&set_fifo);
+	k_poll_event_init(&set_events[NUM_SEMS + 1],
+			  K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &set_fifo);
+
+	for (int i = 0; i < ARRAY_SIZE(set_events); i++) {
+		zassert_ok(k_poll_set_add(&poll_set, &set_events[i]));
+	}
+}
+
+static void set_teardown(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(set_events); i++) {
+		zassert_ok(k_poll_set_remove(&poll_set, &set_events[i]));
+	}
+}
+
+static void set_giver(void *p1, void *p2, void *p3)
+{
+	k_msleep(WAIT_MS);
+	k_sem_give(&set_sems[NUM_SEMS - 1]);
+}
+
+/**
+ * @brief Test readiness reporting of a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_add(), k_poll_set_wait(), k_poll_set_remove()
+ */
+ZTEST(poll_api_1cpu, test_poll_set)
+{
+	struct k_poll_event *ready[4];
+	struct k_poll_event *first;
+
+	set_setup();
+
+	zassert_equal(k_poll_set_wait(&poll_set, ready, 0, K_NO_WAIT), -EINVAL);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	/**TESTPOINT: only the ready event is reported */
+	k_sem_give(&set_sems[3]);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[3]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE);
+
+	/**TESTPOINT: readiness lasts as long as the object is available */
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_ok(k_sem_take(&set_sems[3], K_NO_WAIT));
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	/**TESTPOINT: events are registered again once consumed */
+	k_sem_give(&set_sems[3]);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[3]);
+	zassert_ok(k_sem_take(&set_sems[3], K_NO_WAIT));
+
+	/**TESTPOINT: ready events beyond the array are returned next */
+	k_sem_give(&set_sems[5]);
+	k_sem_give(&set_sems[7]);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, 1, K_NO_WAIT), 1);
+	first = ready[0];
+	zassert_equal(k_poll_set_wait(&poll_set, ready, 1, K_NO_WAIT), 1);
+	zassert_not_equal(ready[0], first);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 2);
+	zassert_ok(k_sem_take(&set_sems[5], K_NO_WAIT));
+	zassert_ok(k_sem_take(&set_sems[7], K_NO_WAIT));
+
+	/**TESTPOINT: signals and FIFOs */
+	k_poll_signal_raise(&set_signal, 0x1337);
+	k_fifo_put(&set_fifo, &set_fifo_item);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 2);
+	zassert_equal_ptr(ready[0], &set_events[NUM_SEMS]);
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED);
+	zassert_equal_ptr(ready[1], &set_events[NUM_SEMS + 1]);
+	zassert_equal(ready[1]->state, K_POLL_STATE_FIFO_DATA_AVAILABLE);
+	k_poll_signal_reset(&set_signal);
+	zassert_equal_ptr(k_fifo_get(&set_fifo, K_NO_WAIT), &set_fifo_item);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	/**TESTPOINT: an event can only be in one set, and only once */
+	zassert_equal(k_poll_set_add(&poll_set, &set_events[0]), -EBUSY);
+	zassert_ok(k_poll_set_remove(&poll_set, &set_events[0]));
+	zassert_equal(k_poll_set_remove(&poll_set, &set_events[0]), -EINVAL);
+	k_sem_give(&set_sems[0]);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), -EAGAIN);
+
+	/**TESTPOINT: an event added while ready is reported */
+	zassert_ok(k_poll_set_add(&poll_set, &set_events[0]));
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_NO_WAIT), 1);
+	zassert_equal_ptr(ready[0], &set_events[0]);
+	zassert_ok(k_sem_take(&set_sems[0], K_NO_WAIT));
+
+	set_teardown();
+}
+
+/**
+ * @brief Test waiting on a poll set
+ *
+ * @ingroup kernel_poll_tests
+ *
+ * @see k_poll_set_wait()
+ */
+ZTEST(poll_api_1cpu, test_poll_set_wait)
+{
+	struct k_poll_event *ready[2];
+
+	set_setup();
+
+	/**TESTPOINT: time out when nothing gets ready */
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(WAIT_MS)), -EAGAIN);
+
+	/**TESTPOINT: wake up when an object gets available */
+	k_thread_create(&set_thread, set_stack, STACK_SIZE, set_giver,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(k_poll_set_wait(&poll_set, ready, ARRAY_SIZE(ready),
+				      K_FOREVER), 1);
+	zassert_equal_ptr(ready[0], &set_events[NUM_SEMS - 1]);
+	zassert_ok(k_sem_take(&set_sems[NUM_SEMS - 1], K_NO_WAIT));
+	k_thread_join(&set_thread, K_FOREVER);
+
+	set_teardown();
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+
+#define TIMEOUT 100
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define THREAD_HIGH_PRIORITY 1
+#define THREAD_LOW_PRIORITY 5
+
+/**TESTPOINT: init via K_RWLOCK_DEFINE*/
+K_RWLOCK_DEFINE(krwlock, 0);
+static struct k_rwlock rwlock;
+
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static K_THREAD_STACK_DEFINE(tstack2, STACK_SIZE);
+static struct k_thread tdata;
+static struct k_thread tdata2;
+
+static ZTEST_DMEM int thread_ret;
+
+static void tThread_entry_read_no_wait(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_rwlock_read_lock((struct k_rwlock *)p1, K_NO_WAIT);
+	if (thread_ret == 0) {
+		k_rwlock_read_unlock((struct k_rwlock *)p1);
+	}
+}
+
+static void tThread_entry_read_timeout(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_rwlock_read_lock((struct k_rwlock *)p1, K_MSEC(TIMEOUT));
+	if (thread_ret == 0) {
+		k_rwlock_read_unlock((struct k_rwlock *)p1);
+	}
+}
+
+static void tThread_entry_write_forever(void *p1, void *p2, void *p3)
+{
+	thread_ret = k_rwlock_write_lock((struct k_rwlock *)p1, K_FOREVER);
+	if (thread_ret == 0) {
+		k_rwlock_write_unlock((struct k_rwlock *)p1);
+	}
+}
+
+static k_tid_t spawn(struct k_thread *thread, k_thread_stack_t *stack,
+		     k_thread_entry_t entry, struct k_rwlock *lock, int prio)
+{
+	return k_thread_create(thread, stack, STACK_SIZE, entry, lock, NULL, NULL,
+			       K_PRIO_PREEMPT(prio), K_USER | K_INHERIT_PERMS,
+			       K_NO_WAIT);
+}
+
+static void rwlock_test_lock_unlock(struct k_rwlock *lock)
+{
+	/** TESTPOINT: several readers, or one writer */
+	zassert_ok(k_rwlock_read_lock(lock, K_FOREVER));
+	zassert_ok(k_rwlock_read_lock(lock, K_NO_WAIT));
+	zassert_equal(k_rwlock_write_lock(lock, K_NO_WAIT), -EBUSY);
+	zassert_equal(k_rwlock_write_lock(lock, K_MSEC(TIMEOUT)), -EAGAIN);
+	zassert_equal(k_rwlock_write_unlock(lock), -EPERM);
+	zassert_ok(k_rwlock_read_unlock(lock));
+	zassert_ok(k_rwlock_read_unlock(lock));
+	zassert_equal(k_rwlock_read_unlock(lock), -EINVAL);
+
+	zassert_ok(k_rwlock_write_lock(lock, K_FOREVER));
+	zassert_equal(k_rwlock_write_lock(lock, K_NO_WAIT), -EDEADLK);
+	zassert_equal(k_rwlock_read_lock(lock, K_NO_WAIT), -EDEADLK);
+	zassert_ok(k_rwlock_write_unlock(lock));
+	zassert_equal(k_rwlock_write_unlock(lock), -EPERM);
+
+	zassert_ok(k_rwlock_write_lock(lock, K_NO_WAIT));
+	zassert_ok(k_rwlock_write_unlock(lock));
+}
+
+/**
+ * @brief Test locking and unlocking a reader/writer lock
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST_USER(rwlock_api, test_rwlock_lock_unlock)
+{
+	rwlock_test_lock_unlock(&krwlock);
+
+	zassert_ok(k_rwlock_init(&rwlock, 0));
+	rwlock_test_lock_unlock(&rwlock);
+
+	zassert_ok(k_rwlock_init(&rwlock, K_RWLOCK_PREFER_WRITER));
+	rwlock_test_lock_unlock(&rwlock);
+
+	zassert_equal(k_rwlock_init(&rwlock, BIT(31)), -EINVAL);
+}
+
+/**
+ * @brief Test that readers wait for a writer, until it unlocks
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST_USER(rwlock_api_1cpu, test_rwlock_reader_wait)
+{
+	zassert_ok(k_rwlock_init(&rwlock, 0));
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_FOREVER));
+
+	thread_ret = 1;
+	spawn(&tdata, tstack, tThread_entry_read_timeout, &rwlock, THREAD_LOW_PRIORITY);
+	k_msleep(TIMEOUT * 2);
+	zassert_equal(thread_ret, -EAGAIN);
+	k_thread_join(&tdata, K_FOREVER);
+
+	thread_ret = 1;
+	spawn(&tdata, tstack, tThread_entry_read_timeout, &rwlock, THREAD_LOW_PRIORITY);
+	k_msleep(TIMEOUT / 2);
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(thread_ret, 0);
+}
+
+/**
+ * @brief Test that waiting writers only stop new readers with
+ * K_RWLOCK_PREFER_WRITER
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST_USER(rwlock_api_1cpu, test_rwlock_preference)
+{
+	uint32_t flags[] = { 0, K_RWLOCK_PREFER_WRITER };
+
+	for (int i = 0; i < ARRAY_SIZE(flags); i++) {
+		zassert_ok(k_rwlock_init(&rwlock, flags[i]));
+		zassert_ok(k_rwlock_read_lock(&rwlock, K_FOREVER));
+
+		/* The writer runs first and waits for the reader. */
+		spawn(&tdata, tstack, tThread_entry_write_forever, &rwlock,
+		      THREAD_HIGH_PRIORITY);
+
+		thread_ret = 1;
+		spawn(&tdata2, tstack2, tThread_entry_read_no_wait, &rwlock,
+		      THREAD_HIGH_PRIORITY);
+		k_thread_join(&tdata2, K_FOREVER);
+		zassert_equal(thread_ret, (flags[i] == 0U) ? 0 : -EBUSY);
+
+		zassert_ok(k_rwlock_read_unlock(&rwlock));
+		k_thread_join(&tdata, K_FOREVER);
+		zassert_equal(thread_ret, 0);
+	}
+}
+
+/**
+ * @brief Test that the writer inherits the priority of waiting threads
+ *
+ * @ingroup kernel_rwlock_tests
+ */
+ZTEST(rwlock_api_1cpu, test_rwlock_priority_inheritance)
+{
+	int prio = k_thread_priority_get(k_current_get());
+
+	k_thread_priority_set(k_current_get(), K_PRIO_PREEMPT(THREAD_LOW_PRIORITY));
+
+	zassert_ok(k_rwlock_init(&rwlock, 0));
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_FOREVER));
+
+	thread_ret = 1;
+	spawn(&tdata, tstack, tThread_entry_read_timeout, &rwlock, THREAD_HIGH_PRIORITY);
+
+	/* The reader preempted the writer and waits for it. */
+	zassert_equal(k_thread_priority_get(k_current_get()),
+		      K_PRIO_PREEMPT(THREAD_HIGH_PRIORITY));
+
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+
+	/* The reader ran, got the lock and returned. */
+	zassert_equal(thread_ret, 0);
+	zassert_equal(k_thread_priority_get(k_current_get()),
+		      K_PRIO_PREEMPT(THREAD_LOW_PRIORITY));
+
+	k_thread_join(&tdata, K_FOREVER);
+
+	/* Timing out gives the inherited priority back. */
+	zassert_ok(k_rwlock_write_lock(&rwlock, K_FOREVER));
+	spawn(&tdata, tstack, tThread_entry_read_timeout, &rwlock, THREAD_HIGH_PRIORITY);
+	zassert_equal(k_thread_priority_get(k_current_get()),
+		      K_PRIO_PREEMPT(THREAD_HIGH_PRIORITY));
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(thread_ret, -EAGAIN);
+	zassert_equal(k_thread_priority_get(k_current_get()),
+		      K_PRIO_PREEMPT(THREAD_LOW_PRIORITY));
+	zassert_ok(k_rwlock_write_unlock(&rwlock));
+
+	k_thread_priority_set(k_current_get(), prio);
+}
+
+static void *rwlock_api_tests_setup(void)
+{
+#ifdef CONFIG_USERSPACE
+	k_thread_access_grant(k_current_get(), &tdata, &tstack, &tdata2,
+			      &tstack2, &krwlock, &rwlock);
+#endif
+	return NULL;
+}
+
+ZTEST_SUITE(rwlock_api, NULL, rwlock_api_tests_setup, NULL, NULL, NULL);
+ZTEST_SUITE(rwlock_api_1cpu, NULL, rwlock_api_tests_setup,
+	    ztest_simple_1cpu_before, ztest_simple_1cpu_after, NULL);
@@ -1147,6 +1147,52 @@ ZTEST(semaphore_1cpu, test_sem_queue_mutual_exclusion)
 	k_thread_join(&sem_tid_2, K_FOREVER);
 }
 
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+static void sem_take_contended(void *p1, void *p2, void *p3)
+{
+	zassert_ok(k_sem_take(&sema, K_FOREVER));
+}
+#endif
+
+/**
+ * @brief Test the contention counters of a semaphore
+ *
+ * @ingroup kernel_semaphore_tests
+ *
+ * @see k_sem_contention_get()
+ */
+ZTEST(semaphore_1cpu, test_sem_contention_stats)
+{
+#ifdef CONFIG_KERNEL_CONTENTION_STATS
+	struct k_obj_contention stats;
+
+	expect_k_sem_init_nomsg(&sema, 1, 1, 0);
+	expect_k_sem_take_nomsg(&sema, K_NO_WAIT, 0);
+	k_sem_contention_get(&sema, &stats);
+	zassert_equal(stats.contended, 0);
+
+	/**TESTPOINT: a failed attempt does not block */
+	expect_k_sem_take_nomsg(&sema, K_NO_WAIT, -EBUSY);
+	k_sem_contention_get(&sema, &stats);
+	zassert_equal(stats.contended, 1);
+	zassert_equal(stats.blocked, 0);
+
+	/**TESTPOINT: a waiter blocks */
+	k_thread_create(&sem_tid_1, stack_1, STACK_SIZE,
+			sem_take_contended, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(THREAD_TEST_PRIORITY), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(100));
+	k_sem_give(&sema);
+	k_thread_join(&sem_tid_1, K_FOREVER);
+	k_sem_contention_get(&sema, &stats);
+	zassert_equal(stats.contended, 2);
+	zassert_equal(stats.blocked, 1);
+	zassert_equal(stats.spin_acquired, 0);
+#else
+	ztest_test_skip();
+#endif
+}
+
 #ifdef CONFIG_USERSPACE
 static void thread_sem_give_null(void *p1, void *p2, void *p3)
 {
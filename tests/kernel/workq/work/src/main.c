@@ -120,6 +120,9 @@ static inline int preempt_counter(void)
 static K_THREAD_STACK_DEFINE(invalid_test_stack, STACK_SIZE);
 static struct k_work_q invalid_test_queue;
 
+static K_THREAD_STACK_DEFINE(budget_stack, STACK_SIZE);
+static struct k_work_q budget_queue;
+
 static atomic_t system_ctr;
 static inline int system_counter(void)
 {
@@ -1318,6 +1321,103 @@ ZTEST(work_1cpu, test_1cpu_queue_no_yield)
 	k_sem_init(&sync_sem, 0, 1);
 }
 
+/* Submit several items with one operation. */
+ZTEST(work_1cpu, test_1cpu_submit_batch)
+{
+	static struct k_work items[3];
+	struct k_work *batch[ARRAY_SIZE(items) + 1];
+	int rc;
+
+	reset_counters();
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		k_work_init(&items[i], counter_handler);
+		batch[i] = &items[i];
+	}
+
+	/* An item listed twice is only queued once */
+	batch[ARRAY_SIZE(items)] = &items[0];
+
+	/* The whole batch is rejected by a queue that isn't running */
+	rc = k_work_submit_batch_to_queue(&not_start_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, -ENODEV);
+	zassert_equal(k_work_busy_get(&items[0]), 0);
+
+	rc = k_work_submit_batch_to_queue(&cooplo_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, ARRAY_SIZE(items));
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(k_work_busy_get(&items[i]), K_WORK_QUEUED);
+	}
+
+	/* Resubmitting queued items is a no-op */
+	rc = k_work_submit_batch_to_queue(&cooplo_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, 0);
+
+	/* The queue is lower priority: nothing ran yet */
+	zassert_equal(cooplo_counter(), 0);
+
+	rc = k_work_queue_drain(&cooplo_queue, false);
+	zassert_equal(rc, 1);
+	zassert_equal(cooplo_counter(), ARRAY_SIZE(items));
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+
+	/* Flush the sync state from completion */
+	zassert_equal(k_sem_take(&sync_sem, K_NO_WAIT), 0);
+}
+
+/* Run a batch on a queue yielding only every few items. */
+ZTEST(work_1cpu, test_1cpu_queue_budget)
+{
+	static struct k_work items[4];
+	struct k_work *batch[ARRAY_SIZE(items)];
+	struct k_work_queue_config cfg = {
+		.name = "wq.budget",
+		.budget = ARRAY_SIZE(items),
+	};
+	int rc;
+
+	reset_counters();
+	k_work_queue_start(&budget_queue, budget_stack, STACK_SIZE,
+			   PREEMPT_PRIORITY, &cfg);
+	zassert_equal(budget_queue.budget, ARRAY_SIZE(items));
+
+	/* Let the queue thread wait for work */
+	k_sleep(K_TICKS(1));
+
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		k_work_init(&items[i], counter_handler);
+		batch[i] = &items[i];
+	}
+
+	rc = k_work_submit_batch_to_queue(&budget_queue, batch,
+					  ARRAY_SIZE(batch));
+	zassert_equal(rc, ARRAY_SIZE(items));
+
+	rc = k_work_queue_drain(&budget_queue, false);
+	zassert_equal(rc, 1);
+	for (int i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(k_work_busy_get(&items[i]), 0);
+	}
+
+#ifdef CONFIG_WORK_QUEUE_STATS
+	k_thread_runtime_stats_t stats;
+
+	/* The whole batch was run on a single wakeup */
+	rc = k_thread_runtime_stats_get(k_work_queue_thread_get(&budget_queue),
+					&stats);
+	zassert_equal(rc, 0);
+	zassert_equal(stats.work_items, ARRAY_SIZE(items));
+	zassert_equal(stats.work_wakeups, 1);
+#endif
+
+	/* Flush the sync state from completion */
+	zassert_equal(k_sem_take(&sync_sem, K_NO_WAIT), 0);
+}
+
 /* Basic functionality with the system work queue. */
 ZTEST(work_1cpu, test_1cpu_system_queue)
 {
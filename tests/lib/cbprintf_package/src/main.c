@@ -88,9 +88,20 @@ static void unpack(const char *desc, struct out_buffer *buf,
 	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) \
 		package[len + ALIGN_OFFSET];\
 	int outlen; \
+	memset(package, 0, len + ALIGN_OFFSET); \
 	pkg = &package[ALIGN_OFFSET]; \
 	CBPRINTF_STATIC_PACKAGE(pkg, len, outlen, ALIGN_OFFSET, flags, fmt, __VA_ARGS__);\
 	zassert_equal(len, outlen); \
+	/* Precompiled package is identical to the static one. */ \
+	CBPRINTF_PRECOMPILED_PACKAGE(NULL, 0, outlen, ALIGN_OFFSET, flags, fmt, __VA_ARGS__); \
+	zassert_equal(len, outlen); \
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) \
+		pre_package[len + ALIGN_OFFSET];\
+	memset(pre_package, 0, len + ALIGN_OFFSET); \
+	CBPRINTF_PRECOMPILED_PACKAGE(&pre_package[ALIGN_OFFSET], len, outlen, \
+				     ALIGN_OFFSET, flags, fmt, __VA_ARGS__); \
+	zassert_equal(len, outlen); \
+	zassert_equal(memcmp(pkg, &pre_package[ALIGN_OFFSET], len), 0); \
 	dump("static", pkg, len); \
 	unpack("static", &st_buf, pkg, len); \
 } while (0)
@@ -898,6 +909,82 @@ ZTEST(cbprintf_package, test_cbprintf_package_convert)
  *
  * @return NULL as we are not supplying any fixture object.
  */
+ZTEST(cbprintf_package, test_cbprintf_precompiled_package)
+{
+	static const char *str = "test";
+	char rw_str[] = "rw";
+	char *pstr = rw_str;
+	long long lli = 0x1122334455667788;
+	int len, plen;
+
+#define PRE_FLAGS (CBPRINTF_PACKAGE_ADD_RO_STR_POS | CBPRINTF_PACKAGE_ADD_RW_STR_POS | \
+		   CBPRINTF_PACKAGE_FIRST_RO_STR_CNT(1))
+#define TEST_FMT "test %s %d %s %llx %s", str, 100, pstr, lli, (const char *)rw_str
+	CBPRINTF_STATIC_PACKAGE(NULL, 0, len, ALIGN_OFFSET, PRE_FLAGS, TEST_FMT);
+	CBPRINTF_PRECOMPILED_PACKAGE(NULL, 0, plen, ALIGN_OFFSET, PRE_FLAGS, TEST_FMT);
+	zassert_true(len > 0);
+	zassert_equal(len, plen);
+
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) package[len + ALIGN_OFFSET];
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) ppackage[len + ALIGN_OFFSET];
+
+	memset(package, 0, sizeof(package));
+	memset(ppackage, 0, sizeof(ppackage));
+
+	CBPRINTF_STATIC_PACKAGE(&package[ALIGN_OFFSET], len, len, ALIGN_OFFSET, PRE_FLAGS,
+				TEST_FMT);
+	/* Nothing is stored when the buffer is too small. */
+	CBPRINTF_PRECOMPILED_PACKAGE(&ppackage[ALIGN_OFFSET], len - 1, plen, ALIGN_OFFSET,
+				     PRE_FLAGS, TEST_FMT);
+	zassert_equal(plen, -ENOSPC);
+	CBPRINTF_PRECOMPILED_PACKAGE(&ppackage[ALIGN_OFFSET], len, plen, ALIGN_OFFSET,
+				     PRE_FLAGS, TEST_FMT);
+	zassert_equal(len, plen);
+	zassert_equal(memcmp(package, ppackage, sizeof(package)), 0);
+
+	/* Format string and first string are read-only, other two are read-write. */
+	uint8_t *hdr = &ppackage[ALIGN_OFFSET];
+
+	zassert_equal(hdr[2], 2);
+	zassert_equal(hdr[3], 2);
+
+	char exp_str[64];
+
+	snprintfcb(exp_str, sizeof(exp_str), TEST_FMT);
+	check_package(&ppackage[ALIGN_OFFSET], len, exp_str);
+
+	if (Z_C_GENERIC) {
+		/* Read-write strings must be indicated in the flags. */
+		CBPRINTF_PRECOMPILED_PACKAGE(NULL, 0, plen, ALIGN_OFFSET, 0, TEST_FMT);
+		zassert_equal(plen, -EINVAL);
+	}
+#undef TEST_FMT
+#undef PRE_FLAGS
+}
+
+ZTEST(cbprintf_package, test_cbprintf_precompiled_layouts_check)
+{
+#if defined(CONFIG_CBPRINTF_PACKAGE_PRECOMPILED) && Z_C_GENERIC && !defined(__cplusplus)
+	uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) package[64];
+	static const char *str = "test";
+	char *pstr = (char *)str;
+	int len;
+
+	/* Only the character pointer used with %p is reported. */
+	CBPRINTF_PRECOMPILED_PACKAGE(package, sizeof(package), len, 0,
+				     CBPRINTF_PACKAGE_ADD_RW_STR_POS,
+				     "%s %p %p", pstr, (void *)pstr, pstr);
+	zassert_true(len > 0);
+	CBPRINTF_PRECOMPILED_PACKAGE(package, sizeof(package), len, 0,
+				     CBPRINTF_PACKAGE_ADD_RW_STR_POS, "%%p %s", pstr);
+	zassert_true(len > 0);
+
+	zassert_equal(cbprintf_package_layouts_check(), 1);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void *print_size_and_alignment_info(void)
 {
 #ifdef __cplusplus
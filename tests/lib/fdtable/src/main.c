@@ -175,4 +175,85 @@ ZTEST(fdtable, test_z_fd_multiple_access)
 	zassert_equal(errno, EBADF, "fd was found");
 }
 
+ZTEST(fdtable, test_z_reserve_fd_lowest)
+{
+	int fd1 = z_reserve_fd();
+	int fd2 = z_reserve_fd();
+	int fd3 = z_reserve_fd();
+
+	zassert_true(fd1 >= 0 && fd2 > fd1 && fd3 > fd2);
+
+	/* POSIX requires the lowest free descriptor to be used */
+	z_free_fd(fd2);
+	zassert_equal(z_reserve_fd(), fd2, "freed fd not reused");
+
+	z_free_fd(fd1);
+	z_free_fd(fd2);
+	z_free_fd(fd3);
+}
+
+ZTEST(fdtable, test_z_reserve_fd_all)
+{
+	int fds[CONFIG_POSIX_MAX_FDS];
+	int n;
+
+	/* every descriptor can be reserved, including in further chunks of a
+	 * dynamic table, then the table is full
+	 */
+	for (n = 0; n < ARRAY_SIZE(fds); n++) {
+		fds[n] = z_reserve_fd();
+		if (fds[n] < 0) {
+			break;
+		}
+
+		zassert_true(fds[n] < CONFIG_POSIX_MAX_FDS);
+		z_finalize_fd(fds[n], INT_TO_POINTER(n + 1), VTABLE_INIT);
+	}
+
+	zassert_true(n > 0);
+	zassert_equal(z_reserve_fd(), -1, "table not full");
+	zassert_equal(errno, ENFILE);
+
+	for (int i = 0; i < n; i++) {
+		zassert_equal_ptr(z_get_fd_obj(fds[i], VTABLE_INIT, EINVAL),
+				  INT_TO_POINTER(i + 1));
+		z_free_fd(fds[i]);
+	}
+}
+
+ZTEST(fdtable, test_z_fd_get)
+{
+	const struct fd_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	int fd, fd2;
+
+	fd = z_reserve_fd();
+	zassert_true(fd >= 0);
+
+	/* reserved, but not finalized */
+	zassert_equal(z_fd_get(fd, &obj, &vtable, NULL), -1);
+	zassert_equal(errno, EBADF);
+
+	z_finalize_fd(fd, &fd, VTABLE_INIT);
+
+	zassert_ok(z_fd_get(fd, &obj, &vtable, &lock));
+	zassert_equal_ptr(obj, &fd);
+	zassert_equal_ptr(vtable, VTABLE_INIT);
+	zassert_not_null(lock);
+
+	/* the reference keeps the descriptor from being reused */
+	z_free_fd(fd);
+	fd2 = z_reserve_fd();
+	zassert_true(fd2 >= 0);
+	zassert_not_equal(fd2, fd, "fd reused while referenced");
+	z_free_fd(fd2);
+	z_fd_put(fd);
+
+	zassert_equal(z_fd_get(fd, &obj, &vtable, NULL), -1);
+	zassert_equal(errno, EBADF);
+	zassert_equal(z_fd_get(-1, &obj, &vtable, NULL), -1);
+	zassert_equal(z_fd_get(CONFIG_POSIX_MAX_FDS, &obj, &vtable, NULL), -1);
+}
+
 ZTEST_SUITE(fdtable, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,123 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/sys/hash_map.h>
+
+#include "_main.h"
+
+/* Only the Concurrent Robin Hood Hashmap is thread-safe */
+#ifdef CONFIG_SYS_HASH_MAP_CHOICE_RH
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(reader_stack, STACK_SIZE);
+static struct k_thread reader_thread;
+static volatile bool done;
+static volatile size_t reader_errors;
+static volatile size_t reader_rounds;
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	uint64_t value;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!done) {
+		/* the lower half of the keys is never removed */
+		for (size_t i = 0; i < MANY / 2; ++i) {
+			if (!sys_hashmap_get(&map, i, &value) || value != i * 3) {
+				++reader_errors;
+			}
+		}
+
+		++reader_rounds;
+		k_yield();
+	}
+}
+
+ZTEST(hash_map, test_concurrent_get)
+{
+	for (size_t i = 0; i < MANY / 2; ++i) {
+		zassert_equal(1, sys_hashmap_insert(&map, i, i * 3, NULL));
+	}
+
+	done = false;
+	reader_errors = 0;
+	reader_rounds = 0;
+	k_thread_create(&reader_thread, reader_stack, STACK_SIZE, reader, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+
+	/* grow and shrink the upper half, so that the tables are migrated and reclaimed */
+	for (size_t round = 0; round < 8; ++round) {
+		for (size_t i = MANY / 2; i < MANY; ++i) {
+			zassert_equal(1, sys_hashmap_insert(&map, i, i * 3, NULL));
+			if (i % 8 == 0) {
+				/* let the reader run, it may have a lower priority */
+				k_sleep(K_TICKS(1));
+			}
+		}
+
+		for (size_t i = MANY / 2; i < MANY; ++i) {
+			zassert_true(sys_hashmap_remove(&map, i, NULL));
+		}
+
+		k_sleep(K_TICKS(1));
+	}
+
+	done = true;
+	k_thread_join(&reader_thread, K_FOREVER);
+
+	zassert_true(reader_rounds > 0);
+	zassert_equal(0, reader_errors, "%zu lookups failed", reader_errors);
+}
+
+ZTEST(hash_map, test_incremental_rehash)
+{
+	struct sys_hashmap_rh_data *data = (struct sys_hashmap_rh_data *)map.data;
+	size_t n_buckets;
+	uint64_t value;
+	size_t i;
+
+	/* fill a table larger than a migration step, then until it grows */
+	for (i = 0; sys_hashmap_num_buckets(&map) <= CONFIG_SYS_HASH_MAP_RH_REHASH_STEP; ++i) {
+		zassert_equal(1, sys_hashmap_insert(&map, i, i, NULL));
+	}
+
+	n_buckets = sys_hashmap_num_buckets(&map);
+	for (; sys_hashmap_num_buckets(&map) == n_buckets; ++i) {
+		zassert_equal(1, sys_hashmap_insert(&map, i, i, NULL));
+	}
+
+	/* growing only starts the migration, every entry remains reachable */
+	zassert_not_null(data->old);
+
+	for (size_t j = 0; j < i; ++j) {
+		zassert_true(sys_hashmap_get(&map, j, &value));
+		zassert_equal(j, value);
+	}
+
+	/* replace and remove entries that may still be in the old table */
+	zassert_equal(0, sys_hashmap_insert(&map, i - 1, 42, &value));
+	zassert_equal(i - 1, value);
+	zassert_true(sys_hashmap_remove(&map, i - 2, &value));
+	zassert_equal(i - 2, value);
+	zassert_false(sys_hashmap_contains_key(&map, i - 2));
+	zassert_equal(i - 1, sys_hashmap_size(&map));
+
+	/* the next updates complete the migration */
+	for (size_t j = 0; j < n_buckets; ++j) {
+		zassert_equal(0, sys_hashmap_insert(&map, i - 1, 42, NULL));
+	}
+
+	zassert_is_null(data->old);
+	zassert_true(sys_hashmap_get(&map, i - 1, &value));
+	zassert_equal(42, value);
+}
+
+#endif /* CONFIG_SYS_HASH_MAP_CHOICE_RH */
@@ -259,6 +259,11 @@ ZTEST(lib_heap, test_solo_free_header)
 
 	TC_PRINT("Testing solo free header in a heap\n");
 
+	/* The heap size above assumes the power-of-two bucket layout */
+	if (IS_ENABLED(CONFIG_SYS_HEAP_BUCKETS_TLSF)) {
+		ztest_test_skip();
+	}
+
 	sys_heap_init(&heap, heapmem, SOLO_FREE_HEADER_HEAP_SZ);
 	if (sizeof(void *) > 4U) {
 		sys_heap_alloc(&heap, 1);
@@ -485,4 +490,75 @@ ZTEST(lib_heap, test_heap_listeners)
 #endif /* CONFIG_SYS_HEAP_LISTENER */
 }
 
+ZTEST(lib_heap, test_tcache)
+{
+#ifdef CONFIG_SYS_HEAP_TCACHE
+	struct sys_heap heap;
+	struct sys_memory_stats stats;
+	void *blocks[CONFIG_SYS_HEAP_TCACHE_DEPTH + 1];
+	unsigned int key;
+	void *p;
+
+	sys_heap_init(&heap, heapmem, SMALL_HEAP_SZ);
+
+	/* The caches may only be used from a stable CPU */
+	key = arch_irq_lock();
+
+	/* Empty cache: the fast path misses, the slow path refills */
+	zassert_is_null(sys_heap_tcache_alloc(&heap, 0, 16), "");
+	p = sys_heap_tcache_refill(&heap, 0, 16);
+	zassert_not_null(p, "");
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.cache_misses, 1, "");
+	zassert_equal(stats.cached_bytes,
+		      (MIN(CONFIG_SYS_HEAP_TCACHE_DEPTH / 2, 8) - 1) *
+		      sys_heap_usable_size(&heap, p), "");
+
+	/* A block of the same size class comes from the cache */
+	blocks[0] = sys_heap_tcache_alloc(&heap, 0, 14);
+	zassert_not_null(blocks[0], "");
+	zassert_equal(sys_heap_usable_size(&heap, blocks[0]),
+		      sys_heap_usable_size(&heap, p), "");
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.cache_hits, 1, "");
+
+	/* Large blocks are never cached */
+	blocks[1] = sys_heap_tcache_refill(&heap, 0, 512);
+	zassert_not_null(blocks[1], "");
+	zassert_false(sys_heap_tcache_free(&heap, blocks[1]), "");
+	sys_heap_tcache_flush(&heap, blocks[1]);
+
+	/* Frees are cached until the bin is full, then flushed */
+	zassert_true(sys_heap_tcache_free(&heap, blocks[0]), "");
+	zassert_true(sys_heap_tcache_free(&heap, p), "");
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = sys_heap_alloc(&heap, 16);
+		zassert_not_null(blocks[i], "");
+	}
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		if (!sys_heap_tcache_free(&heap, blocks[i])) {
+			sys_heap_tcache_flush(&heap, blocks[i]);
+		}
+	}
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_true(stats.cached_bytes <= CONFIG_SYS_HEAP_TCACHE_DEPTH *
+		     sys_heap_usable_size(&heap, p), "");
+	zassert_true(sys_heap_validate(&heap), "");
+
+	/* Draining hands everything back to the heap */
+	zassert_true(sys_heap_tcache_drain(&heap), "");
+	zassert_false(sys_heap_tcache_drain(&heap), "");
+
+	arch_irq_unlock(key);
+
+	sys_heap_runtime_stats_get(&heap, &stats);
+	zassert_equal(stats.cached_bytes, 0, "");
+	zassert_equal(stats.allocated_bytes, 0, "");
+	zassert_true(sys_heap_validate(&heap), "");
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SYS_HEAP_TCACHE */
+}
+
 ZTEST_SUITE(lib_heap, NULL, NULL, NULL, NULL, NULL);
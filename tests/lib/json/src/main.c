@@ -459,12 +459,44 @@ struct encoding_test {
 	int result;
 };
 
+/* Feeds a streaming parser with chunks of chunk_len bytes, each one in
+ * a scratch buffer that is overwritten after use
+ */
+static int64_t stream_parse(struct json_stream_parser *parser, const char *json,
+			    size_t len, size_t chunk_len)
+{
+	char chunk[32];
+
+	__ASSERT_NO_MSG(chunk_len <= sizeof(chunk));
+
+	for (size_t pos = 0; pos < len; pos += chunk_len) {
+		size_t n = MIN(chunk_len, len - pos);
+
+		memcpy(chunk, json + pos, n);
+		(void)json_stream_parse_feed(parser, chunk, n);
+		memset(chunk, '!', n);
+	}
+
+	return json_stream_parse_finish(parser);
+}
+
 static void parse_harness(struct encoding_test encoded[], size_t size)
 {
+	struct json_stream_parser parser;
 	struct test_struct ts;
+	char buf[64];
 	int ret;
 
 	for (int i = 0; i < size; i++) {
+		json_stream_obj_parse_init(&parser, test_descr,
+					   ARRAY_SIZE(test_descr), &ts,
+					   buf, sizeof(buf));
+		ret = stream_parse(&parser, encoded[i].str,
+				   strlen(encoded[i].str), 1);
+		zassert_equal(ret, encoded[i].result,
+			      "Stream decoding '%s' result %d, expected %d",
+			      encoded[i].str, ret, encoded[i].result);
+
 		ret = json_obj_parse(encoded[i].str, strlen(encoded[i].str),
 				     test_descr, ARRAY_SIZE(test_descr), &ts);
 		zassert_equal(ret, encoded[i].result,
@@ -774,4 +806,249 @@ ZTEST(lib_json_test, test_large_descriptor)
 	zassert_true(ret & ((int64_t)1 << 39), "Field int39 not decoded");
 }
 
+ZTEST(lib_json_test, test_json_stream_decoding)
+{
+	static const char encoded[] = "{\"some_string\":\"zephyr 123\\uABCD456\","
+		"\"some_int\":\t42\n,"
+		"\"some_bool\":true    \t  "
+		"\n"
+		"\r   ,"
+		"\"some_nested_struct\":{    "
+		"\"nested_int\":-1234,\n\n"
+		"\"nested_bool\":false,\t"
+		"\"nested_string\":\"this should be escaped: \\t\"},"
+		"\"some_array\":[11,22, 33,\t45,\n299]"
+		"\"another_b!@l\":true,"
+		"\"if\":false,"
+		"\"another-array\":[2,3,5,7],"
+		"\"4nother_ne$+\":{\"nested_int\":1234,"
+		"\"nested_bool\":true,"
+		"\"nested_string\":\"no escape necessary\"}"
+		"}\n";
+	const int expected_array[] = { 11, 22, 33, 45, 299 };
+	const int expected_other_array[] = { 2, 3, 5, 7 };
+	struct json_stream_parser parser;
+	struct test_struct ts;
+	char buf[80];
+	int64_t ret;
+
+	/* Every way of splitting the tokens has to give the same result */
+	for (size_t chunk_len = 1; chunk_len <= 32; chunk_len++) {
+		memset(&ts, 0, sizeof(ts));
+		json_stream_obj_parse_init(&parser, test_descr,
+					   ARRAY_SIZE(test_descr), &ts,
+					   buf, sizeof(buf));
+		ret = stream_parse(&parser, encoded, sizeof(encoded) - 1,
+				   chunk_len);
+
+		zassert_equal(ret, (1 << ARRAY_SIZE(test_descr)) - 1,
+			      "Not all fields decoded with %zu byte chunks",
+			      chunk_len);
+		zassert_true(!strcmp(ts.some_string, "zephyr 123\\uABCD456"));
+		zassert_equal(ts.some_int, 42);
+		zassert_true(ts.some_bool);
+		zassert_equal(ts.some_nested_struct.nested_int, -1234);
+		zassert_false(ts.some_nested_struct.nested_bool);
+		zassert_true(!strcmp(ts.some_nested_struct.nested_string,
+				     "this should be escaped: \\t"));
+		zassert_equal(ts.some_array_len, ARRAY_SIZE(expected_array));
+		zassert_mem_equal(ts.some_array, expected_array,
+				  sizeof(expected_array));
+		zassert_true(ts.another_bxxl);
+		zassert_false(ts.if_);
+		zassert_equal(ts.another_array_len,
+			      ARRAY_SIZE(expected_other_array));
+		zassert_mem_equal(ts.another_array, expected_other_array,
+				  sizeof(expected_other_array));
+		zassert_equal(ts.xnother_nexx.nested_int, 1234);
+		zassert_true(ts.xnother_nexx.nested_bool);
+		zassert_true(!strcmp(ts.xnother_nexx.nested_string,
+				     "no escape necessary"));
+		zassert_equal(json_stream_parse_buf_used(&parser),
+			      sizeof("zephyr 123\\uABCD456") +
+			      sizeof("this should be escaped: \\t") +
+			      sizeof("no escape necessary"));
+	}
+}
+
+ZTEST(lib_json_test, test_json_stream_arr_decoding)
+{
+	static const char encoded[] = "{\"objects_array\":["
+		"[{\"height\":168,\"name\":\"Simón Bolívar\"}],"
+		"[{\"height\":173,\"name\":\"Pelé\"}],"
+		"[{\"height\":195,\"name\":\"Usain Bolt\"}]]"
+		"}";
+	static const char encoded_arr[] = "[{\"name\":\"Pelé\",\"height\":173},"
+		"{\"name\":\"Usain Bolt\",\"height\":195}]";
+	struct obj_array_array obj_array_array_ts;
+	struct json_stream_parser parser;
+	struct obj_array oa;
+	char buf[64];
+	int64_t ret;
+
+	json_stream_obj_parse_init(&parser, array_array_descr,
+				   ARRAY_SIZE(array_array_descr),
+				   &obj_array_array_ts, buf, sizeof(buf));
+	ret = stream_parse(&parser, encoded, sizeof(encoded) - 1, 5);
+	zassert_equal(ret, 1, "Decoding array of arrays returned error");
+	zassert_equal(obj_array_array_ts.objects_array_len, 3);
+	zassert_true(!strcmp(obj_array_array_ts.objects_array[0].objects.name,
+			     "Simón Bolívar"));
+	zassert_equal(obj_array_array_ts.objects_array[1].objects.height, 173);
+	zassert_true(!strcmp(obj_array_array_ts.objects_array[2].objects.name,
+			     "Usain Bolt"));
+
+	json_stream_arr_parse_init(&parser, obj_array_descr, &oa,
+				   buf, sizeof(buf));
+	ret = stream_parse(&parser, encoded_arr, sizeof(encoded_arr) - 1, 3);
+	zassert_equal(ret, 0, "Decoding top-level array returned error");
+	zassert_equal(oa.num_elements, 2);
+	zassert_true(!strcmp(oa.elements[0].name, "Pelé"));
+	zassert_equal(oa.elements[1].height, 195);
+}
+
+ZTEST(lib_json_test, test_json_stream_tokens)
+{
+	struct tokens {
+		struct json_obj_token array;
+		struct json_obj_token number;
+		struct json_obj_token opaque;
+		int after;
+	} t;
+	static const struct json_obj_descr tokens_descr[] = {
+		JSON_OBJ_DESCR_PRIM(struct tokens, array, JSON_TOK_OBJ_ARRAY),
+		JSON_OBJ_DESCR_PRIM(struct tokens, number, JSON_TOK_FLOAT),
+		JSON_OBJ_DESCR_PRIM(struct tokens, opaque, JSON_TOK_OPAQUE),
+		JSON_OBJ_DESCR_PRIM(struct tokens, after, JSON_TOK_NUMBER),
+	};
+	static const char encoded[] = "{\"unknown\":{\"a\":[1,{\"b\":\"]\"}],"
+		"\"c\":true},"
+		"\"array\":[{\"x\":\"]\\\"\"},[2]],"
+		"\"number\":-3.25,"
+		"\"opaque\":\"as is\","
+		"\"after\":5}";
+	struct json_stream_parser parser;
+	char buf[32];
+	int64_t ret;
+
+	/**TESTPOINT: unknown fields are skipped however they nest, and raw
+	 * tokens are copied
+	 */
+	json_stream_obj_parse_init(&parser, tokens_descr,
+				   ARRAY_SIZE(tokens_descr), &t,
+				   buf, sizeof(buf));
+	ret = stream_parse(&parser, encoded, sizeof(encoded) - 1, 4);
+	zassert_equal(ret, (1 << ARRAY_SIZE(tokens_descr)) - 1,
+		      "Not all fields decoded");
+	zassert_equal(t.array.length, strlen("[{\"x\":\"]\\\"\"},[2]]"));
+	zassert_mem_equal(t.array.start, "[{\"x\":\"]\\\"\"},[2]]",
+			  t.array.length);
+	zassert_equal(t.number.length, strlen("-3.25"));
+	zassert_mem_equal(t.number.start, "-3.25", t.number.length);
+	zassert_equal(t.opaque.length, strlen("as is"));
+	zassert_mem_equal(t.opaque.start, "as is", t.opaque.length);
+	zassert_equal(t.after, 5);
+}
+
+ZTEST(lib_json_test, test_json_stream_limits)
+{
+	static const char too_many[] = "[{},{},{},{},{},{},{},{},{},{},{}]";
+	static const char too_deep[] = "{\"unknown\":[[[[[[[[[[]]]]]]]]]]}";
+	static const char incomplete[] = "{\"some_int\":42";
+	static const char strings[] = "{\"some_string\":\"does not fit\"}";
+	struct json_stream_parser parser;
+	struct test_struct ts;
+	struct obj_array oa;
+	char buf[8];
+
+	json_stream_arr_parse_init(&parser, obj_array_descr, &oa, NULL, 0);
+	zassert_equal(stream_parse(&parser, too_many, sizeof(too_many) - 1, 8),
+		      -ENOSPC, "Array bounds check failed");
+
+	json_stream_obj_parse_init(&parser, test_descr, ARRAY_SIZE(test_descr),
+				   &ts, buf, sizeof(buf));
+	zassert_equal(stream_parse(&parser, too_deep, sizeof(too_deep) - 1, 8),
+		      -E2BIG, "Nesting check failed");
+
+	json_stream_obj_parse_init(&parser, test_descr, ARRAY_SIZE(test_descr),
+				   &ts, buf, sizeof(buf));
+	zassert_equal(stream_parse(&parser, strings, sizeof(strings) - 1, 8),
+		      -ENOMEM, "String storage bounds check failed");
+	zassert_equal(json_stream_parse_feed(&parser, "}", 1), -ENOMEM,
+		      "Error not kept");
+
+	json_stream_obj_parse_init(&parser, test_descr, ARRAY_SIZE(test_descr),
+				   &ts, buf, sizeof(buf));
+	zassert_equal(stream_parse(&parser, incomplete, sizeof(incomplete) - 1, 8),
+		      -EINVAL, "Incomplete object accepted");
+	zassert_equal(json_stream_parse_feed(&parser, "}", 1), 0);
+	zassert_equal(json_stream_parse_finish(&parser), 2);
+	zassert_equal(ts.some_int, 42);
+}
+
+struct collector {
+	char out[512];
+	size_t len;
+	int calls;
+};
+
+static int collect_bytes(const char *bytes, size_t len, void *data)
+{
+	struct collector *collector = data;
+
+	if (len > sizeof(collector->out) - collector->len) {
+		return -ENOMEM;
+	}
+
+	memcpy(collector->out + collector->len, bytes, len);
+	collector->len += len;
+	collector->calls++;
+
+	return 0;
+}
+
+ZTEST(lib_json_test, test_json_encode_buffered)
+{
+	struct test_struct ts = {
+		.some_string = "long enough to be written around the buffer,\t"
+			       "with something to escape",
+		.some_int = 42,
+		.some_nested_struct = {
+			.nested_int = -1234,
+			.nested_string = "\"quoted\"",
+		},
+		.some_array = { 1, 4, 8 },
+		.some_array_len = 3,
+		.xnother_nexx = {
+			.nested_string = "",
+		},
+	};
+	static struct collector collector;
+	char expected[512];
+	char buf[16];
+	int ret;
+
+	ret = json_obj_encode_buf(test_descr, ARRAY_SIZE(test_descr), &ts,
+				  expected, sizeof(expected));
+	zassert_equal(ret, 0, "Encoding function returned error");
+
+	for (size_t buf_size = 1; buf_size <= sizeof(buf); buf_size++) {
+		collector.len = 0;
+		collector.calls = 0;
+
+		ret = json_obj_encode_buffered(test_descr, ARRAY_SIZE(test_descr),
+					       &ts, collect_bytes, &collector,
+					       buf, buf_size);
+		zassert_equal(ret, 0, "Buffered encoding returned error");
+		zassert_equal(collector.len, strlen(expected));
+		zassert_mem_equal(collector.out, expected, collector.len,
+				  "Buffered encoding differs with %zu bytes",
+				  buf_size);
+	}
+
+	/**TESTPOINT: a full buffer is written at once */
+	zassert_true(collector.calls <= DIV_ROUND_UP(collector.len, sizeof(buf)) * 2,
+		     "Too many writes: %d", collector.calls);
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,170 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/ztest.h>
+#include <zephyr/sys/mpsc_pbuf.h>
+
+#define LEN_BITS 9
+
+struct test_data {
+	MPSC_PBUF_HDR;
+	uint32_t len : LEN_BITS;
+	uint32_t ts : 32 - MPSC_PBUF_HDR_BITS - LEN_BITS;
+};
+
+union test_item {
+	struct test_data data;
+	union mpsc_pbuf_generic item;
+};
+
+static uint32_t buf32[64];
+static struct mpsc_pbuf_lanes lanes;
+
+static uint32_t get_wlen(const union mpsc_pbuf_generic *item)
+{
+	return ((const union test_item *)item)->data.len;
+}
+
+static uint64_t get_timestamp(const union mpsc_pbuf_generic *item)
+{
+	return ((const union test_item *)item)->data.ts;
+}
+
+static const struct mpsc_pbuf_lanes_config config = {
+	.buffer = {
+		.buf = buf32,
+		.size = ARRAY_SIZE(buf32),
+		.get_wlen = get_wlen,
+		.flags = MPSC_PBUF_MAX_UTILIZATION
+	},
+	.get_timestamp = get_timestamp,
+	.num_lanes = 2
+};
+
+static void put(uint32_t lane, uint32_t ts)
+{
+	union test_item item = {.data = {.valid = 1, .len = 1, .ts = ts }};
+
+	mpsc_pbuf_put_word(&lanes.lanes[lane], item.item);
+}
+
+static void *setup(void)
+{
+	mpsc_pbuf_lanes_init(&lanes, &config);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	mpsc_pbuf_lanes_init(&lanes, &config);
+}
+
+ZTEST(mpsc_pbuf_lanes, test_lanes_init)
+{
+	zassert_equal(lanes.num_lanes, 2);
+	zassert_equal(lanes.lanes[0].size, ARRAY_SIZE(buf32) / 2);
+	zassert_equal(lanes.lanes[1].buf, &buf32[ARRAY_SIZE(buf32) / 2]);
+	zassert_false(mpsc_pbuf_lanes_is_pending(&lanes));
+	zassert_is_null(mpsc_pbuf_lanes_claim(&lanes));
+}
+
+/* Test that the consumer gets the packets of all lanes in timestamp order. */
+ZTEST(mpsc_pbuf_lanes, test_lanes_merge)
+{
+	static const uint32_t lane_ts[][3] = {
+		{ 1, 4, 5 },
+		{ 2, 3, 6 },
+	};
+	const union test_item *t;
+
+	for (int i = 0; i < ARRAY_SIZE(lane_ts); i++) {
+		for (int j = 0; j < ARRAY_SIZE(lane_ts[i]); j++) {
+			put(i, lane_ts[i][j]);
+		}
+	}
+
+	for (uint32_t ts = 1; ts <= 6; ts++) {
+		zassert_true(mpsc_pbuf_lanes_is_pending(&lanes));
+		t = (const union test_item *)mpsc_pbuf_lanes_claim(&lanes);
+		zassert_not_null(t);
+		zassert_equal(t->data.ts, ts);
+		mpsc_pbuf_lanes_free(&lanes, &t->item);
+	}
+
+	zassert_false(mpsc_pbuf_lanes_is_pending(&lanes));
+	zassert_is_null(mpsc_pbuf_lanes_claim(&lanes));
+}
+
+/* Test that packets claimed from different lanes can be freed in any order. */
+ZTEST(mpsc_pbuf_lanes, test_lanes_free_out_of_order)
+{
+	const union mpsc_pbuf_generic *t[3];
+	struct mpsc_pbuf_lane_stats stats;
+
+	put(0, 1);
+	put(1, 2);
+	put(0, 3);
+
+	for (int i = 0; i < ARRAY_SIZE(t); i++) {
+		t[i] = mpsc_pbuf_lanes_claim(&lanes);
+		zassert_not_null(t[i]);
+	}
+
+	mpsc_pbuf_lanes_free(&lanes, t[2]);
+	mpsc_pbuf_lanes_free(&lanes, t[1]);
+
+	zassert_ok(mpsc_pbuf_lanes_get_stats(&lanes, 0, &stats));
+	zassert_equal(stats.now, 2 * sizeof(uint32_t));
+	zassert_ok(mpsc_pbuf_lanes_get_stats(&lanes, 1, &stats));
+	zassert_equal(stats.now, 0);
+
+	mpsc_pbuf_lanes_free(&lanes, t[0]);
+
+	zassert_ok(mpsc_pbuf_lanes_get_stats(&lanes, 0, &stats));
+	zassert_equal(stats.now, 0);
+	zassert_equal(stats.max, 2 * sizeof(uint32_t));
+	zassert_false(mpsc_pbuf_lanes_is_pending(&lanes));
+}
+
+ZTEST(mpsc_pbuf_lanes, test_lanes_alloc_commit)
+{
+	union test_item *packet;
+	const union test_item *t;
+	struct mpsc_pbuf_lane_stats stats;
+	uint32_t lane;
+
+	packet = (union test_item *)mpsc_pbuf_lanes_alloc(&lanes, 4, K_NO_WAIT);
+	zassert_not_null(packet);
+	packet->data.len = 4;
+	packet->data.ts = 10;
+	mpsc_pbuf_lanes_commit(&lanes, &packet->item);
+
+	lane = ((uint32_t *)packet < lanes.lanes[1].buf) ? 0 : 1;
+
+	t = (const union test_item *)mpsc_pbuf_lanes_claim(&lanes);
+	zassert_equal_ptr(t, packet);
+	mpsc_pbuf_lanes_free(&lanes, &t->item);
+
+	/* Fill the lane of the producer, until packets are dropped. */
+	while ((packet = (union test_item *)mpsc_pbuf_lanes_alloc(&lanes, 4,
+								  K_NO_WAIT)) != NULL) {
+		packet->data.len = 4;
+		mpsc_pbuf_lanes_commit(&lanes, &packet->item);
+	}
+
+	zassert_ok(mpsc_pbuf_lanes_get_stats(&lanes, lane, &stats));
+	zassert_equal(stats.size, (ARRAY_SIZE(buf32) / 2 - 1) * sizeof(uint32_t));
+	zassert_equal(stats.drops, 1);
+	zassert_ok(mpsc_pbuf_lanes_get_stats(&lanes, !lane, &stats));
+	zassert_equal(stats.now, 0);
+	zassert_equal(stats.drops, 0);
+
+	zassert_equal(mpsc_pbuf_lanes_get_stats(&lanes, 2, &stats), -EINVAL);
+}
+
+ZTEST_SUITE(mpsc_pbuf_lanes, NULL, setup, before, NULL, NULL);
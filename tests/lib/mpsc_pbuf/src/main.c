@@ -1294,5 +1294,198 @@ ZTEST(log_buffer, test_utilization)
 	zassert_true(packet == NULL);
 }
 
+/* Test that packets can be freed in any order, for example by several
+ * consumers, and that the space is reclaimed once the oldest packet is freed.
+ */
+ZTEST(log_buffer, test_free_out_of_order)
+{
+	struct mpsc_pbuf_buffer buffer;
+	struct mpsc_pbuf_buffer_config config = {
+		.buf = buf32,
+		.size = 8,
+		.notify_drop = ignore_drop,
+		.get_wlen = get_wlen,
+		.flags = MPSC_PBUF_MAX_UTILIZATION
+	};
+	union test_item test_1word = {.data = {.valid = 1, .len = 1 }};
+	union test_item *t[4];
+
+	mpsc_pbuf_init(&buffer, &config);
+
+	for (int i = 0; i < ARRAY_SIZE(t); i++) {
+		test_1word.data.data = i;
+		mpsc_pbuf_put_word(&buffer, test_1word.item);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(t); i++) {
+		t[i] = (union test_item *)mpsc_pbuf_claim(&buffer);
+		zassert_true(t[i] != NULL);
+		zassert_equal(t[i]->data.data, i);
+	}
+
+	zassert_is_null(mpsc_pbuf_claim(&buffer));
+
+	/* Packets freed after the oldest claimed one keep their space. */
+	mpsc_pbuf_free(&buffer, &t[2]->item);
+	mpsc_pbuf_free(&buffer, &t[1]->item);
+	CHECK_USAGE(&buffer, 4, 4);
+
+	/* Freeing the oldest one releases the space of all of them. */
+	mpsc_pbuf_free(&buffer, &t[0]->item);
+	CHECK_USAGE(&buffer, 1, 4);
+	zassert_is_null(mpsc_pbuf_claim(&buffer));
+
+	mpsc_pbuf_free(&buffer, &t[3]->item);
+	CHECK_USAGE(&buffer, 0, 4);
+
+	/* The whole buffer can be used again, across the wrap. */
+	for (int i = 0; i < buffer.size - 1; i++) {
+		test_1word.data.data = i;
+		mpsc_pbuf_put_word(&buffer, test_1word.item);
+	}
+
+	zassert_equal(mpsc_pbuf_get_drops(&buffer), 0);
+
+	for (int i = 0; i < buffer.size - 1; i++) {
+		t[0] = (union test_item *)mpsc_pbuf_claim(&buffer);
+		zassert_true(t[0] != NULL);
+		zassert_equal(t[0]->data.data, i);
+		mpsc_pbuf_free(&buffer, &t[0]->item);
+	}
+
+	zassert_false(mpsc_pbuf_is_pending(&buffer));
+}
+
+/* Test overwriting a full buffer while several packets are claimed, and
+ * freed out of order.
+ */
+ZTEST(log_buffer, test_overwrite_several_claimed)
+{
+	struct mpsc_pbuf_buffer buffer;
+	struct mpsc_pbuf_buffer_config config = {
+		.buf = buf32,
+		.size = 8,
+		.notify_drop = ignore_drop,
+		.get_wlen = get_wlen,
+		.flags = MPSC_PBUF_MODE_OVERWRITE
+	};
+	union test_item test_1word = {.data = {.valid = 1, .len = 1 }};
+	union test_item *t[3];
+	union test_item *p;
+
+	mpsc_pbuf_init(&buffer, &config);
+
+	for (int i = 0; i < buffer.size; i++) {
+		test_1word.data.data = i;
+		mpsc_pbuf_put_word(&buffer, test_1word.item);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(t); i++) {
+		t[i] = (union test_item *)mpsc_pbuf_claim(&buffer);
+		zassert_true(t[i] != NULL);
+		zassert_equal(t[i]->data.data, i);
+	}
+
+	/* Claimed packets are not skipped over, new packets are dropped. */
+	for (int i = 0; i < 4; i++) {
+		test_1word.data.data = buffer.size + i;
+		mpsc_pbuf_put_word(&buffer, test_1word.item);
+	}
+
+	zassert_equal(mpsc_pbuf_get_drops(&buffer), 4);
+
+	mpsc_pbuf_free(&buffer, &t[1]->item);
+	mpsc_pbuf_free(&buffer, &t[2]->item);
+	mpsc_pbuf_free(&buffer, &t[0]->item);
+
+	for (int i = ARRAY_SIZE(t); i < buffer.size; i++) {
+		p = (union test_item *)mpsc_pbuf_claim(&buffer);
+		zassert_true(p != NULL);
+		zassert_equal(p->data.data, i);
+		mpsc_pbuf_free(&buffer, &p->item);
+	}
+
+	zassert_is_null(mpsc_pbuf_claim(&buffer));
+	zassert_false(mpsc_pbuf_is_pending(&buffer));
+
+	/* A single claimed packet is skipped over, and once the writers wrap
+	 * around it, it is not claimed a second time.
+	 */
+	t[0] = (union test_item *)mpsc_pbuf_claim(&buffer);
+	zassert_is_null(t[0]);
+
+	for (int i = 0; i < buffer.size; i++) {
+		test_1word.data.data = i;
+		mpsc_pbuf_put_word(&buffer, test_1word.item);
+	}
+
+	t[0] = (union test_item *)mpsc_pbuf_claim(&buffer);
+	zassert_true(t[0] != NULL);
+	zassert_equal(t[0]->data.data, 0);
+
+	for (int i = 0; i < 2 * buffer.size; i++) {
+		test_1word.data.data = buffer.size + i;
+		mpsc_pbuf_put_word(&buffer, test_1word.item);
+	}
+
+	while ((p = (union test_item *)mpsc_pbuf_claim(&buffer)) != NULL) {
+		zassert_not_equal(p, t[0]);
+		zassert_true(p->data.data >= buffer.size);
+		mpsc_pbuf_free(&buffer, &p->item);
+	}
+
+	mpsc_pbuf_free(&buffer, &t[0]->item);
+
+	test_1word.data.data = 3 * buffer.size;
+	mpsc_pbuf_put_word(&buffer, test_1word.item);
+	p = (union test_item *)mpsc_pbuf_claim(&buffer);
+	zassert_true(p != NULL);
+	zassert_equal(p->data.data, 3 * buffer.size);
+	mpsc_pbuf_free(&buffer, &p->item);
+	zassert_false(mpsc_pbuf_is_pending(&buffer));
+}
+
+ZTEST(log_buffer, test_drops)
+{
+	struct mpsc_pbuf_buffer buffer;
+	struct mpsc_pbuf_buffer_config config = {
+		.buf = buf32,
+		.size = 8,
+		.notify_drop = ignore_drop,
+		.get_wlen = get_wlen,
+		.flags = 0
+	};
+	union test_item test_1word = {.data = {.valid = 1, .len = 1 }};
+	union mpsc_pbuf_generic *packet;
+	uint32_t len = 3;
+
+	mpsc_pbuf_init(&buffer, &config);
+
+	/* In no overwrite mode, the new packets are dropped. */
+	for (int i = 0; i < buffer.size / len; i++) {
+		packet = mpsc_pbuf_alloc(&buffer, len, K_NO_WAIT);
+		zassert_true(packet != NULL);
+		((union test_item *)packet)->data.len = len;
+		mpsc_pbuf_commit(&buffer, packet);
+	}
+
+	zassert_equal(mpsc_pbuf_get_drops(&buffer), 0);
+	zassert_is_null(mpsc_pbuf_alloc(&buffer, len, K_NO_WAIT));
+	zassert_is_null(mpsc_pbuf_alloc(&buffer, len, K_NO_WAIT));
+	zassert_equal(mpsc_pbuf_get_drops(&buffer), 2);
+
+	/* In overwrite mode, the oldest packets are dropped. */
+	config.flags = MPSC_PBUF_MODE_OVERWRITE;
+	mpsc_pbuf_init(&buffer, &config);
+	zassert_equal(mpsc_pbuf_get_drops(&buffer), 0);
+
+	for (int i = 0; i < buffer.size + 2; i++) {
+		test_1word.data.data = i;
+		mpsc_pbuf_put_word(&buffer, test_1word.item);
+	}
+
+	zassert_equal(mpsc_pbuf_get_drops(&buffer), 2);
+}
+
 /*test case main entry*/
 ZTEST_SUITE(log_buffer, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,198 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/work_pool.h>
+
+#define NUM_WORKERS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_ITEMS 64
+#define FAN_DEPTH 6
+#define NUM_FAN_ITEMS ((1 << (FAN_DEPTH + 1)) - 1)
+#define LOOP_LEN 1000
+
+K_WORK_POOL_DEFINE(pool, STACK_SIZE);
+
+static struct k_work items[NUM_ITEMS];
+static atomic_t run_count;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+struct fan_item {
+	struct k_work work;
+	int depth;
+};
+
+static struct fan_item fan_items[NUM_FAN_ITEMS];
+static atomic_t fan_next;
+
+static atomic_t loop_hits[LOOP_LEN];
+static uint64_t nested_sums[16];
+static struct k_work nested_work;
+
+static uint32_t total_executed(void)
+{
+	uint32_t total = 0U;
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		total += pool.workers[i].executed;
+	}
+
+	return total;
+}
+
+static void count_handler(struct k_work *work)
+{
+	if (atomic_inc(&run_count) == NUM_ITEMS - 1) {
+		k_sem_give(&done_sem);
+	}
+}
+
+/* Each item submits two more until FAN_DEPTH, from the worker
+ * running it, i.e. onto that worker's own deque
+ */
+static void fan_handler(struct k_work *work)
+{
+	struct fan_item *item = CONTAINER_OF(work, struct fan_item, work);
+
+	if (item->depth < FAN_DEPTH) {
+		for (int i = 0; i < 2; i++) {
+			struct fan_item *child = &fan_items[atomic_inc(&fan_next)];
+
+			child->depth = item->depth + 1;
+			k_work_init(&child->work, fan_handler);
+			k_work_pool_submit(&pool, &child->work);
+		}
+	}
+
+	if (atomic_inc(&run_count) == NUM_FAN_ITEMS - 1) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void mark_range(size_t begin, size_t end, void *arg)
+{
+	zassert_true(begin < end);
+	zassert_true(end <= LOOP_LEN);
+
+	for (size_t i = begin; i < end; i++) {
+		atomic_inc(&loop_hits[i]);
+	}
+}
+
+static void sum_range(size_t begin, size_t end, void *arg)
+{
+	uint64_t sum = 0U;
+
+	for (size_t i = begin; i < end; i++) {
+		sum += i;
+	}
+
+	atomic_add(arg, (atomic_val_t)sum);
+}
+
+static void nested_range(size_t begin, size_t end, void *arg)
+{
+	for (size_t i = begin; i < end; i++) {
+		atomic_t sum = ATOMIC_INIT(0);
+
+		zassert_ok(k_work_pool_parallel_for(&pool, 100, 7, sum_range, &sum));
+		nested_sums[i] = atomic_get(&sum);
+	}
+}
+
+static void nested_handler(struct k_work *work)
+{
+	zassert_ok(k_work_pool_parallel_for(&pool, ARRAY_SIZE(nested_sums), 1,
+					    nested_range, NULL));
+	k_sem_give(&done_sem);
+}
+
+/**
+ * @brief Test running items submitted from outside the pool
+ */
+ZTEST(lib_work_pool, test_submit)
+{
+	uint32_t executed = total_executed();
+
+	atomic_set(&run_count, 0);
+
+	for (int i = 0; i < NUM_ITEMS; i++) {
+		k_work_init(&items[i], count_handler);
+		k_work_pool_submit(&pool, &items[i]);
+	}
+
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(5)));
+	zassert_equal(atomic_get(&run_count), NUM_ITEMS);
+	zassert_equal(total_executed() - executed, NUM_ITEMS);
+}
+
+/**
+ * @brief Test items submitted from workers, beyond the deque size
+ */
+ZTEST(lib_work_pool, test_fan_out)
+{
+	atomic_set(&run_count, 0);
+	atomic_set(&fan_next, 1);
+
+	fan_items[0].depth = 0;
+	k_work_init(&fan_items[0].work, fan_handler);
+	k_work_pool_submit(&pool, &fan_items[0].work);
+
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(5)));
+	zassert_equal(atomic_get(&run_count), NUM_FAN_ITEMS);
+}
+
+/**
+ * @brief Test that a parallel loop covers every index exactly once
+ */
+ZTEST(lib_work_pool, test_parallel_for)
+{
+	atomic_t sum = ATOMIC_INIT(0);
+
+	for (size_t grain = 1; grain <= LOOP_LEN; grain *= 7) {
+		memset(loop_hits, 0, sizeof(loop_hits));
+
+		zassert_ok(k_work_pool_parallel_for(&pool, LOOP_LEN, grain,
+						    mark_range, NULL));
+		for (int i = 0; i < LOOP_LEN; i++) {
+			zassert_equal(atomic_get(&loop_hits[i]), 1,
+				      "index %d, grain %zu", i, grain);
+		}
+	}
+
+	zassert_ok(k_work_pool_parallel_for(&pool, LOOP_LEN, 10, sum_range, &sum));
+	zassert_equal(atomic_get(&sum), LOOP_LEN * (LOOP_LEN - 1) / 2);
+
+	/* Empty loops and bad grains */
+	zassert_ok(k_work_pool_parallel_for(&pool, 0, 1, mark_range, NULL));
+	zassert_equal(k_work_pool_parallel_for(&pool, LOOP_LEN, 0, mark_range, NULL),
+		      -EINVAL);
+}
+
+/**
+ * @brief Test parallel loops run from pool workers, inside each other
+ */
+ZTEST(lib_work_pool, test_parallel_for_nested)
+{
+	memset(nested_sums, 0, sizeof(nested_sums));
+
+	k_work_init(&nested_work, nested_handler);
+	k_work_pool_submit(&pool, &nested_work);
+
+	zassert_ok(k_sem_take(&done_sem, K_SECONDS(5)));
+	for (int i = 0; i < ARRAY_SIZE(nested_sums); i++) {
+		zassert_equal(nested_sums[i], 99 * 100 / 2);
+	}
+}
+
+static void *work_pool_setup(void)
+{
+	k_work_pool_start(&pool, K_PRIO_PREEMPT(1));
+
+	return NULL;
+}
+
+ZTEST_SUITE(lib_work_pool, NULL, work_pool_setup, NULL, NULL, NULL);
@@ -544,6 +544,45 @@ static void test_route_preference(void)
 	net_route_del(entry);
 }
 
+static void test_route_longest_prefix(void)
+{
+	struct in6_addr other_addr = dest_addr;
+	struct net_route_entry *route_32, *route_64, *found;
+
+	other_addr.s6_addr[4] = 0x1;
+
+	route_32 = net_route_add(my_iface,
+				 &dest_addr, 32,
+				 &peer_addr,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(route_32, "Route add failed");
+
+	route_64 = net_route_add(my_iface,
+				 &dest_addr, 64,
+				 &peer_addr_alt,
+				 NET_IPV6_ND_INFINITE_LIFETIME,
+				 NET_ROUTE_PREFERENCE_MEDIUM);
+	zassert_not_null(route_64, "Route add failed");
+	zassert_not_equal(route_64, route_32,
+			  "Longer prefix replaced the shorter one");
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(found, route_64, "Longest prefix not used");
+
+	found = net_route_lookup(my_iface, &other_addr);
+	zassert_equal_ptr(found, route_32, "Shorter prefix not used");
+
+	zassert_ok(net_route_del(route_64), "Route del failed");
+
+	found = net_route_lookup(my_iface, &dest_addr);
+	zassert_equal_ptr(found, route_32, "Deleted route still found");
+
+	zassert_ok(net_route_del(route_32), "Route del failed");
+
+	found = net_route_lookup(my_iface, &other_addr);
+	zassert_is_null(found, "Deleted route still found");
+}
 
 /*test case main entry*/
 ZTEST(route_test_suite, test_route)
@@ -566,6 +605,7 @@ ZTEST(route_test_suite, test_route)
 	test_route_del_many();
 	test_route_lifetime();
 	test_route_preference();
+	test_route_longest_prefix();
 }
 
 ZTEST_SUITE(route_test_suite, NULL, NULL, NULL, NULL, NULL);
@@ -129,4 +129,257 @@ ZTEST(lib_base64, test_base64_codec)
 	zassert_equal(rc, -ENOMEM, "Error: dst NULL: decode test return value");
 }
 
+static inline uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+/* Bit at a time reference encoder */
+static size_t ref_encode(uint8_t *dst, const uint8_t *src, size_t slen)
+{
+	static const char alphabet[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	size_t bits = slen * 8;
+	size_t n = 0;
+
+	for (size_t bit = 0; bit < bits; bit += 6) {
+		uint8_t v = 0;
+
+		for (size_t i = bit; i < bit + 6; i++) {
+			v <<= 1;
+			if (i < bits) {
+				v |= (src[i / 8] >> (7 - i % 8)) & 1;
+			}
+		}
+		dst[n++] = alphabet[v];
+	}
+
+	while (n % 4 != 0) {
+		dst[n++] = '=';
+	}
+
+	return n;
+}
+
+static int stream_encode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
+			 size_t slen, uint32_t *seed)
+{
+	struct base64_encoder enc;
+	size_t off = 0, n = 0, chunk, len;
+	int rc;
+
+	base64_encoder_init(&enc);
+
+	while (off < slen) {
+		chunk = xorshift32(seed) % 9;
+		chunk = MIN(chunk, slen - off);
+		rc = base64_encoder_update(&enc, dst + n, dlen - n, &len, src + off, chunk);
+		if (rc != 0) {
+			return rc;
+		}
+		off += chunk;
+		n += len;
+	}
+
+	rc = base64_encoder_finish(&enc, dst + n, dlen - n, &len);
+	*olen = n + len;
+
+	return rc;
+}
+
+static int stream_decode(uint8_t *dst, size_t dlen, size_t *olen, const uint8_t *src,
+			 size_t slen, uint32_t *seed)
+{
+	struct base64_decoder dec;
+	size_t off = 0, n = 0, chunk, len;
+	int rc;
+
+	base64_decoder_init(&dec);
+
+	while (off < slen) {
+		chunk = xorshift32(seed) % 11;
+		chunk = MIN(chunk, slen - off);
+		rc = base64_decoder_update(&dec, dst + n, dlen - n, &len, src + off, chunk);
+		if (rc != 0) {
+			return rc;
+		}
+		off += chunk;
+		n += len;
+	}
+
+	*olen = n;
+
+	return base64_decoder_finish(&dec);
+}
+
+ZTEST(lib_base64, test_base64_roundtrip)
+{
+	static uint8_t data[256], enc[400], ref[400], dec[256];
+	uint32_t seed = 1;
+	size_t len, ref_len;
+	int rc;
+
+	for (int iter = 0; iter < 2000; iter++) {
+		size_t slen = xorshift32(&seed) % sizeof(data);
+
+		for (size_t i = 0; i < slen; i++) {
+			data[i] = xorshift32(&seed);
+		}
+
+		ref_len = ref_encode(ref, data, slen);
+
+		rc = base64_encode(enc, sizeof(enc), &len, data, slen);
+		zassert_equal(rc, 0, "Encode return value");
+		zassert_equal(len, ref_len, "Encode length");
+		zassert_mem_equal(enc, ref, len, "Encode comparison");
+
+		rc = stream_encode(enc, sizeof(enc), &len, data, slen, &seed);
+		zassert_equal(rc, 0, "Stream encode return value");
+		zassert_equal(len, ref_len, "Stream encode length");
+		zassert_mem_equal(enc, ref, len, "Stream encode comparison");
+
+		rc = base64_decode(dec, sizeof(dec), &len, ref, ref_len);
+		zassert_equal(rc, 0, "Decode return value");
+		zassert_equal(len, slen, "Decode length");
+		zassert_mem_equal(dec, data, len, "Decode comparison");
+
+		rc = stream_decode(dec, sizeof(dec), &len, ref, ref_len, &seed);
+		zassert_equal(rc, 0, "Stream decode return value");
+		zassert_equal(len, slen, "Stream decode length");
+		zassert_mem_equal(dec, data, len, "Stream decode comparison");
+	}
+}
+
+/* Insert line endings, spaces, pads and invalid characters at random in
+ * valid data, and check that the one-shot and streaming decoders, with
+ * their different fast paths, agree.
+ */
+ZTEST(lib_base64, test_base64_decode_fuzz)
+{
+	static const char *const inserts[] = {
+		"\n", "\r\n", " \r\n", "  \n", " ", "\r", "=", "==", "!", "A", "\xc3",
+	};
+	static uint8_t data[96], enc[256], dec[256], sdec[256];
+	uint32_t seed = 7;
+	size_t len, slen, dlen, sdlen, chars;
+	int rc, stream_rc;
+
+	for (int iter = 0; iter < 5000; iter++) {
+		len = xorshift32(&seed) % sizeof(data);
+
+		for (size_t i = 0; i < len; i++) {
+			data[i] = xorshift32(&seed);
+		}
+
+		rc = base64_encode(enc, sizeof(enc), &slen, data, len);
+		zassert_equal(rc, 0, "Encode return value");
+
+		for (int k = xorshift32(&seed) % 4; k > 0; k--) {
+			const char *ins = inserts[xorshift32(&seed) % ARRAY_SIZE(inserts)];
+			size_t ins_len = strlen(ins);
+			size_t pos = xorshift32(&seed) % (slen + 1);
+
+			memmove(&enc[pos + ins_len], &enc[pos], slen - pos);
+			memcpy(&enc[pos], ins, ins_len);
+			slen += ins_len;
+		}
+
+		chars = 0;
+		for (size_t i = 0; i < slen; i++) {
+			if (enc[i] != ' ' && enc[i] != '\r' && enc[i] != '\n') {
+				chars++;
+			}
+		}
+
+		rc = base64_decode(dec, sizeof(dec), &dlen, enc, slen);
+		stream_rc = stream_decode(sdec, sizeof(sdec), &sdlen, enc, slen, &seed);
+
+		if (rc != 0) {
+			zassert_equal(rc, -EINVAL, "Decode return value");
+			zassert_not_equal(stream_rc, 0, "Stream decode accepted invalid data");
+			continue;
+		}
+
+		/* The one-shot decoder ignores an incomplete last group */
+		if (chars % 4 == 0) {
+			zassert_equal(stream_rc, 0, "Stream decode return value");
+		}
+
+		if (stream_rc == 0) {
+			zassert_equal(sdlen, dlen, "Stream decode length");
+			zassert_mem_equal(sdec, dec, dlen, "Stream decode comparison");
+		}
+	}
+}
+
+ZTEST(lib_base64, test_base64_stream_errors)
+{
+	struct base64_encoder enc;
+	struct base64_decoder dec;
+	uint8_t buffer[16];
+	size_t len;
+	int rc;
+
+	/* A too small buffer does not consume the input */
+	base64_encoder_init(&enc);
+	rc = base64_encoder_update(&enc, buffer, 3, &len, base64_test_dec, 4);
+	zassert_equal(rc, -ENOMEM, "Encode update ENOMEM return value");
+	zassert_equal(len, 4, "Encode update required length");
+	rc = base64_encoder_update(&enc, buffer, 4, &len, base64_test_dec, 4);
+	zassert_equal(rc, 0, "Encode update return value");
+	zassert_equal(len, 4, "Encode update length");
+	rc = base64_encoder_finish(&enc, buffer + 4, 3, &len);
+	zassert_equal(rc, -ENOMEM, "Encode finish ENOMEM return value");
+	zassert_equal(len, 4, "Encode finish required length");
+	rc = base64_encoder_finish(&enc, buffer + 4, 4, &len);
+	zassert_equal(rc, 0, "Encode finish return value");
+	zassert_mem_equal(buffer, "JEhuVg==", 8, "Encode comparison");
+
+	base64_decoder_init(&dec);
+	rc = base64_decoder_update(&dec, buffer, 5, &len,
+				   (const uint8_t *)"JEhuVg==", 8);
+	zassert_equal(rc, -ENOMEM, "Decode update ENOMEM return value");
+	zassert_equal(len, 6, "Decode update required length");
+	rc = base64_decoder_update(&dec, buffer, 6, &len,
+				   (const uint8_t *)"JEhuVg==", 8);
+	zassert_equal(rc, 0, "Decode update return value");
+	zassert_equal(len, 4, "Decode update length");
+	zassert_mem_equal(buffer, base64_test_dec, 4, "Decode comparison");
+	rc = base64_decoder_finish(&dec);
+	zassert_equal(rc, 0, "Decode finish return value");
+
+	/* Incomplete group */
+	base64_decoder_init(&dec);
+	rc = base64_decoder_update(&dec, buffer, sizeof(buffer), &len,
+				   (const uint8_t *)"JEhuV", 5);
+	zassert_equal(rc, 0, "Decode partial return value");
+	rc = base64_decoder_finish(&dec);
+	zassert_equal(rc, -EINVAL, "Decode partial finish return value");
+
+	/* CR without LF, across chunks */
+	base64_decoder_init(&dec);
+	rc = base64_decoder_update(&dec, buffer, sizeof(buffer), &len,
+				   (const uint8_t *)"JEhu\r", 5);
+	zassert_equal(rc, 0, "Decode CR return value");
+	rc = base64_decoder_update(&dec, buffer, sizeof(buffer), &len,
+				   (const uint8_t *)"Vg==", 4);
+	zassert_equal(rc, -EINVAL, "Decode CR without LF return value");
+
+	/* Space inside a line, across chunks */
+	base64_decoder_init(&dec);
+	rc = base64_decoder_update(&dec, buffer, sizeof(buffer), &len,
+				   (const uint8_t *)"JEhu ", 5);
+	zassert_equal(rc, 0, "Decode space return value");
+	rc = base64_decoder_update(&dec, buffer, sizeof(buffer), &len,
+				   (const uint8_t *)"Vg==", 4);
+	zassert_equal(rc, -EINVAL, "Decode space inside a line return value");
+}
+
 ZTEST_SUITE(lib_base64, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,424 @@
+/*
+ * Copyright The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <limits.h>
+#include <stdlib.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/btree.h>
+
+/* Small nodes by default, for deep trees with few entries */
+#ifndef TEST_BTREE_ORDER
+#define TEST_BTREE_ORDER 5
+#endif
+
+#undef CONFIG_BTREE_ORDER
+#define CONFIG_BTREE_ORDER TEST_BTREE_ORDER
+
+#include "../../../lib/os/btree.c"
+
+#define MAX_KEY 2048
+
+static struct sys_btree tree;
+
+/* Value of each key in the tree, for reference */
+static bool present[MAX_KEY];
+static uint64_t values[MAX_KEY];
+
+/* Number of allocated nodes, and of nodes which can still be allocated */
+static int allocated;
+static int budget;
+
+static void *test_alloc(void *ptr, size_t size)
+{
+	if (size == 0) {
+		allocated--;
+		free(ptr);
+		return NULL;
+	}
+
+	if (budget == 0) {
+		return NULL;
+	}
+
+	budget--;
+	allocated++;
+
+	return malloc(size);
+}
+
+static inline uint32_t xorshift32(uint32_t *state)
+{
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	*state = x;
+
+	return x;
+}
+
+/* Check the structure of a subtree of height h with keys in [lo, hi),
+ * count its entries and collect its leaves in order.
+ */
+static void check_node(const struct sys_btree_node *node, uint8_t h, bool root, uint64_t lo,
+		       uint64_t hi, size_t *size, const struct sys_btree_node ***leaves)
+{
+	zassert_true(node->n <= MAX_KEYS, "Node overflow");
+	if (!root) {
+		zassert_true(node->n >= MIN_KEYS, "Node underflow");
+	}
+
+	for (uint16_t i = 0; i < node->n; i++) {
+		zassert_true(node->keys[i] >= lo && node->keys[i] < hi, "Key out of range");
+		if (i > 0) {
+			zassert_true(node->keys[i - 1] < node->keys[i], "Keys out of order");
+		}
+	}
+
+	if (h == 1) {
+		*(*leaves)++ = node;
+		*size += node->n;
+		return;
+	}
+
+	zassert_true(node->n > 0, "Inner node without keys");
+
+	for (uint16_t i = 0; i <= node->n; i++) {
+		check_node(node->children[i], h - 1, false, i > 0 ? node->keys[i - 1] : lo,
+			   i < node->n ? node->keys[i] : hi, size, leaves);
+	}
+}
+
+static void check_tree(void)
+{
+	static const struct sys_btree_node *leaves[MAX_KEY];
+	const struct sys_btree_node **last = leaves;
+	const struct sys_btree_node *node;
+	size_t size = 0, ref_size = 0;
+
+	if (tree.root == NULL) {
+		zassert_equal(tree.size, 0, "Empty tree with entries");
+		zassert_equal(tree.height, 0, "Empty tree with levels");
+		zassert_equal(allocated, 0, "Empty tree with nodes");
+		return;
+	}
+
+	check_node(tree.root, tree.height, true, 0, UINT64_MAX, &size, &last);
+	zassert_equal(size, tree.size, "Wrong size");
+
+	/* The leaves are linked in order */
+	node = leaves[0];
+	for (const struct sys_btree_node **leaf = leaves; leaf < last; leaf++) {
+		zassert_equal_ptr(node, *leaf, "Leaf not linked");
+		node = node->next;
+	}
+	zassert_is_null(node, "Last leaf linked");
+
+	for (uint64_t key = 0; key < MAX_KEY; key++) {
+		ref_size += present[key] ? 1 : 0;
+	}
+	zassert_equal(ref_size, tree.size, "Size differs from reference");
+}
+
+static void check_contents(void)
+{
+	struct sys_btree_iterator it;
+	uint64_t value, next = 0;
+
+	for (uint64_t key = 0; key < MAX_KEY; key++) {
+		zassert_equal(sys_btree_get(&tree, key, &value), present[key], "Wrong get");
+		if (present[key]) {
+			zassert_equal(value, values[key], "Wrong value");
+		}
+	}
+
+	SYS_BTREE_FOR_EACH(&tree, &it) {
+		while (!present[next]) {
+			next++;
+		}
+		zassert_equal(it.key, next, "Iteration skipped key %u", (unsigned int)next);
+		zassert_equal(it.value, values[next], "Wrong value in iteration");
+		next++;
+	}
+
+	while (next < MAX_KEY) {
+		zassert_false(present[next], "Iteration missed key %u", (unsigned int)next);
+		next++;
+	}
+}
+
+static void *setup(void)
+{
+	sys_btree_init(&tree, test_alloc);
+
+	return NULL;
+}
+
+static void before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(present, 0, sizeof(present));
+	budget = INT_MAX;
+}
+
+static void after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sys_btree_clear(&tree, NULL, NULL);
+	zassert_equal(allocated, 0, "Nodes leaked");
+}
+
+ZTEST(lib_btree, test_btree_random)
+{
+	uint32_t seed = 1;
+	uint64_t key, value, old_value;
+	int ret;
+
+	for (int i = 0; i < 50000; i++) {
+		/* Grow the tree in the first half, then shrink it */
+		bool insert = xorshift32(&seed) % 8 < (i < 25000 ? 5 : 3);
+
+		key = xorshift32(&seed) % MAX_KEY;
+		value = xorshift32(&seed);
+
+		if (insert) {
+			ret = sys_btree_insert(&tree, key, value, &old_value);
+			zassert_equal(ret, present[key] ? 0 : 1, "Wrong insert result");
+			if (ret == 0) {
+				zassert_equal(old_value, values[key], "Wrong old value");
+			}
+			present[key] = true;
+			values[key] = value;
+		} else {
+			zassert_equal(sys_btree_remove(&tree, key, &value), present[key],
+				      "Wrong remove result");
+			if (present[key]) {
+				zassert_equal(value, values[key], "Wrong removed value");
+			}
+			present[key] = false;
+		}
+
+		if (i % 1000 == 0) {
+			check_tree();
+			check_contents();
+		}
+	}
+
+	check_tree();
+	check_contents();
+
+	/* Remove everything */
+	for (key = 0; key < MAX_KEY; key++) {
+		zassert_equal(sys_btree_remove(&tree, key, NULL), present[key], "Wrong remove");
+		present[key] = false;
+	}
+
+	check_tree();
+}
+
+ZTEST(lib_btree, test_btree_ordered)
+{
+	/* Ascending and descending insertions and removals */
+	for (uint64_t key = 0; key < MAX_KEY; key++) {
+		zassert_equal(sys_btree_insert(&tree, key, ~key, NULL), 1, "Insert failed");
+		present[key] = true;
+		values[key] = ~key;
+	}
+
+	check_tree();
+	check_contents();
+
+	for (uint64_t key = MAX_KEY; key-- > 0;) {
+		zassert_true(sys_btree_remove(&tree, key, NULL), "Remove failed");
+		present[key] = false;
+
+		if (key % 256 == 0) {
+			check_tree();
+		}
+	}
+
+	for (uint64_t key = MAX_KEY; key-- > 0;) {
+		zassert_equal(sys_btree_insert(&tree, key, key, NULL), 1, "Insert failed");
+	}
+
+	for (uint64_t key = 0; key < MAX_KEY; key++) {
+		zassert_true(sys_btree_remove(&tree, key, NULL), "Remove failed");
+	}
+
+	check_tree();
+}
+
+ZTEST(lib_btree, test_btree_lower_bound)
+{
+	struct sys_btree_iterator it;
+	uint32_t seed = 3;
+	uint64_t first, end, next;
+	int count;
+
+	zassert_false(sys_btree_lower_bound(&tree, 0, &it), "Empty tree has entries");
+	zassert_is_null(it.node, "Iterator not at end");
+
+	/* Even keys only */
+	for (uint64_t key = 0; key < MAX_KEY; key += 2) {
+		zassert_equal(sys_btree_insert(&tree, key, key * 3, NULL), 1, "Insert failed");
+	}
+
+	for (uint64_t key = 0; key < MAX_KEY; key++) {
+		bool found = sys_btree_lower_bound(&tree, key, &it);
+
+		if (key > MAX_KEY - 2) {
+			zassert_false(found, "Entry above the last key");
+			continue;
+		}
+
+		zassert_true(found, "No entry for %u", (unsigned int)key);
+		zassert_equal(it.key, ROUND_UP(key, 2), "Wrong lower bound of %u", (unsigned int)key);
+		zassert_equal(it.value, it.key * 3, "Wrong value");
+	}
+
+	for (int i = 0; i < 1000; i++) {
+		uint64_t lo = xorshift32(&seed) % (MAX_KEY + 10);
+		uint64_t hi = lo + xorshift32(&seed) % 100;
+
+		count = 0;
+		first = ROUND_UP(lo, 2);
+		end = MIN(hi, MAX_KEY);
+		next = first;
+		SYS_BTREE_FOR_EACH_RANGE(&tree, &it, lo, hi) {
+			zassert_equal(it.key, next, "Wrong key in range");
+			next += 2;
+			count++;
+		}
+
+		zassert_equal(count, end > first ? (end - first + 1) / 2 : 0,
+			      "Wrong number of keys in [%u, %u)", (unsigned int)lo, (unsigned int)hi);
+	}
+}
+
+ZTEST(lib_btree, test_btree_bulk_load)
+{
+	static uint64_t keys[MAX_KEY], vals[MAX_KEY];
+
+	for (size_t i = 0; i < MAX_KEY; i++) {
+		keys[i] = i;
+		vals[i] = i * 7;
+	}
+
+	for (size_t n = 0; n < MAX_KEY; n += (n < 64 ? 1 : 97)) {
+		zassert_equal(sys_btree_bulk_load(&tree, keys, vals, n), 0, "Bulk load of %zu", n);
+
+		for (size_t i = 0; i < MAX_KEY; i++) {
+			present[i] = i < n;
+			values[i] = i * 7;
+		}
+
+		check_tree();
+		check_contents();
+
+		/* The tree can be modified afterwards */
+		for (uint64_t key = 0; key < MAX_KEY; key += 3) {
+			if (present[key]) {
+				zassert_true(sys_btree_remove(&tree, key, NULL), "Remove failed");
+				present[key] = false;
+			} else {
+				zassert_equal(sys_btree_insert(&tree, key, key, NULL), 1,
+					      "Insert failed");
+				present[key] = true;
+				values[key] = key;
+			}
+		}
+
+		check_tree();
+		check_contents();
+
+		sys_btree_clear(&tree, NULL, NULL);
+	}
+
+	zassert_equal(sys_btree_insert(&tree, 1, 1, NULL), 1, "Insert failed");
+	zassert_equal(sys_btree_bulk_load(&tree, keys, vals, 10), -EBUSY, "Non-empty tree loaded");
+	sys_btree_clear(&tree, NULL, NULL);
+
+	keys[5] = keys[4];
+	zassert_equal(sys_btree_bulk_load(&tree, keys, vals, 10), -EINVAL, "Unsorted keys loaded");
+	zassert_is_null(tree.root, "Tree modified");
+}
+
+static void count_cb(uint64_t key, uint64_t value, void *cookie)
+{
+	uint64_t *next = cookie;
+
+	zassert_equal(key, *next, "Clear out of order");
+	zassert_equal(value, key + 1, "Wrong value on clear");
+	(*next)++;
+}
+
+ZTEST(lib_btree, test_btree_clear)
+{
+	uint64_t next = 0;
+
+	for (uint64_t key = 0; key < 1000; key++) {
+		zassert_equal(sys_btree_insert(&tree, key, key + 1, NULL), 1, "Insert failed");
+	}
+
+	sys_btree_clear(&tree, count_cb, &next);
+	zassert_equal(next, 1000, "Entries missed on clear");
+	zassert_true(sys_btree_is_empty(&tree), "Tree not empty");
+	zassert_equal(allocated, 0, "Nodes leaked");
+}
+
+ZTEST(lib_btree, test_btree_enomem)
+{
+	static uint64_t keys[MAX_KEY];
+	uint32_t seed = 5;
+	uint64_t key, old_value;
+	int ret;
+
+	/* Inserting until the budget is exhausted leaves a valid tree, in
+	 * which existing keys can still be updated.
+	 */
+	budget = 20;
+	for (int i = 0; i < 5000; i++) {
+		key = xorshift32(&seed) % MAX_KEY;
+
+		ret = sys_btree_insert(&tree, key, i, &old_value);
+		if (ret == -ENOMEM) {
+			zassert_false(present[key], "Update of an existing key failed");
+			continue;
+		}
+
+		zassert_equal(ret, present[key] ? 0 : 1, "Wrong insert result");
+		present[key] = true;
+		values[key] = i;
+	}
+
+	check_tree();
+	check_contents();
+
+	sys_btree_clear(&tree, NULL, NULL);
+
+	/* A failed bulk load frees its nodes */
+	for (size_t i = 0; i < MAX_KEY; i++) {
+		keys[i] = i;
+	}
+
+	for (budget = 0; budget < 100; budget++) {
+		int left = budget;
+
+		ret = sys_btree_bulk_load(&tree, keys, keys, MAX_KEY);
+		if (ret == 0) {
+			break;
+		}
+
+		zassert_equal(ret, -ENOMEM, "Wrong bulk load result");
+		zassert_is_null(tree.root, "Tree modified");
+		zassert_equal(allocated, 0, "Nodes leaked");
+		budget = left;
+	}
+}
+
+ZTEST_SUITE(lib_btree, NULL, setup, before, after, NULL);
@@ -50,6 +50,37 @@ ZTEST(crc, test_crc32_ieee)
 	zassert_equal(crc32_ieee(test3, sizeof(test3)), 0x20089AA4);
 }
 
+ZTEST(crc, test_crc_long)
+{
+	static uint8_t data[1021];
+	uint32_t crc;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)i;
+	}
+
+	/* Longer than any table-driven or hardware block size, and not a
+	 * multiple of any of them
+	 */
+	zassert_equal(crc32_ieee(data, sizeof(data)), 0xB02C88C3);
+	zassert_equal(crc32_c(0, data, sizeof(data), true, true), 0x26681FBC);
+	zassert_equal(crc16_ccitt(0, data, sizeof(data)), 0x9262);
+	zassert_equal(crc16_reflect(0x8408, 0, data, sizeof(data)), 0x9262);
+	zassert_equal(crc16_itu_t(0, data, sizeof(data)), 0x44D7);
+	zassert_equal(crc16(0x1021, 0, data, sizeof(data)), 0x44D7);
+
+	/* Same results in pieces, at odd offsets */
+	crc = crc32_ieee_update(0, data, 3);
+	crc = crc32_ieee_update(crc, &data[3], 700);
+	crc = crc32_ieee_update(crc, &data[703], sizeof(data) - 703);
+	zassert_equal(crc, 0xB02C88C3);
+
+	crc = crc32_c(0, data, 5, true, false);
+	crc = crc32_c(crc, &data[5], 600, false, false);
+	crc = crc32_c(crc, &data[605], sizeof(data) - 605, false, true);
+	zassert_equal(crc, 0x26681FBC);
+}
+
 ZTEST(crc, test_crc16)
 {
 	uint8_t test[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
@@ -18,6 +18,14 @@ ZTEST(util_cxx, test_u8_to_dec) {
 	run_u8_to_dec();
 }
 
+ZTEST(util_cxx, test_bin2hex) {
+	run_bin2hex();
+}
+
+ZTEST(util_cxx, test_hex2bin) {
+	run_hex2bin();
+}
+
 ZTEST(util_cxx, test_COND_CODE_1) {
 	run_COND_CODE_1();
 }
@@ -161,6 +169,14 @@ ZTEST(util_cc, test_u8_to_dec) {
 	run_u8_to_dec();
 }
 
+ZTEST(util_cc, test_bin2hex) {
+	run_bin2hex();
+}
+
+ZTEST(util_cc, test_hex2bin) {
+	run_hex2bin();
+}
+
 ZTEST(util_cc, test_COND_CODE_1) {
 	run_COND_CODE_1();
 }